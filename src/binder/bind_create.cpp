@@ -32,6 +32,7 @@
 #include "binder/expressions/bound_constant.h"
 #include "binder/expressions/bound_star.h"
 #include "binder/expressions/bound_unary_op.h"
+#include "binder/statement/analyze_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/index_statement.h"
 #include "binder/statement/select_statement.h"
@@ -93,7 +94,14 @@ auto Binder::BindCreate(duckdb_libpgquery::PGCreateStmt *pg_stmt) -> std::unique
         auto cdef = reinterpret_cast<duckdb_libpgquery::PGColumnDef *>(c->data.ptr_value);
         auto centry = BindColumnDefinition(cdef);
         if (cdef->constraints != nullptr) {
-          throw NotImplementedException("constraints not supported");
+          for (auto cell = cdef->constraints->head; cell != nullptr; cell = lnext(cell)) {
+            auto constraint = reinterpret_cast<duckdb_libpgquery::PGConstraint *>(cell->data.ptr_value);
+            if (constraint->contype == duckdb_libpgquery::PG_CONSTR_NOTNULL) {
+              centry.SetNotNull();
+            } else if (constraint->contype != duckdb_libpgquery::PG_CONSTR_NULL) {
+              throw NotImplementedException("only NOT NULL and NULL constraints are supported");
+            }
+          }
         }
         columns.push_back(std::move(centry));
         column_count++;
@@ -129,7 +137,31 @@ auto Binder::BindIndex(duckdb_libpgquery::PGIndexStmt *stmt) -> std::unique_ptr<
     }
   }
 
-  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols));
+  // Without `USING`, the parser reports its own default access method, which is a B+ tree for us.
+  auto index_type = IndexType::BPlusTreeIndex;
+  auto access_method = StringUtil::Lower(stmt->accessMethod == nullptr ? "" : stmt->accessMethod);
+  if (access_method == "hash") {
+    index_type = IndexType::HashTableIndex;
+  } else if (!access_method.empty() && access_method != "btree" && access_method != DEFAULT_INDEX_TYPE) {
+    throw NotImplementedException(fmt::format("index type {} is not supported", access_method));
+  }
+
+  return std::make_unique<IndexStatement>(stmt->idxname, std::move(table), std::move(cols), index_type);
+}
+
+auto Binder::BindAnalyze(duckdb_libpgquery::PGVacuumStmt *stmt) -> std::unique_ptr<AnalyzeStatement> {
+  // The parser reads both VACUUM and ANALYZE into a vacuum statement. Tables are vacuumed with `\\vacuum` instead.
+  if ((stmt->options & duckdb_libpgquery::PG_VACOPT_VACUUM) != 0) {
+    throw NotImplementedException("VACUUM is not supported, use \\vacuum <table>");
+  }
+  if (stmt->va_cols != nullptr) {
+    throw NotImplementedException("ANALYZE of a column list is not supported");
+  }
+  if (stmt->relation == nullptr) {
+    return std::make_unique<AnalyzeStatement>("");
+  }
+  auto table = BindBaseTableRef(stmt->relation->relname, std::nullopt);
+  return std::make_unique<AnalyzeStatement>(table->table_);
 }
 
 }  // namespace bustub
@@ -0,0 +1,81 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "binder/binder.h"
+#include "binder/bound_expression.h"
+#include "binder/expressions/bound_constant.h"
+#include "binder/expressions/bound_parameter.h"
+#include "binder/statement/prepare_statement.h"
+#include "common/exception.h"
+#include "nodes/parsenodes.hpp"
+
+namespace bustub {
+
+auto Binder::BindPrepare(duckdb_libpgquery::PGPrepareStmt *stmt) -> std::unique_ptr<PrepareStatement> {
+  std::vector<TypeId> param_types;
+  if (stmt->argtypes != nullptr) {
+    for (auto c = stmt->argtypes->head; c != nullptr; c = lnext(c)) {
+      auto *type_name = reinterpret_cast<duckdb_libpgquery::PGTypeName *>(c->data.ptr_value);
+      auto name =
+          std::string(reinterpret_cast<duckdb_libpgquery::PGValue *>(type_name->names->tail->data.ptr_value)->val.str);
+      if (name == "int4") {
+        param_types.push_back(TypeId::INTEGER);
+      } else if (name == "varchar") {
+        param_types.push_back(TypeId::VARCHAR);
+      } else if (name == "bool") {
+        param_types.push_back(TypeId::BOOLEAN);
+      } else {
+        throw NotImplementedException(fmt::format("unsupported parameter type: {}", name));
+      }
+    }
+  }
+
+  parameter_types_ = std::move(param_types);
+  auto statement = BindStatement(stmt->query);
+  switch (statement->type_) {
+    case StatementType::SELECT_STATEMENT:
+    case StatementType::INSERT_STATEMENT:
+    case StatementType::UPDATE_STATEMENT:
+    case StatementType::DELETE_STATEMENT:
+      break;
+    default:
+      throw NotImplementedException(fmt::format("cannot prepare a {} statement", statement->type_));
+  }
+  auto prepare = std::make_unique<PrepareStatement>(stmt->name, std::move(statement), std::move(*parameter_types_));
+  parameter_types_.reset();
+  return prepare;
+}
+
+auto Binder::BindExecute(duckdb_libpgquery::PGExecuteStmt *stmt) -> std::unique_ptr<ExecuteStatement> {
+  std::vector<Value> params;
+  if (stmt->params != nullptr) {
+    for (auto &expr : BindExpressionList(stmt->params)) {
+      if (expr->type_ != ExpressionType::CONSTANT) {
+        throw NotImplementedException("parameters of EXECUTE must be constants");
+      }
+      params.push_back(dynamic_cast<const BoundConstant &>(*expr).val_);
+    }
+  }
+  return std::make_unique<ExecuteStatement>(stmt->name, std::move(params));
+}
+
+auto Binder::BindDeallocate(duckdb_libpgquery::PGDeallocateStmt *stmt) -> std::unique_ptr<DeallocateStatement> {
+  return std::make_unique<DeallocateStatement>(stmt->name == nullptr ? "" : stmt->name);
+}
+
+auto Binder::BindParamRef(duckdb_libpgquery::PGParamRef *node) -> std::unique_ptr<BoundExpression> {
+  if (!parameter_types_.has_value()) {
+    throw bustub::Exception("parameters can only be used in PREPARE");
+  }
+  if (node->number < 1) {
+    throw bustub::Exception(fmt::format("invalid parameter ${}", node->number));
+  }
+  auto param_idx = static_cast<uint32_t>(node->number - 1);
+  if (param_idx >= parameter_types_->size()) {
+    parameter_types_->resize(param_idx + 1, TypeId::INTEGER);
+  }
+  return std::make_unique<BoundParameter>(param_idx, (*parameter_types_)[param_idx]);
+}
+
+}  // namespace bustub
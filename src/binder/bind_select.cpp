@@ -14,6 +14,7 @@
 #include "binder/expressions/bound_column_ref.h"
 #include "binder/expressions/bound_constant.h"
 #include "binder/expressions/bound_star.h"
+#include "binder/expressions/bound_subquery_expr.h"
 #include "binder/expressions/bound_unary_op.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/select_statement.h"
@@ -479,6 +480,13 @@ auto Binder::BindColumnRef(duckdb_libpgquery::PGColumnRef *node) -> std::unique_
       for (auto node = fields->head; node != nullptr; node = node->next) {
         column_names.emplace_back(reinterpret_cast<duckdb_libpgquery::PGValue *>(node->data.ptr_value)->val.str);
       }
+      // A column the subquery does not have may come from the query around it, which makes the subquery correlated.
+      if (outer_scope_ != nullptr && (scope_->type_ == TableReferenceType::EMPTY ||
+                                      ResolveColumnInternal(*scope_, column_names) == nullptr)) {
+        if (auto outer_column = ResolveColumnInternal(*outer_scope_, column_names); outer_column != nullptr) {
+          return outer_column;
+        }
+      }
       return ResolveColumn(*scope_, column_names);
     }
     case duckdb_libpgquery::T_PGAStar: {
@@ -522,7 +530,7 @@ auto Binder::BindFuncCall(duckdb_libpgquery::PGFuncCall *root) -> std::unique_pt
   }
 
   if (function_name == "min" || function_name == "max" || function_name == "first" || function_name == "last" ||
-      function_name == "sum" || function_name == "count") {
+      function_name == "sum" || function_name == "count" || function_name == "avg") {
     // Rewrite count(*) to count_star().
     if (function_name == "count" && children.empty()) {
       function_name = "count_star";
@@ -780,6 +788,44 @@ auto Binder::BindBoolExpr(duckdb_libpgquery::PGBoolExpr *root) -> std::unique_pt
   UNREACHABLE("We should have handled all cases!");
 }
 
+auto Binder::BindSubLink(duckdb_libpgquery::PGSubLink *root) -> std::unique_ptr<BoundExpression> {
+  BUSTUB_ASSERT(root, "nullptr");
+  SubqueryType subquery_type;
+  std::unique_ptr<BoundExpression> child = nullptr;
+  switch (root->subLinkType) {
+    case duckdb_libpgquery::PG_EXISTS_SUBLINK: {
+      subquery_type = SubqueryType::EXISTS;
+      break;
+    }
+    case duckdb_libpgquery::PG_ANY_SUBLINK: {
+      // `x IN (...)` has no operator name, `x = ANY (...)` has `=`.
+      if (root->operName != nullptr) {
+        auto op_name =
+            std::string(reinterpret_cast<duckdb_libpgquery::PGValue *>(root->operName->head->data.ptr_value)->val.str);
+        if (op_name != "=") {
+          throw NotImplementedException(fmt::format("{} ANY is not supported", op_name));
+        }
+      }
+      subquery_type = SubqueryType::ANY;
+      child = BindExpression(root->testexpr);
+      break;
+    }
+    default:
+      throw NotImplementedException("only EXISTS and IN subqueries are supported");
+  }
+
+  // The subquery sees the columns of this query, but not those of the queries around this one.
+  auto old_outer_scope = outer_scope_;
+  outer_scope_ = scope_;
+  auto subquery = BindSelect(reinterpret_cast<duckdb_libpgquery::PGSelectStmt *>(root->subselect));
+  outer_scope_ = old_outer_scope;
+
+  if (subquery_type == SubqueryType::ANY && subquery->select_list_.size() != 1) {
+    throw bustub::Exception("subquery of IN must return exactly one column");
+  }
+  return std::make_unique<BoundSubqueryExpr>(subquery_type, std::move(subquery), std::move(child));
+}
+
 auto Binder::BindExpression(duckdb_libpgquery::PGNode *node) -> std::unique_ptr<BoundExpression> {
   BUSTUB_ASSERT(node, "nullptr");
   switch (node->type) {
@@ -797,6 +843,10 @@ auto Binder::BindExpression(duckdb_libpgquery::PGNode *node) -> std::unique_ptr<
       return BindAExpr(reinterpret_cast<duckdb_libpgquery::PGAExpr *>(node));
     case duckdb_libpgquery::T_PGBoolExpr:
       return BindBoolExpr(reinterpret_cast<duckdb_libpgquery::PGBoolExpr *>(node));
+    case duckdb_libpgquery::T_PGParamRef:
+      return BindParamRef(reinterpret_cast<duckdb_libpgquery::PGParamRef *>(node));
+    case duckdb_libpgquery::T_PGSubLink:
+      return BindSubLink(reinterpret_cast<duckdb_libpgquery::PGSubLink *>(node));
     default:
       break;
   }
@@ -830,6 +880,9 @@ auto Binder::BindExplain(duckdb_libpgquery::PGExplainStmt *stmt) -> std::unique_
       if (strcmp(temp->defname, "schema") == 0 || strcmp(temp->defname, "s") == 0) {
         explain_options |= ExplainOptions::SCHEMA;
       }
+      if (strcmp(temp->defname, "analyze") == 0 || strcmp(temp->defname, "a") == 0) {
+        explain_options |= ExplainOptions::ANALYZE;
+      }
     }
   }
   return std::make_unique<ExplainStatement>(BindStatement(stmt->query), explain_options);
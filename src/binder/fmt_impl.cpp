@@ -1,5 +1,6 @@
 #include "binder/bound_order_by.h"
 #include "binder/expressions/bound_agg_call.h"
+#include "binder/expressions/bound_subquery_expr.h"
 #include "binder/statement/select_statement.h"
 #include "binder/table_ref/bound_cte_ref.h"
 #include "binder/table_ref/bound_expression_list_ref.h"
@@ -34,4 +35,12 @@ auto BoundSubqueryRef::ToString() const -> std::string {
                      StringUtil::IndentAllLines(subquery_->ToString(), 2, true), columns);
 }
 
+auto BoundSubqueryExpr::ToString() const -> std::string {
+  auto subquery = StringUtil::IndentAllLines(subquery_->ToString(), 2, true);
+  if (subquery_type_ == SubqueryType::EXISTS) {
+    return fmt::format("(EXISTS {})", subquery);
+  }
+  return fmt::format("({} IN {})", child_, subquery);
+}
+
 }  // namespace bustub
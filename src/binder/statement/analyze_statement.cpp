@@ -0,0 +1,13 @@
+#include "binder/statement/analyze_statement.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+AnalyzeStatement::AnalyzeStatement(std::string table)
+    : BoundStatement(StatementType::ANALYZE_STATEMENT), table_(std::move(table)) {}
+
+auto AnalyzeStatement::ToString() const -> std::string {
+  return fmt::format("BoundAnalyze {{ table={} }}", table_.empty() ? "<stale tables>" : table_);
+}
+
+}  // namespace bustub
@@ -0,0 +1,46 @@
+#include "binder/statement/prepare_statement.h"
+#include "fmt/format.h"
+#include "fmt/ranges.h"
+
+#include "common/util/string_util.h"
+#include "type/type.h"
+
+namespace bustub {
+
+PrepareStatement::PrepareStatement(std::string name, std::unique_ptr<BoundStatement> statement,
+                                   std::vector<TypeId> param_types)
+    : BoundStatement(StatementType::PREPARE_STATEMENT),
+      name_(std::move(name)),
+      statement_(std::move(statement)),
+      param_types_(std::move(param_types)) {}
+
+auto PrepareStatement::ToString() const -> std::string {
+  std::vector<std::string> types;
+  types.reserve(param_types_.size());
+  for (auto type : param_types_) {
+    types.push_back(Type::TypeIdToString(type));
+  }
+  return fmt::format("BoundPrepare {{\n  name={},\n  param_types=[{}],\n  statement={},\n}}", name_,
+                     fmt::join(types, ", "), StringUtil::IndentAllLines(statement_->ToString(), 2, true));
+}
+
+ExecuteStatement::ExecuteStatement(std::string name, std::vector<Value> params)
+    : BoundStatement(StatementType::EXECUTE_STATEMENT), name_(std::move(name)), params_(std::move(params)) {}
+
+auto ExecuteStatement::ToString() const -> std::string {
+  std::vector<std::string> params;
+  params.reserve(params_.size());
+  for (const auto &param : params_) {
+    params.push_back(param.ToString());
+  }
+  return fmt::format("BoundExecute {{ name={}, params=[{}] }}", name_, fmt::join(params, ", "));
+}
+
+DeallocateStatement::DeallocateStatement(std::string name)
+    : BoundStatement(StatementType::DEALLOCATE_STATEMENT), name_(std::move(name)) {}
+
+auto DeallocateStatement::ToString() const -> std::string {
+  return fmt::format("BoundDeallocate {{ name={} }}", name_.empty() ? "<all>" : name_);
+}
+
+}  // namespace bustub
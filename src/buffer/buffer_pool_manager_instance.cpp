@@ -15,8 +15,11 @@
 
 #include "common/config.h"
 #include "common/exception.h"
+#include "common/logger.h"
 #include "common/macros.h"
+#include "storage/page/b_plus_tree_page.h"
 #include "storage/page/page.h"
+#include "storage/page/table_page.h"
 
 namespace bustub {
 
@@ -33,6 +36,9 @@ BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManag
     free_list_.emplace_back(static_cast<int>(i));
   }
 
+  // A reopened database file keeps its pages, so new pages go after them.
+  next_page_id_ = disk_manager_->GetNumPages();
+
   // // TODO(students): remove this line after you have implemented the buffer pool manager
   // throw NotImplementedException(
   //     "BufferPoolManager is not implemented yet. If you have finished implementing BPM, please remove the throw "
@@ -40,18 +46,24 @@ BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManag
 }
 
 BufferPoolManagerInstance::~BufferPoolManagerInstance() {
+  // Nobody can unpin a page anymore, so whatever is still pinned was leaked.
+  for (const auto &[page_id, pin_count] : GetPinnedPages()) {
+    LOG_WARN("page %d is still pinned %d time(s) at shutdown", page_id, pin_count);
+  }
   delete[] pages_;
   delete page_table_;
   delete replacer_;
 }
 
 auto BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) -> Page * {
-  std::scoped_lock<std::mutex> lock(latch_);
+  auto lock = AcquireLatch();
 
   frame_id_t available_frame_id = -1;
   if (!AvailableFrameJudgement(&available_frame_id)) {
+    stats_.no_free_frame_.Add();
     return nullptr;
   }
+  stats_.new_pages_.Add();
   auto new_page = AllocatePage();
   pages_[available_frame_id].ResetMemory();
   pages_[available_frame_id].pin_count_ = 1;
@@ -66,17 +78,22 @@ auto BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) -> Page * {
 }
 
 auto BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) -> Page * {
-  std::scoped_lock<std::mutex> lock(latch_);
+  auto lock = AcquireLatch();
 
   auto existing_frame_id = -1;
   if (page_table_->Find(page_id, existing_frame_id)) {
+    stats_.fetch_hits_.Add();
+    GetThreadStats().fetch_hits_++;
     replacer_->RecordAccess(existing_frame_id);
     replacer_->SetEvictable(existing_frame_id, false);
     pages_[existing_frame_id].pin_count_++;  // pin_count 记录了访问这个页面的线程数量
     return &pages_[existing_frame_id];
   }
+  stats_.fetch_misses_.Add();
+  GetThreadStats().fetch_misses_++;
   frame_id_t available_frame_id = -1;
   if (!AvailableFrameJudgement(&available_frame_id)) {
+    stats_.no_free_frame_.Add();
     return nullptr;
   }
 
@@ -94,7 +111,7 @@ auto BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) -> Page * {
 }
 
 auto BufferPoolManagerInstance::UnpinPgImp(page_id_t page_id, bool is_dirty) -> bool {
-  std::scoped_lock<std::mutex> lock(latch_);
+  auto lock = AcquireLatch();
 
   auto unpin_frame = -1;
   if (!page_table_->Find(page_id, unpin_frame)) {
@@ -113,28 +130,30 @@ auto BufferPoolManagerInstance::UnpinPgImp(page_id_t page_id, bool is_dirty) ->
 }
 
 auto BufferPoolManagerInstance::FlushPgImp(page_id_t page_id) -> bool {
-  std::scoped_lock<std::mutex> lock(latch_);
+  auto lock = AcquireLatch();
   auto flush_frame = -1;
   if (!page_table_->Find(page_id, flush_frame)) {
     return false;
   }
   disk_manager_->WritePage(page_id, pages_[flush_frame].GetData());
+  stats_.flushes_.Add();
   pages_[flush_frame].is_dirty_ = false;
   return true;
 }
 
 void BufferPoolManagerInstance::FlushAllPgsImp() {
-  std::scoped_lock<std::mutex> lock(latch_);
+  auto lock = AcquireLatch();
   for (size_t i = 0; i < pool_size_; i++) {
     if (pages_[i].page_id_ != INVALID_PAGE_ID) {
-      disk_manager_->WritePage(i, pages_[i].GetData());
+      disk_manager_->WritePage(pages_[i].page_id_, pages_[i].GetData());
+      stats_.flushes_.Add();
       pages_[i].is_dirty_ = false;
     }
   }
 }
 
 auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
-  std::scoped_lock<std::mutex> lock(latch_);
+  auto lock = AcquireLatch();
   auto delete_frame = -1;
   if (!page_table_->Find(page_id, delete_frame)) {
     return true;
@@ -146,6 +165,7 @@ auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
     disk_manager_->WritePage(page_id, pages_[delete_frame].GetData());
     pages_[delete_frame].is_dirty_ = false;
   }
+  stats_.deleted_pages_.Add();
   page_table_->Remove(page_id);
   replacer_->Remove(delete_frame);
   free_list_.push_back(delete_frame);
@@ -158,6 +178,57 @@ auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
   return true;
 }
 
+auto BufferPoolManagerInstance::GetPinnedPages() -> std::vector<std::pair<page_id_t, int>> {
+  std::scoped_lock<std::mutex> lock(latch_);
+  std::vector<std::pair<page_id_t, int>> pinned_pages;
+  for (size_t i = 0; i < pool_size_; i++) {
+    if (pages_[i].page_id_ != INVALID_PAGE_ID && pages_[i].pin_count_ > 0) {
+      pinned_pages.emplace_back(pages_[i].page_id_, pages_[i].pin_count_);
+    }
+  }
+  return pinned_pages;
+}
+
+auto BufferPoolManagerInstance::GetResidency() -> PageResidency {
+  auto lock = AcquireLatch();
+  PageResidency residency;
+  for (size_t i = 0; i < pool_size_; i++) {
+    const auto &page = pages_[i];
+    if (page.page_id_ == INVALID_PAGE_ID) {
+      residency.free_++;
+      continue;
+    }
+    residency.pinned_ += page.pin_count_ > 0 ? 1 : 0;
+    residency.dirty_ += page.is_dirty_ ? 1 : 0;
+
+    // Pages carry no type tag, so they are told apart by the page id each layout keeps in its header: a table page
+    // starts with it, a B+ tree page stores it after its type and size fields.
+    const auto *tree_page = reinterpret_cast<const BPlusTreePage *>(page.GetData());
+    if (page.page_id_ == HEADER_PAGE_ID) {
+      residency.header_++;
+    } else if (tree_page->GetPageId() == page.page_id_ && tree_page->IsLeafPage()) {
+      residency.index_leaf_++;
+    } else if (tree_page->GetPageId() == page.page_id_ && tree_page->IsInternalPage()) {
+      residency.index_internal_++;
+    } else if (static_cast<const TablePage &>(page).GetTablePageId() == page.page_id_) {
+      residency.table_++;
+    } else {
+      residency.other_++;
+    }
+  }
+  return residency;
+}
+
+auto BufferPoolManagerInstance::AcquireLatch() -> std::unique_lock<std::mutex> {
+  std::unique_lock<std::mutex> lock(latch_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    stats_.latch_contentions_.Add();
+    StatTimer timer(&stats_.latch_wait_ns_);
+    lock.lock();
+  }
+  return lock;
+}
+
 auto BufferPoolManagerInstance::AllocatePage() -> page_id_t { return next_page_id_++; }
 
 auto BufferPoolManagerInstance::AvailableFrameJudgement(frame_id_t *available_frame_id) -> bool {
@@ -168,6 +239,7 @@ auto BufferPoolManagerInstance::AvailableFrameJudgement(frame_id_t *available_fr
   }
   if (replacer_->Evict(available_frame_id)) {
     if (pages_[*available_frame_id].IsDirty()) {
+      stats_.dirty_writebacks_.Add();
       disk_manager_->WritePage(pages_[*available_frame_id].page_id_, pages_[*available_frame_id].GetData());
       pages_[*available_frame_id].is_dirty_ = false;
     }
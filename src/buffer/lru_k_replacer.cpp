@@ -183,13 +183,16 @@ auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
    * 如果没有可以驱逐元素
    */
   if (Size() == 0) {
+    stats_.failed_evictions_.Add();
     return false;
   }
+  size_t scanned = 0;
   /**
    * 首先尝试删除距离为无限大的缓存
    */
   for (auto it = new_frame_.rbegin(); it != new_frame_.rend(); it++) {
     auto frame = *it;
+    scanned++;
     if (evictable_[frame]) {
       recorded_cnt_[frame] = 0;
       new_locate_.erase(frame);
@@ -197,6 +200,8 @@ auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
       *frame_id = frame;
       curr_size_--;
       hist_[frame].clear();
+      stats_.evictions_.Add();
+      stats_.evict_scan_length_.Record(scanned);
       return true;
     }
   }
@@ -206,6 +211,7 @@ auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
    */
   for (auto it = cache_frame_.begin(); it != cache_frame_.end(); it++) {
     auto frame = (*it).first;
+    scanned++;
     if (evictable_[frame]) {
       recorded_cnt_[frame] = 0;
       cache_frame_.erase(it);
@@ -213,9 +219,13 @@ auto LRUKReplacer::Evict(frame_id_t *frame_id) -> bool {
       *frame_id = frame;
       curr_size_--;
       hist_[frame].clear();
+      stats_.evictions_.Add();
+      stats_.evict_scan_length_.Record(scanned);
       return true;
     }
   }
+  stats_.failed_evictions_.Add();
+  stats_.evict_scan_length_.Record(scanned);
   return false;
 }
 
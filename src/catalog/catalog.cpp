@@ -0,0 +1,304 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// catalog.cpp
+//
+// Identification: src/catalog/catalog.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/catalog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "fmt/format.h"
+#include "storage/index/generic_key.h"
+#include "storage/page/catalog_page.h"
+#include "storage/page/header_page.h"
+
+namespace bustub {
+
+namespace {
+
+/** Bumped whenever the layout of the serialized catalog changes. */
+constexpr uint32_t CATALOG_FORMAT_VERSION = 3;
+
+/** CatalogWriter appends fixed-size values and length-prefixed strings to the catalog stream. */
+class CatalogWriter {
+ public:
+  template <class T>
+  void Write(T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    buffer_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  void WriteString(const std::string &value) {
+    Write(static_cast<uint32_t>(value.size()));
+    buffer_.append(value);
+  }
+
+  auto GetBuffer() const -> const std::string & { return buffer_; }
+
+ private:
+  std::string buffer_;
+};
+
+/** CatalogReader reads the values back in the order they were written, and throws if the stream ends early. */
+class CatalogReader {
+ public:
+  explicit CatalogReader(const std::string &buffer) : buffer_(buffer) {}
+
+  template <class T>
+  auto Read() -> T {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    memcpy(&value, Consume(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  auto ReadString() -> std::string {
+    auto size = Read<uint32_t>();
+    return {Consume(size), size};
+  }
+
+ private:
+  auto Consume(size_t size) -> const char * {
+    if (size > buffer_.size() - offset_) {
+      throw Exception("the catalog pages are corrupted");
+    }
+    const char *data = buffer_.data() + offset_;
+    offset_ += size;
+    return data;
+  }
+
+  const std::string &buffer_;
+  size_t offset_{0};
+};
+
+/** Reopen an index of the key type GenericKey<KeySize>, which is what the catalog builds indexes with. */
+template <size_t KeySize>
+auto OpenIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *bpm, IndexType index_type,
+               page_id_t root_page_id) -> std::unique_ptr<Index> {
+  using KeyType = GenericKey<KeySize>;
+  using KeyComparator = GenericComparator<KeySize>;
+  if (index_type == IndexType::HashTableIndex) {
+    return std::make_unique<ExtendibleHashTableIndex<KeyType, RID, KeyComparator>>(
+        std::move(metadata), bpm, HashFunction<KeyType>{}, root_page_id);
+  }
+  return std::make_unique<BPlusTreeIndex<KeyType, RID, KeyComparator>>(std::move(metadata), bpm, root_page_id);
+}
+
+}  // namespace
+
+void Catalog::Save() {
+  if (bpm_ == nullptr) {
+    return;
+  }
+
+  CatalogWriter out;
+  out.Write(CATALOG_FORMAT_VERSION);
+  out.Write(next_table_oid_.load());
+  out.Write(next_index_oid_.load());
+
+  std::vector<const TableInfo *> tables;
+  for (const auto &[oid, table_info] : tables_) {
+    if (table_info->table_ != nullptr) {
+      tables.push_back(table_info.get());
+    }
+  }
+  out.Write(static_cast<uint32_t>(tables.size()));
+  for (const auto *table_info : tables) {
+    out.Write(table_info->oid_);
+    out.WriteString(table_info->name_);
+    out.Write(table_info->table_->GetFirstPageId());
+    out.Write(table_info->table_->GetTupleCount());
+    out.Write(static_cast<uint32_t>(table_info->schema_.GetColumnCount()));
+    for (const auto &column : table_info->schema_.GetColumns()) {
+      out.WriteString(column.GetName());
+      out.Write(column.GetType());
+      out.Write(column.GetLength());
+      out.Write(column.IsNullable());
+    }
+
+    auto indexes = GetTableIndexes(table_info->name_);
+    out.Write(static_cast<uint32_t>(indexes.size()));
+    for (auto *index_info : indexes) {
+      out.Write(index_info->index_oid_);
+      out.WriteString(index_info->name_);
+      out.Write(index_info->index_type_);
+      out.Write(static_cast<uint32_t>(index_info->key_size_));
+      out.Write(index_info->index_->GetRootPageId());
+      const auto &key_attrs = index_info->index_->GetKeyAttrs();
+      out.Write(static_cast<uint32_t>(key_attrs.size()));
+      for (auto key_attr : key_attrs) {
+        out.Write(key_attr);
+      }
+    }
+  }
+
+  // Cut the stream into pages, writing over the pages of the previous save before allocating new ones.
+  const auto &stream = out.GetBuffer();
+  auto page_cnt = std::max<size_t>(1, (stream.size() + CatalogPage::DATA_CAPACITY - 1) / CatalogPage::DATA_CAPACITY);
+  while (catalog_page_ids_.size() < page_cnt) {
+    page_id_t page_id;
+    auto guard = bpm_->NewPageGuarded(&page_id);
+    if (!guard.IsValid()) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate a page for the catalog");
+    }
+    catalog_page_ids_.push_back(page_id);
+  }
+  for (size_t i = 0; i < page_cnt; i++) {
+    auto offset = i * CatalogPage::DATA_CAPACITY;
+    auto size = std::min(stream.size() - offset, CatalogPage::DATA_CAPACITY);
+    auto guard = bpm_->FetchPageWrite(catalog_page_ids_[i]);
+    auto *page = guard.AsMut<CatalogPage>();
+    page->Init();
+    page->SetData(stream.data() + offset, size);
+    if (i + 1 < page_cnt) {
+      page->SetNextPageId(catalog_page_ids_[i + 1]);
+    }
+  }
+  // The catalog shrank: the chain now ends earlier, and the pages past its end hold nothing.
+  while (catalog_page_ids_.size() > page_cnt) {
+    bpm_->DeletePage(catalog_page_ids_.back());
+    catalog_page_ids_.pop_back();
+  }
+
+  auto header_guard = bpm_->FetchPageWrite(HEADER_PAGE_ID);
+  auto *header_page = header_guard.AsMut<HeaderPage>();
+  if (!header_page->UpdateRecord(CatalogPage::CATALOG_RECORD_NAME, catalog_page_ids_[0]) &&
+      !header_page->InsertRecord(CatalogPage::CATALOG_RECORD_NAME, catalog_page_ids_[0])) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "the header page has no room for the catalog record");
+  }
+}
+
+void Catalog::Load() {
+  BUSTUB_ASSERT(tables_.empty() && indexes_.empty(), "The catalog can only be loaded into an empty catalog.");
+  if (bpm_ == nullptr) {
+    return;
+  }
+
+  page_id_t page_id;
+  {
+    auto header_guard = bpm_->FetchPageRead(HEADER_PAGE_ID);
+    if (!header_guard.As<HeaderPage>()->GetRootId(CatalogPage::CATALOG_RECORD_NAME, &page_id)) {
+      // No clean shutdown has saved a catalog into this file yet. There is no log to recover one from.
+      return;
+    }
+  }
+  std::string stream;
+  while (page_id != INVALID_PAGE_ID) {
+    auto guard = bpm_->FetchPageRead(page_id);
+    const auto *page = guard.As<CatalogPage>();
+    catalog_page_ids_.push_back(page_id);
+    stream.append(page->GetData(), page->GetDataSize());
+    page_id = page->GetNextPageId();
+  }
+
+  CatalogReader in(stream);
+  if (in.Read<uint32_t>() != CATALOG_FORMAT_VERSION) {
+    throw Exception("the catalog was saved in an unknown format");
+  }
+  next_table_oid_ = in.Read<table_oid_t>();
+  next_index_oid_ = in.Read<index_oid_t>();
+
+  auto table_cnt = in.Read<uint32_t>();
+  for (uint32_t i = 0; i < table_cnt; i++) {
+    auto table_oid = in.Read<table_oid_t>();
+    auto table_name = in.ReadString();
+    auto first_page_id = in.Read<page_id_t>();
+    auto tuple_count = in.Read<uint64_t>();
+    std::vector<Column> columns;
+    auto column_cnt = in.Read<uint32_t>();
+    columns.reserve(column_cnt);
+    for (uint32_t j = 0; j < column_cnt; j++) {
+      auto column_name = in.ReadString();
+      auto type = in.Read<TypeId>();
+      auto length = in.Read<uint32_t>();
+      auto is_nullable = in.Read<bool>();
+      if (type == TypeId::VARCHAR) {
+        columns.emplace_back(std::move(column_name), type, length);
+      } else {
+        columns.emplace_back(std::move(column_name), type);
+      }
+      if (!is_nullable) {
+        columns.back().SetNotNull();
+      }
+    }
+
+    // The count and the page chain are whatever the last clean shutdown saved. Without a log to replay, the
+    // catalog state of a database that crashed after that save is not recovered, so it is not checked either.
+    auto table = std::make_unique<TableHeap>(bpm_, lock_manager_, log_manager_, first_page_id, tuple_count);
+    auto table_info = std::make_unique<TableInfo>(Schema{columns}, table_name, std::move(table), table_oid);
+    const auto &schema = table_info->schema_;
+    auto &table_indexes = index_names_[table_name];
+
+    auto index_cnt = in.Read<uint32_t>();
+    for (uint32_t j = 0; j < index_cnt; j++) {
+      auto index_oid = in.Read<index_oid_t>();
+      auto index_name = in.ReadString();
+      auto index_type = in.Read<IndexType>();
+      auto key_size = in.Read<uint32_t>();
+      auto root_page_id = in.Read<page_id_t>();
+      std::vector<uint32_t> key_attrs(in.Read<uint32_t>());
+      for (auto &key_attr : key_attrs) {
+        key_attr = in.Read<uint32_t>();
+      }
+
+      auto metadata = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs);
+      std::unique_ptr<Index> index;
+      switch (key_size) {
+        case 4:
+          index = OpenIndex<4>(std::move(metadata), bpm_, index_type, root_page_id);
+          break;
+        case 8:
+          index = OpenIndex<8>(std::move(metadata), bpm_, index_type, root_page_id);
+          break;
+        case 16:
+          index = OpenIndex<16>(std::move(metadata), bpm_, index_type, root_page_id);
+          break;
+        case 32:
+          index = OpenIndex<32>(std::move(metadata), bpm_, index_type, root_page_id);
+          break;
+        case 64:
+          index = OpenIndex<64>(std::move(metadata), bpm_, index_type, root_page_id);
+          break;
+        default:
+          throw Exception(fmt::format("cannot reopen index {} with a key of {} bytes", index_name, key_size));
+      }
+
+      auto key_schema = Schema::CopySchema(&schema, key_attrs);
+      indexes_.emplace(index_oid, std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid,
+                                                              table_name, key_size, index_type));
+      table_indexes.emplace(index_name, index_oid);
+    }
+
+    tables_.emplace(table_oid, std::move(table_info));
+    table_names_.emplace(table_name, table_oid);
+  }
+}
+
+void Catalog::AnalyzeTable(TableInfo *table_info) {
+  if (table_info->table_ == nullptr) {
+    throw Exception(fmt::format("table {} has no table heap to analyze", table_info->name_));
+  }
+  auto stats = std::make_unique<TableStats>(TableStats::Collect(bpm_, *table_info->table_, table_info->schema_,
+                                                                table_info->oid_));
+  {
+    std::scoped_lock lock(table_info->stats_latch_);
+    table_info->stats_ = std::move(stats);
+  }
+  version_.fetch_add(1);
+}
+
+}  // namespace bustub
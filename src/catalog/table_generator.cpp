@@ -170,6 +170,10 @@ void TableGenerator::GenerateTestTables() {
   };
 
   for (auto &table_meta : insert_meta) {
+    // A reopened database already has its test tables.
+    if (exec_ctx_->GetCatalog()->GetTable(table_meta.name_) != Catalog::NULL_TABLE_INFO) {
+      continue;
+    }
     // Create Schema
     std::vector<Column> cols{};
     cols.reserve(table_meta.col_meta_.size());
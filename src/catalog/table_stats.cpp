@@ -0,0 +1,214 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_stats.cpp
+//
+// Identification: src/catalog/table_stats.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/table_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string_view>
+
+#include "common/exception.h"
+#include "storage/table/tuple_view.h"
+
+namespace bustub {
+
+namespace {
+
+/** The finalizer of MurmurHash3, which spreads every input bit over the whole hash. */
+auto Mix(uint64_t hash) -> uint64_t {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/**
+ * Hash a non-null value for the distinct-count sketch. HashUtil's byte hash collides a lot on integers, so numbers are
+ * hashed by their bits, which the sketch mixes again.
+ */
+auto SketchHash(const Value &value) -> hash_t {
+  switch (value.GetTypeId()) {
+    case TypeId::TINYINT:
+      return static_cast<hash_t>(value.GetAs<int8_t>());
+    case TypeId::SMALLINT:
+      return static_cast<hash_t>(value.GetAs<int16_t>());
+    case TypeId::INTEGER:
+      return static_cast<hash_t>(value.GetAs<int32_t>());
+    case TypeId::BIGINT:
+    case TypeId::TIMESTAMP:
+      return static_cast<hash_t>(value.GetAs<int64_t>());
+    case TypeId::DECIMAL: {
+      auto raw = value.GetAs<double>();
+      hash_t bits;
+      memcpy(&bits, &raw, sizeof(bits));
+      return bits;
+    }
+    case TypeId::VARCHAR:
+      return std::hash<std::string_view>{}(std::string_view(value.GetData(), value.GetLength()));
+    default:
+      return HashUtil::HashValue(&value);
+  }
+}
+
+auto IsLess(const Value &left, const Value &right) -> bool { return left.CompareLessThan(right) == CmpBool::CmpTrue; }
+
+/** Account for a non-null value in the sketch and the bounds of a column. */
+void AddValue(ColumnStats *column, const Value &value) {
+  column->distinct_.Add(SketchHash(value));
+  if (column->min_.IsNull() || IsLess(value, column->min_)) {
+    column->min_ = value;
+  }
+  if (column->max_.IsNull() || IsLess(column->max_, value)) {
+    column->max_ = value;
+  }
+}
+
+}  // namespace
+
+void HyperLogLog::Add(hash_t hash) {
+  auto mixed = Mix(hash);
+  auto idx = mixed >> (64 - PRECISION);
+  // The guard bit bounds the rank when the remaining bits are all zero.
+  auto rest = (mixed << PRECISION) | (uint64_t{1} << (PRECISION - 1));
+  auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+  registers_[idx] = std::max(registers_[idx], rank);
+}
+
+auto HyperLogLog::Estimate() const -> uint64_t {
+  const auto m = static_cast<double>(REGISTER_CNT);
+  double sum = 0;
+  size_t zeros = 0;
+  for (auto reg : registers_) {
+    sum += std::ldexp(1.0, -reg);
+    zeros += reg == 0 ? 1 : 0;
+  }
+  auto estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+  // Small cardinalities leave registers empty, and are estimated better by counting those.
+  if (estimate <= 2.5 * m && zeros != 0) {
+    estimate = m * std::log(m / static_cast<double>(zeros));
+  }
+  return static_cast<uint64_t>(std::llround(estimate));
+}
+
+EquiDepthHistogram::EquiDepthHistogram(std::vector<Value> *sample) {
+  std::sort(sample->begin(), sample->end(), IsLess);
+  auto n = sample->size();
+  auto bucket_cnt = std::min(BUCKET_CNT, n);
+  bounds_.reserve(bucket_cnt);
+  for (size_t i = 0; i < bucket_cnt; i++) {
+    bounds_.push_back((*sample)[(i + 1) * n / bucket_cnt - 1]);
+  }
+}
+
+auto EquiDepthHistogram::EstimateLessThan(const Value &value) const -> double {
+  if (bounds_.empty()) {
+    return 0.5;
+  }
+  // Every bucket before the first one whose bound is not below the value lies entirely below it. The value is assumed
+  // to fall in the middle of its own bucket.
+  auto bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value, IsLess) - bounds_.begin();
+  if (static_cast<size_t>(bucket) == bounds_.size()) {
+    return 1.0;
+  }
+  return (static_cast<double>(bucket) + 0.5) / static_cast<double>(bounds_.size());
+}
+
+auto TableStats::Collect(BufferPoolManager *bpm, const TableHeap &table, const Schema &schema, uint64_t seed)
+    -> TableStats {
+  TableStats stats;
+  auto column_cnt = schema.GetColumnCount();
+  stats.columns_.resize(column_cnt);
+
+  // Every row is counted, and a reservoir keeps a uniform sample of the rows for the histograms.
+  std::mt19937_64 gen(seed);
+  std::vector<std::vector<Value>> sample(column_cnt);
+  for (auto page_id = table.GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+    TupleView view(bpm, page_id);
+    if (!view.IsValid()) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch a table page to analyze");
+    }
+    for (bool found = view.SeekFirst(); found; found = view.SeekAfter(view.GetRid())) {
+      auto row = stats.row_count_++;
+      size_t slot = row;
+      if (row >= SAMPLE_SIZE) {
+        slot = std::uniform_int_distribution<uint64_t>(0, row)(gen);
+      }
+      for (uint32_t i = 0; i < column_cnt; i++) {
+        auto value = view.GetValue(&schema, i);
+        if (value.IsNull()) {
+          stats.columns_[i].null_count_++;
+        } else {
+          AddValue(&stats.columns_[i], value);
+        }
+        if (row < SAMPLE_SIZE) {
+          sample[i].push_back(std::move(value));
+        } else if (slot < SAMPLE_SIZE) {
+          sample[i][slot] = std::move(value);
+        }
+      }
+    }
+    page_id = view.GetNextPageId();
+  }
+
+  stats.analyzed_rows_ = stats.row_count_;
+  stats.sampled_rows_ = std::min<uint64_t>(stats.row_count_, SAMPLE_SIZE);
+  for (uint32_t i = 0; i < column_cnt; i++) {
+    auto &values = sample[i];
+    values.erase(std::remove_if(values.begin(), values.end(), [](const Value &value) { return value.IsNull(); }),
+                 values.end());
+    stats.columns_[i].histogram_ = EquiDepthHistogram(&values);
+  }
+  return stats;
+}
+
+void TableStats::RecordInsert(const Tuple &tuple, const Schema &schema) {
+  row_count_++;
+  modified_rows_++;
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    auto value = tuple.GetValue(&schema, i);
+    if (value.IsNull()) {
+      columns_[i].null_count_++;
+    } else {
+      AddValue(&columns_[i], value);
+    }
+  }
+}
+
+void TableStats::RecordDelete(const Tuple &tuple, const Schema &schema) {
+  row_count_ -= std::min<uint64_t>(row_count_, 1);
+  modified_rows_++;
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    if (columns_[i].null_count_ != 0 && tuple.GetValue(&schema, i).IsNull()) {
+      columns_[i].null_count_--;
+    }
+  }
+}
+
+auto TableStats::GetDistinctCount(uint32_t col_idx) const -> uint64_t {
+  const auto &column = columns_[col_idx];
+  auto non_null_rows = row_count_ - std::min(row_count_, column.null_count_);
+  return std::min(column.distinct_.Estimate(), non_null_rows);
+}
+
+auto TableStats::GetNullFraction(uint32_t col_idx) const -> double {
+  if (row_count_ == 0) {
+    return 0;
+  }
+  return static_cast<double>(columns_[col_idx].null_count_) / static_cast<double>(row_count_);
+}
+
+}  // namespace bustub
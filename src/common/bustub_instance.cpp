@@ -1,14 +1,18 @@
+#include <mutex>  // NOLINT
 #include <optional>
 #include <shared_mutex>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
+#include "binder/statement/analyze_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/index_statement.h"
+#include "binder/statement/prepare_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
 #include "buffer/buffer_pool_manager_instance.h"
@@ -17,22 +21,28 @@
 #include "common/bustub_instance.h"
 #include "common/enums/statement_type.h"
 #include "common/exception.h"
+#include "common/logger.h"
 #include "common/util/string_util.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
 #include "execution/execution_engine.h"
+#include "execution/execution_profile.h"
 #include "execution/executor_context.h"
 #include "execution/executors/mock_scan_executor.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/parameter_value_expression.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/result_cursor.h"
 #include "fmt/core.h"
 #include "fmt/format.h"
+#include "optimizer/cost_model.h"
 #include "optimizer/optimizer.h"
 #include "planner/planner.h"
 #include "recovery/checkpoint_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
 #include "storage/disk/disk_manager_memory.h"
+#include "storage/page/header_page.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -59,6 +69,19 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
     buffer_pool_manager_ = nullptr;
   }
 
+  // A database file that already holds pages is reopened: it has its header page, and the catalog saved in it.
+  is_file_backed_ = true;
+  bool reopen = buffer_pool_manager_ != nullptr && disk_manager_->GetNumPages() > 0;
+
+  // Reserve the header page, in which the B+ tree indexes record their root page ids. Otherwise the first table page
+  // would be allocated there and overwritten by the first index created.
+  if (buffer_pool_manager_ != nullptr && !reopen) {
+    page_id_t header_page_id;
+    auto header_guard = buffer_pool_manager_->NewPageGuarded(&header_page_id);
+    BUSTUB_ASSERT(header_page_id == HEADER_PAGE_ID, "The header page must be the first page.");
+    header_guard.AsMut<HeaderPage>()->Init();
+  }
+
   // Transaction (txn) related.
   lock_manager_ = new LockManager();
   txn_manager_ = new TransactionManager(lock_manager_, log_manager_);
@@ -68,6 +91,12 @@ BustubInstance::BustubInstance(const std::string &db_file_name) {
 
   // Catalog.
   catalog_ = new Catalog(buffer_pool_manager_, lock_manager_, log_manager_);
+  if (reopen) {
+    catalog_->Load();
+  } else if (buffer_pool_manager_ != nullptr) {
+    // Save the empty catalog right away, which claims its header page record before the B+ tree indexes fill the page.
+    catalog_->Save();
+  }
 
   // Execution engine.
   execution_engine_ = new ExecutionEngine(buffer_pool_manager_, txn_manager_, catalog_);
@@ -91,6 +120,15 @@ BustubInstance::BustubInstance() {
     buffer_pool_manager_ = nullptr;
   }
 
+  // Reserve the header page, in which the B+ tree indexes record their root page ids. Otherwise the first table page
+  // would be allocated there and overwritten by the first index created.
+  if (buffer_pool_manager_ != nullptr) {
+    page_id_t header_page_id;
+    auto header_guard = buffer_pool_manager_->NewPageGuarded(&header_page_id);
+    BUSTUB_ASSERT(header_page_id == HEADER_PAGE_ID, "The header page must be the first page.");
+    header_guard.AsMut<HeaderPage>()->Init();
+  }
+
   // Transaction (txn) related.
   lock_manager_ = new LockManager();
   txn_manager_ = new TransactionManager(lock_manager_, log_manager_);
@@ -132,6 +170,7 @@ void BustubInstance::CmdDisplayIndices(ResultWriter &writer) {
   writer.WriteHeaderCell("index_oid");
   writer.WriteHeaderCell("index_name");
   writer.WriteHeaderCell("index_cols");
+  writer.WriteHeaderCell("index_type");
   writer.EndHeader();
   for (const auto &table_name : table_names) {
     for (const auto *index_info : catalog_->GetTableIndexes(table_name)) {
@@ -140,12 +179,231 @@ void BustubInstance::CmdDisplayIndices(ResultWriter &writer) {
       writer.WriteCell(fmt::format("{}", index_info->index_oid_));
       writer.WriteCell(index_info->name_);
       writer.WriteCell(index_info->key_schema_.ToString());
+      writer.WriteCell(index_info->index_type_ == IndexType::HashTableIndex ? "hash" : "btree");
+      writer.EndRow();
+    }
+  }
+  writer.EndTable();
+}
+
+void BustubInstance::CmdVacuum(const std::string &table_name, ResultWriter &writer, Transaction *txn) {
+  // Moving tuples changes their RIDs and frees pages, and executors do not take the catalog lock, so every other
+  // transaction has to be over first. They are waited for before the catalog lock is taken, since they may need it.
+  txn_manager_->BlockOtherTransactions(txn);
+  size_t moved_cnt;
+  size_t freed_pages;
+  try {
+    std::unique_lock<std::shared_mutex> l(catalog_lock_);
+    auto *table_info = catalog_->GetTable(table_name);
+    if (table_info == Catalog::NULL_TABLE_INFO) {
+      throw Exception(fmt::format("table not found: {}", table_name));
+    }
+
+    // The transaction vacuuming rolls back or commits its own writes by RID, so those tuples stay where they are.
+    std::unordered_set<page_id_t> written_pages;
+    for (const auto &record : *txn->GetWriteSet()) {
+      if (record.table_ == table_info->table_.get()) {
+        written_pages.insert(record.rid_.GetPageId());
+      }
+    }
+    std::vector<std::pair<RID, RID>> moved;
+    freed_pages = table_info->table_->Vacuum(txn, written_pages, &moved);
+    moved_cnt = moved.size();
+
+    // Point the indexes at the new locations.
+    auto indexes = catalog_->GetTableIndexes(table_name);
+    Tuple tuple;
+    for (const auto &[old_rid, new_rid] : moved) {
+      table_info->table_->GetTuple(new_rid, &tuple, txn);
+      for (auto *index_info : indexes) {
+        auto key =
+            tuple.KeyFromTuple(table_info->schema_, index_info->key_schema_, index_info->index_->GetKeyAttrs());
+        index_info->index_->DeleteEntry(key, old_rid, txn);
+        index_info->index_->InsertEntry(key, new_rid, txn);
+      }
+    }
+  } catch (...) {
+    txn_manager_->ResumeOtherTransactions();
+    throw;
+  }
+  txn_manager_->ResumeOtherTransactions();
+
+  WriteOneCell(fmt::format("Vacuumed {}: {} tuples moved, {} pages freed", table_name, moved_cnt, freed_pages),
+               writer);
+}
+
+void BustubInstance::ExecuteAnalyze(const AnalyzeStatement &stmt, ResultWriter &writer) {
+  // Analyzing only reads the tables, and the statistics have their own latch.
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  std::vector<TableInfo *> tables;
+  if (!stmt.table_.empty()) {
+    tables.push_back(catalog_->GetTable(stmt.table_));
+  } else {
+    for (const auto &name : catalog_->GetTableNames()) {
+      auto *table_info = catalog_->GetTable(name);
+      std::scoped_lock lock(table_info->stats_latch_);
+      if (table_info->table_ != nullptr && (table_info->stats_ == nullptr || table_info->stats_->IsStale())) {
+        tables.push_back(table_info);
+      }
+    }
+  }
+  for (auto *table_info : tables) {
+    catalog_->AnalyzeTable(table_info);
+  }
+
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  for (const auto *header : {"table", "column", "rows", "null_frac", "n_distinct", "buckets", "min", "max"}) {
+    writer.WriteHeaderCell(header);
+  }
+  writer.EndHeader();
+  for (auto *table_info : tables) {
+    std::scoped_lock lock(table_info->stats_latch_);
+    const auto &stats = *table_info->stats_;
+    for (uint32_t i = 0; i < table_info->schema_.GetColumnCount(); i++) {
+      const auto &column = stats.columns_[i];
+      writer.BeginRow();
+      writer.WriteCell(table_info->name_);
+      writer.WriteCell(table_info->schema_.GetColumn(i).GetName());
+      writer.WriteCell(fmt::format("{}", stats.row_count_));
+      writer.WriteCell(fmt::format("{:.2f}", stats.GetNullFraction(i)));
+      writer.WriteCell(fmt::format("{}", stats.GetDistinctCount(i)));
+      writer.WriteCell(fmt::format("{}", column.histogram_.GetBounds().size()));
+      writer.WriteCell(column.min_.IsNull() ? "NULL" : column.min_.ToString());
+      writer.WriteCell(column.max_.IsNull() ? "NULL" : column.max_.ToString());
       writer.EndRow();
     }
   }
   writer.EndTable();
 }
 
+auto BustubInstance::CollectStats() -> std::vector<std::tuple<std::string, std::string, std::string>> {
+  std::vector<std::tuple<std::string, std::string, std::string>> stats;
+  auto add = [&](const std::string &component, const std::string &name, auto value) {
+    stats.emplace_back(component, name, fmt::format("{}", value));
+  };
+  auto add_histogram = [&](const std::string &component, const std::string &name, const StatHistogram &histogram) {
+    auto count = histogram.GetCount();
+    add(component, name + "_count", count);
+    add(component, name + "_avg", count == 0 ? 0 : histogram.GetSum() / count);
+    add(component, name + "_p50", histogram.GetPercentile(0.5));
+    add(component, name + "_p99", histogram.GetPercentile(0.99));
+  };
+
+  auto *bpm = dynamic_cast<BufferPoolManagerInstance *>(buffer_pool_manager_);
+  if (bpm != nullptr) {
+    const auto &pool = bpm->GetStats();
+    auto hits = pool.fetch_hits_.Get();
+    auto misses = pool.fetch_misses_.Get();
+    add("buffer_pool", "pool_size", bpm->GetPoolSize());
+    add("buffer_pool", "fetch_hits", hits);
+    add("buffer_pool", "fetch_misses", misses);
+    auto fetches = hits + misses;
+    add("buffer_pool", "hit_ratio", fmt::format("{:.4f}", fetches == 0 ? 0.0 : static_cast<double>(hits) / fetches));
+    add("buffer_pool", "no_free_frame", pool.no_free_frame_.Get());
+    add("buffer_pool", "new_pages", pool.new_pages_.Get());
+    add("buffer_pool", "deleted_pages", pool.deleted_pages_.Get());
+    add("buffer_pool", "dirty_writebacks", pool.dirty_writebacks_.Get());
+    add("buffer_pool", "flushes", pool.flushes_.Get());
+    add("buffer_pool", "latch_contentions", pool.latch_contentions_.Get());
+    add_histogram("buffer_pool", "latch_wait_ns", pool.latch_wait_ns_);
+
+    const auto &replacer = bpm->GetReplacerStats();
+    add("replacer", "evictions", replacer.evictions_.Get());
+    add("replacer", "failed_evictions", replacer.failed_evictions_.Get());
+    add_histogram("replacer", "evict_scan_length", replacer.evict_scan_length_);
+
+    auto residency = bpm->GetResidency();
+    add("residency", "free", residency.free_);
+    add("residency", "header", residency.header_);
+    add("residency", "table", residency.table_);
+    add("residency", "index_internal", residency.index_internal_);
+    add("residency", "index_leaf", residency.index_leaf_);
+    add("residency", "other", residency.other_);
+    add("residency", "pinned", residency.pinned_);
+    add("residency", "dirty", residency.dirty_);
+  }
+
+  const auto &disk = disk_manager_->GetStats();
+  add("disk", "reads", disk.reads_.Get());
+  add("disk", "writes", disk.writes_.Get());
+  add_histogram("disk", "read_latency_ns", disk.read_latency_ns_);
+  add_histogram("disk", "write_latency_ns", disk.write_latency_ns_);
+
+  add("plan_cache", "entries", plan_cache_.Size());
+  add("plan_cache", "hits", plan_cache_.hits_.Get());
+  add("plan_cache", "misses", plan_cache_.misses_.Get());
+  add("plan_cache", "evictions", plan_cache_.evictions_.Get());
+  {
+    std::scoped_lock lock(prepared_latch_);
+    add("plan_cache", "prepared_statements", prepared_statements_.size());
+  }
+  return stats;
+}
+
+auto BustubInstance::DumpStats() -> std::string {
+  std::string json = "{";
+  std::string component;
+  for (const auto &[stat_component, name, value] : CollectStats()) {
+    if (stat_component != component) {
+      json += fmt::format("{}\"{}\": {{", component.empty() ? "" : "}, ", stat_component);
+      component = stat_component;
+    } else {
+      json += ", ";
+    }
+    json += fmt::format("\"{}\": {}", name, value);
+  }
+  json += component.empty() ? "}" : "}}";
+  return json;
+}
+
+void BustubInstance::CmdStats(const std::string &args, ResultWriter &writer) {
+  if (args == "json") {
+    WriteOneCell(DumpStats(), writer);
+    return;
+  }
+  if (args == "reset") {
+    auto *bpm = dynamic_cast<BufferPoolManagerInstance *>(buffer_pool_manager_);
+    if (bpm != nullptr) {
+      auto &pool = bpm->GetStats();
+      for (auto *counter : {&pool.fetch_hits_, &pool.fetch_misses_, &pool.no_free_frame_, &pool.new_pages_,
+                            &pool.deleted_pages_, &pool.dirty_writebacks_, &pool.flushes_, &pool.latch_contentions_}) {
+        counter->Reset();
+      }
+      pool.latch_wait_ns_.Reset();
+      auto &replacer = bpm->GetReplacerStats();
+      replacer.evictions_.Reset();
+      replacer.failed_evictions_.Reset();
+      replacer.evict_scan_length_.Reset();
+    }
+    auto &disk = disk_manager_->GetStats();
+    disk.reads_.Reset();
+    disk.writes_.Reset();
+    disk.read_latency_ns_.Reset();
+    disk.write_latency_ns_.Reset();
+    WriteOneCell("Statistics reset", writer);
+    return;
+  }
+  if (!args.empty()) {
+    throw Exception(fmt::format("unsupported \\stats option: {}", args));
+  }
+
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  writer.WriteHeaderCell("component");
+  writer.WriteHeaderCell("statistic");
+  writer.WriteHeaderCell("value");
+  writer.EndHeader();
+  for (const auto &[component, name, value] : CollectStats()) {
+    writer.BeginRow();
+    writer.WriteCell(component);
+    writer.WriteCell(name);
+    writer.WriteCell(value);
+    writer.EndRow();
+  }
+  writer.EndTable();
+}
+
 void BustubInstance::WriteOneCell(const std::string &cell, ResultWriter &writer) {
   writer.BeginTable(true);
   writer.BeginRow();
@@ -160,6 +418,8 @@ void BustubInstance::CmdDisplayHelp(ResultWriter &writer) {
 \dt: show all tables
 \di: show all indices
 \help: show this message again
+\vacuum <table>: compact the table and free its empty pages
+\stats [json|reset]: show buffer pool, replacer and disk statistics, dump them as JSON, or reset them
 
 BusTub shell currently only supports a small set of Postgres queries. We'll set
 up a doc describing the current status later. It will silently ignore some parts
@@ -175,12 +435,34 @@ see the execution plan of your query.
 auto BustubInstance::ExecuteSql(const std::string &sql, ResultWriter &writer) -> bool {
   auto txn = txn_manager_->Begin();
   auto result = ExecuteSqlTxn(sql, writer, txn);
-  txn_manager_->Commit(txn);
+  // A statement that failed halfway may have changed a table and only some of its indexes.
+  if (result) {
+    txn_manager_->Commit(txn);
+  } else {
+    txn_manager_->Abort(txn);
+  }
   delete txn;
   return result;
 }
 
-auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer, Transaction *txn) -> bool {
+auto BustubInstance::PlanCacheKey(const std::string &sql, const SessionVariables &variables)
+    -> std::optional<std::string> {
+  auto key = PlanCache::Normalize(sql);
+  if (!PlanCache::IsCacheable(key)) {
+    return std::nullopt;
+  }
+  // The plans of sessions that force the starter rule are kept apart from the others.
+  if (IsForceStarterRule(variables)) {
+    key.insert(0, "starter_rule:");
+  }
+  return key;
+}
+
+auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer, Transaction *txn,
+                                   SessionVariables *variables, PreparedStatements *prepared) -> bool {
+  auto &session_variables = variables != nullptr ? *variables : session_variables_;
+  auto &prepared_statements = prepared != nullptr ? *prepared : prepared_statements_;
+
   if (!sql.empty() && sql[0] == '\\') {
     // Internal meta-commands, like in `psql`.
     if (sql == "\\dt") {
@@ -195,9 +477,25 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
       CmdDisplayHelp(writer);
       return true;
     }
+    if (sql == "\\stats" || StringUtil::StartsWith(sql, "\\stats ")) {
+      CmdStats(StringUtil::Strip(sql.substr(std::string("\\stats").size()), ' '), writer);
+      return true;
+    }
+    if (StringUtil::StartsWith(sql, "\\vacuum ")) {
+      CmdVacuum(StringUtil::Strip(sql.substr(std::string("\\vacuum ").size()), ' '), writer, txn);
+      return true;
+    }
     throw Exception(fmt::format("unsupported internal command: {}", sql));
   }
 
+  // A statement executed before runs its cached plan, without being parsed again.
+  auto cache_key = PlanCacheKey(sql, session_variables);
+  if (cache_key.has_value()) {
+    if (auto cached_plan = plan_cache_.Get(*cache_key, catalog_->GetVersion()); cached_plan.has_value()) {
+      return ExecutePlan(*cached_plan, writer, txn);
+    }
+  }
+
   bool is_successful = true;
 
   std::shared_lock<std::shared_mutex> l(catalog_lock_);
@@ -240,7 +538,7 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         std::unique_lock<std::shared_mutex> l(catalog_lock_);
         auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
             txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
-            INTEGER_SIZE, IntegerHashFunctionType{});
+            INTEGER_SIZE, IntegerHashFunctionType{}, index_stmt.index_type_);
         l.unlock();
 
         if (info == nullptr) {
@@ -249,15 +547,49 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         WriteOneCell(fmt::format("Index created with id = {}", info->index_oid_), writer);
         continue;
       }
+      case StatementType::ANALYZE_STATEMENT: {
+        ExecuteAnalyze(dynamic_cast<const AnalyzeStatement &>(*statement), writer);
+        continue;
+      }
       case StatementType::VARIABLE_SHOW_STATEMENT: {
         const auto &show_stmt = dynamic_cast<const VariableShowStatement &>(*statement);
-        auto content = GetSessionVariable(show_stmt.variable_);
+        auto content = GetSessionVariable(session_variables, show_stmt.variable_);
         WriteOneCell(fmt::format("{}={}", show_stmt.variable_, content), writer);
         continue;
       }
       case StatementType::VARIABLE_SET_STATEMENT: {
         const auto &set_stmt = dynamic_cast<const VariableSetStatement &>(*statement);
-        session_variables_[set_stmt.variable_] = set_stmt.value_;
+        session_variables[set_stmt.variable_] = set_stmt.value_;
+        continue;
+      }
+      case StatementType::PREPARE_STATEMENT: {
+        auto &prepare_stmt = dynamic_cast<PrepareStatement &>(*statement);
+        auto prepared_stmt = std::make_shared<PreparedStatement>();
+        prepared_stmt->plan_ = PlanStatement(*prepare_stmt.statement_, session_variables);
+        prepared_stmt->statement_ = std::move(prepare_stmt.statement_);
+        prepared_stmt->param_types_ = prepare_stmt.param_types_;
+
+        std::scoped_lock lock(prepared_latch_);
+        if (prepared_statements.count(prepare_stmt.name_) != 0) {
+          throw Exception(fmt::format("prepared statement {} already exists", prepare_stmt.name_));
+        }
+        prepared_statements.emplace(prepare_stmt.name_, std::move(prepared_stmt));
+        continue;
+      }
+      case StatementType::EXECUTE_STATEMENT: {
+        const auto &execute_stmt = dynamic_cast<const ExecuteStatement &>(*statement);
+        is_successful &= ExecutePreparedTxn(execute_stmt.name_, execute_stmt.params_, writer, txn, &session_variables,
+                                            &prepared_statements);
+        continue;
+      }
+      case StatementType::DEALLOCATE_STATEMENT: {
+        const auto &deallocate_stmt = dynamic_cast<const DeallocateStatement &>(*statement);
+        std::scoped_lock lock(prepared_latch_);
+        if (deallocate_stmt.name_.empty()) {
+          prepared_statements.clear();
+        } else if (prepared_statements.erase(deallocate_stmt.name_) == 0) {
+          throw Exception(fmt::format("prepared statement {} does not exist", deallocate_stmt.name_));
+        }
         continue;
       }
       case StatementType::EXPLAIN_STATEMENT: {
@@ -288,15 +620,38 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         }
 
         // Print optimizer result.
-        bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
+        bustub::Optimizer optimizer(*catalog_, IsForceStarterRule(session_variables));
         auto optimized_plan = optimizer.Optimize(planner.plan_);
 
-        l.unlock();
-
+        // Every node of the optimized plan is shown with its estimated rows and cost.
         if ((explain_stmt.options_ & ExplainOptions::OPTIMIZER) != 0) {
+          CostModel cost_model(*catalog_);
           output += "=== OPTIMIZER ===";
           output += "\n";
-          output += optimized_plan->ToString(show_schema);
+          output += optimized_plan->ToString(
+              show_schema, [&cost_model](const AbstractPlanNode &plan) { return cost_model.Annotate(plan); });
+          output += "\n";
+        }
+
+        l.unlock();
+
+        // Run the query, and show next to the estimates what each executor actually did. Like any other query it takes
+        // effect, e.g. an analyzed INSERT inserts; only its result is thrown away.
+        if ((explain_stmt.options_ & ExplainOptions::ANALYZE) != 0) {
+          ExecutionProfile profile;
+          auto exec_ctx = MakeExecutorContext(txn);
+          exec_ctx->SetProfile(&profile);
+          auto executed = execution_engine_->Execute(
+              optimized_plan, [](const std::vector<Tuple> &batch) {}, txn, exec_ctx.get());
+          is_successful &= executed;
+
+          std::shared_lock<std::shared_mutex> annotate_lock(catalog_lock_);
+          CostModel cost_model(*catalog_);
+          output += executed ? "=== ANALYZE ===" : "=== ANALYZE (failed) ===";
+          output += "\n";
+          output += optimized_plan->ToString(show_schema, [&cost_model, &profile](const AbstractPlanNode &plan) {
+            return fmt::format("{} {}", cost_model.Annotate(plan), profile.Annotate(plan));
+          });
           output += "\n";
         }
 
@@ -308,48 +663,133 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         break;
     }
 
-    std::shared_lock<std::shared_mutex> l(catalog_lock_);
+    auto plan = PlanStatement(*statement, session_variables);
+    if (cache_key.has_value() && binder.statement_nodes_.size() == 1) {
+      plan_cache_.Put(*cache_key, plan);
+    }
+    is_successful &= ExecutePlan(plan, writer, txn);
+  }
 
-    // Plan the query.
-    bustub::Planner planner(*catalog_);
-    planner.PlanQuery(*statement);
+  return is_successful;
+}
 
-    // Optimize the query.
-    bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
-    auto optimized_plan = optimizer.Optimize(planner.plan_);
+auto BustubInstance::ExecutePreparedTxn(const std::string &name, const std::vector<Value> &params,
+                                        ResultWriter &writer, Transaction *txn, SessionVariables *variables,
+                                        PreparedStatements *prepared) -> bool {
+  auto &prepared_statements = prepared != nullptr ? *prepared : prepared_statements_;
+  std::shared_ptr<PreparedStatement> prepared_stmt;
+  CachedPlan plan;
+  {
+    std::scoped_lock lock(prepared_latch_);
+    auto it = prepared_statements.find(name);
+    if (it == prepared_statements.end()) {
+      throw Exception(fmt::format("prepared statement {} does not exist", name));
+    }
+    prepared_stmt = it->second;
+    plan = prepared_stmt->plan_;
+  }
 
-    l.unlock();
+  const auto &param_types = prepared_stmt->param_types_;
+  if (params.size() != param_types.size()) {
+    throw Exception(
+        fmt::format("prepared statement {} takes {} parameters, got {}", name, param_types.size(), params.size()));
+  }
+  std::vector<Value> bound_params;
+  bound_params.reserve(params.size());
+  for (size_t i = 0; i < params.size(); i++) {
+    if (params[i].GetTypeId() == param_types[i]) {
+      bound_params.push_back(params[i]);
+    } else if (params[i].IsNull()) {
+      bound_params.push_back(ValueFactory::GetNullValueByType(param_types[i]));
+    } else {
+      bound_params.push_back(params[i].CastAs(param_types[i]));
+    }
+  }
 
-    // Execute the query.
-    auto exec_ctx = MakeExecutorContext(txn);
-    std::vector<Tuple> result_set{};
-    is_successful &= execution_engine_->Execute(optimized_plan, &result_set, txn, exec_ctx.get());
+  // A new index or new statistics may call for another plan. Planning takes the catalog lock, so it is done without
+  // the latch, and the plan is kept unless another EXECUTE kept one made at a later version meanwhile.
+  if (plan.catalog_version_ != catalog_->GetVersion()) {
+    plan = PlanStatement(*prepared_stmt->statement_, variables != nullptr ? *variables : session_variables_);
+    std::scoped_lock lock(prepared_latch_);
+    if (prepared_stmt->plan_.catalog_version_ < plan.catalog_version_) {
+      prepared_stmt->plan_ = plan;
+    }
+  }
 
-    // Return the result set as a vector of string.
-    auto schema = planner.plan_->OutputSchema();
+  ParameterBinding binding(&bound_params);
+  return ExecutePlan(plan, writer, txn);
+}
 
-    // Generate header for the result set.
-    writer.BeginTable(false);
-    writer.BeginHeader();
-    for (const auto &column : schema.GetColumns()) {
-      writer.WriteHeaderCell(column.GetName());
-    }
-    writer.EndHeader();
+auto BustubInstance::PlanStatement(const BoundStatement &statement, const SessionVariables &variables) -> CachedPlan {
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  auto catalog_version = catalog_->GetVersion();
 
-    // Transforming result set into strings.
-    for (const auto &tuple : result_set) {
-      writer.BeginRow();
-      for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
-        writer.WriteCell(tuple.GetValue(&schema, i).ToString());
-      }
-      writer.EndRow();
-    }
-    writer.EndTable();
+  // Plan the query.
+  bustub::Planner planner(*catalog_);
+  planner.PlanQuery(statement);
+
+  // Optimize the query.
+  bustub::Optimizer optimizer(*catalog_, IsForceStarterRule(variables));
+  auto optimized_plan = optimizer.Optimize(planner.plan_);
+
+  // The result set is shown with the column names of the planner, which the optimizer may not keep.
+  return {std::move(optimized_plan), planner.plan_->output_schema_, catalog_version};
+}
+
+auto BustubInstance::ExecutePlan(const CachedPlan &plan, ResultWriter &writer, Transaction *txn) -> bool {
+  const auto &schema = *plan.schema_;
+
+  // Generate header for the result set.
+  writer.BeginTable(false);
+  writer.BeginHeader();
+  for (const auto &column : schema.GetColumns()) {
+    writer.WriteHeaderCell(column.GetName());
   }
+  writer.EndHeader();
 
+  // Execute the query, writing the rows as strings as soon as they are produced.
+  auto exec_ctx = MakeExecutorContext(txn);
+  auto is_successful = execution_engine_->Execute(
+      plan.plan_,
+      [&writer, &schema](const std::vector<Tuple> &batch) {
+        for (const auto &tuple : batch) {
+          writer.BeginRow();
+          for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+            writer.WriteCell(tuple.GetValue(&schema, i).ToString());
+          }
+          writer.EndRow();
+        }
+      },
+      txn, exec_ctx.get());
+  writer.EndTable();
   return is_successful;
 }
 
+auto BustubInstance::OpenCursor(const std::string &sql, Transaction *txn) -> std::unique_ptr<ResultCursor> {
+  if (!StringUtil::StartsWith(PlanCache::Normalize(sql), "select ")) {
+    throw Exception("a cursor can only be opened on a SELECT statement");
+  }
+  auto cache_key = PlanCacheKey(sql, session_variables_);
+  auto plan = plan_cache_.Get(*cache_key, catalog_->GetVersion());
+  if (!plan.has_value()) {
+    std::shared_lock<std::shared_mutex> l(catalog_lock_);
+    bustub::Binder binder(*catalog_);
+    binder.ParseAndSave(sql);
+    if (binder.statement_nodes_.size() != 1) {
+      throw Exception("a cursor can only be opened on a single statement");
+    }
+    auto statement = binder.BindStatement(binder.statement_nodes_.front());
+    if (statement->type_ != StatementType::SELECT_STATEMENT) {
+      throw Exception("a cursor can only be opened on a SELECT statement");
+    }
+    l.unlock();
+
+    plan = PlanStatement(*statement, session_variables_);
+    plan_cache_.Put(*cache_key, *plan);
+  }
+  return std::make_unique<ResultCursor>(MakeExecutorContext(txn), plan->plan_, plan->schema_);
+}
+
 /**
  * FOR TEST ONLY. Generate test tables in this BusTub instance.
  * It's used in the shell to predefine some tables, as we don't support
@@ -391,6 +831,15 @@ BustubInstance::~BustubInstance() {
   if (enable_logging) {
     log_manager_->StopFlushThread();
   }
+  // Without a log to replay, a database file is only consistent after a clean shutdown like this one.
+  if (is_file_backed_ && buffer_pool_manager_ != nullptr) {
+    try {
+      catalog_->Save();
+    } catch (Exception &e) {
+      LOG_ERROR("Failed to save the catalog: %s", e.what());
+    }
+    buffer_pool_manager_->FlushAllPages();
+  }
   delete execution_engine_;
   delete catalog_;
   delete checkpoint_manager_;
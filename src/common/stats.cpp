@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// stats.cpp
+//
+// Identification: src/common/stats.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bustub {
+
+auto StatsShard() -> size_t {
+  static std::atomic<size_t> next_shard{0};
+  thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % STATS_SHARD_CNT;
+  return shard;
+}
+
+auto StatCounter::Get() const -> uint64_t {
+  uint64_t value = 0;
+  for (const auto &shard : shards_) {
+    value += shard.value_.load(std::memory_order_relaxed);
+  }
+  return value;
+}
+
+void StatCounter::Reset() {
+  for (auto &shard : shards_) {
+    shard.value_.store(0, std::memory_order_relaxed);
+  }
+}
+
+void StatHistogram::Record(uint64_t value) {
+  // The bucket is the number of significant bits, so 0 -> 0, 1 -> 1, 2..3 -> 2, 4..7 -> 3 and so on.
+  size_t bucket = 0;
+  for (auto v = value; v != 0 && bucket < BUCKET_CNT - 1; v >>= 1) {
+    bucket++;
+  }
+  auto &shard = shards_[StatsShard()];
+  shard.buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  shard.sum_.fetch_add(value, std::memory_order_relaxed);
+}
+
+auto StatHistogram::GetCount() const -> uint64_t {
+  uint64_t count = 0;
+  for (const auto &shard : shards_) {
+    for (const auto &bucket : shard.buckets_) {
+      count += bucket.load(std::memory_order_relaxed);
+    }
+  }
+  return count;
+}
+
+auto StatHistogram::GetSum() const -> uint64_t {
+  uint64_t sum = 0;
+  for (const auto &shard : shards_) {
+    sum += shard.sum_.load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+auto StatHistogram::GetPercentile(double percentile) const -> uint64_t {
+  std::array<uint64_t, BUCKET_CNT> buckets{};
+  uint64_t count = 0;
+  for (const auto &shard : shards_) {
+    for (size_t i = 0; i < BUCKET_CNT; i++) {
+      auto n = shard.buckets_[i].load(std::memory_order_relaxed);
+      buckets[i] += n;
+      count += n;
+    }
+  }
+  if (count == 0) {
+    return 0;
+  }
+  auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 1.0) * count)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_CNT; i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return i == 0 ? 0 : (uint64_t{1} << i) - 1;
+    }
+  }
+  return (uint64_t{1} << (BUCKET_CNT - 1)) - 1;
+}
+
+void StatHistogram::Reset() {
+  for (auto &shard : shards_) {
+    for (auto &bucket : shard.buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    shard.sum_.store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace bustub
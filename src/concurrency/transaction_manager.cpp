@@ -18,6 +18,7 @@
 #include <unordered_set>
 
 #include "catalog/catalog.h"
+#include "common/exception.h"
 #include "storage/table/table_heap.h"
 namespace bustub {
 
@@ -38,6 +39,11 @@ auto TransactionManager::Begin(Transaction *txn, IsolationLevel isolation_level)
     txn->SetPrevLSN(lsn);
   }
 
+  {
+    std::unique_lock lock(running_txns_latch_);
+    running_txns_cv_.wait(lock, [this] { return !others_blocked_; });
+    running_txns_.insert(txn);
+  }
   std::unique_lock<std::shared_mutex> l(txn_map_mutex);
   txn_map[txn->GetTransactionId()] = txn;
   return txn;
@@ -58,6 +64,11 @@ void TransactionManager::Commit(Transaction *txn) {
     write_set->pop_back();
   }
   write_set->clear();
+  {
+    std::scoped_lock lock(running_txns_latch_);
+    running_txns_.erase(txn);
+  }
+  running_txns_cv_.notify_all();
 
   // Release all the locks.
   ReleaseLocks(txn);
@@ -78,7 +89,9 @@ void TransactionManager::Abort(Transaction *txn) {
       // Note that this also releases the lock when holding the page latch.
       table->ApplyDelete(item.rid_, txn);
     } else if (item.wtype_ == WType::UPDATE) {
-      table->UpdateTuple(item.tuple_, item.rid_, txn);
+      // Updates in place never shrink a tuple, so the space the old tuple needs is still there.
+      [[maybe_unused]] bool is_restored = table->UpdateTuple(item.tuple_, item.rid_, txn);
+      BUSTUB_ASSERT(is_restored, "Couldn't put the old tuple back in its page.");
     }
     table_write_set->pop_back();
   }
@@ -108,6 +121,11 @@ void TransactionManager::Abort(Transaction *txn) {
   }
   table_write_set->clear();
   index_write_set->clear();
+  {
+    std::scoped_lock lock(running_txns_latch_);
+    running_txns_.erase(txn);
+  }
+  running_txns_cv_.notify_all();
 
   // Release all the locks.
   ReleaseLocks(txn);
@@ -115,6 +133,26 @@ void TransactionManager::Abort(Transaction *txn) {
   global_txn_latch_.RUnlock();
 }
 
+void TransactionManager::BlockOtherTransactions(Transaction *txn) {
+  std::unique_lock lock(running_txns_latch_);
+  // Waiting for the other blocker would never end, since it waits for txn as well.
+  if (others_blocked_) {
+    throw Exception("another transaction already blocks the others");
+  }
+  others_blocked_ = true;
+  running_txns_cv_.wait(lock, [this, txn] {
+    return running_txns_.empty() || (running_txns_.size() == 1 && running_txns_.count(txn) == 1);
+  });
+}
+
+void TransactionManager::ResumeOtherTransactions() {
+  {
+    std::scoped_lock lock(running_txns_latch_);
+    others_blocked_ = false;
+  }
+  running_txns_cv_.notify_all();
+}
+
 void TransactionManager::BlockAllTransactions() { global_txn_latch_.WLock(); }
 
 void TransactionManager::ResumeTransactions() { global_txn_latch_.WUnlock(); }
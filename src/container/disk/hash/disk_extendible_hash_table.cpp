@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -17,6 +18,7 @@
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/macros.h"
 #include "common/rid.h"
 #include "container/disk/hash/disk_extendible_hash_table.h"
 
@@ -24,9 +26,28 @@ namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::DiskExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
-                                         const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
-  //  implement me!
+                                         const KeyComparator &comparator, HashFunction<KeyType> hash_fn,
+                                         page_id_t directory_page_id)
+    : directory_page_id_(directory_page_id),
+      buffer_pool_manager_(buffer_pool_manager),
+      comparator_(comparator),
+      hash_fn_(std::move(hash_fn)) {
+  if (directory_page_id_ != INVALID_PAGE_ID) {
+    // The pages of a reopened table are read on first use.
+    return;
+  }
+  // Start with a directory of global depth 0 and a single, empty bucket.
+  BasicPageGuard dir_guard = buffer_pool_manager_->NewPageGuarded(&directory_page_id_);
+  page_id_t bucket_page_id;
+  BasicPageGuard bucket_guard = buffer_pool_manager_->NewPageGuarded(&bucket_page_id);
+  if (!dir_guard.IsValid() || !bucket_guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate pages for hash table " + name);
+  }
+  auto *dir_page = dir_guard.AsMut<HashTableDirectoryPage>();
+  dir_page->SetPageId(directory_page_id_);
+  dir_page->SetBucketPageId(0, bucket_page_id);
+  dir_page->SetLocalDepth(0, 0);
+  bucket_guard.AsMut<HASH_TABLE_BUCKET_TYPE>()->SetOverflowPageId(INVALID_PAGE_ID);
 }
 
 /*****************************************************************************
@@ -45,23 +66,23 @@ auto HASH_TABLE_TYPE::Hash(KeyType key) -> uint32_t {
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-inline auto HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, HashTableDirectoryPage *dir_page) -> uint32_t {
-  return 0;
+inline auto HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, const HashTableDirectoryPage *dir_page) -> uint32_t {
+  return Hash(key) & dir_page->GetGlobalDepthMask();
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-inline auto HASH_TABLE_TYPE::KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t {
-  return 0;
+inline auto HASH_TABLE_TYPE::KeyToPageId(KeyType key, const HashTableDirectoryPage *dir_page) -> page_id_t {
+  return dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page));
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchDirectoryPage() -> HashTableDirectoryPage * {
-  return nullptr;
+  return reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE * {
-  return nullptr;
+  return reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(buffer_pool_manager_->FetchPage(bucket_page_id)->GetData());
 }
 
 /*****************************************************************************
@@ -69,7 +90,27 @@ auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BU
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  table_latch_.RLock();
+  ReadPageGuard dir_guard = buffer_pool_manager_->FetchPageRead(directory_page_id_);
+  BUSTUB_ENSURE(dir_guard.IsValid(), "BPM full");
+  auto bucket_page_id = KeyToPageId(key, dir_guard.As<HashTableDirectoryPage>());
+  dir_guard.Drop();
+
+  ReadPageGuard bucket_guard = buffer_pool_manager_->FetchPageRead(bucket_page_id);
+  BUSTUB_ENSURE(bucket_guard.IsValid(), "BPM full");
+  const auto *bucket_page = bucket_guard.As<HASH_TABLE_BUCKET_TYPE>();
+  auto found = bucket_page->GetValue(key, comparator_, result);
+  // The latch on the first page of the bucket covers its overflow pages as well.
+  for (auto page_id = bucket_page->GetOverflowPageId(); page_id != INVALID_PAGE_ID;) {
+    ReadPageGuard overflow_guard = buffer_pool_manager_->FetchPageRead(page_id);
+    BUSTUB_ENSURE(overflow_guard.IsValid(), "BPM full");
+    const auto *overflow_page = overflow_guard.As<HASH_TABLE_BUCKET_TYPE>();
+    found = overflow_page->GetValue(key, comparator_, result) || found;
+    page_id = overflow_page->GetOverflowPageId();
+  }
+  bucket_guard.Drop();
+  table_latch_.RUnlock();
+  return found;
 }
 
 /*****************************************************************************
@@ -77,12 +118,180 @@ auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  // Inserts only latch their bucket, so that they run in parallel unless the bucket has to split.
+  table_latch_.RLock();
+  ReadPageGuard dir_guard = buffer_pool_manager_->FetchPageRead(directory_page_id_);
+  BUSTUB_ENSURE(dir_guard.IsValid(), "BPM full");
+  auto bucket_page_id = KeyToPageId(key, dir_guard.As<HashTableDirectoryPage>());
+  dir_guard.Drop();
+
+  WritePageGuard bucket_guard = buffer_pool_manager_->FetchPageWrite(bucket_page_id);
+  BUSTUB_ENSURE(bucket_guard.IsValid(), "BPM full");
+  auto *bucket_page = bucket_guard.AsMut<HASH_TABLE_BUCKET_TYPE>();
+  bool full;
+  auto inserted = InsertIntoBucket(bucket_page, key, value, false, &full);
+  bucket_guard.Drop();
+  table_latch_.RUnlock();
+  if (!full) {
+    return inserted;
+  }
+  return SplitInsert(transaction, key, value);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.WLock();
+  WritePageGuard dir_guard = buffer_pool_manager_->FetchPageWrite(directory_page_id_);
+  BUSTUB_ENSURE(dir_guard.IsValid(), "BPM full");
+  auto *dir_page = dir_guard.AsMut<HashTableDirectoryPage>();
+
+  // Somebody else may have split the bucket in the meantime, and a split may leave every pair on one side, so keep
+  // splitting until the key's bucket has room. A bucket that no split can separate, or that would need a bigger
+  // directory than fits in a page, gets an overflow page instead.
+  while (true) {
+    auto bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    auto bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    WritePageGuard bucket_guard = buffer_pool_manager_->FetchPageWrite(bucket_page_id);
+    BUSTUB_ENSURE(bucket_guard.IsValid(), "BPM full");
+    auto *bucket_page = bucket_guard.AsMut<HASH_TABLE_BUCKET_TYPE>();
+    auto local_depth = dir_page->GetLocalDepth(bucket_idx);
+    auto can_split = (local_depth < dir_page->GetGlobalDepth() || dir_page->Size() * 2 <= DIRECTORY_ARRAY_SIZE) &&
+                     !BucketHasOneHash(bucket_page, Hash(key));
+    bool full;
+    auto inserted = InsertIntoBucket(bucket_page, key, value, !can_split, &full);
+    if (!full) {
+      bucket_guard.Drop();
+      dir_guard.Drop();
+      table_latch_.WUnlock();
+      return inserted;
+    }
+
+    if (local_depth == dir_page->GetGlobalDepth()) {
+      dir_page->IncrGlobalDepth();
+    }
+
+    page_id_t image_page_id;
+    BasicPageGuard image_guard = buffer_pool_manager_->NewPageGuarded(&image_page_id);
+    BUSTUB_ENSURE(image_guard.IsValid(), "BPM full");
+    image_guard.AsMut<HASH_TABLE_BUCKET_TYPE>()->SetOverflowPageId(INVALID_PAGE_ID);
+
+    // Every directory entry of the bucket gets one more bit of local depth; those with that bit set move to the image.
+    auto high_bit = 1U << local_depth;
+    for (uint32_t idx = 0; idx < dir_page->Size(); idx++) {
+      if (dir_page->GetBucketPageId(idx) == bucket_page_id) {
+        dir_page->IncrLocalDepth(idx);
+        if ((idx & high_bit) != 0) {
+          dir_page->SetBucketPageId(idx, image_page_id);
+        }
+      }
+    }
+    // The pairs that move are all different, so they are appended to the image without looking for them there.
+    auto move_pairs = [&](HASH_TABLE_BUCKET_TYPE *page) {
+      for (uint32_t slot = 0; slot < BUCKET_ARRAY_SIZE && page->IsOccupied(slot); slot++) {
+        if (!page->IsReadable(slot) || (Hash(page->KeyAt(slot)) & high_bit) == 0) {
+          continue;
+        }
+        auto *image_page = image_guard.AsMut<HASH_TABLE_BUCKET_TYPE>();
+        if (image_page->IsFull()) {
+          page_id_t overflow_page_id;
+          BasicPageGuard overflow_guard = buffer_pool_manager_->NewPageGuarded(&overflow_page_id);
+          BUSTUB_ENSURE(overflow_guard.IsValid(), "BPM full");
+          overflow_guard.AsMut<HASH_TABLE_BUCKET_TYPE>()->SetOverflowPageId(INVALID_PAGE_ID);
+          image_page->SetOverflowPageId(overflow_page_id);
+          image_guard = std::move(overflow_guard);
+          image_page = image_guard.AsMut<HASH_TABLE_BUCKET_TYPE>();
+        }
+        image_page->Insert(page->KeyAt(slot), page->ValueAt(slot), comparator_);
+        page->RemoveAt(slot);
+      }
+    };
+    move_pairs(bucket_page);
+    for (auto page_id = bucket_page->GetOverflowPageId(); page_id != INVALID_PAGE_ID;) {
+      WritePageGuard overflow_guard = buffer_pool_manager_->FetchPageWrite(page_id);
+      BUSTUB_ENSURE(overflow_guard.IsValid(), "BPM full");
+      auto *overflow_page = overflow_guard.AsMut<HASH_TABLE_BUCKET_TYPE>();
+      move_pairs(overflow_page);
+      page_id = overflow_page->GetOverflowPageId();
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::InsertIntoBucket(HASH_TABLE_BUCKET_TYPE *bucket_page, const KeyType &key, const ValueType &value,
+                                       bool grow, bool *full) -> bool {
+  *full = false;
+  // The pair may be on any page of the bucket, so all of them are searched before a free slot is taken.
+  std::vector<ValueType> values;
+  bucket_page->GetValue(key, comparator_, &values);
+  auto free_page_id = INVALID_PAGE_ID;
+  auto last_page_id = INVALID_PAGE_ID;
+  for (auto page_id = bucket_page->GetOverflowPageId(); page_id != INVALID_PAGE_ID;) {
+    ReadPageGuard overflow_guard = buffer_pool_manager_->FetchPageRead(page_id);
+    BUSTUB_ENSURE(overflow_guard.IsValid(), "BPM full");
+    const auto *overflow_page = overflow_guard.As<HASH_TABLE_BUCKET_TYPE>();
+    overflow_page->GetValue(key, comparator_, &values);
+    if (free_page_id == INVALID_PAGE_ID && !overflow_page->IsFull()) {
+      free_page_id = page_id;
+    }
+    last_page_id = page_id;
+    page_id = overflow_page->GetOverflowPageId();
+  }
+  if (std::find(values.begin(), values.end(), value) != values.end()) {
+    return false;
+  }
+
+  if (!bucket_page->IsFull()) {
+    return bucket_page->Insert(key, value, comparator_);
+  }
+  if (free_page_id != INVALID_PAGE_ID) {
+    WritePageGuard free_guard = buffer_pool_manager_->FetchPageWrite(free_page_id);
+    BUSTUB_ENSURE(free_guard.IsValid(), "BPM full");
+    return free_guard.AsMut<HASH_TABLE_BUCKET_TYPE>()->Insert(key, value, comparator_);
+  }
+  if (!grow) {
+    *full = true;
+    return false;
+  }
+
+  page_id_t overflow_page_id;
+  BasicPageGuard overflow_guard = buffer_pool_manager_->NewPageGuarded(&overflow_page_id);
+  BUSTUB_ENSURE(overflow_guard.IsValid(), "BPM full");
+  auto *overflow_page = overflow_guard.AsMut<HASH_TABLE_BUCKET_TYPE>();
+  overflow_page->SetOverflowPageId(INVALID_PAGE_ID);
+  overflow_page->Insert(key, value, comparator_);
+  if (last_page_id == INVALID_PAGE_ID) {
+    bucket_page->SetOverflowPageId(overflow_page_id);
+  } else {
+    WritePageGuard last_guard = buffer_pool_manager_->FetchPageWrite(last_page_id);
+    BUSTUB_ENSURE(last_guard.IsValid(), "BPM full");
+    last_guard.AsMut<HASH_TABLE_BUCKET_TYPE>()->SetOverflowPageId(overflow_page_id);
+  }
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::BucketHasOneHash(const HASH_TABLE_BUCKET_TYPE *bucket_page, uint32_t hash) -> bool {
+  auto has_one_hash = [&](const HASH_TABLE_BUCKET_TYPE *page) {
+    for (uint32_t slot = 0; slot < BUCKET_ARRAY_SIZE && page->IsOccupied(slot); slot++) {
+      if (page->IsReadable(slot) && Hash(page->KeyAt(slot)) != hash) {
+        return false;
+      }
+    }
+    return true;
+  };
+  if (!has_one_hash(bucket_page)) {
+    return false;
+  }
+  for (auto page_id = bucket_page->GetOverflowPageId(); page_id != INVALID_PAGE_ID;) {
+    ReadPageGuard overflow_guard = buffer_pool_manager_->FetchPageRead(page_id);
+    BUSTUB_ENSURE(overflow_guard.IsValid(), "BPM full");
+    const auto *overflow_page = overflow_guard.As<HASH_TABLE_BUCKET_TYPE>();
+    if (!has_one_hash(overflow_page)) {
+      return false;
+    }
+    page_id = overflow_page->GetOverflowPageId();
+  }
+  return true;
 }
 
 /*****************************************************************************
@@ -90,14 +299,103 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  ReadPageGuard dir_guard = buffer_pool_manager_->FetchPageRead(directory_page_id_);
+  BUSTUB_ENSURE(dir_guard.IsValid(), "BPM full");
+  auto bucket_page_id = KeyToPageId(key, dir_guard.As<HashTableDirectoryPage>());
+  dir_guard.Drop();
+
+  WritePageGuard bucket_guard = buffer_pool_manager_->FetchPageWrite(bucket_page_id);
+  BUSTUB_ENSURE(bucket_guard.IsValid(), "BPM full");
+  auto *bucket_page = bucket_guard.AsMut<HASH_TABLE_BUCKET_TYPE>();
+  auto removed = bucket_page->Remove(key, value, comparator_);
+  // An overflow page that becomes empty is unlinked from the bucket and freed right away.
+  WritePageGuard prev_guard;
+  auto *prev_page = bucket_page;
+  for (auto page_id = bucket_page->GetOverflowPageId(); !removed && page_id != INVALID_PAGE_ID;) {
+    WritePageGuard overflow_guard = buffer_pool_manager_->FetchPageWrite(page_id);
+    BUSTUB_ENSURE(overflow_guard.IsValid(), "BPM full");
+    auto *overflow_page = overflow_guard.AsMut<HASH_TABLE_BUCKET_TYPE>();
+    removed = overflow_page->Remove(key, value, comparator_);
+    if (removed && overflow_page->IsEmpty()) {
+      prev_page->SetOverflowPageId(overflow_page->GetOverflowPageId());
+      overflow_guard.Drop();
+      buffer_pool_manager_->DeletePage(page_id);
+      break;
+    }
+    page_id = overflow_page->GetOverflowPageId();
+    prev_guard = std::move(overflow_guard);
+    prev_page = overflow_page;
+  }
+  prev_guard.Drop();
+  auto empty = bucket_page->IsEmpty() && bucket_page->GetOverflowPageId() == INVALID_PAGE_ID;
+  bucket_guard.Drop();
+  table_latch_.RUnlock();
+
+  if (removed && empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
 }
 
 /*****************************************************************************
  * MERGE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {}
+void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  WritePageGuard dir_guard = buffer_pool_manager_->FetchPageWrite(directory_page_id_);
+  BUSTUB_ENSURE(dir_guard.IsValid(), "BPM full");
+  auto *dir_page = dir_guard.AsMut<HashTableDirectoryPage>();
+
+  // Folding a bucket into its image may leave the merged bucket empty with an empty image of its own, so go on until
+  // the key's bucket can't be merged anymore.
+  while (true) {
+    auto bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    auto bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    auto local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (local_depth == 0) {
+      break;
+    }
+    auto image_idx = dir_page->GetSplitImageIndex(bucket_idx);
+    auto image_page_id = dir_page->GetBucketPageId(image_idx);
+    if (dir_page->GetLocalDepth(image_idx) != local_depth) {
+      break;
+    }
+
+    // Of the pair, an empty bucket goes away and the other one takes over all of its directory entries.
+    ReadPageGuard bucket_guard = buffer_pool_manager_->FetchPageRead(bucket_page_id);
+    ReadPageGuard image_guard = buffer_pool_manager_->FetchPageRead(image_page_id);
+    BUSTUB_ENSURE(bucket_guard.IsValid() && image_guard.IsValid(), "BPM full");
+    auto is_empty = [](const HASH_TABLE_BUCKET_TYPE *page) {
+      return page->IsEmpty() && page->GetOverflowPageId() == INVALID_PAGE_ID;
+    };
+    auto bucket_empty = is_empty(bucket_guard.As<HASH_TABLE_BUCKET_TYPE>());
+    auto image_empty = is_empty(image_guard.As<HASH_TABLE_BUCKET_TYPE>());
+    bucket_guard.Drop();
+    image_guard.Drop();
+    if (!bucket_empty && !image_empty) {
+      break;
+    }
+    auto [kept_page_id, dropped_page_id] =
+        bucket_empty ? std::make_pair(image_page_id, bucket_page_id) : std::make_pair(bucket_page_id, image_page_id);
+
+    for (uint32_t idx = 0; idx < dir_page->Size(); idx++) {
+      auto page_id = dir_page->GetBucketPageId(idx);
+      if (page_id == bucket_page_id || page_id == image_page_id) {
+        dir_page->SetBucketPageId(idx, kept_page_id);
+        dir_page->DecrLocalDepth(idx);
+      }
+    }
+    buffer_pool_manager_->DeletePage(dropped_page_id);
+  }
+
+  while (dir_page->CanShrink()) {
+    dir_page->DecrGlobalDepth();
+  }
+  dir_guard.Drop();
+  table_latch_.WUnlock();
+}
 
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -17,6 +18,7 @@
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/macros.h"
 #include "common/rid.h"
 #include "container/disk/hash/linear_probe_hash_table.h"
 
@@ -26,21 +28,186 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                       const KeyComparator &comparator, size_t num_buckets,
                                       HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {}
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  auto num_blocks = std::max<size_t>(1, (num_buckets + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE);
+  if (num_blocks > HashTableHeaderPage::MaxBlocks() * HashTableHeaderPage::MaxBlocks()) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "too many buckets for hash table " + name);
+  }
+  BasicPageGuard header_guard = buffer_pool_manager_->NewPageGuarded(&header_page_id_);
+  if (!header_guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate pages for hash table " + name);
+  }
+  auto *header_page = header_guard.AsMut<HashTableHeaderPage>();
+  header_page->SetPageId(header_page_id_);
+  header_page->SetSize(num_blocks * BLOCK_ARRAY_SIZE);
+  CreateNewBlockPages(header_page, num_blocks);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+HASH_TABLE_TYPE::~LinearProbeHashTable() {
+  {
+    BasicPageGuard header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+    BUSTUB_ASSERT(header_guard.IsValid(), "BPM full");
+    DeleteBlockPages(header_guard.As<HashTableHeaderPage>());
+  }
+  buffer_pool_manager_->DeletePage(header_page_id_);
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+template <typename Visitor>
+auto HASH_TABLE_TYPE::Probe(const HashTableHeaderPage *header_page, const KeyType &key, Visitor &&visit) -> size_t {
+  auto size = header_page->GetSize();
+  auto slot = static_cast<size_t>(hash_fn_.GetHash(key) % size);
+  // Consecutive slots mostly share a block, so keep the block pinned until the probe moves on to the next one.
+  BasicPageGuard block_guard;
+  auto block_idx = size / BLOCK_ARRAY_SIZE;
+  for (size_t probed = 0; probed < size; probed++, slot = (slot + 1) % size) {
+    if (slot / BLOCK_ARRAY_SIZE != block_idx) {
+      block_idx = slot / BLOCK_ARRAY_SIZE;
+      block_guard = FetchBlockPage(header_page, block_idx);
+    }
+    if (!block_guard.As<HASH_TABLE_BLOCK_TYPE>()->IsOccupied(slot % BLOCK_ARRAY_SIZE) || !visit(&block_guard, slot)) {
+      return slot;
+    }
+  }
+  return size;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::FetchBlockPage(const HashTableHeaderPage *header_page, size_t block_idx) -> BasicPageGuard {
+  BasicPageGuard list_guard =
+      buffer_pool_manager_->FetchPageBasic(header_page->GetBlockPageId(block_idx / HashTableHeaderPage::MaxBlocks()));
+  BUSTUB_ENSURE(list_guard.IsValid(), "BPM full");
+  auto block_page_id =
+      list_guard.As<HashTableHeaderPage>()->GetBlockPageId(block_idx % HashTableHeaderPage::MaxBlocks());
+  list_guard.Drop();
+  BasicPageGuard block_guard = buffer_pool_manager_->FetchPageBasic(block_page_id);
+  BUSTUB_ENSURE(block_guard.IsValid(), "BPM full");
+  return block_guard;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::CreateNewBlockPages(HashTableHeaderPage *header_page, size_t num_blocks) {
+  BasicPageGuard list_guard;
+  for (size_t i = 0; i < num_blocks; i++) {
+    if (i % HashTableHeaderPage::MaxBlocks() == 0) {
+      page_id_t list_page_id;
+      list_guard = buffer_pool_manager_->NewPageGuarded(&list_page_id);
+      if (!list_guard.IsValid()) {
+        throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate block pages for hash table");
+      }
+      list_guard.AsMut<HashTableHeaderPage>()->SetPageId(list_page_id);
+      header_page->AddBlockPageId(list_page_id);
+    }
+    page_id_t block_page_id;
+    BasicPageGuard block_guard = buffer_pool_manager_->NewPageGuarded(&block_page_id);
+    if (!block_guard.IsValid()) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate block pages for hash table");
+    }
+    // An empty block is all zeroes, but it still has to reach the disk once it is evicted.
+    block_guard.AsMut<HASH_TABLE_BLOCK_TYPE>();
+    list_guard.AsMut<HashTableHeaderPage>()->AddBlockPageId(block_page_id);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::DeleteBlockPages(const HashTableHeaderPage *old_header_page) {
+  for (size_t i = 0; i < old_header_page->NumBlocks(); i++) {
+    auto list_page_id = old_header_page->GetBlockPageId(i);
+    {
+      BasicPageGuard list_guard = buffer_pool_manager_->FetchPageBasic(list_page_id);
+      BUSTUB_ASSERT(list_guard.IsValid(), "BPM full");
+      const auto *list_page = list_guard.As<HashTableHeaderPage>();
+      for (size_t j = 0; j < list_page->NumBlocks(); j++) {
+        buffer_pool_manager_->DeletePage(list_page->GetBlockPageId(j));
+      }
+    }
+    buffer_pool_manager_->DeletePage(list_page_id);
+  }
+}
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  table_latch_.RLock();
+  BasicPageGuard header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+  BUSTUB_ENSURE(header_guard.IsValid(), "BPM full");
+  bool found = false;
+  Probe(header_guard.As<HashTableHeaderPage>(), key, [&](BasicPageGuard *block_guard, size_t slot) {
+    const auto *block_page = block_guard->As<HASH_TABLE_BLOCK_TYPE>();
+    auto offset = slot % BLOCK_ARRAY_SIZE;
+    if (block_page->IsReadable(offset) && comparator_(key, block_page->KeyAt(offset)) == 0) {
+      result->push_back(block_page->ValueAt(offset));
+      found = true;
+    }
+    return true;
+  });
+  header_guard.Drop();
+  table_latch_.RUnlock();
+  return found;
 }
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.WLock();
+  BasicPageGuard header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+  BUSTUB_ENSURE(header_guard.IsValid(), "BPM full");
+  auto size = header_guard.As<HashTableHeaderPage>()->GetSize();
+  // Rebuild before the probe sequences get long. Tombstones count as well, since probes have to step over them too.
+  if ((num_occupied_ + 1) * 4 > size * 3) {
+    header_guard.Drop();
+    try {
+      Rebuild(num_readable_ * 2 >= size ? size * 2 : size);
+    } catch (...) {
+      table_latch_.WUnlock();
+      throw;
+    }
+    header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+    BUSTUB_ENSURE(header_guard.IsValid(), "BPM full");
+  }
+  const auto *header_page = header_guard.As<HashTableHeaderPage>();
+
+  // The whole probe sequence has to be checked for the pair, but the first tombstone on the way can take it.
+  auto tombstone = header_page->GetSize();
+  bool duplicate = false;
+  auto end = Probe(header_page, key, [&](BasicPageGuard *block_guard, size_t slot) {
+    const auto *block_page = block_guard->As<HASH_TABLE_BLOCK_TYPE>();
+    auto offset = slot % BLOCK_ARRAY_SIZE;
+    if (!block_page->IsReadable(offset)) {
+      tombstone = std::min(tombstone, slot);
+    } else if (comparator_(key, block_page->KeyAt(offset)) == 0 && block_page->ValueAt(offset) == value) {
+      duplicate = true;
+      return false;
+    }
+    return true;
+  });
+  if (duplicate) {
+    header_guard.Drop();
+    table_latch_.WUnlock();
+    return false;
+  }
+
+  // The load factor keeps an unoccupied slot around, so the probe always ends on one.
+  BUSTUB_ASSERT(end < header_page->GetSize(), "probe went through the whole table");
+  auto slot = tombstone < header_page->GetSize() ? tombstone : end;
+  BasicPageGuard block_guard = FetchBlockPage(header_page, slot / BLOCK_ARRAY_SIZE);
+  block_guard.AsMut<HASH_TABLE_BLOCK_TYPE>()->Insert(slot % BLOCK_ARRAY_SIZE, key, value);
+  block_guard.Drop();
+  if (slot == end) {
+    num_occupied_++;
+  }
+  num_readable_++;
+  header_guard.Drop();
+  table_latch_.WUnlock();
+  return true;
 }
 
 /*****************************************************************************
@@ -48,21 +215,108 @@ auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.WLock();
+  BasicPageGuard header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+  BUSTUB_ENSURE(header_guard.IsValid(), "BPM full");
+  bool removed = false;
+  Probe(header_guard.As<HashTableHeaderPage>(), key, [&](BasicPageGuard *block_guard, size_t slot) {
+    const auto *block_page = block_guard->As<HASH_TABLE_BLOCK_TYPE>();
+    auto offset = slot % BLOCK_ARRAY_SIZE;
+    if (block_page->IsReadable(offset) && comparator_(key, block_page->KeyAt(offset)) == 0 &&
+        block_page->ValueAt(offset) == value) {
+      block_guard->AsMut<HASH_TABLE_BLOCK_TYPE>()->Remove(offset);
+      removed = true;
+      return false;
+    }
+    return true;
+  });
+  if (removed) {
+    num_readable_--;
+  }
+  header_guard.Drop();
+  table_latch_.WUnlock();
+  return removed;
 }
 
 /*****************************************************************************
  * RESIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Resize(size_t initial_size) {}
+void HASH_TABLE_TYPE::Resize(size_t initial_size) {
+  table_latch_.WLock();
+  try {
+    Rebuild(initial_size * 2);
+  } catch (...) {
+    table_latch_.WUnlock();
+    throw;
+  }
+  table_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::Rebuild(size_t size) {
+  auto num_blocks = std::max<size_t>(1, (size + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE);
+  if (num_blocks > HashTableHeaderPage::MaxBlocks() * HashTableHeaderPage::MaxBlocks()) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "linear probe hash table is full");
+  }
+  page_id_t new_header_page_id;
+  BasicPageGuard new_header_guard = buffer_pool_manager_->NewPageGuarded(&new_header_page_id);
+  BUSTUB_ENSURE(new_header_guard.IsValid(), "BPM full");
+  auto *new_header_page = new_header_guard.AsMut<HashTableHeaderPage>();
+  new_header_page->SetPageId(new_header_page_id);
+  new_header_page->SetSize(num_blocks * BLOCK_ARRAY_SIZE);
+  CreateNewBlockPages(new_header_page, num_blocks);
+
+  // Old blocks are read one at a time, so besides the two headers only one old and one new block are pinned.
+  BasicPageGuard old_header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+  BUSTUB_ENSURE(old_header_guard.IsValid(), "BPM full");
+  const auto *old_header_page = old_header_guard.As<HashTableHeaderPage>();
+  for (size_t block_idx = 0; block_idx < old_header_page->GetSize() / BLOCK_ARRAY_SIZE; block_idx++) {
+    BasicPageGuard block_guard = FetchBlockPage(old_header_page, block_idx);
+    const auto *block_page = block_guard.As<HASH_TABLE_BLOCK_TYPE>();
+    for (slot_offset_t offset = 0; offset < BLOCK_ARRAY_SIZE; offset++) {
+      if (block_page->IsReadable(offset)) {
+        ResizeInsert(new_header_page, block_page->KeyAt(offset), block_page->ValueAt(offset));
+      }
+    }
+  }
+  DeleteBlockPages(old_header_page);
+  old_header_guard.Drop();
+  buffer_pool_manager_->DeletePage(header_page_id_);
+
+  header_page_id_ = new_header_page_id;
+  num_occupied_ = num_readable_;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::ResizeInsert(const HashTableHeaderPage *header_page, const KeyType &key,
+                                   const ValueType &value) {
+  auto slot = Probe(header_page, key, [](BasicPageGuard * /*block_guard*/, size_t /*slot*/) { return true; });
+  BUSTUB_ASSERT(slot < header_page->GetSize(), "probe went through the whole table");
+  BasicPageGuard block_guard = FetchBlockPage(header_page, slot / BLOCK_ARRAY_SIZE);
+  block_guard.AsMut<HASH_TABLE_BLOCK_TYPE>()->Insert(slot % BLOCK_ARRAY_SIZE, key, value);
+}
 
 /*****************************************************************************
  * GETSIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetSize() -> size_t {
-  return 0;
+  table_latch_.RLock();
+  BasicPageGuard header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+  BUSTUB_ENSURE(header_guard.IsValid(), "BPM full");
+  auto size = header_guard.As<HashTableHeaderPage>()->GetSize();
+  header_guard.Drop();
+  table_latch_.RUnlock();
+  return size;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::GetNumPairs() -> size_t {
+  table_latch_.RLock();
+  auto num_pairs = num_readable_;
+  table_latch_.RUnlock();
+  return num_pairs;
 }
 
 template class LinearProbeHashTable<int, int, IntComparator>;
@@ -9,21 +9,240 @@
 // Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "common/exception.h"
 #include "common/rid.h"
 #include "execution/executors/aggregation_executor.h"
 #include "storage/table/tuple.h"
+#include "type/limits.h"
+#include "type/type.h"
 
 namespace bustub {
 
+namespace {
+
+/** Set in the type byte of a NULL group by value in a flat key */
+constexpr uint8_t KEY_NULL_FLAG = 0x80;
+
+/** @return Whether an AggregateState can hold the values of a type */
+auto IsFixedWidthNumber(TypeId type_id) -> bool {
+  switch (type_id) {
+    case TypeId::TINYINT:
+    case TypeId::SMALLINT:
+    case TypeId::INTEGER:
+    case TypeId::BIGINT:
+    case TypeId::DECIMAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** @return The value of an integer of any width */
+auto IntegerOf(const Value &value) -> int64_t {
+  switch (value.GetTypeId()) {
+    case TypeId::TINYINT:
+      return value.GetAs<int8_t>();
+    case TypeId::SMALLINT:
+      return value.GetAs<int16_t>();
+    case TypeId::INTEGER:
+      return value.GetAs<int32_t>();
+    default:
+      return value.GetAs<int64_t>();
+  }
+}
+
+/** @return The value of a number as a DECIMAL */
+auto DecimalOf(const Value &value) -> double {
+  return value.GetTypeId() == TypeId::DECIMAL ? value.GetAs<double>() : static_cast<double>(IntegerOf(value));
+}
+
+/** @return An integer of the given type, which must be in its range like the result of Value::Add */
+auto MakeIntegerValue(TypeId type_id, int64_t integer) -> Value {
+  int64_t min = BUSTUB_INT64_MIN;
+  int64_t max = BUSTUB_INT64_MAX;
+  switch (type_id) {
+    case TypeId::TINYINT:
+      min = BUSTUB_INT8_MIN;
+      max = BUSTUB_INT8_MAX;
+      break;
+    case TypeId::SMALLINT:
+      min = BUSTUB_INT16_MIN;
+      max = BUSTUB_INT16_MAX;
+      break;
+    case TypeId::INTEGER:
+      min = BUSTUB_INT32_MIN;
+      max = BUSTUB_INT32_MAX;
+      break;
+    default:
+      break;
+  }
+  if (integer < min || integer > max) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+  }
+  return {type_id, integer};
+}
+
+}  // namespace
+
+SimpleAggregationHashTable::SimpleAggregationHashTable(const std::vector<AbstractExpressionRef> &group_bys,
+                                                       const std::vector<AbstractExpressionRef> &agg_exprs,
+                                                       const std::vector<AggregationType> &agg_types,
+                                                       const std::vector<bool> &distinct)
+    : group_bys_{group_bys},
+      agg_exprs_{agg_exprs},
+      agg_types_{agg_types},
+      combiner_{agg_types, distinct},
+      typed_{true} {
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    auto type_id = agg_exprs_[i]->GetReturnType();
+    bool counts =
+        agg_types_[i] == AggregationType::CountStarAggregate || agg_types_[i] == AggregationType::CountAggregate;
+    typed_ = typed_ && !distinct[i] && (counts || IsFixedWidthNumber(type_id));
+    decimal_.push_back(agg_types_[i] == AggregationType::AvgAggregate || (!counts && type_id == TypeId::DECIMAL));
+  }
+}
+
+void SimpleAggregationHashTable::InsertCombine(const Tuple &tuple, const Schema &schema) {
+  key_.clear();
+  for (const auto &expr : group_bys_) {
+    SerializeKeyValue(expr->Evaluate(&tuple, schema), &key_);
+  }
+  inputs_.clear();
+  for (const auto &expr : agg_exprs_) {
+    inputs_.emplace_back(expr->Evaluate(&tuple, schema));
+  }
+
+  // The key is only copied into the table for a new group.
+  auto [iter, inserted] = ht_.try_emplace(key_, ht_.size());
+  auto group = iter->second;
+  if (typed_) {
+    if (inserted) {
+      states_.resize(states_.size() + agg_types_.size(), AggregateState{0, {0}});
+    }
+    CombineStates(states_.data() + group * agg_types_.size());
+    return;
+  }
+  if (inserted) {
+    values_.push_back(combiner_.GenerateInitialAggregateValue());
+  }
+  combiner_.CombineAggregateValues(&values_[group], AggregateValue{inputs_, {}, {}});
+}
+
+void SimpleAggregationHashTable::SerializeKeyValue(const Value &value, std::string *key) {
+  auto type_id = value.GetTypeId();
+  if (value.IsNull()) {
+    key->push_back(static_cast<char>(type_id | KEY_NULL_FLAG));
+    return;
+  }
+  key->push_back(static_cast<char>(type_id));
+  auto offset = key->size();
+  auto size = type_id == TypeId::VARCHAR ? sizeof(uint32_t) + value.GetLength() : Type::GetTypeSize(type_id);
+  key->resize(offset + size);
+  value.SerializeTo(key->data() + offset);
+}
+
+void SimpleAggregationHashTable::CombineStates(AggregateState *states) const {
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    const auto &input = inputs_[i];
+    auto &state = states[i];
+    if (agg_types_[i] != AggregationType::CountStarAggregate && input.IsNull()) {
+      continue;
+    }
+    switch (agg_types_[i]) {
+      case AggregationType::CountStarAggregate:
+      case AggregationType::CountAggregate:
+        break;
+      case AggregationType::SumAggregate:
+      case AggregationType::AvgAggregate:
+        if (decimal_[i]) {
+          state.decimal_ += DecimalOf(input);
+        } else if (__builtin_add_overflow(state.integer_, IntegerOf(input), &state.integer_)) {
+          throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+        }
+        break;
+      case AggregationType::MinAggregate:
+        if (decimal_[i]) {
+          state.decimal_ = state.count_ == 0 ? DecimalOf(input) : std::min(state.decimal_, DecimalOf(input));
+        } else {
+          state.integer_ = state.count_ == 0 ? IntegerOf(input) : std::min(state.integer_, IntegerOf(input));
+        }
+        break;
+      case AggregationType::MaxAggregate:
+        if (decimal_[i]) {
+          state.decimal_ = state.count_ == 0 ? DecimalOf(input) : std::max(state.decimal_, DecimalOf(input));
+        } else {
+          state.integer_ = state.count_ == 0 ? IntegerOf(input) : std::max(state.integer_, IntegerOf(input));
+        }
+        break;
+    }
+    state.count_++;
+  }
+}
+
+auto SimpleAggregationHashTable::Output(Iterator iter) const -> std::vector<Value> {
+  std::vector<Value> values;
+  values.reserve(group_bys_.size() + agg_types_.size());
+  const char *data = iter.Key().data();
+  for (size_t i = 0; i < group_bys_.size(); i++) {
+    auto type_byte = static_cast<uint8_t>(*data++);
+    auto type_id = static_cast<TypeId>(type_byte & ~KEY_NULL_FLAG);
+    if ((type_byte & KEY_NULL_FLAG) != 0) {
+      values.push_back(ValueFactory::GetNullValueByType(type_id));
+      continue;
+    }
+    values.push_back(Value::DeserializeFrom(data, type_id));
+    data += type_id == TypeId::VARCHAR ? sizeof(uint32_t) + values.back().GetLength() : Type::GetTypeSize(type_id);
+  }
+
+  auto group = iter.Val();
+  if (!typed_) {
+    auto aggregates = combiner_.FinalizeAggregateValue(values_[group]);
+    values.insert(values.end(), aggregates.begin(), aggregates.end());
+    return values;
+  }
+  // Like AggregateCombiner, aggregates without any value are NULL, and only AVG is a DECIMAL otherwise.
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    const auto &state = states_[group * agg_types_.size() + i];
+    switch (agg_types_[i]) {
+      case AggregationType::CountStarAggregate:
+        values.push_back(MakeIntegerValue(TypeId::INTEGER, state.count_));
+        break;
+      case AggregationType::CountAggregate:
+        values.push_back(state.count_ == 0 ? ValueFactory::GetNullValueByType(TypeId::INTEGER)
+                                           : MakeIntegerValue(TypeId::INTEGER, state.count_));
+        break;
+      case AggregationType::SumAggregate:
+      case AggregationType::MinAggregate:
+      case AggregationType::MaxAggregate:
+        if (state.count_ == 0) {
+          values.push_back(ValueFactory::GetNullValueByType(TypeId::INTEGER));
+        } else if (decimal_[i]) {
+          values.push_back(ValueFactory::GetDecimalValue(state.decimal_));
+        } else {
+          values.push_back(MakeIntegerValue(agg_exprs_[i]->GetReturnType(), state.integer_));
+        }
+        break;
+      case AggregationType::AvgAggregate:
+        values.push_back(state.count_ == 0
+                             ? ValueFactory::GetNullValueByType(TypeId::DECIMAL)
+                             : ValueFactory::GetDecimalValue(state.decimal_ / static_cast<double>(state.count_)));
+        break;
+    }
+  }
+  return values;
+}
+
 AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
                                          std::unique_ptr<AbstractExecutor> &&child)
     : AbstractExecutor(exec_ctx),
       plan_(plan),
       child_(std::move(child)),
-      aht_(plan->GetAggregates(), plan->GetAggregateTypes()),
+      aht_(plan->GetGroupBys(), plan->GetAggregates(), plan->GetAggregateTypes(), plan->GetDistinct()),
       aht_iterator_(aht_.End()),
       end_(aht_.End()) {}
 
@@ -37,9 +256,7 @@ void AggregationExecutor::Init() {
   RID rid{};
   auto next_child = child_->Next(&tuple_tmp, &rid);
   while (next_child) {
-    auto key = MakeAggregateKey(&tuple_tmp);
-    auto aggregate_value = MakeAggregateValue(&tuple_tmp);
-    aht_.InsertCombine(key, aggregate_value);
+    aht_.InsertCombine(tuple_tmp, child_->GetOutputSchema());
     next_child = child_->Next(&tuple_tmp, &rid);
   }
   // 表初始化后再初始化迭代器
@@ -60,20 +277,14 @@ auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
         // 检查是否存在分组依据
         return false;
       }
-      auto value = aht_.GenerateInitialAggregateValue();
-      *tuple = Tuple(value.aggregates_, &curr_schema);
+      *tuple = Tuple(aht_.InitialOutput(), &curr_schema);
       empty_output_ = false;
       return true;
     }
     // 结束
     return false;
   }
-  auto key = aht_iterator_.Key();
-  auto value = aht_iterator_.Val();
-  std::vector<Value> values;
-  values.insert(values.end(), key.group_bys_.begin(), key.group_bys_.end());
-  values.insert(values.end(), value.aggregates_.begin(), value.aggregates_.end());
-  *tuple = Tuple(values, &curr_schema);
+  *tuple = Tuple(aht_.Output(aht_iterator_), &curr_schema);
   ++aht_iterator_;
   return true;
 }
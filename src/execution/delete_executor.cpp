@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/executors/delete_executor.h"
@@ -31,20 +32,25 @@ auto DeleteExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
   int count = 0;
   auto table_oid = plan_->table_oid_;
   auto table_info = exec_ctx_->GetCatalog()->GetTable(table_oid);
+  auto indexes_info = exec_ctx_->GetCatalog()->GetTableIndexes(table_info->name_);
+  // 与插入一样，索引项缓存到语句结束后按键序批量删除
+  std::vector<std::vector<std::pair<Tuple, RID>>> index_entries(indexes_info.size());
   Tuple child_tuple{};
   while (child_executor_->Next(&child_tuple, rid)) {
     if (table_info->table_->MarkDelete(*rid, exec_ctx_->GetTransaction())) {
       // 更新索引信息.表名和表info一一对应
-      auto indexes_info = exec_ctx_->GetCatalog()->GetTableIndexes(table_info->name_);
-      for (auto index_info : indexes_info) {
-        auto key = (&child_tuple)
-                       ->KeyFromTuple(child_executor_->GetOutputSchema(), index_info->key_schema_,
-                                      index_info->index_->GetKeyAttrs());
-        index_info->index_->DeleteEntry(key, *rid, exec_ctx_->GetTransaction());
+      for (size_t i = 0; i < indexes_info.size(); i++) {
+        auto key = child_tuple.KeyFromTuple(child_executor_->GetOutputSchema(), indexes_info[i]->key_schema_,
+                                            indexes_info[i]->index_->GetKeyAttrs());
+        index_entries[i].emplace_back(std::move(key), *rid);
       }
+      table_info->RecordDelete(child_tuple);
       ++count;
     }
   }
+  for (size_t i = 0; i < indexes_info.size(); i++) {
+    indexes_info[i]->index_->DeleteEntries(index_entries[i], exec_ctx_->GetTransaction());
+  }
   std::vector<Value> values;
   values.emplace_back(INTEGER, count);  // emplace_back()就地构造。
   auto tuple_tmp = Tuple(values, &this->GetOutputSchema());
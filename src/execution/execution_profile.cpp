@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// execution_profile.cpp
+//
+// Identification: src/execution/execution_profile.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/execution_profile.h"
+
+#include <algorithm>
+
+#include "fmt/format.h"
+
+namespace bustub {
+
+namespace {
+
+auto FormatNs(uint64_t ns) -> std::string { return fmt::format("{:.2f}ms", ns / 1e6); }
+
+auto FormatBytes(size_t bytes) -> std::string {
+  if (bytes < 1024) {
+    return fmt::format("{}B", bytes);
+  }
+  if (bytes < 1024 * 1024) {
+    return fmt::format("{:.1f}KB", bytes / 1024.0);
+  }
+  return fmt::format("{:.1f}MB", bytes / (1024.0 * 1024.0));
+}
+
+}  // namespace
+
+auto ExecutionProfile::FindOperator(const AbstractPlanNode &plan) const -> OperatorProfile {
+  auto iter = operators_.find(&plan);
+  return iter != operators_.end() ? iter->second : OperatorProfile{};
+}
+
+auto ExecutionProfile::Annotate(const AbstractPlanNode &plan) const -> std::string {
+  auto profile = FindOperator(plan);
+  uint64_t total_ns = profile.init_ns_ + profile.next_ns_;
+
+  // What the children did happened inside this executor's calls; take it out to get the executor's own share.
+  uint64_t rows_in = 0;
+  uint64_t self_ns = total_ns;
+  uint64_t self_hits = profile.fetch_hits_;
+  uint64_t self_misses = profile.fetch_misses_;
+  for (const auto &child : plan.GetChildren()) {
+    auto child_profile = FindOperator(*child);
+    rows_in += child_profile.rows_out_;
+    self_ns -= std::min(self_ns, child_profile.init_ns_ + child_profile.next_ns_);
+    self_hits -= std::min(self_hits, child_profile.fetch_hits_);
+    self_misses -= std::min(self_misses, child_profile.fetch_misses_);
+  }
+
+  return fmt::format("actual_rows={} rows_in={} loops={} time={} self={} fetches={} misses={} memory={}",
+                     profile.rows_out_, rows_in, profile.loops_, FormatNs(total_ns), FormatNs(self_ns),
+                     self_hits + self_misses, self_misses, FormatBytes(profile.peak_memory_));
+}
+
+}  // namespace bustub
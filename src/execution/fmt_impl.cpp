@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <type_traits>
 #include "execution/plans/update_plan.h"
 #include "fmt/format.h"
@@ -7,14 +8,17 @@
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "execution/plans/aggregation_plan.h"
+#include "execution/plans/hash_semi_join_plan.h"
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/plans/stream_aggregation_plan.h"
 #include "execution/plans/topn_plan.h"
 
 namespace bustub {
 
-auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema) const -> std::string {
+auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema, const PlanAnnotator &annotator) const
+    -> std::string {
   if (children_.empty()) {
     return "";
   }
@@ -22,7 +26,7 @@ auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema) const -> s
   children_str.reserve(children_.size());
   auto indent_str = StringUtil::Indent(indent);
   for (const auto &child : children_) {
-    auto child_str = child->ToString(with_schema);
+    auto child_str = child->ToString(with_schema, annotator);
     auto lines = StringUtil::Split(child_str, '\n');
     for (auto &line : lines) {
       children_str.push_back(fmt::format("{}{}", indent_str, line));
@@ -32,9 +36,30 @@ auto AbstractPlanNode::ChildrenToString(int indent, bool with_schema) const -> s
 }
 
 auto AggregationPlanNode::PlanNodeToString() const -> std::string {
+  if (std::find(distinct_.begin(), distinct_.end(), true) != distinct_.end()) {
+    std::vector<std::string> distinct;
+    for (bool is_distinct : distinct_) {
+      distinct.emplace_back(is_distinct ? "true" : "false");
+    }
+    return fmt::format("Agg {{ types={}, aggregates={}, distinct=[{}], group_by={} }}", agg_types_, aggregates_,
+                       fmt::join(distinct, ", "), group_bys_);
+  }
   return fmt::format("Agg {{ types={}, aggregates={}, group_by={} }}", agg_types_, aggregates_, group_bys_);
 }
 
+auto StreamAggregationPlanNode::PlanNodeToString() const -> std::string {
+  return "Stream" + AggregationPlanNode::PlanNodeToString();
+}
+
+auto HashSemiJoinPlanNode::PlanNodeToString() const -> std::string {
+  if (null_aware_) {
+    return fmt::format("HashSemiJoin {{ type={}, left_keys={}, right_keys={}, null_aware=true }}", join_type_,
+                       left_key_expressions_, right_key_expressions_);
+  }
+  return fmt::format("HashSemiJoin {{ type={}, left_keys={}, right_keys={} }}", join_type_, left_key_expressions_,
+                     right_key_expressions_);
+}
+
 auto ProjectionPlanNode::PlanNodeToString() const -> std::string {
   return fmt::format("Projection {{ exprs={} }}", expressions_);
 }
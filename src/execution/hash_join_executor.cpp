@@ -12,23 +12,78 @@
 
 #include "execution/executors/hash_join_executor.h"
 
-// Note for 2022 Fall: You don't need to implement HashJoinExecutor to pass all tests. You ONLY need to implement it
-// if you want to get faster in leaderboard tests.
-
 namespace bustub {
 
 HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                                    std::unique_ptr<AbstractExecutor> &&left_child,
                                    std::unique_ptr<AbstractExecutor> &&right_child)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {
   if (plan->GetJoinType() != JoinType::LEFT && plan->GetJoinType() != JoinType::INNER) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void HashJoinExecutor::Init() { throw NotImplementedException("HashJoinExecutor is not implemented"); }
+void HashJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  hash_table_.clear();
+  matches_ = nullptr;
+  match_idx_ = 0;
+
+  Tuple right_tuple;
+  RID right_rid;
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  while (right_executor_->Next(&right_tuple, &right_rid)) {
+    auto key = plan_->RightJoinKeyExpression().Evaluate(&right_tuple, right_schema);
+    if (!key.IsNull()) {
+      hash_table_[HashJoinKey{std::move(key)}].push_back(right_tuple);
+    }
+  }
+}
+
+auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    if (matches_ != nullptr && match_idx_ < matches_->size()) {
+      *tuple = MergeTuples(&(*matches_)[match_idx_++]);
+      return true;
+    }
 
-auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+    RID left_rid;
+    if (!left_executor_->Next(&left_tuple_, &left_rid)) {
+      return false;
+    }
+    auto key = plan_->LeftJoinKeyExpression().Evaluate(&left_tuple_, left_executor_->GetOutputSchema());
+    auto it = key.IsNull() ? hash_table_.end() : hash_table_.find(HashJoinKey{std::move(key)});
+    if (it != hash_table_.end()) {
+      matches_ = &it->second;
+      match_idx_ = 0;
+      continue;
+    }
+    matches_ = nullptr;
+    if (plan_->GetJoinType() == JoinType::LEFT) {
+      *tuple = MergeTuples(nullptr);
+      return true;
+    }
+  }
+}
+
+auto HashJoinExecutor::MergeTuples(const Tuple *right) const -> Tuple {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.push_back(left_tuple_.GetValue(&left_schema, i));
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.push_back(right != nullptr ? right->GetValue(&right_schema, i)
+                                      : ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType()));
+  }
+  return Tuple{values, &GetOutputSchema()};
+}
 
 }  // namespace bustub
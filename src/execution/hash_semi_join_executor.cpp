@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_semi_join_executor.cpp
+//
+// Identification: src/execution/hash_semi_join_executor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/hash_semi_join_executor.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+namespace {
+
+auto HasNull(const std::vector<Value> &values) -> bool {
+  return std::any_of(values.begin(), values.end(), [](const Value &value) { return value.IsNull(); });
+}
+
+}  // namespace
+
+HashSemiJoinExecutor::HashSemiJoinExecutor(ExecutorContext *exec_ctx, const HashSemiJoinPlanNode *plan,
+                                           std::unique_ptr<AbstractExecutor> &&left_child,
+                                           std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {
+  if (plan->GetJoinType() != JoinType::SEMI && plan->GetJoinType() != JoinType::ANTI) {
+    throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
+  }
+  if (plan->IsNullAware() && (plan->GetJoinType() != JoinType::ANTI || plan->RightJoinKeyExpressions().empty())) {
+    throw bustub::NotImplementedException("only an anti join with keys can be null-aware");
+  }
+}
+
+void HashSemiJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  keys_.clear();
+  not_in_groups_.clear();
+
+  Tuple right_tuple;
+  RID right_rid;
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  while (right_executor_->Next(&right_tuple, &right_rid)) {
+    auto keys = EvaluateKeys(plan_->RightJoinKeyExpressions(), right_tuple, right_schema);
+    if (!plan_->IsNullAware()) {
+      if (!HasNull(keys)) {
+        keys_.insert(SemiJoinKey{std::move(keys)});
+      }
+      // Without keys, as for an uncorrelated EXISTS, one right tuple decides for every left tuple.
+      if (keys_.size() == 1 && plan_->RightJoinKeyExpressions().empty()) {
+        break;
+      }
+      continue;
+    }
+    auto value = std::move(keys.back());
+    keys.pop_back();
+    if (HasNull(keys)) {
+      continue;
+    }
+    auto &group = not_in_groups_[SemiJoinKey{std::move(keys)}];
+    if (value.IsNull()) {
+      group.has_null_ = true;
+    } else {
+      group.values_.insert(HashJoinKey{std::move(value)});
+    }
+  }
+}
+
+auto HashSemiJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  while (left_executor_->Next(tuple, rid)) {
+    if (IsOutput(EvaluateKeys(plan_->LeftJoinKeyExpressions(), *tuple, left_schema))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto HashSemiJoinExecutor::IsOutput(std::vector<Value> keys) const -> bool {
+  if (!plan_->IsNullAware()) {
+    bool found = !HasNull(keys) && keys_.count(SemiJoinKey{std::move(keys)}) != 0;
+    return found == (plan_->GetJoinType() == JoinType::SEMI);
+  }
+
+  // `x NOT IN (...)` is true if there are no values to compare with, and otherwise only if x is compared with every
+  // one of them and differs.
+  auto value = std::move(keys.back());
+  keys.pop_back();
+  if (HasNull(keys)) {
+    return true;
+  }
+  auto group = not_in_groups_.find(SemiJoinKey{std::move(keys)});
+  if (group == not_in_groups_.end()) {
+    return true;
+  }
+  return !value.IsNull() && !group->second.has_null_ && group->second.values_.count(HashJoinKey{value}) == 0;
+}
+
+auto HashSemiJoinExecutor::EvaluateKeys(const std::vector<AbstractExpressionRef> &key_expressions, const Tuple &tuple,
+                                        const Schema &schema) -> std::vector<Value> {
+  std::vector<Value> keys;
+  keys.reserve(key_expressions.size());
+  for (const auto &expr : key_expressions) {
+    keys.push_back(expr->Evaluate(&tuple, schema));
+  }
+  return keys;
+}
+
+auto HashSemiJoinExecutor::GetMemoryUsage() const -> size_t {
+  size_t bytes = 0;
+  for (const auto &key : keys_) {
+    bytes += sizeof(key) + key.values_.size() * sizeof(Value);
+  }
+  for (const auto &[key, group] : not_in_groups_) {
+    bytes += sizeof(key) + key.values_.size() * sizeof(Value) + sizeof(group) +
+             group.values_.size() * sizeof(HashJoinKey);
+  }
+  return bytes;
+}
+
+}  // namespace bustub
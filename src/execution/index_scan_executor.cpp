@@ -22,16 +22,58 @@ void IndexScanExecutor::Init() {
   auto index_oid = plan_->GetIndexOid();
 
   auto index_info = exec_ctx_->GetCatalog()->GetIndex(index_oid);
+  table_heap_ = exec_ctx_->GetCatalog()->GetTable(index_info->table_name_)->table_.get();  // 独占指针
+  produced_ = 0;
+
+  if (plan_->pred_key_ != nullptr) {
+    // A point lookup works on any kind of index.
+    std::vector<Value> key_values{plan_->pred_key_->Evaluate(nullptr, GetOutputSchema())};
+    rids_.clear();
+    rid_idx_ = 0;
+    // The key of a prepared statement is only known now, and a NULL key equals nothing.
+    if (!key_values[0].IsNull()) {
+      Tuple key(key_values, &index_info->key_schema_);
+      index_info->index_->ScanKey(key, &rids_, exec_ctx_->GetTransaction());
+    }
+    return;
+  }
 
   index_tree_ =
       dynamic_cast<BPlusTreeIndexForOneIntegerColumn *>(index_info->index_.get());  // 获取独占指针的裸指针,注意释放
 
   indicator_ = index_tree_->GetBeginIterator();
   end_ = index_tree_->GetEndIterator();
-  table_heap_ = exec_ctx_->GetCatalog()->GetTable(index_info->table_name_)->table_.get();  // 独占指针
 }
 
 auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  // A bounded scan stops reading the index as soon as it produced enough tuples.
+  if (plan_->limit_.has_value() && produced_ >= *plan_->limit_) {
+    return false;
+  }
+  while (FetchNext(tuple, rid)) {
+    if (plan_->filter_predicate_ != nullptr) {
+      auto value = plan_->filter_predicate_->Evaluate(tuple, GetOutputSchema());
+      if (value.IsNull() || !value.GetAs<bool>()) {
+        continue;
+      }
+    }
+    produced_++;
+    return true;
+  }
+  return false;
+}
+
+auto IndexScanExecutor::FetchNext(Tuple *tuple, RID *rid) -> bool {
+  if (plan_->pred_key_ != nullptr) {
+    while (rid_idx_ < rids_.size()) {
+      *rid = rids_[rid_idx_++];
+      if (table_heap_->GetTuple(*rid, tuple, exec_ctx_->GetTransaction())) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   if (indicator_ == end_) {
     return false;
   }
@@ -1,70 +1,92 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// insert_executor.cpp
-//
-// Identification: src/execution/insert_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-
-#include <memory>
-#include <vector>
-
-#include "catalog/catalog.h"
-#include "execution/executors/insert_executor.h"
-#include "storage/table/tuple.h"
-#include "type/type.h"
-
-namespace bustub {
-
-InsertExecutor::InsertExecutor(ExecutorContext *exec_ctx, const InsertPlanNode *plan,
-                               std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
-
-void InsertExecutor::Init() {
-  insert_result_ = false;
-  child_executor_->Init();
-}
-
-auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
-  // insert 有一个子executor节点，这个child——executor有自己的next函数，为当前算子提供tuple
-  if (insert_result_) {
-    return false;
-  }
-  int count = 0;
-  Tuple child_tuple{};
-  RID child_rid{};
-
-  auto table_indexes =
-      exec_ctx_->GetCatalog()->GetTableIndexes(exec_ctx_->GetCatalog()->GetTable(plan_->TableOid())->name_);
-  // 用于在每个索引上遍历插入key
-  auto table_info = exec_ctx_->GetCatalog()->GetTable(plan_->table_oid_);  // 插入tuple
-  auto tuple_schema = child_executor_->GetOutputSchema();
-
-  while (child_executor_->Next(&child_tuple, rid)) {
-    auto insert_result = table_info->table_->InsertTuple(child_tuple, &child_rid, exec_ctx_->GetTransaction());
-    if (insert_result) {
-      ++count;
-    }
-    if (!table_indexes.empty() && insert_result) {
-      std::for_each(table_indexes.begin(), table_indexes.end(), [&](auto lt) {
-        auto key_schema = lt->index_->GetKeySchema();
-        auto key_attrs = lt->index_->GetKeyAttrs();
-        auto key = child_tuple.KeyFromTuple(tuple_schema, *key_schema, key_attrs);
-        lt->index_->InsertEntry(key, child_rid, exec_ctx_->GetTransaction());
-      });
-    }
-  }
-  std::vector<Value> values{};
-  values.reserve(GetOutputSchema().GetColumnCount());
-  values.emplace_back(INTEGER, count);
-  Tuple tuple_tmp = Tuple(values, &GetOutputSchema());
-  *tuple = tuple_tmp;
-  insert_result_ = true;
-  return true;
-}
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// insert_executor.cpp
+//
+// Identification: src/execution/insert_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "common/exception.h"
+#include "execution/executors/insert_executor.h"
+#include "fmt/format.h"
+#include "storage/index/generic_key.h"
+#include "storage/table/tuple.h"
+#include "type/type.h"
+
+namespace bustub {
+
+InsertExecutor::InsertExecutor(ExecutorContext *exec_ctx, const InsertPlanNode *plan,
+                               std::unique_ptr<AbstractExecutor> &&child_executor)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void InsertExecutor::Init() {
+  insert_result_ = false;
+  child_executor_->Init();
+}
+
+auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
+  // insert 有一个子executor节点，这个child——executor有自己的next函数，为当前算子提供tuple
+  if (insert_result_) {
+    return false;
+  }
+  int count = 0;
+  Tuple child_tuple{};
+  RID child_rid{};
+
+  auto table_indexes =
+      exec_ctx_->GetCatalog()->GetTableIndexes(exec_ctx_->GetCatalog()->GetTable(plan_->TableOid())->name_);
+  // 用于在每个索引上遍历插入key
+  auto table_info = exec_ctx_->GetCatalog()->GetTable(plan_->table_oid_);  // 插入tuple
+  auto tuple_schema = child_executor_->GetOutputSchema();
+
+  // 索引项先按索引缓存起来，整条语句插入完后再按键序批量插入，每个叶子只需下降一次
+  std::vector<std::vector<std::pair<Tuple, RID>>> index_entries(table_indexes.size());
+  std::vector<Tuple> keys(table_indexes.size());
+  const auto &columns = table_info->schema_.GetColumns();
+  while (child_executor_->Next(&child_tuple, rid)) {
+    for (uint32_t i = 0; i < columns.size(); i++) {
+      if (!columns[i].IsNullable() && child_tuple.IsNull(&tuple_schema, i)) {
+        throw ExecutionException(fmt::format("column {} of table {} is NOT NULL", columns[i].GetName(),
+                                             table_info->name_));
+      }
+    }
+    // 先检查所有索引键都放得下，再写表，这样出错时表和索引不会不一致
+    for (size_t i = 0; i < table_indexes.size(); i++) {
+      auto &index = table_indexes[i]->index_;
+      keys[i] = child_tuple.KeyFromTuple(tuple_schema, *index->GetKeySchema(), index->GetKeyAttrs());
+      if (!KeyFits(keys[i], *index->GetKeySchema(), table_indexes[i]->key_size_)) {
+        throw ExecutionException(fmt::format("index key of {} bytes does not fit in index {}", keys[i].GetLength(),
+                                             table_indexes[i]->name_));
+      }
+    }
+    auto insert_result = table_info->table_->InsertTuple(child_tuple, &child_rid, exec_ctx_->GetTransaction());
+    if (insert_result) {
+      ++count;
+      table_info->RecordInsert(child_tuple);
+      for (size_t i = 0; i < table_indexes.size(); i++) {
+        index_entries[i].emplace_back(std::move(keys[i]), child_rid);
+      }
+    }
+  }
+  for (size_t i = 0; i < table_indexes.size(); i++) {
+    table_indexes[i]->index_->InsertEntries(index_entries[i], exec_ctx_->GetTransaction());
+  }
+  std::vector<Value> values{};
+  values.reserve(GetOutputSchema().GetColumnCount());
+  values.emplace_back(INTEGER, count);
+  Tuple tuple_tmp = Tuple(values, &GetOutputSchema());
+  *tuple = tuple_tmp;
+  insert_result_ = true;
+  return true;
+}
+
+}  // namespace bustub
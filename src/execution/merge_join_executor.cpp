@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.cpp
+//
+// Identification: src/execution/merge_join_executor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/merge_join_executor.h"
+
+namespace bustub {
+
+MergeJoinExecutor::MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_child,
+                                     std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {
+  if (plan->GetJoinType() != JoinType::LEFT && plan->GetJoinType() != JoinType::INNER) {
+    throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
+  }
+}
+
+void MergeJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  run_.clear();
+  AdvanceLeft();
+  AdvanceRight();
+}
+
+auto MergeJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (left_valid_) {
+    if (left_matched_) {
+      if (match_idx_ < run_.size()) {
+        *tuple = MergeTuples(&run_[match_idx_++]);
+        return true;
+      }
+      AdvanceLeft();
+      continue;
+    }
+    if (FindRun()) {
+      left_matched_ = true;
+      match_idx_ = 0;
+      continue;
+    }
+    if (plan_->GetJoinType() == JoinType::LEFT) {
+      *tuple = MergeTuples(nullptr);
+      AdvanceLeft();
+      return true;
+    }
+    AdvanceLeft();
+  }
+  return false;
+}
+
+void MergeJoinExecutor::AdvanceLeft() {
+  RID left_rid;
+  left_valid_ = left_executor_->Next(&left_tuple_, &left_rid);
+  if (left_valid_) {
+    left_key_ = plan_->LeftJoinKeyExpression().Evaluate(&left_tuple_, left_executor_->GetOutputSchema());
+  }
+  left_matched_ = false;
+  match_idx_ = 0;
+}
+
+void MergeJoinExecutor::AdvanceRight() {
+  RID right_rid;
+  right_valid_ = right_executor_->Next(&right_tuple_, &right_rid);
+  if (right_valid_) {
+    right_key_ = plan_->RightJoinKeyExpression().Evaluate(&right_tuple_, right_executor_->GetOutputSchema());
+  }
+}
+
+auto MergeJoinExecutor::FindRun() -> bool {
+  if (left_key_.IsNull()) {
+    return false;
+  }
+  // Left tuples with the same key as the one before are joined with the same run.
+  if (!run_.empty() && run_key_.CompareEquals(left_key_) == CmpBool::CmpTrue) {
+    return true;
+  }
+  run_.clear();
+  while (right_valid_ && (right_key_.IsNull() || right_key_.CompareLessThan(left_key_) == CmpBool::CmpTrue)) {
+    AdvanceRight();
+  }
+  while (right_valid_ && right_key_.CompareEquals(left_key_) == CmpBool::CmpTrue) {
+    run_.push_back(right_tuple_);
+    AdvanceRight();
+  }
+  run_key_ = left_key_;
+  return !run_.empty();
+}
+
+auto MergeJoinExecutor::MergeTuples(const Tuple *right) const -> Tuple {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.push_back(left_tuple_.GetValue(&left_schema, i));
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.push_back(right != nullptr ? right->GetValue(&right_schema, i)
+                                      : ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType()));
+  }
+  return Tuple{values, &GetOutputSchema()};
+}
+
+}  // namespace bustub
@@ -39,36 +39,42 @@ void NestIndexJoinExecutor::Init() {
   index_oid_t oid = plan_->GetIndexOid();
   inner_index_ = exec_ctx_->GetCatalog()->GetIndex(oid);
   inner_table_ptr_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetInnerTableOid());
+  inner_rids_.clear();
+  inner_idx_ = 0;
 }
 
 auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  // 每次从outer_table中获取一个键，循环遍历索引表找出匹配的键输出，若没有匹配的键则输出null或不输出
+  // 每次从outer_table中获取一个键，在索引中找出所有匹配的键逐个输出，
+  // 若没有匹配的键则输出null或不输出
   RID left_rid;
-  while (child_executor_->Next(&outer_tuple_, &left_rid)) {
+  while (true) {
+    // 先输出上一个外表元组剩余的匹配。
+    // 索引的键可以重复（如hash索引），因此一个外表元组可能匹配多个内表元组
+    if (inner_idx_ < inner_rids_.size()) {
+      inner_table_ptr_->table_->GetTuple(inner_rids_[inner_idx_++], &inner_tuple_, exec_ctx_->GetTransaction());
+      std::vector<Value> value;
+      MergeValueFromTuple(value, false);
+      *tuple = Tuple(value, &GetOutputSchema());
+      return true;
+    }
+    if (!child_executor_->Next(&outer_tuple_, &left_rid)) {
+      return false;
+    }
     // 从left_tuple构建索引键用于在索引中查找
     // 先获取value，在构建成tuple类型的key
     // 最后用这个key在索引中查找
     std::vector<Value> key_val{plan_->KeyPredicate()->Evaluate(&outer_tuple_, left_schema_)};
     // 用索引的schema来构建索引键
     Tuple key_tup = Tuple(key_val, index_schema_);
-    std::vector<RID> results{};
-    // 由于index中没有重复的键，因此在扫描到一个匹配的值之后，此次扫描结束，不用在往下扫描。而外表（左表）指向下一行继续扫描
-    inner_index_->index_->ScanKey(key_tup, &results, exec_ctx_->GetTransaction());
-    if (!results.empty()) {
-      auto inner_rid = results.back();
-      inner_table_ptr_->table_->GetTuple(inner_rid, &inner_tuple_, exec_ctx_->GetTransaction());
-      std::vector<Value> value;
-      MergeValueFromTuple(value, false);
-      *tuple = Tuple(value, &GetOutputSchema());
-      return true;
-    }
-    if (plan_->GetJoinType() == JoinType::LEFT) {
+    inner_rids_.clear();
+    inner_idx_ = 0;
+    inner_index_->index_->ScanKey(key_tup, &inner_rids_, exec_ctx_->GetTransaction());
+    if (inner_rids_.empty() && plan_->GetJoinType() == JoinType::LEFT) {
       std::vector<Value> value;
       MergeValueFromTuple(value, true);  // 右表的null值
       *tuple = Tuple(value, &GetOutputSchema());
       return true;
     }
   }
-  return false;
 }
 }  // namespace bustub
@@ -25,94 +25,131 @@ NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext *exec_ctx, const
       plan_(plan),
       left_executor_(std::move(left_executor)),
       right_executor_(std::move(right_executor)) {
-  if (plan->GetJoinType() != JoinType::LEFT && plan->GetJoinType() != JoinType::INNER) {
+  if (plan->GetJoinType() != JoinType::LEFT && plan->GetJoinType() != JoinType::INNER &&
+      plan->GetJoinType() != JoinType::SEMI && plan->GetJoinType() != JoinType::ANTI) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
 void NestedLoopJoinExecutor::Init() {
-  // 初始化非常重要，尤其要重置指针。
   left_executor_->Init();
   right_executor_->Init();
-  left_tuple_ = Tuple{};
-  right_tuple_ = Tuple{};
-  left_rid_ = RID{};
-  right_rid_ = RID{};
-  next_ltuple_existent_ = left_executor_->Next(&left_tuple_, &left_rid_);
-  next_rtuple_existent_ = right_executor_->Next(&right_tuple_, &right_rid_);
-}
-
-auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  // 左连接要考虑输出null，内连接要考虑输出相互匹配。
+  inner_tuples_.clear();
+  inner_block_ends_.clear();
+  outer_block_.clear();
+  outer_matches_.clear();
+  outer_idx_ = 0;
+  match_idx_ = 0;
 
-  if (!next_ltuple_existent_) {  // 对于内连接和左连接，左表空直接结束
-    return false;
+  // Materialize the right side once, instead of executing it again for every left tuple.
+  Tuple right_tuple;
+  RID right_rid;
+  size_t block_bytes = 0;
+  while (right_executor_->Next(&right_tuple, &right_rid)) {
+    block_bytes += right_tuple.GetLength();
+    inner_tuples_.push_back(std::move(right_tuple));
+    if (block_bytes >= NLJ_INNER_BLOCK_BYTES) {
+      inner_block_ends_.push_back(inner_tuples_.size());
+      block_bytes = 0;
+    }
   }
+  if (block_bytes > 0) {
+    inner_block_ends_.push_back(inner_tuples_.size());
+  }
+}
 
-  if (plan_->GetJoinType() == JoinType::LEFT) {
-    while (next_ltuple_existent_) {
-      while (next_rtuple_existent_) {
-        auto pred_value = plan_->Predicate().EvaluateJoin(&left_tuple_, left_executor_->GetOutputSchema(),
-                                                          &right_tuple_, right_executor_->GetOutputSchema());
-
-        if (!pred_value.GetAs<bool>()) {
-          // GetAs()函数会将value转换成bool值。为true说明两者相匹配 此时将左右两表拼接后输出
-          next_rtuple_existent_ = right_executor_->Next(&right_tuple_, &right_rid_);
-        } else {
-          std::vector<Value> value;
-          MergeValueFromTuple(value, false);
-          *tuple = Tuple(value, &plan_->OutputSchema());
-          right_found_ = true;
-          next_rtuple_existent_ = right_executor_->Next(&right_tuple_, &right_rid_);
+auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (true) {
+    while (outer_idx_ < outer_block_.size()) {
+      const auto &left = outer_block_[outer_idx_];
+      const auto &matches = outer_matches_[outer_idx_];
+      if (IsSemiOrAnti()) {
+        outer_idx_++;
+        if (matches.empty() == (plan_->GetJoinType() == JoinType::ANTI)) {
+          *tuple = left;
           return true;
         }
+        continue;
       }
-      // 循环结束后表明右表遍历完成，若右表没有相匹配的值 right_found为false，表明要为额外输出null
-      // 还要让左表指向下一条值,右表迭代器初始化接着遍历
-      if (!right_found_) {
-        std::vector<Value> value;
-        MergeValueFromTuple(value, true);
-        *tuple = Tuple(value, &plan_->OutputSchema());
-
-        right_found_ = false;
-        next_ltuple_existent_ = left_executor_->Next(&left_tuple_, &left_rid_);
-        right_executor_->Init();
-        next_rtuple_existent_ = right_executor_->Next(&right_tuple_, &right_rid_);
-
+      if (match_idx_ < matches.size()) {
+        *tuple = MergeTuples(left, &inner_tuples_[matches[match_idx_++]]);
+        return true;
+      }
+      outer_idx_++;
+      match_idx_ = 0;
+      if (matches.empty() && plan_->GetJoinType() == JoinType::LEFT) {
+        *tuple = MergeTuples(left, nullptr);
         return true;
       }
-      //
-      right_found_ = false;
-      next_ltuple_existent_ = left_executor_->Next(&left_tuple_, &left_rid_);
-      right_executor_->Init();
-      next_rtuple_existent_ = right_executor_->Next(&right_tuple_, &right_rid_);
     }
-  } else if (plan_->GetJoinType() == JoinType::INNER) {
-    while (next_ltuple_existent_) {
-      while (next_rtuple_existent_) {
-        auto pred_value = plan_->Predicate().EvaluateJoin(&left_tuple_, left_executor_->GetOutputSchema(),
-                                                          &right_tuple_, right_executor_->GetOutputSchema());
+    if (!JoinNextOuterBlock()) {
+      return false;
+    }
+  }
+}
 
-        if (!pred_value.GetAs<bool>()) {
-          // GetAs()函数会将value转换成bool值。为true说明两者相匹配 此时将左右两表拼接后输出
-          next_rtuple_existent_ = right_executor_->Next(&right_tuple_, &right_rid_);
-        } else {
-          std::vector<Value> value;
-          MergeValueFromTuple(value, false);
-          *tuple = Tuple(value, &plan_->OutputSchema());
-          next_rtuple_existent_ = right_executor_->Next(&right_tuple_, &right_rid_);
-          return true;
+auto NestedLoopJoinExecutor::JoinNextOuterBlock() -> bool {
+  // Without right tuples, an inner or semi join has nothing to match the left side with.
+  if (inner_tuples_.empty() && (plan_->GetJoinType() == JoinType::INNER || plan_->GetJoinType() == JoinType::SEMI)) {
+    return false;
+  }
+
+  outer_block_.clear();
+  Tuple left_tuple;
+  RID left_rid;
+  while (outer_block_.size() < NLJ_OUTER_BLOCK_SIZE && left_executor_->Next(&left_tuple, &left_rid)) {
+    outer_block_.push_back(std::move(left_tuple));
+  }
+  if (outer_block_.empty()) {
+    return false;
+  }
+  outer_matches_.resize(outer_block_.size());
+  for (auto &matches : outer_matches_) {
+    matches.clear();
+  }
+  outer_idx_ = 0;
+  match_idx_ = 0;
+
+  // Every right block is joined with the whole outer block while it is in cache. Blocks are visited in order, so the
+  // matches of each left tuple are collected in the order of the right side.
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  size_t block_begin = 0;
+  for (auto block_end : inner_block_ends_) {
+    for (size_t i = 0; i < outer_block_.size(); i++) {
+      // A semi or anti join only needs to know whether a left tuple has a match.
+      if (IsSemiOrAnti() && !outer_matches_[i].empty()) {
+        continue;
+      }
+      for (size_t j = block_begin; j < block_end; j++) {
+        auto value = plan_->Predicate().EvaluateJoin(&outer_block_[i], left_schema, &inner_tuples_[j], right_schema);
+        if (!value.IsNull() && value.GetAs<bool>()) {
+          outer_matches_[i].push_back(j);
+          if (IsSemiOrAnti()) {
+            break;
+          }
         }
       }
-      // 循环结束后表明右表遍历完成，此时要让左表指向下一条值,右表迭代器初始化接着遍历
-      next_ltuple_existent_ = left_executor_->Next(&left_tuple_, &left_rid_);
-      right_executor_->Init();
-      next_rtuple_existent_ = right_executor_->Next(&right_tuple_, &right_rid_);
     }
-    return false;
+    block_begin = block_end;
+  }
+  return true;
+}
+
+auto NestedLoopJoinExecutor::MergeTuples(const Tuple &left, const Tuple *right) const -> Tuple {
+  const auto &left_schema = left_executor_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    values.push_back(left.GetValue(&left_schema, i));
+  }
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.push_back(right != nullptr ? right->GetValue(&right_schema, i)
+                                      : ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType()));
   }
-  return false;
+  return Tuple{values, &GetOutputSchema()};
 }
 
 }  // namespace bustub
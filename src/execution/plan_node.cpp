@@ -74,7 +74,8 @@ auto AggregationPlanNode::InferAggSchema(const std::vector<AbstractExpressionRef
   }
   for (size_t idx = 0; idx < aggregates.size(); idx++) {
     // TODO(chi): correctly infer agg call return type
-    output.emplace_back(Column("<unnamed>", TypeId::INTEGER));
+    output.emplace_back(
+        Column("<unnamed>", agg_types[idx] == AggregationType::AvgAggregate ? TypeId::DECIMAL : TypeId::INTEGER));
   }
   return Schema(output);
 }
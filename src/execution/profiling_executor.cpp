@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// profiling_executor.cpp
+//
+// Identification: src/execution/profiling_executor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/profiling_executor.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <utility>
+
+#include "common/stats.h"
+
+namespace bustub {
+
+ProfilingExecutor::ProfilingExecutor(ExecutorContext *exec_ctx, std::unique_ptr<AbstractExecutor> &&child_executor,
+                                     OperatorProfile *profile)
+    : AbstractExecutor(exec_ctx), child_executor_(std::move(child_executor)), profile_(profile) {}
+
+void ProfilingExecutor::Init() {
+  auto start = TakeSnapshot();
+  child_executor_->Init();
+  Record(start, &profile_->init_ns_);
+  profile_->loops_++;
+  // Blocking executors build their hash table or sort their input in Init().
+  RecordMemory();
+}
+
+auto ProfilingExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  auto start = TakeSnapshot();
+  auto produced = child_executor_->Next(tuple, rid);
+  Record(start, &profile_->next_ns_);
+  if (produced) {
+    profile_->rows_out_++;
+  } else {
+    // GetMemoryUsage() may walk everything the executor holds, which is too slow to do for every tuple.
+    RecordMemory();
+  }
+  return produced;
+}
+
+auto ProfilingExecutor::TakeSnapshot() -> Snapshot {
+  const auto &thread_stats = GetThreadStats();
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return {static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+          thread_stats.fetch_hits_, thread_stats.fetch_misses_};
+}
+
+void ProfilingExecutor::Record(const Snapshot &start, uint64_t *ns) {
+  auto end = TakeSnapshot();
+  *ns += end.ns_ - start.ns_;
+  profile_->fetch_hits_ += end.fetch_hits_ - start.fetch_hits_;
+  profile_->fetch_misses_ += end.fetch_misses_ - start.fetch_misses_;
+}
+
+void ProfilingExecutor::RecordMemory() {
+  profile_->peak_memory_ = std::max(profile_->peak_memory_, child_executor_->GetMemoryUsage());
+}
+
+}  // namespace bustub
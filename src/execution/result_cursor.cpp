@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// result_cursor.cpp
+//
+// Identification: src/execution/result_cursor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/result_cursor.h"
+
+#include <utility>
+
+#include "execution/executor_factory.h"
+
+namespace bustub {
+
+ResultCursor::ResultCursor(std::unique_ptr<ExecutorContext> exec_ctx, AbstractPlanNodeRef plan, SchemaRef schema,
+                           size_t batch_size)
+    : exec_ctx_(std::move(exec_ctx)), plan_(std::move(plan)), schema_(std::move(schema)), batch_size_(batch_size) {
+  executor_ = ExecutorFactory::CreateExecutor(exec_ctx_.get(), plan_);
+}
+
+auto ResultCursor::Next(std::vector<Tuple> *batch) -> bool {
+  batch->clear();
+  if (is_exhausted_) {
+    return false;
+  }
+  if (!is_initialized_) {
+    executor_->Init();
+    is_initialized_ = true;
+  }
+
+  RID rid{};
+  Tuple tuple{};
+  while (batch->size() < batch_size_) {
+    if (!executor_->Next(&tuple, &rid)) {
+      is_exhausted_ = true;
+      break;
+    }
+    batch->push_back(std::move(tuple));
+  }
+  return !batch->empty();
+}
+
+}  // namespace bustub
@@ -12,6 +12,7 @@
 
 #include "execution/executors/seq_scan_executor.h"
 #include "concurrency/transaction.h"
+#include "storage/table/tuple_view.h"
 
 namespace bustub {
 
@@ -19,27 +20,43 @@ SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNod
     : AbstractExecutor(exec_ctx),
       plan_(plan),
       filter_predicate_(plan->filter_predicate_),
-      end_(exec_ctx->GetCatalog()->GetTable(plan->table_oid_)->table_->End()),
-      iterator_(end_) {}
+      table_heap_(exec_ctx->GetCatalog()->GetTable(plan->table_oid_)->table_.get()) {}
 
 void SeqScanExecutor::Init() {
-  auto txn = exec_ctx_->GetTransaction();
   // if ((txn->GetIsolationLevel() == IsolationLevel::REPEATABLE_READ ||
   //     txn->GetIsolationLevel() == IsolationLevel::READ_COMMITTED)) {
   // }
-  iterator_ = exec_ctx_->GetCatalog()->GetTable(plan_->table_oid_)->table_->Begin(txn);
+  page_id_ = table_heap_->GetFirstPageId();
+  rid_ = RID{};
   // table_name_ = exec_ctx_->GetCatalog()->GetTable(plan_->table_oid_)->name_;
 }
 
 auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   // auto txn = exec_ctx_->GetTransaction();
   // auto oid = plan_->GetTableOid();
-  if (iterator_ == end_) {
-    return false;
+  // Tuples are read in place, and only those that pass the filter are copied out of the page.
+  while (page_id_ != INVALID_PAGE_ID) {
+    TupleView view(exec_ctx_->GetBufferPoolManager(), page_id_);
+    BUSTUB_ENSURE(view.IsValid(), "BPM full");
+    // Resume after the last tuple produced from this page.
+    bool found = rid_.GetPageId() == page_id_ ? view.SeekAfter(rid_) : view.SeekFirst();
+    for (; found; found = view.SeekAfter(rid_)) {
+      rid_ = view.GetRid();
+      if (filter_predicate_ != nullptr) {
+        auto value = filter_predicate_->Evaluate(&view.GetTuple(), GetOutputSchema());
+        if (value.IsNull() || !value.GetAs<bool>()) {
+          continue;
+        }
+      }
+      if (runtime_filter_ && !runtime_filter_(view.GetTuple())) {
+        continue;
+      }
+      *tuple = view.Materialize();
+      *rid = rid_;
+      return true;
+    }
+    page_id_ = view.GetNextPageId();
   }
-
-  *rid = iterator_->GetRid();
-  *tuple = *iterator_++;
-  return true;
+  return false;
 }
 }  // namespace bustub
@@ -31,6 +31,15 @@ void SortExecutor::Init() {
       auto left_value = expr->Evaluate(&lhs, orderby_schema);
       auto right_value = expr->Evaluate(&rhs, orderby_schema);
 
+      // NULLs compare with nothing. They sort first in ascending order, as in a B+ tree, so that the output stays
+      // sorted for merge joins.
+      if (left_value.IsNull() || right_value.IsNull()) {
+        if (left_value.IsNull() && right_value.IsNull()) {
+          continue;
+        }
+        bool less = left_value.IsNull();
+        return order_type == OrderByType::DESC ? less : !less;
+      }
       if (left_value.CompareEquals(right_value) == CmpBool::CmpTrue) {
         continue;
       }
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// stream_aggregation_executor.cpp
+//
+// Identification: src/execution/stream_aggregation_executor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/stream_aggregation_executor.h"
+
+namespace bustub {
+
+StreamAggregationExecutor::StreamAggregationExecutor(ExecutorContext *exec_ctx, const StreamAggregationPlanNode *plan,
+                                                     std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_(std::move(child)),
+      combiner_(plan->GetAggregateTypes(), plan->GetDistinct()) {}
+
+void StreamAggregationExecutor::Init() {
+  child_->Init();
+  group_key_ = {};
+  group_value_ = {};
+  has_group_ = false;
+  has_output_ = false;
+}
+
+auto StreamAggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  const auto &child_schema = child_->GetOutputSchema();
+  Tuple child_tuple{};
+  RID child_rid{};
+  while (child_->Next(&child_tuple, &child_rid)) {
+    AggregateKey key;
+    for (const auto &expr : plan_->GetGroupBys()) {
+      key.group_bys_.emplace_back(expr->Evaluate(&child_tuple, child_schema));
+    }
+    AggregateValue input;
+    for (const auto &expr : plan_->GetAggregates()) {
+      input.aggregates_.emplace_back(expr->Evaluate(&child_tuple, child_schema));
+    }
+
+    bool group_ends = has_group_ && !(key == group_key_);
+    if (group_ends) {
+      *tuple = MakeOutputTuple();
+    }
+    if (!has_group_ || group_ends) {
+      group_key_ = std::move(key);
+      group_value_ = combiner_.GenerateInitialAggregateValue();
+      has_group_ = true;
+    }
+    combiner_.CombineAggregateValues(&group_value_, input);
+    if (group_ends) {
+      has_output_ = true;
+      return true;
+    }
+  }
+
+  if (has_group_) {
+    *tuple = MakeOutputTuple();
+    has_group_ = false;
+    has_output_ = true;
+    return true;
+  }
+  // Without groups, an empty child is aggregated into a single row of initial values.
+  if (!has_output_ && plan_->GetGroupBys().empty()) {
+    group_value_ = combiner_.GenerateInitialAggregateValue();
+    *tuple = MakeOutputTuple();
+    has_output_ = true;
+    return true;
+  }
+  return false;
+}
+
+auto StreamAggregationExecutor::MakeOutputTuple() const -> Tuple {
+  auto aggregates = combiner_.FinalizeAggregateValue(group_value_);
+  std::vector<Value> values;
+  values.reserve(group_key_.group_bys_.size() + aggregates.size());
+  values.insert(values.end(), group_key_.group_bys_.begin(), group_key_.group_bys_.end());
+  values.insert(values.end(), aggregates.begin(), aggregates.end());
+  return Tuple{values, &GetOutputSchema()};
+}
+
+}  // namespace bustub
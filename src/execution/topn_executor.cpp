@@ -1,59 +1,45 @@
 #include "execution/executors/topn_executor.h"
+#include <algorithm>
 #include <utility>
 
 namespace bustub {
 
 TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
+  // The child sees the heap as it fills up, so the filter gets stricter as the scan goes on.
+  child_executor_->PushDownRuntimeFilter([this](const Tuple &tuple) { return MayEnter(MakeSortKeys(tuple)); });
+}
 
 void TopNExecutor::Init() {
   child_executor_->Init();
 
+  heap_.clear();
   sorted_tuple_.clear();
 
-  auto orderby_schema = GetOutputSchema();
-  // lambda表达式接受两个tuple，用来比较
-  // 比较时要用到对应的orderby字段，可以从plan中AbstractExpressionRef获取
-  // 同时这个表达式可以提供evalute函数，针对当前模式，输出用来比较的字段
-  // 排序字段可以有多个，按先后顺序比较。第一个不相等，直接得到结果；相等，则比较第二个。不会出现所有字段全部相等的情况。
-  auto cmp = [&](Tuple &lhs, Tuple &rhs) -> bool {
-    for (const auto &[order_type, expr] : plan_->GetOrderBy()) {
-      auto left_value = expr->Evaluate(&lhs, orderby_schema);
-      auto right_value = expr->Evaluate(&rhs, orderby_schema);
-
-      if (left_value.CompareEquals(right_value) == CmpBool::CmpTrue) {
-        continue;
-      }
-      // 返回false时不改变原来顺序 返回true时与原来顺序相反
-      // 对于升序，要求lhs<rhs。当lessthan，则返回false
-      // 对于降序，则相反
-      if (order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT) {
-        return left_value.CompareLessThan(right_value) == CmpBool::CmpTrue;
-      }
-      BUSTUB_ASSERT(order_type == OrderByType::DESC, "一定是降序，不应该为无效的排序方式");
-      return left_value.CompareLessThan(right_value) != CmpBool::CmpTrue;
-    }
-    // 正常的话不会命中这个return
-    return false;
-  };
-
-  std::priority_queue<Tuple, std::vector<Tuple>, decltype(cmp)> pq(cmp);
+  auto cmp = [this](const Entry &lhs, const Entry &rhs) { return Before(lhs.keys_, rhs.keys_); };
   Tuple tuple{};
   RID rid{};
   while (child_executor_->Next(&tuple, &rid)) {
-    // 将tuple加入队列，大根堆会自动排序
-    pq.push(tuple);
-    // 当队列个数大于要输出的N时，将末尾元素弹出
-    if (pq.size() > plan_->GetN()) {
-      pq.pop();
+    auto keys = MakeSortKeys(tuple);
+    if (!MayEnter(keys)) {
+      continue;
+    }
+    heap_.push_back({std::move(keys), tuple});
+    std::push_heap(heap_.begin(), heap_.end(), cmp);
+    // 当堆中个数大于要输出的N时，将排在最后的元素弹出
+    if (heap_.size() > plan_->GetN()) {
+      std::pop_heap(heap_.begin(), heap_.end(), cmp);
+      heap_.pop_back();
     }
   }
 
-  while (!pq.empty()) {
-    sorted_tuple_.push_back(pq.top());
-    pq.pop();
+  // Next() pops from the back, so the last tuple in the order goes first.
+  std::sort_heap(heap_.begin(), heap_.end(), cmp);
+  for (auto it = heap_.rbegin(); it != heap_.rend(); ++it) {
+    sorted_tuple_.push_back(std::move(it->tuple_));
   }
+  heap_.clear();
 }
 
 auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
@@ -65,4 +51,42 @@ auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   return true;
 }
 
+auto TopNExecutor::MakeSortKeys(const Tuple &tuple) const -> std::vector<Value> {
+  std::vector<Value> keys;
+  keys.reserve(plan_->GetOrderBy().size());
+  for (const auto &[order_type, expr] : plan_->GetOrderBy()) {
+    keys.push_back(expr->Evaluate(&tuple, GetOutputSchema()));
+  }
+  return keys;
+}
+
+auto TopNExecutor::Before(const std::vector<Value> &keys, const std::vector<Value> &other) const -> bool {
+  // 排序字段可以有多个，按先后顺序比较。
+  // 第一个不相等，直接得到结果；相等，则比较第二个。
+  for (size_t i = 0; i < keys.size(); i++) {
+    const auto &left_value = keys[i];
+    const auto &right_value = other[i];
+    bool desc = plan_->GetOrderBy()[i].first == OrderByType::DESC;
+    if (left_value.IsNull() || right_value.IsNull()) {
+      if (left_value.IsNull() && right_value.IsNull()) {
+        continue;
+      }
+      return left_value.IsNull() != desc;
+    }
+    if (left_value.CompareEquals(right_value) == CmpBool::CmpTrue) {
+      continue;
+    }
+    return (left_value.CompareLessThan(right_value) == CmpBool::CmpTrue) != desc;
+  }
+  return false;
+}
+
+auto TopNExecutor::MayEnter(const std::vector<Value> &keys) const -> bool {
+  if (heap_.size() < plan_->GetN()) {
+    return true;
+  }
+  // A tuple that ties with the last one kept would be dropped again right away.
+  return !heap_.empty() && Before(keys, heap_.front().keys_);
+}
+
 }  // namespace bustub
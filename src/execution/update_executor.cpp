@@ -9,20 +9,187 @@
 // Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
+#include "common/exception.h"
 #include "execution/executors/update_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "fmt/format.h"
+#include "storage/index/generic_key.h"
 
 namespace bustub {
 
 UpdateExecutor::UpdateExecutor(ExecutorContext *exec_ctx, const UpdatePlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
-  // As of Fall 2022, you DON'T need to implement update executor to have perfect score in project 3 / project 4.
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void UpdateExecutor::Init() {
+  child_executor_->Init();
+  update_result_ = false;
+  auto *catalog = exec_ctx_->GetCatalog();
+  table_info_ = catalog->GetTable(plan_->TableOid());
+
+  // A column is left alone when its target expression is the column itself, as the planner makes it for the columns
+  // missing from the SET clause.
+  auto is_unchanged = [this](uint32_t col_idx) {
+    const auto *column = dynamic_cast<const ColumnValueExpression *>(plan_->target_expressions_[col_idx].get());
+    return column != nullptr && column->GetTupleIdx() == 0 && column->GetColIdx() == col_idx;
+  };
+  changed_indexes_.clear();
+  for (auto *index_info : catalog->GetTableIndexes(table_info_->name_)) {
+    const auto &key_attrs = index_info->index_->GetKeyAttrs();
+    if (!std::all_of(key_attrs.begin(), key_attrs.end(), is_unchanged)) {
+      changed_indexes_.push_back(index_info);
+    }
+  }
 }
 
-void UpdateExecutor::Init() { throw NotImplementedException("UpdateExecutor is not implemented"); }
+auto UpdateExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
+  if (update_result_) {
+    return false;
+  }
+  auto *txn = exec_ctx_->GetTransaction();
+  auto *table = table_info_->table_.get();
+
+  std::vector<IndexChange> in_place;
+  std::vector<IndexChange> moved;
+  int count = 0;
+  Tuple old_tuple;
+  RID old_rid;
+  while (child_executor_->Next(&old_tuple, &old_rid)) {
+    auto new_tuple = UpdatedTuple(old_tuple);
+    const auto &columns = table_info_->schema_.GetColumns();
+    for (uint32_t i = 0; i < columns.size(); i++) {
+      if (!columns[i].IsNullable() && new_tuple.IsNull(&table_info_->schema_, i)) {
+        throw ExecutionException(
+            fmt::format("column {} of table {} is NOT NULL", columns[i].GetName(), table_info_->name_));
+      }
+    }
+    // The index keys are checked before the table is written, so that a key that does not fit cannot leave the
+    // table changed and the index not.
+    for (const auto *index_info : changed_indexes_) {
+      const auto &key_schema = index_info->key_schema_;
+      auto key = new_tuple.KeyFromTuple(table_info_->schema_, key_schema, index_info->index_->GetKeyAttrs());
+      if (!KeyFits(key, key_schema, index_info->key_size_)) {
+        throw ExecutionException(
+            fmt::format("index key of {} bytes does not fit in index {}", key.GetLength(), index_info->name_));
+      }
+    }
+    // A tuple that shrank in place would free space a later insert can take, leaving the page no room to put the old
+    // tuple back on abort. It moves instead, like a tuple that grew out of its page.
+    if (new_tuple.GetLength() >= old_tuple.GetLength() && table->UpdateTuple(new_tuple, old_rid, txn)) {
+      if (!changed_indexes_.empty()) {
+        in_place.push_back({old_tuple, old_rid, std::move(new_tuple), old_rid});
+      }
+    } else if (txn->GetState() != TransactionState::ABORTED && table->MarkDelete(old_rid, txn)) {
+      // The new tuple is smaller than the old one, or does not fit in its page.
+      moved.push_back({old_tuple, old_rid, std::move(new_tuple), RID{}});
+    } else {
+      continue;
+    }
+    count++;
+  }
+
+  for (auto &change : moved) {
+    if (!table->InsertTuple(change.new_tuple_, &change.new_rid_, txn)) {
+      throw ExecutionException("updated tuple is too large");
+    }
+  }
+  ApplyIndexChanges(in_place, moved);
+  for (const auto *changes : {&in_place, &moved}) {
+    for (const auto &change : *changes) {
+      table_info_->RecordDelete(change.old_tuple_);
+      table_info_->RecordInsert(change.new_tuple_);
+    }
+  }
+
+  std::vector<Value> values;
+  values.emplace_back(INTEGER, count);
+  *tuple = Tuple(values, &GetOutputSchema());
+  update_result_ = true;
+  return true;
+}
 
-auto UpdateExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool { return false; }
+auto UpdateExecutor::UpdatedTuple(const Tuple &old_tuple) const -> Tuple {
+  const auto &schema = table_info_->schema_;
+  std::vector<Value> values;
+  values.reserve(schema.GetColumnCount());
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    auto value = plan_->target_expressions_[i]->Evaluate(&old_tuple, child_executor_->GetOutputSchema());
+    auto type = schema.GetColumn(i).GetType();
+    if (value.IsNull()) {
+      values.push_back(ValueFactory::GetNullValueByType(type));
+    } else {
+      values.push_back(value.GetTypeId() == type ? std::move(value) : value.CastAs(type));
+    }
+  }
+  return Tuple{values, &schema};
+}
+
+void UpdateExecutor::ApplyIndexChanges(const std::vector<IndexChange> &in_place,
+                                       const std::vector<IndexChange> &moved) {
+  if (in_place.empty() && moved.empty()) {
+    return;
+  }
+  auto *txn = exec_ctx_->GetTransaction();
+  auto *catalog = exec_ctx_->GetCatalog();
+  for (auto *index_info : catalog->GetTableIndexes(table_info_->name_)) {
+    // A tuple updated in place keeps its RID, so only the indexes on a changed column need it.
+    bool is_changed = std::find(changed_indexes_.begin(), changed_indexes_.end(), index_info) != changed_indexes_.end();
+    if (!is_changed && moved.empty()) {
+      continue;
+    }
+    auto key_of = [&](const Tuple &tuple) {
+      return tuple.KeyFromTuple(table_info_->schema_, index_info->key_schema_, index_info->index_->GetKeyAttrs());
+    };
+
+    std::vector<std::pair<Tuple, Tuple>> in_place_keys;
+    std::vector<const IndexChange *> in_place_changes;
+    if (is_changed) {
+      for (const auto &change : in_place) {
+        auto old_key = key_of(change.old_tuple_);
+        auto new_key = key_of(change.new_tuple_);
+        if (old_key.GetLength() == new_key.GetLength() &&
+            memcmp(old_key.GetData(), new_key.GetData(), old_key.GetLength()) == 0) {
+          continue;
+        }
+        in_place_keys.emplace_back(std::move(old_key), std::move(new_key));
+        in_place_changes.push_back(&change);
+      }
+    }
+
+    // All the old keys go before any new key comes in, so that keys swapped between rows never meet. Each change is
+    // recorded as soon as it is made: Abort undoes the records from the back, so it likewise takes out every new key
+    // before putting an old one back, and a duplicate key found halfway leaves nothing it cannot undo.
+    auto *index_write_set = txn->GetIndexWriteSet().get();
+    auto remove = [&](const Tuple &key, const IndexChange &change) {
+      index_info->index_->DeleteEntry(key, change.old_rid_, txn);
+      index_write_set->emplace_back(change.old_rid_, table_info_->oid_, WType::DELETE, change.old_tuple_,
+                                    index_info->index_oid_, catalog);
+    };
+    auto add = [&](const Tuple &key, const IndexChange &change) {
+      if (!index_info->index_->InsertEntry(key, change.new_rid_, txn)) {
+        txn->SetState(TransactionState::ABORTED);
+        throw ExecutionException(fmt::format("duplicate key in index {}", index_info->name_));
+      }
+      index_write_set->emplace_back(change.new_rid_, table_info_->oid_, WType::INSERT, change.new_tuple_,
+                                    index_info->index_oid_, catalog);
+    };
+    for (size_t i = 0; i < in_place_keys.size(); i++) {
+      remove(in_place_keys[i].first, *in_place_changes[i]);
+    }
+    for (const auto &change : moved) {
+      remove(key_of(change.old_tuple_), change);
+    }
+    for (size_t i = 0; i < in_place_keys.size(); i++) {
+      add(in_place_keys[i].second, *in_place_changes[i]);
+    }
+    for (const auto &change : moved) {
+      add(key_of(change.new_tuple_), change);
+    }
+  }
+}
 
 }  // namespace bustub
@@ -21,6 +21,8 @@ enum class ExpressionType : uint8_t {
   UNARY_OP = 8,   /**< Unary expression type. */
   BINARY_OP = 9,  /**< Binary expression type. */
   ALIAS = 10,     /**< Alias expression type. */
+  PARAMETER = 11, /**< Parameter placeholder of a prepared statement, e.g., `$1`. */
+  SUBQUERY = 12,  /**< A subquery in an expression, e.g., `EXISTS (SELECT ...)`. */
 };
 
 /**
@@ -98,6 +100,12 @@ struct fmt::formatter<bustub::ExpressionType> : formatter<string_view> {
       case bustub::ExpressionType::ALIAS:
         name = "Alias";
         break;
+      case bustub::ExpressionType::PARAMETER:
+        name = "Parameter";
+        break;
+      case bustub::ExpressionType::SUBQUERY:
+        name = "Subquery";
+        break;
     }
     return formatter<string_view>::format(name, ctx);
   }
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+#include "binder/bound_expression.h"
+#include "fmt/format.h"
+#include "type/type_id.h"
+
+namespace bustub {
+
+/**
+ * A parameter placeholder of a prepared statement, e.g., `$1`.
+ */
+class BoundParameter : public BoundExpression {
+ public:
+  BoundParameter(uint32_t param_idx, TypeId type_id)
+      : BoundExpression(ExpressionType::PARAMETER), param_idx_(param_idx), type_id_(type_id) {}
+
+  auto ToString() const -> std::string override { return fmt::format("${}", param_idx_ + 1); }
+
+  auto HasAggregation() const -> bool override { return false; }
+
+  /** The position of the parameter, starting from 0 for `$1`. */
+  uint32_t param_idx_;
+
+  /** The type the parameter was declared with. */
+  TypeId type_id_;
+};
+}  // namespace bustub
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "binder/bound_expression.h"
+#include "binder/statement/select_statement.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/** The kinds of subqueries an expression can hold. */
+enum class SubqueryType : uint8_t {
+  INVALID = 0, /**< Invalid subquery type. */
+  EXISTS = 1,  /**< `EXISTS (SELECT ...)` */
+  ANY = 2,     /**< `x IN (SELECT ...)`, or `x = ANY (SELECT ...)` */
+};
+
+/**
+ * A subquery used as a predicate, e.g., `EXISTS (SELECT ...)` or `x IN (SELECT ...)`. Its WHERE clause may refer to
+ * the columns of the enclosing query, which makes it correlated.
+ */
+class BoundSubqueryExpr : public BoundExpression {
+ public:
+  BoundSubqueryExpr(SubqueryType subquery_type, std::unique_ptr<SelectStatement> subquery,
+                    std::unique_ptr<BoundExpression> child)
+      : BoundExpression(ExpressionType::SUBQUERY),
+        subquery_type_(subquery_type),
+        subquery_(std::move(subquery)),
+        child_(std::move(child)) {}
+
+  auto ToString() const -> std::string override;
+
+  auto HasAggregation() const -> bool override { return false; }
+
+  /** The kind of subquery. */
+  SubqueryType subquery_type_;
+
+  /** The subquery. */
+  std::unique_ptr<SelectStatement> subquery_;
+
+  /** For ANY, the expression compared with the rows of the subquery. Otherwise nullptr. */
+  std::unique_ptr<BoundExpression> child_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,26 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/analyze_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "binder/bound_statement.h"
+
+namespace bustub {
+
+class AnalyzeStatement : public BoundStatement {
+ public:
+  explicit AnalyzeStatement(std::string table);
+
+  /** Name of the table to analyze. Empty to analyze every table whose statistics are missing or stale. */
+  std::string table_;
+
+  auto ToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/prepare_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "binder/bound_statement.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class PrepareStatement : public BoundStatement {
+ public:
+  explicit PrepareStatement(std::string name, std::unique_ptr<BoundStatement> statement,
+                            std::vector<TypeId> param_types);
+
+  /** Name of the prepared statement. */
+  std::string name_;
+
+  /** The statement to prepare, in which the parameters are bound to `BoundParameter`s. */
+  std::unique_ptr<BoundStatement> statement_;
+
+  /** Types of the parameters, by position. Parameters without a declared type are integers. */
+  std::vector<TypeId> param_types_;
+
+  auto ToString() const -> std::string override;
+};
+
+class ExecuteStatement : public BoundStatement {
+ public:
+  explicit ExecuteStatement(std::string name, std::vector<Value> params);
+
+  /** Name of the prepared statement to execute. */
+  std::string name_;
+
+  /** Values of the parameters, not yet cast to the declared types. */
+  std::vector<Value> params_;
+
+  auto ToString() const -> std::string override;
+};
+
+class DeallocateStatement : public BoundStatement {
+ public:
+  explicit DeallocateStatement(std::string name);
+
+  /** Name of the prepared statement to remove. Empty to remove all of them. */
+  std::string name_;
+
+  auto ToString() const -> std::string override;
+};
+
+}  // namespace bustub
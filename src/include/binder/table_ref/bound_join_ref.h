@@ -18,7 +18,9 @@ enum class JoinType : uint8_t {
   LEFT = 1,    /**< Left join. */
   RIGHT = 3,   /**< Right join. */
   INNER = 4,   /**< Inner join. */
-  OUTER = 5    /**< Outer join. */
+  OUTER = 5,   /**< Outer join. */
+  SEMI = 6,    /**< Semi join: the left tuples with a match, as `EXISTS` and `IN` keep them. */
+  ANTI = 7     /**< Anti join: the left tuples without a match, as `NOT EXISTS` and `NOT IN` keep them. */
 };
 
 /**
@@ -74,6 +76,12 @@ struct fmt::formatter<bustub::JoinType> : formatter<string_view> {
       case bustub::JoinType::OUTER:
         name = "Outer";
         break;
+      case bustub::JoinType::SEMI:
+        name = "Semi";
+        break;
+      case bustub::JoinType::ANTI:
+        name = "Anti";
+        break;
       default:
         name = "Unknown";
         break;
@@ -20,6 +20,7 @@
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
 #include "storage/page/page.h"
+#include "storage/page/page_guard.h"
 
 namespace bustub {
 
@@ -84,6 +85,46 @@ class BufferPoolManager {
     GradingCallback(callback, CallbackType::AFTER, INVALID_PAGE_ID);
   }
 
+  /**
+   * Fetch a page and keep it pinned for as long as the returned guard lives.
+   * @param page_id id of page to be fetched
+   * @return the guard, which is empty if the page could not be fetched
+   */
+  auto FetchPageBasic(page_id_t page_id) -> BasicPageGuard { return {this, FetchPage(page_id)}; }
+
+  /**
+   * Fetch a page and keep it pinned and read-latched for as long as the returned guard lives.
+   * @param page_id id of page to be fetched
+   * @return the guard, which is empty if the page could not be fetched
+   */
+  auto FetchPageRead(page_id_t page_id) -> ReadPageGuard {
+    auto *page = FetchPage(page_id);
+    if (page != nullptr) {
+      page->RLatch();
+    }
+    return {this, page};
+  }
+
+  /**
+   * Fetch a page and keep it pinned and write-latched for as long as the returned guard lives.
+   * @param page_id id of page to be fetched
+   * @return the guard, which is empty if the page could not be fetched
+   */
+  auto FetchPageWrite(page_id_t page_id) -> WritePageGuard {
+    auto *page = FetchPage(page_id);
+    if (page != nullptr) {
+      page->WLatch();
+    }
+    return {this, page};
+  }
+
+  /**
+   * Create a new page and keep it pinned for as long as the returned guard lives.
+   * @param[out] page_id id of created page
+   * @return the guard, which is empty if no new page could be created
+   */
+  auto NewPageGuarded(page_id_t *page_id) -> BasicPageGuard { return {this, NewPage(page_id)}; }
+
   /** @return size of the buffer pool */
   virtual auto GetPoolSize() -> size_t = 0;
 
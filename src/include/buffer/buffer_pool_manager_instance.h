@@ -15,10 +15,13 @@
 #include <list>
 #include <mutex>  // NOLINT
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "buffer/lru_k_replacer.h"
 #include "common/config.h"
+#include "common/stats.h"
 #include "container/hash/extendible_hash_table.h"
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
@@ -26,6 +29,43 @@
 
 namespace bustub {
 
+/**
+ * BufferPoolStats counts what happens on the fetch path of a BufferPoolManagerInstance. Evictions are counted by the
+ * replacer, and page reads and writes by the disk manager.
+ */
+struct BufferPoolStats {
+  /** fetches of a page that was already in the pool */
+  StatCounter fetch_hits_;
+  /** fetches that had to read the page from disk */
+  StatCounter fetch_misses_;
+  /** fetches and new pages that failed because every frame was pinned */
+  StatCounter no_free_frame_;
+  StatCounter new_pages_;
+  StatCounter deleted_pages_;
+  /** dirty victims written back to make room for another page */
+  StatCounter dirty_writebacks_;
+  /** pages written by FlushPage() and FlushAllPages() */
+  StatCounter flushes_;
+  /** acquisitions of the pool latch that had to wait, and how long they waited */
+  StatCounter latch_contentions_;
+  StatHistogram latch_wait_ns_;
+};
+
+/**
+ * PageResidency is a snapshot of what the frames of a buffer pool hold.
+ */
+struct PageResidency {
+  size_t free_{0};
+  size_t header_{0};
+  size_t table_{0};
+  size_t index_internal_{0};
+  size_t index_leaf_{0};
+  /** pages of any other layout, e.g. hash tables, or pages that were never written */
+  size_t other_{0};
+  size_t pinned_{0};
+  size_t dirty_{0};
+};
+
 /**
  * BufferPoolManager reads disk pages to and from its internal buffer pool.
  */
@@ -52,6 +92,21 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   /** @brief Return the pointer to all the pages in the buffer pool. */
   auto GetPages() -> Page * { return pages_; }
 
+  /**
+   * @brief Return the pages that are currently pinned, with their pin counts. Once every user of the buffer pool is
+   * done, any page left here has leaked a pin. The destructor reports them.
+   */
+  auto GetPinnedPages() -> std::vector<std::pair<page_id_t, int>>;
+
+  /** @return the fetch path statistics of this buffer pool */
+  auto GetStats() -> BufferPoolStats & { return stats_; }
+
+  /** @return the eviction statistics of the replacer of this buffer pool */
+  auto GetReplacerStats() -> ReplacerStats & { return replacer_->GetStats(); }
+
+  /** @return what kind of pages the frames hold right now */
+  auto GetResidency() -> PageResidency;
+
  protected:
   /**
    * TODO(P1): Add implementation
@@ -174,6 +229,11 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   std::list<frame_id_t> free_list_;
   /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
   std::mutex latch_;
+  /** Fetch path statistics. */
+  BufferPoolStats stats_;
+
+  /** @brief Lock latch_. Only an acquisition that has to wait is timed, so the uncontended path stays cheap. */
+  auto AcquireLatch() -> std::unique_lock<std::mutex>;
 
   /**
    * @brief Allocate a page on disk. Caller should acquire the latch before calling this function.
@@ -202,9 +202,19 @@
 
 #include "common/config.h"
 #include "common/macros.h"
+#include "common/stats.h"
 
 namespace bustub {
 
+/**
+ * ReplacerStats counts the victims an LRUKReplacer picked, and how many candidates it had to look at to find them.
+ */
+struct ReplacerStats {
+  StatCounter evictions_;
+  StatCounter failed_evictions_;
+  StatHistogram evict_scan_length_;
+};
+
 /**
  * LRUKReplacer implements the LRU-k replacement policy.
  *
@@ -320,6 +330,9 @@ class LRUKReplacer {
 
   auto GetFrame(frame_id_t frame_id) -> bool;
 
+  /** @return the eviction statistics of this replacer */
+  auto GetStats() -> ReplacerStats & { return stats_; }
+
   // auto CmpTimestamp(const LRUKReplacer::k_time &f1, const LRUKReplacer::k_time &f2) -> bool;
 
  private:
@@ -345,6 +358,8 @@ class LRUKReplacer {
   std::unordered_map<frame_id_t, std::list<k_time>::iterator> cache_locate_;
   static auto CmpTimestamp(const k_time &f1, const k_time &f2) -> bool;
 
+  ReplacerStats stats_;
+
   // // map是非线程安全的
   // std::unordered_map<frame_id_t, size_t> access_frequence_count_;//用于记录访问频度
   // std::unordered_map<frame_id_t, bool> is_evictable_;//用于记录是否可驱逐
@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -20,6 +22,7 @@
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
+#include "catalog/table_stats.h"
 #include "container/hash/hash_function.h"
 #include "storage/index/b_plus_tree_index.h"
 #include "storage/index/extendible_hash_table_index.h"
@@ -56,8 +59,30 @@ struct TableInfo {
   std::unique_ptr<TableHeap> table_;
   /** The table OID */
   const table_oid_t oid_;
+  /** The statistics collected by ANALYZE, null until the table is analyzed. Guarded by stats_latch_. */
+  std::unique_ptr<TableStats> stats_;
+  std::mutex stats_latch_;
+
+  /** Account for a tuple inserted into the table in its statistics, if it has any. */
+  void RecordInsert(const Tuple &tuple) {
+    std::scoped_lock lock(stats_latch_);
+    if (stats_ != nullptr) {
+      stats_->RecordInsert(tuple, schema_);
+    }
+  }
+
+  /** Account for a tuple deleted from the table in its statistics, if it has any. */
+  void RecordDelete(const Tuple &tuple) {
+    std::scoped_lock lock(stats_latch_);
+    if (stats_ != nullptr) {
+      stats_->RecordDelete(tuple, schema_);
+    }
+  }
 };
 
+/** The kinds of index the catalog can build. */
+enum class IndexType { BPlusTreeIndex, HashTableIndex };
+
 /**
  * The IndexInfo class maintains metadata about a index.
  */
@@ -70,15 +95,17 @@ struct IndexInfo {
    * @param index_oid The unique OID for the index
    * @param table_name The name of the table on which the index is created
    * @param key_size The size of the index key, in bytes
+   * @param index_type The kind of the index
    */
   IndexInfo(Schema key_schema, std::string name, std::unique_ptr<Index> &&index, index_oid_t index_oid,
-            std::string table_name, size_t key_size)
+            std::string table_name, size_t key_size, IndexType index_type = IndexType::BPlusTreeIndex)
       : key_schema_{std::move(key_schema)},
         name_{std::move(name)},
         index_{std::move(index)},
         index_oid_{index_oid},
         table_name_{std::move(table_name)},
-        key_size_{key_size} {}
+        key_size_{key_size},
+        index_type_{index_type} {}
   /** The schema for the index key */
   Schema key_schema_;
   /** The name of the index */
@@ -91,12 +118,16 @@ struct IndexInfo {
   std::string table_name_;
   /** The size of the index key, in bytes */
   const size_t key_size_;
+  /** The kind of the index. Only a B+ tree index can be scanned in key order, a hash index serves point lookups. */
+  const IndexType index_type_;
 };
 
 /**
- * The Catalog is a non-persistent catalog that is designed for
- * use by executors within the DBMS execution engine. It handles
- * table creation, table lookup, index creation, and index lookup.
+ * The Catalog is designed for use by executors within the DBMS
+ * execution engine. It handles table creation, table lookup, index
+ * creation, and index lookup. A database file keeps its catalog in
+ * catalog pages: Save() writes them at shutdown and Load() reads them
+ * back when the file is reopened.
  */
 class Catalog {
  public:
@@ -150,6 +181,7 @@ class Catalog {
     tables_.emplace(table_oid, std::move(meta));
     table_names_.emplace(table_name, table_oid);
     index_names_.emplace(table_name, std::unordered_map<std::string, index_oid_t>{});
+    version_.fetch_add(1);
 
     return tmp;
   }
@@ -196,12 +228,14 @@ class Catalog {
    * @param key_attrs Key attributes
    * @param keysize Size of the key
    * @param hash_function The hash function for the index
+   * @param index_type The kind of index to build
    * @return A (non-owning) pointer to the metadata of the new table
    */
   template <class KeyType, class ValueType, class KeyComparator>
   auto CreateIndex(Transaction *txn, const std::string &index_name, const std::string &table_name, const Schema &schema,
                    const Schema &key_schema, const std::vector<uint32_t> &key_attrs, std::size_t keysize,
-                   HashFunction<KeyType> hash_function) -> IndexInfo * {
+                   HashFunction<KeyType> hash_function, IndexType index_type = IndexType::BPlusTreeIndex)
+      -> IndexInfo * {
     // Reject the creation request for nonexistent table
     if (table_names_.find(table_name) == table_names_.end()) {
       return NULL_INDEX_INFO;
@@ -221,12 +255,13 @@ class Catalog {
     auto meta = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs);
 
     // Construct the index, take ownership of metadata
-    // TODO(Kyle): We should update the API for CreateIndex
-    // to allow specification of the index type itself, not
-    // just the key, value, and comparator types
-
-    // TODO(chi): support both hash index and btree index
-    auto index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_);
+    std::unique_ptr<Index> index;
+    if (index_type == IndexType::HashTableIndex) {
+      index = std::make_unique<ExtendibleHashTableIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
+                                                                                           hash_function);
+    } else {
+      index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_);
+    }
 
     // Populate the index with all tuples in table heap
     auto *table_meta = GetTable(table_name);
@@ -239,13 +274,14 @@ class Catalog {
     const auto index_oid = next_index_oid_.fetch_add(1);
 
     // Construct index information; IndexInfo takes ownership of the Index itself
-    auto index_info =
-        std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name, keysize);
+    auto index_info = std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name,
+                                                  keysize, index_type);
     auto *tmp = index_info.get();
 
     // Update internal tracking
     indexes_.emplace(index_oid, std::move(index_info));
     table_indexes.emplace(index_name, index_oid);
+    version_.fetch_add(1);
 
     return tmp;
   }
@@ -298,7 +334,7 @@ class Catalog {
    * @param index_oid The OID of the index for which to query
    * @return A (non-owning) pointer to the metadata for the index
    */
-  auto GetIndex(index_oid_t index_oid) -> IndexInfo * {
+  auto GetIndex(index_oid_t index_oid) const -> IndexInfo * {
     auto index = indexes_.find(index_oid);
     if (index == indexes_.end()) {
       return NULL_INDEX_INFO;
@@ -342,6 +378,31 @@ for (const auto &x : table_names_) {
     return result;
   }
 
+  /**
+   * Serialize the schemas of the tables, their first pages and the roots of their indexes into the chain of catalog
+   * pages, which the header page points to. Tables without a table heap, e.g. the mock tables, are not saved.
+   */
+  void Save();
+
+  /**
+   * Restore the catalog saved in the header page's catalog chain, if there is one. Only the catalog pages are read:
+   * the table heaps and indexes are reopened on their saved pages, which are read on first use.
+   */
+  void Load();
+
+  /**
+   * Collect the statistics of a table, replacing the ones it had. The statistics are kept in memory only, so a
+   * reopened database has to be analyzed again.
+   * @param table_info the table to analyze, which must have a table heap
+   */
+  void AnalyzeTable(TableInfo *table_info);
+
+  /**
+   * @return the version of the catalog, which changes whenever a table or an index is created or a table is analyzed.
+   * Plans made at one version may be worse, or wrong, at a later one.
+   */
+  auto GetVersion() const -> uint64_t { return version_.load(); }
+
  private:
   [[maybe_unused]] BufferPoolManager *bpm_;
   [[maybe_unused]] LockManager *lock_manager_;
@@ -372,6 +433,12 @@ for (const auto &x : table_names_) {
 
   /** The next index identifier to be used. */
   std::atomic<index_oid_t> next_index_oid_{0};
+
+  /** The version of the catalog, see GetVersion() */
+  std::atomic<uint64_t> version_{0};
+
+  /** The pages the catalog was saved to, which the next Save() writes over. */
+  std::vector<page_id_t> catalog_page_ids_;
 };
 
 }  // namespace bustub
@@ -65,7 +65,8 @@ class Column {
         column_type_(column.column_type_),
         fixed_length_(column.fixed_length_),
         variable_length_(column.variable_length_),
-        column_offset_(column.column_offset_) {}
+        column_offset_(column.column_offset_),
+        is_nullable_(column.is_nullable_) {}
 
   /** @return column name */
   auto GetName() const -> std::string { return column_name_; }
@@ -93,6 +94,12 @@ class Column {
   /** @return true if column is inlined, false otherwise */
   auto IsInlined() const -> bool { return column_type_ != TypeId::VARCHAR; }
 
+  /** @return false if the column was declared NOT NULL, true otherwise */
+  auto IsNullable() const -> bool { return is_nullable_; }
+
+  /** Declare the column NOT NULL. */
+  void SetNotNull() { is_nullable_ = false; }
+
   /** @return a string representation of this column */
   auto ToString(bool simplified = true) const -> std::string;
 
@@ -116,8 +123,8 @@ class Column {
       case TypeId::TIMESTAMP:
         return 8;
       case TypeId::VARCHAR:
-        // TODO(Amadou): Confirm this.
-        return 12;
+        // The slot of a VARCHAR in the fixed-size area of a tuple, see Tuple.
+        return 4;
       default: {
         UNREACHABLE("Cannot get size of invalid type");
       }
@@ -138,6 +145,9 @@ class Column {
 
   /** Column offset in the tuple. */
   uint32_t column_offset_{0};
+
+  /** False if the column was declared NOT NULL, so that no tuple holds a NULL in it. */
+  bool is_nullable_{true};
 };
 
 }  // namespace bustub
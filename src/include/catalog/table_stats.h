@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_stats.h
+//
+// Identification: src/include/catalog/table_stats.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/schema.h"
+#include "common/util/hash_util.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * HyperLogLog estimates the number of distinct values it has seen from a small, fixed number of registers. Each value
+ * is hashed, the first PRECISION bits of the hash pick a register, and the register keeps the longest run of leading
+ * zeros seen in the remaining bits. Sketches can only grow: a value cannot be removed again.
+ */
+class HyperLogLog {
+ public:
+  static constexpr size_t PRECISION = 10;
+  static constexpr size_t REGISTER_CNT = size_t{1} << PRECISION;
+
+  /** Add a value, given by its hash. The hash is mixed again, so it only has to be free of collisions. */
+  void Add(hash_t hash);
+
+  /** @return the estimated number of distinct values added, with a standard error of about 3% */
+  auto Estimate() const -> uint64_t;
+
+ private:
+  std::array<uint8_t, REGISTER_CNT> registers_{};
+};
+
+/**
+ * An equi-depth histogram splits the sorted values of a column into buckets of (about) the same number of values, and
+ * keeps the upper bound of every bucket. Frequent values thus get narrow buckets.
+ */
+class EquiDepthHistogram {
+ public:
+  static constexpr size_t BUCKET_CNT = 32;
+
+  EquiDepthHistogram() = default;
+
+  /** Build the histogram from a sample of the non-null values of a column. The sample is sorted in place. */
+  explicit EquiDepthHistogram(std::vector<Value> *sample);
+
+  /** @return the upper bounds of the buckets, in ascending order */
+  auto GetBounds() const -> const std::vector<Value> & { return bounds_; }
+
+  /** @return the estimated fraction of the non-null values that are less than value, or 0.5 without a histogram */
+  auto EstimateLessThan(const Value &value) const -> double;
+
+ private:
+  std::vector<Value> bounds_;
+};
+
+/** ColumnStats describes the values of one column. */
+struct ColumnStats {
+  /** The number of NULLs, counted over every row */
+  uint64_t null_count_{0};
+  /** A sketch of the distinct non-null values, over every row */
+  HyperLogLog distinct_;
+  /** A histogram over the sampled non-null values */
+  EquiDepthHistogram histogram_;
+  /** The smallest and largest values, NULL if the column only holds NULLs */
+  Value min_;
+  Value max_;
+};
+
+/**
+ * TableStats holds what ANALYZE found out about a table. Row counts, null counts and distinct counts cover every row
+ * of the table; the histograms are built from a sample of at most SAMPLE_SIZE rows.
+ *
+ * The executors that modify the table keep the counts up to date, so that they stay close between two ANALYZE runs.
+ * The histograms do not change until the next ANALYZE.
+ */
+struct TableStats {
+  static constexpr size_t SAMPLE_SIZE = 10000;
+  /** A plain ANALYZE refreshes the statistics once more than this fraction of the rows has changed. */
+  static constexpr double STALE_FRACTION = 0.2;
+
+  /**
+   * Scan a table and collect its statistics.
+   * @param bpm the buffer pool the table lives in
+   * @param table the table heap
+   * @param schema the schema of the table
+   * @param seed the seed of the sampling
+   */
+  static auto Collect(BufferPoolManager *bpm, const TableHeap &table, const Schema &schema, uint64_t seed)
+      -> TableStats;
+
+  /** Account for a tuple inserted into the table. */
+  void RecordInsert(const Tuple &tuple, const Schema &schema);
+
+  /** Account for a tuple deleted from the table. Distinct counts cannot shrink, so they are left alone. */
+  void RecordDelete(const Tuple &tuple, const Schema &schema);
+
+  /** @return true if so much of the table has changed since the statistics were collected that they are stale */
+  auto IsStale() const -> bool {
+    return static_cast<double>(modified_rows_) > STALE_FRACTION * static_cast<double>(analyzed_rows_);
+  }
+
+  /** @return the estimated number of distinct non-null values of a column, at most the number of non-null rows */
+  auto GetDistinctCount(uint32_t col_idx) const -> uint64_t;
+
+  /** @return the fraction of the rows in which a column is NULL */
+  auto GetNullFraction(uint32_t col_idx) const -> double;
+
+  /** The number of rows in the table */
+  uint64_t row_count_{0};
+  /** The number of rows when the statistics were collected, and how many rows were sampled then */
+  uint64_t analyzed_rows_{0};
+  uint64_t sampled_rows_{0};
+  /** The number of rows inserted or deleted since then */
+  uint64_t modified_rows_{0};
+  std::vector<ColumnStats> columns_;
+};
+
+}  // namespace bustub
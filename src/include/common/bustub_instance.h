@@ -14,18 +14,22 @@
 
 #include <iostream>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <optional>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "binder/bound_statement.h"
 #include "catalog/catalog.h"
 #include "common/config.h"
 #include "common/util/string_util.h"
 #include "libfort/lib/fort.hpp"
+#include "planner/plan_cache.h"
 #include "type/value.h"
 
 namespace bustub {
@@ -40,6 +44,25 @@ class LogManager;
 class CheckpointManager;
 class Catalog;
 class ExecutionEngine;
+class ResultCursor;
+class AnalyzeStatement;
+
+/** The variables of a session, changed with SET and read with SHOW. */
+using SessionVariables = std::unordered_map<std::string, std::string>;
+
+/** A statement prepared with PREPARE. Only plan_ changes once it is prepared, under the prepared statement latch. */
+struct PreparedStatement {
+  /** The bound statement, which is planned again when the catalog changes */
+  std::unique_ptr<BoundStatement> statement_;
+  std::vector<TypeId> param_types_;
+  CachedPlan plan_;
+};
+
+/**
+ * The statements of a session prepared with PREPARE, by name. They are shared, so that an EXECUTE can plan one again
+ * without the latch while a DEALLOCATE drops it.
+ */
+using PreparedStatements = std::unordered_map<std::string, std::shared_ptr<PreparedStatement>>;
 
 class ResultWriter {
  public:
@@ -224,8 +247,31 @@ class BustubInstance {
 
   /**
    * Execute a SQL query in the BusTub instance with provided txn.
+   * @param variables the variables of the session executing the query, or nullptr for those of the instance
+   * @param prepared the prepared statements of the session executing the query, or nullptr for those of the instance
    */
-  auto ExecuteSqlTxn(const std::string &sql, ResultWriter &writer, Transaction *txn) -> bool;
+  auto ExecuteSqlTxn(const std::string &sql, ResultWriter &writer, Transaction *txn,
+                     SessionVariables *variables = nullptr, PreparedStatements *prepared = nullptr) -> bool;
+
+  /**
+   * Execute a statement prepared with PREPARE in the BusTub instance with provided txn. The statement is neither
+   * parsed nor planned again, unless the catalog has changed since it was planned. This is what `EXECUTE` does, minus
+   * parsing the `EXECUTE` itself.
+   * @param name the name of the prepared statement
+   * @param params the values of the parameters, which are cast to the declared types
+   * @param variables the variables of the session executing the statement, or nullptr for those of the instance
+   * @param prepared the prepared statements of the session, or nullptr for those of the instance
+   */
+  auto ExecutePreparedTxn(const std::string &name, const std::vector<Value> &params, ResultWriter &writer,
+                          Transaction *txn, SessionVariables *variables = nullptr,
+                          PreparedStatements *prepared = nullptr) -> bool;
+
+  /**
+   * Open a cursor over the result of a SELECT statement in the BusTub instance with provided txn, for the application
+   * to pull the rows in batches instead of having them written. The query runs as the cursor is read, in the thread
+   * reading it, and the cursor must be dropped before the transaction ends.
+   */
+  auto OpenCursor(const std::string &sql, Transaction *txn) -> std::unique_ptr<ResultCursor>;
 
   /**
    * FOR TEST ONLY. Generate test tables in this BusTub instance.
@@ -254,15 +300,25 @@ class BustubInstance {
   ExecutionEngine *execution_engine_;
   std::shared_mutex catalog_lock_;
 
-  auto GetSessionVariable(const std::string &key) -> std::string {
-    if (session_variables_.find(key) != session_variables_.end()) {
-      return session_variables_[key];
+  auto GetSessionVariable(const std::string &key) -> std::string { return GetSessionVariable(session_variables_, key); }
+
+  static auto GetSessionVariable(const SessionVariables &variables, const std::string &key) -> std::string {
+    if (auto variable = variables.find(key); variable != variables.end()) {
+      return variable->second;
     }
     return "";
   }
 
-  auto IsForceStarterRule() -> bool {
-    auto variable = StringUtil::Lower(GetSessionVariable("force_optimizer_starter_rule"));
+  /**
+   * @return the buffer pool, replacer and disk statistics as a JSON object, e.g. for a benchmark to save alongside its
+   * results. The `\stats json` meta-command prints the same.
+   */
+  auto DumpStats() -> std::string;
+
+  auto IsForceStarterRule() -> bool { return IsForceStarterRule(session_variables_); }
+
+  static auto IsForceStarterRule(const SessionVariables &variables) -> bool {
+    auto variable = StringUtil::Lower(GetSessionVariable(variables, "force_optimizer_starter_rule"));
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
@@ -270,8 +326,28 @@ class BustubInstance {
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
   void CmdDisplayHelp(ResultWriter &writer);
+  void CmdVacuum(const std::string &table_name, ResultWriter &writer, Transaction *txn);
+  void CmdStats(const std::string &args, ResultWriter &writer);
+  /** Analyze the named table, or every table that was never analyzed or whose statistics are stale. */
+  void ExecuteAnalyze(const AnalyzeStatement &stmt, ResultWriter &writer);
+  /** @return every statistic as (component, name, value), where the value is a number formatted for display */
+  auto CollectStats() -> std::vector<std::tuple<std::string, std::string, std::string>>;
   void WriteOneCell(const std::string &cell, ResultWriter &writer);
-  std::unordered_map<std::string, std::string> session_variables_;
+  /** Plan and optimize a SELECT, INSERT, UPDATE or DELETE statement. */
+  auto PlanStatement(const BoundStatement &statement, const SessionVariables &variables) -> CachedPlan;
+  /** @return the key a statement's plan is cached under, or std::nullopt if its plan is not cached */
+  static auto PlanCacheKey(const std::string &sql, const SessionVariables &variables) -> std::optional<std::string>;
+  /** Execute a plan and write its result set, row by row as it is produced. */
+  auto ExecutePlan(const CachedPlan &plan, ResultWriter &writer, Transaction *txn) -> bool;
+  /** The variables of the statements executed without a session of their own, e.g. from the shell */
+  SessionVariables session_variables_;
+  /** The plans of the statements executed most recently, by their normalized text */
+  PlanCache plan_cache_;
+  /** The statements prepared without a session of their own, shared by every thread using the instance */
+  PreparedStatements prepared_statements_;
+  std::mutex prepared_latch_;
+  /** Whether the database lives in a file, which keeps the catalog and the pages across restarts. */
+  bool is_file_backed_{false};
 };
 
 }  // namespace bustub
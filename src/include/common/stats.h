@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// stats.h
+//
+// Identification: src/include/common/stats.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+
+namespace bustub {
+
+/** Number of shards a statistic is split into. Threads are spread over the shards round-robin. */
+static constexpr size_t STATS_SHARD_CNT = 16;
+
+/** @return the shard the calling thread updates */
+auto StatsShard() -> size_t;
+
+/**
+ * StatCounter is a monotonically increasing counter that can be bumped from hot paths. Every thread increments its own
+ * cache line with a relaxed atomic add, so concurrent updates neither take a lock nor bounce a shared line; reading the
+ * counter sums the shards.
+ */
+class StatCounter {
+ public:
+  void Add(uint64_t n = 1) { shards_[StatsShard()].value_.fetch_add(n, std::memory_order_relaxed); }
+
+  /** @return the sum over all shards, which may miss increments that race with the read */
+  auto Get() const -> uint64_t;
+
+  void Reset();
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> value_{0};
+  };
+  std::array<Shard, STATS_SHARD_CNT> shards_;
+};
+
+/**
+ * StatHistogram records a distribution (typically a latency in nanoseconds) into power-of-two buckets: bucket 0 holds
+ * the value 0 and bucket i holds the values in [2^(i-1), 2^i). Like StatCounter it is sharded per thread.
+ */
+class StatHistogram {
+ public:
+  static constexpr size_t BUCKET_CNT = 48;
+
+  void Record(uint64_t value);
+
+  /** @return the number of recorded values */
+  auto GetCount() const -> uint64_t;
+
+  /** @return the sum of the recorded values */
+  auto GetSum() const -> uint64_t;
+
+  /**
+   * @param percentile a fraction in [0, 1], e.g. 0.99
+   * @return the upper bound of the bucket the percentile falls into, or 0 if nothing was recorded
+   */
+  auto GetPercentile(double percentile) const -> uint64_t;
+
+  void Reset();
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, BUCKET_CNT> buckets_{};
+    std::atomic<uint64_t> sum_{0};
+  };
+  std::array<Shard, STATS_SHARD_CNT> shards_;
+};
+
+/**
+ * ThreadStats counts what the calling thread does across every buffer pool. Unlike the shared statistics, it tells the
+ * work of one query apart from that of the queries running next to it, which is what EXPLAIN ANALYZE reports. The
+ * counters are plain thread-local integers, so bumping them is as cheap as an increment.
+ */
+struct ThreadStats {
+  uint64_t fetch_hits_{0};
+  uint64_t fetch_misses_{0};
+};
+
+/** @return the statistics of the calling thread */
+inline auto GetThreadStats() -> ThreadStats & {
+  thread_local ThreadStats stats;
+  return stats;
+}
+
+/** StatTimer records the nanoseconds between its construction and destruction into a histogram. */
+class StatTimer {
+ public:
+  explicit StatTimer(StatHistogram *histogram) : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+  StatTimer(const StatTimer &) = delete;
+  auto operator=(const StatTimer &) -> StatTimer & = delete;
+
+  ~StatTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    histogram_->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  }
+
+ private:
+  StatHistogram *histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace bustub
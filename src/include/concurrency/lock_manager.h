@@ -297,8 +297,8 @@ class LockManager {
    *
    *要有一个接口能根据已授权的锁 输出还能兼容的锁类型
    */
-  auto GrantCompatibleLock(LockMode mode, Transaction *txn, std::shared_ptr<LockRequestQueue> &queue, bool table_lock)
-      -> bool;
+  auto GrantCompatibleLock(LockMode mode, Transaction *txn, std::shared_ptr<LockRequestQueue> &queue, bool table_lock,
+                           bool empty_queue) -> bool;
 
   void CompatibleLock(const std::unordered_set<LockMode> &granted_lock, std::unordered_set<LockMode> &compatible_lock);
 
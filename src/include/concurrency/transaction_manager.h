@@ -13,6 +13,8 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>  // NOLINT
+#include <mutex>               // NOLINT
 #include <shared_mutex>
 #include <unordered_map>
 #include <unordered_set>
@@ -77,6 +79,17 @@ class TransactionManager {
     return res;
   }
 
+  /**
+   * Keeps new transactions from beginning, then waits until every running transaction but txn committed or aborted,
+   * so that nobody else holds on to a page or a RID of any table. Only one transaction can block the others at a time.
+   * @param txn the transaction that goes on running
+   * @throw Exception if another transaction already blocks the others
+   */
+  void BlockOtherTransactions(Transaction *txn);
+
+  /** Lets transactions begin again after BlockOtherTransactions. */
+  void ResumeOtherTransactions();
+
   /** Prevents all transactions from performing operations, used for checkpointing. */
   void BlockAllTransactions();
 
@@ -140,6 +153,14 @@ class TransactionManager {
 
   /** The global transaction latch is used for checkpointing. */
   ReaderWriterLatch global_txn_latch_;
+
+  /** The transactions that began but did not commit or abort yet. Unlike txn_map, it never holds a deleted one. */
+  std::unordered_set<Transaction *> running_txns_;
+  /** Whether BlockOtherTransactions keeps new transactions from beginning */
+  bool others_blocked_{false};
+  std::mutex running_txns_latch_;
+  /** Signalled when a transaction commits or aborts, and when transactions may begin again */
+  std::condition_variable running_txns_cv_;
 };
 
 }  // namespace bustub
@@ -40,9 +40,11 @@ class DiskExtendibleHashTable {
    * @param buffer_pool_manager buffer pool manager to be used
    * @param comparator comparator for keys
    * @param hash_fn the hash function
+   * @param directory_page_id the directory of an existing hash table to reopen, or INVALID_PAGE_ID to create one
    */
   explicit DiskExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
-                                   const KeyComparator &comparator, HashFunction<KeyType> hash_fn);
+                                   const KeyComparator &comparator, HashFunction<KeyType> hash_fn,
+                                   page_id_t directory_page_id = INVALID_PAGE_ID);
 
   /**
    * Inserts a key-value pair into the hash table.
@@ -79,6 +81,9 @@ class DiskExtendibleHashTable {
    */
   auto GetGlobalDepth() -> uint32_t;
 
+  /** @return the page id of the directory, from which the hash table can be reopened */
+  auto GetDirectoryPageId() const -> page_id_t { return directory_page_id_; }
+
   /**
    * Helper function to verify the integrity of the extendible hash table's directory.
    */
@@ -110,7 +115,7 @@ class DiskExtendibleHashTable {
    * @param dir_page to use for lookup of global depth
    * @return the directory index
    */
-  auto KeyToDirectoryIndex(KeyType key, HashTableDirectoryPage *dir_page) -> uint32_t;
+  auto KeyToDirectoryIndex(KeyType key, const HashTableDirectoryPage *dir_page) -> uint32_t;
 
   /**
    * Get the bucket page_id corresponding to a key.
@@ -119,7 +124,7 @@ class DiskExtendibleHashTable {
    * @param dir_page a pointer to the hash table's directory page
    * @return the bucket page_id corresponding to the input key
    */
-  auto KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t;
+  auto KeyToPageId(KeyType key, const HashTableDirectoryPage *dir_page) -> page_id_t;
 
   /**
    * Fetches the directory page from the buffer pool manager.
@@ -146,6 +151,26 @@ class DiskExtendibleHashTable {
    */
   auto SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool;
 
+  /**
+   * Inserts a pair into the first page of a bucket that has room, without splitting the bucket.
+   *
+   * @param bucket_page the first page of the bucket, which the caller holds the write latch of
+   * @param key the key to insert
+   * @param value the value to insert
+   * @param grow whether to append an overflow page to the bucket when all of its pages are full
+   * @param[out] full set to whether the pair was not inserted for lack of room
+   * @return whether the pair was inserted
+   */
+  auto InsertIntoBucket(HASH_TABLE_BUCKET_TYPE *bucket_page, const KeyType &key, const ValueType &value, bool grow,
+                        bool *full) -> bool;
+
+  /**
+   * @param bucket_page the first page of the bucket, which the caller holds a latch of
+   * @param hash the hash of the key to insert
+   * @return whether every pair in the bucket has the given hash, so that no split can separate them
+   */
+  auto BucketHasOneHash(const HASH_TABLE_BUCKET_TYPE *bucket_page, uint32_t hash) -> bool;
+
   /**
    * Optionally merges an empty bucket into it's pair.  This is called by Remove,
    * if Remove makes a bucket empty.
@@ -21,15 +21,31 @@
 #include "container/hash/hash_function.h"
 #include "storage/page/hash_table_block_page.h"
 #include "storage/page/hash_table_header_page.h"
+#include "storage/page/page_guard.h"
 
 namespace bustub {
 
 #define HASH_TABLE_TYPE LinearProbeHashTable<KeyType, ValueType, KeyComparator>
 
 /**
- * Implementation of linear probing hash table that is backed by a buffer pool
- * manager. Non-unique keys are supported. Supports insert and delete. The
- * table dynamically grows once full.
+ * Implementation of linear probing hash table that is backed by a buffer
+ * pool manager. Non-unique keys are supported. Supports insert and delete.
+ * The table dynamically grows once full.
+ *
+ * Slots are spread over block pages. The header page lists block list pages,
+ * which are laid out like header pages and list the ids of the block pages,
+ * so that the table is not limited to the blocks one page can list. A key
+ * probes from the slot its hash picks towards the end of the table, wrapping
+ * around, up to the first slot that was never occupied. A removed pair leaves
+ * a tombstone behind, so that it does not cut the probe sequences going
+ * through its slot. An insert reuses the first tombstone on its way.
+ *
+ * Once pairs and tombstones take three quarters of the slots, the next insert
+ * rebuilds the table into a new set of pages: twice as large if at least half
+ * of the slots hold pairs, otherwise just as large, which drops the
+ * tombstones. Only a handful of pages are pinned at any time, so the table
+ * can grow well past the size of the buffer pool, e.g. to hold the build side
+ * of a hash join or the groups of an aggregation that do not fit in memory.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTable {
@@ -39,18 +55,23 @@ class LinearProbeHashTable {
    *
    * @param buffer_pool_manager buffer pool manager to be used
    * @param comparator comparator for keys
-   * @param num_buckets initial number of buckets contained by this hash table
+   * @param num_buckets initial number of buckets contained by this hash table, rounded up to whole block pages
    * @param hash_fn the hash function
    */
   explicit LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                 const KeyComparator &comparator, size_t num_buckets, HashFunction<KeyType> hash_fn);
 
+  /**
+   * Deletes the pages of the hash table.
+   */
+  ~LinearProbeHashTable();
+
   /**
    * Inserts a key-value pair into the hash table.
    * @param transaction the current transaction
    * @param key the key to create
    * @param value the value to be associated with the key
-   * @return true if insert succeeded, false otherwise
+   * @return true if insert succeeded, false if the pair is already in the table
    */
   auto Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool;
 
@@ -80,26 +101,55 @@ class LinearProbeHashTable {
 
   /**
    * Gets the size of the hash table
-   * @return current size of the hash table
+   * @return current number of buckets (slots) of the hash table
    */
   auto GetSize() -> size_t;
 
+  /**
+   * @return the number of pairs in the hash table
+   */
+  auto GetNumPairs() -> size_t;
+
  private:
-  auto GetHeaderPage() -> HashTableHeaderPage *;
-  auto GetBlockPage(page_id_t block_page_id) -> HASH_TABLE_BLOCK_TYPE *;
-  void ResizeInsert(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value);
-  void DeleteBlockPages(HashTableHeaderPage *old_header_page);
+  /**
+   * Walks the probe sequence of a key, from the slot its hash picks up to the first unoccupied slot, and calls visit
+   * on every occupied slot on the way. The caller holds the table latch.
+   *
+   * @param header_page the header page of the table to probe
+   * @param key the key to probe for
+   * @param visit called with the pinned block page and the slot number; the probe stops when it returns false
+   * @return the slot the probe stopped at, or the size of the table if it went through every slot
+   */
+  template <typename Visitor>
+  auto Probe(const HashTableHeaderPage *header_page, const KeyType &key, Visitor &&visit) -> size_t;
+
+  /**
+   * Moves every pair into a new table of at least size slots, leaving the tombstones behind. The caller holds the
+   * table latch in write mode.
+   */
+  void Rebuild(size_t size);
+
+  /** Inserts a pair into a table that is being rebuilt, which has neither tombstones nor duplicates. */
+  /** @return the pinned block page at block_idx of the table */
+  auto FetchBlockPage(const HashTableHeaderPage *header_page, size_t block_idx) -> BasicPageGuard;
+
+  void ResizeInsert(const HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value);
+  void DeleteBlockPages(const HashTableHeaderPage *old_header_page);
   void CreateNewBlockPages(HashTableHeaderPage *header_page, size_t num_blocks);
-  auto GetValueLatchFree(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool;
 
   // member variable
   page_id_t header_page_id_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writer is only resize
+  // Lookups are readers. Inserts and removes are writers, like resizes, since the probe sequence of a key may cross
+  // any number of block pages.
   ReaderWriterLatch table_latch_;
 
+  // Slots holding a pair, and slots holding a pair or a tombstone. Both are only updated by writers.
+  size_t num_readable_{0};
+  size_t num_occupied_{0};
+
   // Hash function
   HashFunction<KeyType> hash_fn_;
 };
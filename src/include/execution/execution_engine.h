@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <functional>
+#include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
@@ -21,6 +23,7 @@
 #include "execution/executor_context.h"
 #include "execution/executor_factory.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/result_cursor.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -41,6 +44,9 @@ class ExecutionEngine {
 
   DISALLOW_COPY_AND_MOVE(ExecutionEngine);
 
+  /** Receives the tuples of a streamed result, one batch at a time. */
+  using ResultConsumer = std::function<void(const std::vector<Tuple> &batch)>;
+
   /**
    * Execute a query plan.
    * @param plan The query plan to execute
@@ -52,6 +58,34 @@ class ExecutionEngine {
   // NOLINTNEXTLINE
   auto Execute(const AbstractPlanNodeRef &plan, std::vector<Tuple> *result_set, Transaction *txn,
                ExecutorContext *exec_ctx) -> bool {
+    auto executor_succeeded = Execute(
+        plan,
+        [result_set](const std::vector<Tuple> &batch) {
+          if (result_set != nullptr) {
+            result_set->insert(result_set->end(), batch.begin(), batch.end());
+          }
+        },
+        txn, exec_ctx);
+    if (!executor_succeeded && result_set != nullptr) {
+      result_set->clear();
+    }
+    return executor_succeeded;
+  }
+
+  /**
+   * Execute a query plan, handing its tuples to a consumer as they are produced instead of collecting them. At most
+   * batch_size tuples are held at a time. If the query fails, the batches consumed before the failure are not taken
+   * back.
+   * @param plan The query plan to execute
+   * @param consumer Called with each batch of tuples produced by executing the plan
+   * @param txn The transaction context in which the query executes
+   * @param exec_ctx The executor context in which the query executes
+   * @param batch_size The maximum number of tuples in a batch
+   * @return `true` if execution of the query plan succeeds, `false` otherwise
+   */
+  // NOLINTNEXTLINE
+  auto Execute(const AbstractPlanNodeRef &plan, const ResultConsumer &consumer, Transaction *txn,
+               ExecutorContext *exec_ctx, size_t batch_size = RESULT_BATCH_SIZE) -> bool {
     BUSTUB_ASSERT((txn == exec_ctx->GetTransaction()), "Broken Invariant");
 
     // Construct the executor for the abstract plan node
@@ -62,15 +96,12 @@ class ExecutionEngine {
 
     try {
       executor->Init();
-      PollExecutor(executor.get(), plan, result_set);
+      PollExecutor(executor.get(), consumer, batch_size);
     } catch (const ExecutionException &ex) {
 #ifndef NDEBUG
       LOG_ERROR("Error Encountered in Executor Execution: %s", ex.what());
 #endif
       executor_succeeded = false;
-      if (result_set != nullptr) {
-        result_set->clear();
-      }
     }
 
     return executor_succeeded;
@@ -80,18 +111,24 @@ class ExecutionEngine {
   /**
    * Poll the executor until exhausted, or exception escapes.
    * @param executor The root executor
-   * @param plan The plan to execute
-   * @param result_set The tuple result set
+   * @param consumer The consumer of the produced tuples
+   * @param batch_size The number of tuples the consumer is handed at a time
    */
-  static void PollExecutor(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
-                           std::vector<Tuple> *result_set) {
+  static void PollExecutor(AbstractExecutor *executor, const ResultConsumer &consumer, size_t batch_size) {
     RID rid{};
     Tuple tuple{};
+    std::vector<Tuple> batch;
+    batch.reserve(batch_size);
     while (executor->Next(&tuple, &rid)) {
-      if (result_set != nullptr) {
-        result_set->push_back(tuple);
+      batch.push_back(std::move(tuple));
+      if (batch.size() == batch_size) {
+        consumer(batch);
+        batch.clear();
       }
     }
+    if (!batch.empty()) {
+      consumer(batch);
+    }
   }
 
   [[maybe_unused]] BufferPoolManager *bpm_;
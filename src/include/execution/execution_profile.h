@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// execution_profile.h
+//
+// Identification: src/include/execution/execution_profile.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * OperatorProfile is what EXPLAIN ANALYZE measured of one executor. Times and fetches are inclusive: they cover the
+ * children the executor pulled from, which are subtracted when the profile is printed.
+ */
+struct OperatorProfile {
+  /** how many times the executor was initialized, e.g. once per outer tuple for the inner side of a join */
+  uint64_t loops_{0};
+  uint64_t rows_out_{0};
+  uint64_t init_ns_{0};
+  uint64_t next_ns_{0};
+  /** buffer pool fetches made by the thread running the executor */
+  uint64_t fetch_hits_{0};
+  uint64_t fetch_misses_{0};
+  /** the most bytes the executor held at once, by AbstractExecutor::GetMemoryUsage() */
+  size_t peak_memory_{0};
+};
+
+/**
+ * ExecutionProfile collects the OperatorProfile of every executor of a query, by plan node. A query is profiled when
+ * its ExecutorContext has a profile; the ExecutorFactory then wraps each executor it creates in a ProfilingExecutor.
+ */
+class ExecutionProfile {
+ public:
+  /** @return the profile of a plan node, empty if it was not executed yet */
+  auto GetOperator(const AbstractPlanNode *plan) -> OperatorProfile * { return &operators_[plan]; }
+
+  /**
+   * @return the profile of a plan node as shown by EXPLAIN ANALYZE, e.g.
+   * "actual_rows=10 rows_in=1000 loops=1 time=1.52ms self=0.31ms fetches=12 misses=3 memory=4.1KB"
+   */
+  auto Annotate(const AbstractPlanNode &plan) const -> std::string;
+
+ private:
+  /** @return the profile of a plan node, or an empty one if it was never executed */
+  auto FindOperator(const AbstractPlanNode &plan) const -> OperatorProfile;
+
+  std::unordered_map<const AbstractPlanNode *, OperatorProfile> operators_;
+};
+
+}  // namespace bustub
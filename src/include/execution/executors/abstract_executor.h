@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "execution/executor_context.h"
 #include "storage/table/tuple.h"
 
@@ -52,7 +54,32 @@ class AbstractExecutor {
   /** @return The executor context in which this executor runs */
   auto GetExecutorContext() -> ExecutorContext * { return exec_ctx_; }
 
+  /**
+   * @return An estimate of the bytes this executor holds, e.g. materialized tuples or a hash table, not counting its
+   * children. It is only asked for by EXPLAIN ANALYZE, so it may take time proportional to what is held.
+   */
+  virtual auto GetMemoryUsage() const -> size_t { return 0; }
+
+  /**
+   * Hand the executor a test that the parent applies to every tuple it gets, and that may get stricter while the
+   * parent runs, like the threshold of a top-N heap. An executor that can run the test before it copies a tuple out
+   * skips the tuples that fail it. Skipping them is only an optimization: the parent still tests what it gets.
+   * @param runtime_filter returns false for a tuple, in the output schema of this executor, that the parent drops
+   * @return `true` if the executor applies the filter
+   */
+  virtual auto PushDownRuntimeFilter(std::function<bool(const Tuple &)> runtime_filter) -> bool { return false; }
+
  protected:
+  /** @return An estimate of the bytes held by a container of tuples */
+  template <class Container>
+  static auto TupleMemoryUsage(const Container &tuples) -> size_t {
+    size_t bytes = 0;
+    for (const auto &tuple : tuples) {
+      bytes += sizeof(Tuple) + tuple.GetLength();
+    }
+    return bytes;
+  }
+
   /** The executor context in which the executor runs */
   ExecutorContext *exec_ctx_;
 };
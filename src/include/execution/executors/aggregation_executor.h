@@ -13,7 +13,9 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -30,21 +32,21 @@
 namespace bustub {
 
 /**
- * A simplified hash table that has all the necessary functionality for aggregations.
+ * AggregateCombiner computes the aggregates of a single group from its input values, one input tuple at a time. It is
+ * shared by the hash-based and the streaming aggregation, which only differ in how they find the group of a tuple.
  */
-class SimpleAggregationHashTable {
+class AggregateCombiner {
  public:
   /**
-   * Construct a new SimpleAggregationHashTable instance.
-   * @param agg_exprs the aggregation expressions
+   * Construct a new AggregateCombiner instance.
    * @param agg_types the types of aggregations
+   * @param distinct whether each aggregation only sees the distinct values of its input
    */
-  SimpleAggregationHashTable(const std::vector<AbstractExpressionRef> &agg_exprs,
-                             const std::vector<AggregationType> &agg_types)
-      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {}
+  AggregateCombiner(const std::vector<AggregationType> &agg_types, const std::vector<bool> &distinct)
+      : agg_types_{agg_types}, distinct_{distinct} {}
 
   /** @return The initial aggregrate value for this aggregation executor */
-  auto GenerateInitialAggregateValue() -> AggregateValue {
+  auto GenerateInitialAggregateValue() const -> AggregateValue {
     std::vector<Value> values{};
     for (const auto &agg_type : agg_types_) {
       switch (agg_type) {
@@ -59,20 +61,29 @@ class SimpleAggregationHashTable {
           // Others starts at null.
           values.emplace_back(ValueFactory::GetNullValueByType(TypeId::INTEGER));
           break;
+        case AggregationType::AvgAggregate:
+          // Avg sums up decimals, and is divided by the count at the end.
+          values.emplace_back(ValueFactory::GetDecimalValue(0));
+          break;
       }
     }
-    return {values};
+    AggregateValue value{std::move(values), std::vector<int64_t>(agg_types_.size(), 0), {}};
+    value.distinct_values_.resize(agg_types_.size());
+    return value;
   }
 
   /**
-   * TODO(Student)
-   *
    * Combines the input into the aggregation result.
    * @param[out] result The output aggregate value
    * @param input The input value
    */
-  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
-    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) const {
+    for (uint32_t i = 0; i < agg_types_.size(); i++) {
+      // A DISTINCT aggregate skips the values it has seen before; NULLs are skipped by all of them anyway.
+      if (distinct_[i] && !input.aggregates_[i].IsNull() &&
+          !result->distinct_values_[i].insert(AggregateKey{{input.aggregates_[i]}}).second) {
+        continue;
+      }
       switch (agg_types_[i]) {                     // agg_types_应该是一组要进行聚合操作的集合
         case AggregationType::CountStarAggregate:  // aggregates应该是表中的一行数据
           result->aggregates_[i] = result->aggregates_[i].Add(Value(input.aggregates_[i].GetTypeId(), 1));
@@ -83,7 +94,7 @@ class SimpleAggregationHashTable {
               // 若是第一个不为null的值，需要初始化为1
               result->aggregates_[i] = Value(result->aggregates_[i].GetTypeId(), 1);
             } else {
-              result->aggregates_[i] = result->aggregates_[i].Add(Value(input.aggregates_[i].GetTypeId(), 1));
+              result->aggregates_[i] = result->aggregates_[i].Add(ValueFactory::GetIntegerValue(1));
             }
           }
           break;
@@ -114,38 +125,117 @@ class SimpleAggregationHashTable {
             }
           }
           break;
+        case AggregationType::AvgAggregate:
+          if (!input.aggregates_[i].IsNull()) {
+            result->aggregates_[i] = result->aggregates_[i].Add(input.aggregates_[i].CastAs(TypeId::DECIMAL));
+            result->counts_[i]++;
+          }
+          break;
       }
     }
   }
 
   /**
-   * Inserts a value into the hash table and then combines it with the current aggregation.
-   * @param agg_key the key to be inserted
-   * @param agg_val the value to be inserted
+   * Computes the output of the aggregation from its running value.
+   * @param value The aggregate value of a group after all of its input was combined into it
+   * @return The aggregates, in the order of the output columns
    */
-  void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
+  auto FinalizeAggregateValue(const AggregateValue &value) const -> std::vector<Value> {
+    std::vector<Value> values{value.aggregates_};
+    for (uint32_t i = 0; i < agg_types_.size(); i++) {
+      if (agg_types_[i] == AggregationType::AvgAggregate) {
+        values[i] = value.counts_[i] == 0 ? ValueFactory::GetNullValueByType(TypeId::DECIMAL)
+                                          : ValueFactory::GetDecimalValue(value.aggregates_[i].GetAs<double>() /
+                                                                          static_cast<double>(value.counts_[i]));
+      }
     }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
+    return values;
+  }
+
+  /** @return An estimate of the bytes held by an aggregate value */
+  static auto GetMemoryUsage(const AggregateValue &value) -> size_t {
+    size_t bytes = sizeof(value) + value.aggregates_.size() * sizeof(Value) + value.counts_.size() * sizeof(int64_t);
+    for (const auto &seen : value.distinct_values_) {
+      bytes += sizeof(seen) + seen.size() * (sizeof(AggregateKey) + sizeof(Value) + sizeof(void *));
+    }
+    return bytes;
+  }
+
+ private:
+  /** The types of aggregations that we have */
+  const std::vector<AggregationType> &agg_types_;
+  /** Whether each aggregation is DISTINCT */
+  const std::vector<bool> &distinct_;
+};
+
+/**
+ * The running state of one aggregate of one group whose input is of a fixed-width numeric type, see
+ * SimpleAggregationHashTable.
+ */
+struct AggregateState {
+  /** The number of values aggregated, or of rows for COUNT(*) */
+  int64_t count_;
+  union {
+    /** SUM, MIN and MAX of an integer input */
+    int64_t integer_;
+    /** SUM, MIN and MAX of a DECIMAL input, and the running sum of AVG */
+    double decimal_;
+  };
+};
+
+/**
+ * A simplified hash table that has all the necessary functionality for aggregations.
+ *
+ * The group by values of a tuple are serialized into a flat byte key, hashed once, and looked up with a buffer that is
+ * reused for every tuple. When all aggregates are over numbers and none is DISTINCT, the aggregates of a group are
+ * typed AggregateStates next to each other in a single array, so that combining a tuple into an existing group
+ * allocates nothing and does not go through Value. Other aggregates keep an AggregateValue per group instead.
+ */
+class SimpleAggregationHashTable {
+ public:
+  /**
+   * Construct a new SimpleAggregationHashTable instance.
+   * @param group_bys the group by expressions
+   * @param agg_exprs the aggregation expressions
+   * @param agg_types the types of aggregations
+   * @param distinct whether each aggregation only sees the distinct values of its input
+   */
+  SimpleAggregationHashTable(const std::vector<AbstractExpressionRef> &group_bys,
+                             const std::vector<AbstractExpressionRef> &agg_exprs,
+                             const std::vector<AggregationType> &agg_types, const std::vector<bool> &distinct);
+
+  /**
+   * Finds the group of a tuple, inserting it if it is new, and combines the tuple into the aggregates of the group.
+   * @param tuple the tuple to be aggregated
+   * @param schema the schema of the tuple
+   */
+  void InsertCombine(const Tuple &tuple, const Schema &schema);
+
+  /** @return The output of an aggregation without groups over no tuples */
+  auto InitialOutput() const -> std::vector<Value> {
+    return combiner_.FinalizeAggregateValue(combiner_.GenerateInitialAggregateValue());
   }
 
   /**
    * Clear the hash table
    */
-  void Clear() { ht_.clear(); }
+  void Clear() {
+    ht_.clear();
+    states_.clear();
+    values_.clear();
+  }
 
   /** An iterator over the aggregation hash table */
   class Iterator {
    public:
     /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_{iter} {}
+    explicit Iterator(std::unordered_map<std::string, size_t>::const_iterator iter) : iter_{iter} {}
 
-    /** @return The key of the iterator */
-    auto Key() -> const AggregateKey & { return iter_->first; }
+    /** @return The serialized group by values of the group */
+    auto Key() -> const std::string & { return iter_->first; }
 
-    /** @return The value of the iterator */
-    auto Val() -> const AggregateValue & { return iter_->second; }
+    /** @return The index of the group, which locates its aggregates */
+    auto Val() -> size_t { return iter_->second; }
 
     /** @return The iterator before it is incremented */
     auto operator++() -> Iterator & {
@@ -161,9 +251,27 @@ class SimpleAggregationHashTable {
 
    private:
     /** Aggregates map */
-    std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
+    std::unordered_map<std::string, size_t>::const_iterator iter_;
   };
 
+  /**
+   * @return The output of a group: its group by values, followed by its aggregates
+   * @param iter An iterator that points to the group
+   */
+  auto Output(Iterator iter) const -> std::vector<Value>;
+
+  /** @return An estimate of the bytes held by the hash table */
+  auto GetMemoryUsage() const -> size_t {
+    size_t bytes = states_.capacity() * sizeof(AggregateState);
+    for (const auto &[key, group] : ht_) {
+      bytes += sizeof(key) + key.size() + sizeof(group) + sizeof(void *);
+    }
+    for (const auto &value : values_) {
+      bytes += AggregateCombiner::GetMemoryUsage(value);
+    }
+    return bytes;
+  }
+
   /** @return Iterator to the start of the hash table */
   auto Begin() -> Iterator { return Iterator{ht_.cbegin()}; }
 
@@ -171,12 +279,33 @@ class SimpleAggregationHashTable {
   auto End() -> Iterator { return Iterator{ht_.cend()}; }
 
  private:
-  /** The hash table is just a map from aggregate keys to aggregate values */
-  std::unordered_map<AggregateKey, AggregateValue> ht_{};
+  /** Appends a group by value to a flat key, as its type, whether it is NULL, and its serialized bytes. */
+  static void SerializeKeyValue(const Value &value, std::string *key);
+
+  /** Combines the aggregate inputs of a tuple into the typed states of its group. */
+  void CombineStates(AggregateState *states) const;
+
+  /** The hash table maps the serialized group by values to the index of the group */
+  std::unordered_map<std::string, size_t> ht_{};
+  /** The typed aggregates of the groups, agg_types_.size() per group, if typed_ */
+  std::vector<AggregateState> states_{};
+  /** The aggregates of each group, if not typed_ */
+  std::vector<AggregateValue> values_{};
+  /** The group by expressions that we have */
+  const std::vector<AbstractExpressionRef> &group_bys_;
   /** The aggregate expressions that we have */
   const std::vector<AbstractExpressionRef> &agg_exprs_;
   /** The types of aggregations that we have */
   const std::vector<AggregationType> &agg_types_;
+  /** Computes the aggregates of each group that has no typed states */
+  AggregateCombiner combiner_;
+  /** Whether the aggregates are kept in typed states */
+  bool typed_;
+  /** Whether the typed state of each aggregate holds a DECIMAL */
+  std::vector<bool> decimal_;
+  /** The key and the aggregate inputs of the current tuple, kept to reuse their memory */
+  std::string key_;
+  std::vector<Value> inputs_;
 };
 
 /**
@@ -208,28 +337,11 @@ class AggregationExecutor : public AbstractExecutor {
   /** @return The output schema for the aggregation */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
+  auto GetMemoryUsage() const -> size_t override { return aht_.GetMemoryUsage(); }
+
   /** Do not use or remove this function, otherwise you will get zero points. */
   auto GetChildExecutor() const -> const AbstractExecutor *;
 
- private:
-  /** @return The tuple as an AggregateKey */
-  auto MakeAggregateKey(const Tuple *tuple) -> AggregateKey {
-    std::vector<Value> keys;
-    for (const auto &expr : plan_->GetGroupBys()) {
-      keys.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
-    }
-    return {keys};
-  }
-
-  /** @return The tuple as an AggregateValue */
-  auto MakeAggregateValue(const Tuple *tuple) -> AggregateValue {
-    std::vector<Value> vals;
-    for (const auto &expr : plan_->GetAggregates()) {
-      vals.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
-    }
-    return {vals};
-  }
-
  private:
   /** The aggregation plan node */
   const AggregationPlanNode *plan_;
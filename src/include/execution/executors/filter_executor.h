@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/executor_context.h"
@@ -51,6 +53,11 @@ class FilterExecutor : public AbstractExecutor {
   /** @return The output schema for the filter plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
+  /** The filter passes tuples on unchanged, so its child may as well drop them. */
+  auto PushDownRuntimeFilter(std::function<bool(const Tuple &)> runtime_filter) -> bool override {
+    return child_executor_->PushDownRuntimeFilter(std::move(runtime_filter));
+  }
+
  private:
   /** The filter plan node to be executed */
   const FilterPlanNode *plan_;
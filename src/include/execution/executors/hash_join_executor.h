@@ -13,17 +13,47 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/hash_join_plan.h"
+#include "common/util/hash_util.h"
 #include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** HashJoinKey is the value of a join key in the hash table of a hash join. NULL keys never enter the table. */
+struct HashJoinKey {
+  Value value_;
+
+  auto operator==(const HashJoinKey &other) const -> bool {
+    return value_.CompareEquals(other.value_) == CmpBool::CmpTrue;
+  }
+};
+
+}  // namespace bustub
+
+namespace std {
+
+/** Implements std::hash on HashJoinKey */
+template <>
+struct hash<bustub::HashJoinKey> {
+  auto operator()(const bustub::HashJoinKey &key) const -> std::size_t {
+    return bustub::HashUtil::HashValue(&key.value_);
+  }
+};
+
+}  // namespace std
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes an equi-JOIN on two tables. It builds a hash table over the right side in Init(), and then
+ * streams the left side through it, so the right side should be the smaller one.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -51,9 +81,31 @@ class HashJoinExecutor : public AbstractExecutor {
   /** @return The output schema for the join */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
+  auto GetMemoryUsage() const -> size_t override {
+    size_t bytes = 0;
+    for (const auto &[key, tuples] : hash_table_) {
+      bytes += sizeof(key) + sizeof(tuples) + TupleMemoryUsage(tuples);
+    }
+    return bytes;
+  }
+
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** Combine the current left tuple with a right tuple, or with NULLs if right is nullptr. */
+  auto MergeTuples(const Tuple *right) const -> Tuple;
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
+
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** The tuples of the right side, by join key */
+  std::unordered_map<HashJoinKey, std::vector<Tuple>> hash_table_;
+
+  Tuple left_tuple_{};
+  /** The right tuples matching left_tuple_, and how many of them were emitted */
+  const std::vector<Tuple> *matches_{nullptr};
+  size_t match_idx_{0};
 };
 
 }  // namespace bustub
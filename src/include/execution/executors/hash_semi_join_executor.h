@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_semi_join_executor.h
+//
+// Identification: src/include/execution/executors/hash_semi_join_executor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/executors/hash_join_executor.h"
+#include "execution/plans/hash_semi_join_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/** SemiJoinKey is the values of the join keys in the hash table of a semi join. Keys with a NULL never enter it. */
+struct SemiJoinKey {
+  std::vector<Value> values_;
+
+  auto operator==(const SemiJoinKey &other) const -> bool {
+    for (uint32_t i = 0; i < other.values_.size(); i++) {
+      if (values_[i].CompareEquals(other.values_[i]) != CmpBool::CmpTrue) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+}  // namespace bustub
+
+namespace std {
+
+/** Implements std::hash on SemiJoinKey */
+template <>
+struct hash<bustub::SemiJoinKey> {
+  auto operator()(const bustub::SemiJoinKey &key) const -> std::size_t {
+    size_t curr_hash = 0;
+    for (const auto &value : key.values_) {
+      curr_hash = bustub::HashUtil::CombineHashes(curr_hash, bustub::HashUtil::HashValue(&value));
+    }
+    return curr_hash;
+  }
+};
+
+}  // namespace std
+
+namespace bustub {
+
+/**
+ * HashSemiJoinExecutor executes a semi or anti join. It builds a hash table of the keys of the right side in Init(),
+ * and then streams the left side through it, outputting each left tuple at most once and never a right one.
+ */
+class HashSemiJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new HashSemiJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The semi join plan to be executed
+   * @param left_child The child executor whose tuples are output
+   * @param right_child The child executor whose tuples are looked for
+   */
+  HashSemiJoinExecutor(ExecutorContext *exec_ctx, const HashSemiJoinPlanNode *plan,
+                       std::unique_ptr<AbstractExecutor> &&left_child,
+                       std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join, building the hash table */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next left tuple kept by the join
+   * @param[out] rid The RID of that left tuple
+   * @return `true` if a tuple was produced, `false` if there are no more tuples.
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the join, the one of the left side */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+  auto GetMemoryUsage() const -> size_t override;
+
+ private:
+  /**
+   * The right values of a null-aware anti join that share the other keys. For a left tuple with these keys, the last
+   * key is found, unknown if there is a NULL, and otherwise not found.
+   */
+  struct NotInGroup {
+    std::unordered_set<HashJoinKey> values_;
+    bool has_null_{false};
+  };
+
+  /** @return The values of the key expressions for a tuple */
+  static auto EvaluateKeys(const std::vector<AbstractExpressionRef> &key_expressions, const Tuple &tuple,
+                           const Schema &schema) -> std::vector<Value>;
+
+  /** @return true if the left tuple with these keys is output */
+  auto IsOutput(std::vector<Value> keys) const -> bool;
+
+  /** The semi join plan node to be executed. */
+  const HashSemiJoinPlanNode *plan_;
+
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** The keys of the right side */
+  std::unordered_set<SemiJoinKey> keys_;
+  /** For a null-aware anti join, the right values by the keys but the last */
+  std::unordered_map<SemiJoinKey, NotInGroup> not_in_groups_;
+};
+
+}  // namespace bustub
@@ -26,7 +26,7 @@
 namespace bustub {
 
 /**
- * IndexScanExecutor executes an index scan over a table.
+ * IndexScanExecutor executes an index scan over a table, applying the filter and the limit of the plan.
  */
 
 class IndexScanExecutor : public AbstractExecutor {
@@ -45,6 +45,9 @@ class IndexScanExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** Read the next tuple the index points to, before the filter. @return false if there are no more */
+  auto FetchNext(Tuple *tuple, RID *rid) -> bool;
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
 
@@ -55,5 +58,12 @@ class IndexScanExecutor : public AbstractExecutor {
   decltype(index_tree_->GetBeginIterator()) indicator_{};
 
   decltype(index_tree_->GetEndIterator()) end_{};
+
+  /** For a point lookup: the RIDs the index returned for the key, and the next one to produce. */
+  std::vector<RID> rids_;
+  size_t rid_idx_{0};
+
+  /** The number of tuples produced so far, for the limit. */
+  size_t produced_{0};
 };
 }  // namespace bustub
@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.h
+//
+// Identification: src/include/execution/executors/merge_join_executor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/merge_join_plan.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/**
+ * MergeJoinExecutor executes an equi-JOIN on two inputs sorted by their join keys. Both sides are read once, in step:
+ * for every left key, the right side is advanced past the smaller keys, and the run of right tuples with an equal key
+ * is buffered, so that left tuples with duplicate keys are all joined with it. Only one run is kept in memory.
+ *
+ * NULL keys never match, wherever the inputs sort them.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new MergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The MergeJoin join plan to be executed
+   * @param left_child The child executor that produces tuples for the left side of join, sorted by the left key
+   * @param right_child The child executor that produces tuples for the right side of join, sorted by the right key
+   */
+  MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_child, std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join.
+   * @param[out] rid The next tuple RID, not used by merge join.
+   * @return `true` if a tuple was produced, `false` if there are no more tuples.
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the join */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+  auto GetMemoryUsage() const -> size_t override { return TupleMemoryUsage(run_); }
+
+ private:
+  /** Read the next left tuple and its key. */
+  void AdvanceLeft();
+
+  /** Read the next right tuple and its key. */
+  void AdvanceRight();
+
+  /** Point run_ at the right tuples whose key equals the left key. @return false if there are none */
+  auto FindRun() -> bool;
+
+  /** Combine the current left tuple with a right tuple, or with NULLs if right is nullptr. */
+  auto MergeTuples(const Tuple *right) const -> Tuple;
+
+  /** The MergeJoin plan node to be executed. */
+  const MergeJoinPlanNode *plan_;
+
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  Tuple left_tuple_{};
+  Value left_key_;
+  bool left_valid_{false};
+  /** Whether run_ holds the matches of left_tuple_, and how many of them were emitted */
+  bool left_matched_{false};
+  size_t match_idx_{0};
+
+  /** The next right tuple not yet buffered in a run */
+  Tuple right_tuple_{};
+  Value right_key_;
+  bool right_valid_{false};
+
+  /** The right tuples with key run_key_, the last key both sides have */
+  std::vector<Tuple> run_;
+  Value run_key_;
+};
+
+}  // namespace bustub
@@ -78,5 +78,9 @@ class NestIndexJoinExecutor : public AbstractExecutor {
 
   Tuple inner_tuple_{};
   Tuple outer_tuple_{};  // sql语句中的左表在算子中为外表，由child_executor提供next
+
+  /** The RIDs the index found for outer_tuple_, and the next one to emit */
+  std::vector<RID> inner_rids_;
+  size_t inner_idx_{0};
 };
 }  // namespace bustub
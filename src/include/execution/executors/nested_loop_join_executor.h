@@ -24,8 +24,15 @@
 
 namespace bustub {
 
+/** The number of left tuples joined against the right side in one pass over it. */
+static constexpr size_t NLJ_OUTER_BLOCK_SIZE = 64;
+/** The bytes of right tuples in a block, small enough for the block to stay in cache while an outer block is joined. */
+static constexpr size_t NLJ_INNER_BLOCK_BYTES = 64 * 1024;
+
 /**
- * NestedLoopJoinExecutor executes a nested-loop JOIN on two tables.
+ * NestedLoopJoinExecutor executes a block nested-loop JOIN on two tables. The right side is materialized once in
+ * Init(), and then joined in cache-sized blocks against blocks of NLJ_OUTER_BLOCK_SIZE left tuples. Tuples come out
+ * in the order of a tuple-at-a-time nested-loop join: by left tuple, then by right tuple.
  */
 class NestedLoopJoinExecutor : public AbstractExecutor {
  public:
@@ -54,37 +61,42 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
   /** @return The output schema for the insert */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
-  // value值合并函数，将两个表的tuple组合成新的tuple
-  void MergeValueFromTuple(std::vector<Value> &value, bool right_isnull) const {
-    auto left_column_count = left_executor_->GetOutputSchema().GetColumnCount();
-    auto right_column_count = right_executor_->GetOutputSchema().GetColumnCount();
-    for (unsigned int i = 0; i < left_column_count; i++) {
-      value.push_back(left_tuple_.GetValue(&left_executor_->GetOutputSchema(), i));
-    }
-    for (unsigned int i = 0; i < right_column_count; i++) {
-      if (!right_isnull) {
-        value.push_back(right_tuple_.GetValue(&right_executor_->GetOutputSchema(), i));
-      } else {
-        value.push_back(ValueFactory::GetNullValueByType(right_executor_->GetOutputSchema().GetColumn(i).GetType()));
-      }
+  auto GetMemoryUsage() const -> size_t override {
+    size_t bytes = TupleMemoryUsage(inner_tuples_) + TupleMemoryUsage(outer_block_);
+    for (const auto &matches : outer_matches_) {
+      bytes += sizeof(matches) + matches.size() * sizeof(uint32_t);
     }
+    return bytes;
   }
 
  private:
+  /** @return true if the join outputs left tuples only, the ones with (semi) or without (anti) a match */
+  auto IsSemiOrAnti() const -> bool {
+    return plan_->GetJoinType() == JoinType::SEMI || plan_->GetJoinType() == JoinType::ANTI;
+  }
+
+  /** Read the next block of left tuples, and find their matches on the right. False if the left side is exhausted. */
+  auto JoinNextOuterBlock() -> bool;
+
+  /** Combine a left tuple with a right tuple, or with NULLs if right is nullptr. */
+  auto MergeTuples(const Tuple &left, const Tuple *right) const -> Tuple;
+
   /** The NestedLoopJoin plan node to be executed. */
   const NestedLoopJoinPlanNode *plan_;
 
   std::unique_ptr<AbstractExecutor> left_executor_;
   std::unique_ptr<AbstractExecutor> right_executor_;
 
-  Tuple left_tuple_{};
-  Tuple right_tuple_{};
-  bool next_ltuple_existent_{false};
-  bool next_rtuple_existent_{false};
-  RID left_rid_{};
-  RID right_rid_{};
-  // 左连接右表有无匹配项
-  bool right_found_{false};
+  /** The tuples of the right side, and where each of their blocks ends */
+  std::vector<Tuple> inner_tuples_;
+  std::vector<size_t> inner_block_ends_;
+
+  /** The current block of left tuples, and for each of them the indexes of its matches in inner_tuples_ */
+  std::vector<Tuple> outer_block_;
+  std::vector<std::vector<uint32_t>> outer_matches_;
+  /** The left tuple being emitted, and how many of its matches were */
+  size_t outer_idx_{0};
+  size_t match_idx_{0};
 };
 
 }  // namespace bustub
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// profiling_executor.h
+//
+// Identification: src/include/execution/executors/profiling_executor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "execution/execution_profile.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * ProfilingExecutor wraps another executor for EXPLAIN ANALYZE. It passes every call through unchanged, and records
+ * into an OperatorProfile how many tuples came out, how long the calls took, which buffer pool fetches the thread made
+ * during them and how much memory the executor held.
+ */
+class ProfilingExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new ProfilingExecutor instance.
+   * @param exec_ctx The executor context
+   * @param child_executor The executor to profile
+   * @param profile Where to record the profile of the executor
+   */
+  ProfilingExecutor(ExecutorContext *exec_ctx, std::unique_ptr<AbstractExecutor> &&child_executor,
+                    OperatorProfile *profile);
+
+  void Init() override;
+
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  auto GetOutputSchema() const -> const Schema & override { return child_executor_->GetOutputSchema(); }
+
+  auto GetMemoryUsage() const -> size_t override { return child_executor_->GetMemoryUsage(); }
+
+  auto PushDownRuntimeFilter(std::function<bool(const Tuple &)> runtime_filter) -> bool override {
+    return child_executor_->PushDownRuntimeFilter(std::move(runtime_filter));
+  }
+
+ private:
+  /** The clock and the fetch counters of the calling thread at the start of a call */
+  struct Snapshot {
+    uint64_t ns_;
+    uint64_t fetch_hits_;
+    uint64_t fetch_misses_;
+  };
+
+  static auto TakeSnapshot() -> Snapshot;
+
+  /** Add the fetches since a snapshot to the profile, and the time since it to *ns. */
+  void Record(const Snapshot &start, uint64_t *ns);
+
+  /** Sample the memory the executor holds. */
+  void RecordMemory();
+
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  OperatorProfile *profile_;
+};
+
+}  // namespace bustub
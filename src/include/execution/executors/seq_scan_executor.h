@@ -12,14 +12,16 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/seq_scan_plan.h"
-#include "storage/table/table_iterator.h"
+#include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -50,6 +52,12 @@ class SeqScanExecutor : public AbstractExecutor {
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
+  /** The scan tests the runtime filter on tuples in place, after the filter of the plan. */
+  auto PushDownRuntimeFilter(std::function<bool(const Tuple &)> runtime_filter) -> bool override {
+    runtime_filter_ = std::move(runtime_filter);
+    return true;
+  }
+
  private:
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
@@ -57,11 +65,17 @@ class SeqScanExecutor : public AbstractExecutor {
   /** If the seqscan has any filtering condition */
   std::shared_ptr<AbstractExpression> filter_predicate_;
 
-  /** The end of cursor iterator */
-  TableIterator end_;
+  /** The filter of the parent, if it pushed one down */
+  std::function<bool(const Tuple &)> runtime_filter_;
 
-  /** The current cursor scanning the table */
-  TableIterator iterator_;
+  /** The table being scanned */
+  TableHeap *table_heap_;
+
+  /** The page the scan is at */
+  page_id_t page_id_{INVALID_PAGE_ID};
+
+  /** The last tuple produced by the scan */
+  RID rid_{};
 
   /** The current cursor scanning the table */
   // bool obtain_lock_{false};
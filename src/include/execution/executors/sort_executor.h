@@ -50,6 +50,8 @@ class SortExecutor : public AbstractExecutor {
   /** @return The output schema for the sort */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
+  auto GetMemoryUsage() const -> size_t override { return TupleMemoryUsage(sorted_tuple_); }
+
  private:
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
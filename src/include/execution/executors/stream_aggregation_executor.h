@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// stream_aggregation_executor.h
+//
+// Identification: src/include/execution/executors/stream_aggregation_executor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/executors/aggregation_executor.h"
+#include "execution/plans/stream_aggregation_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * StreamAggregationExecutor executes an aggregation over a child that emits the rows of each group next to each other.
+ * Only the group that is being read is kept; it is output as soon as a row with another key arrives.
+ */
+class StreamAggregationExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new StreamAggregationExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The streaming aggregation plan to be executed
+   * @param child The child executor, sorted by the group by columns
+   */
+  StreamAggregationExecutor(ExecutorContext *exec_ctx, const StreamAggregationPlanNode *plan,
+                            std::unique_ptr<AbstractExecutor> &&child);
+
+  /** Initialize the aggregation */
+  void Init() override;
+
+  /**
+   * Yield the next group from the aggregation.
+   * @param[out] tuple The next tuple produced by the aggregation
+   * @param[out] rid The next tuple RID, not used by the aggregation
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** @return The output schema for the aggregation */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+  auto GetMemoryUsage() const -> size_t override {
+    return group_key_.group_bys_.size() * sizeof(Value) + AggregateCombiner::GetMemoryUsage(group_value_);
+  }
+
+ private:
+  /** @return The output tuple of the current group */
+  auto MakeOutputTuple() const -> Tuple;
+
+  /** The streaming aggregation plan node */
+  const StreamAggregationPlanNode *plan_;
+  /** The child executor, sorted by the group by columns */
+  std::unique_ptr<AbstractExecutor> child_;
+  AggregateCombiner combiner_;
+
+  /** The group whose rows are being read, if has_group_ */
+  AggregateKey group_key_;
+  AggregateValue group_value_;
+  bool has_group_{false};
+  /** Whether any tuple was output, as an aggregation without groups outputs one even for an empty child */
+  bool has_output_{false};
+};
+
+}  // namespace bustub
@@ -21,11 +21,14 @@
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/topn_plan.h"
 #include "storage/table/tuple.h"
+#include "type/value.h"
 
 namespace bustub {
 
 /**
- * The TopNExecutor executor executes a topn.
+ * The TopNExecutor executor executes a topn. It keeps the first N tuples seen so far in a heap, whose top is the last
+ * of them in the order. Once the heap is full, only a tuple that comes before the top can enter it, and that test is
+ * pushed down to the child as a runtime filter, so that a scan drops the other tuples without copying them.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
@@ -50,12 +53,32 @@ class TopNExecutor : public AbstractExecutor {
   /** @return The output schema for the topn */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
+  auto GetMemoryUsage() const -> size_t override { return TupleMemoryUsage(sorted_tuple_); }
+
  private:
+  /** A tuple in the heap, with the values of its order by expressions */
+  struct Entry {
+    std::vector<Value> keys_;
+    Tuple tuple_;
+  };
+
+  /** @return the values of the order by expressions for a tuple */
+  auto MakeSortKeys(const Tuple &tuple) const -> std::vector<Value>;
+
+  /** @return whether keys come strictly before other in the order. NULLs sort first in ascending order, as in Sort. */
+  auto Before(const std::vector<Value> &keys, const std::vector<Value> &other) const -> bool;
+
+  /** @return whether a tuple with these keys enters the heap */
+  auto MayEnter(const std::vector<Value> &keys) const -> bool;
+
   /** The topn plan node to be executed */
   const TopNPlanNode *plan_;
 
   std::unique_ptr<AbstractExecutor> child_executor_;
 
+  /** The first N tuples so far, a max-heap by Before */
+  std::vector<Entry> heap_;
+
   std::deque<Tuple> sorted_tuple_;
 };
 }  // namespace bustub
@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "catalog/catalog.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/update_plan.h"
@@ -27,6 +28,11 @@ namespace bustub {
 /**
  * UpdateExecutor executes an update on a table.
  * Updated values are always pulled from a child.
+ *
+ * Tuples are updated in place when the new tuple fits in their page, so they keep their RID, and only the indexes on
+ * a changed column are touched. A tuple that no longer fits is moved: deleted, and inserted again once the child is
+ * exhausted, so that a scan of the table never meets it twice. Index changes are applied in a batch per index after
+ * the child is exhausted too, which keeps an index scan feeding the update from seeing the keys it changed.
  */
 class UpdateExecutor : public AbstractExecutor {
   friend class UpdatePlanNode;
@@ -45,12 +51,13 @@ class UpdateExecutor : public AbstractExecutor {
   void Init() override;
 
   /**
-   * Yield the next tuple from the udpate.
-   * @param[out] tuple The next tuple produced by the update
+   * Yield the number of rows updated in the table.
+   * @param[out] tuple The integer tuple indicating the number of rows updated in the table
    * @param[out] rid The next tuple RID produced by the update (ignore this)
    * @return `true` if a tuple was produced, `false` if there are no more tuples
    *
    * NOTE: UpdateExecutor::Next() does not use the `rid` out-parameter.
+   * NOTE: UpdateExecutor::Next() returns true with the number of updated rows produced only once.
    */
   auto Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool override;
 
@@ -58,11 +65,32 @@ class UpdateExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** A change to make to an index: the key of old_tuple_ goes away, the key of new_tuple_ comes in. */
+  struct IndexChange {
+    Tuple old_tuple_;
+    RID old_rid_;
+    Tuple new_tuple_;
+    RID new_rid_;
+  };
+
+  /** Build the updated version of a tuple of the table. */
+  auto UpdatedTuple(const Tuple &old_tuple) const -> Tuple;
+
+  /**
+   * Apply the changes to every index that they affect, and record them for rollback.
+   * @throw ExecutionException if a new key is already in an index, after marking the transaction aborted
+   */
+  void ApplyIndexChanges(const std::vector<IndexChange> &in_place, const std::vector<IndexChange> &moved);
+
   /** The update plan node to be executed */
   const UpdatePlanNode *plan_;
   /** Metadata identifying the table that should be updated */
-  const TableInfo *table_info_;
+  TableInfo *table_info_{nullptr};
   /** The child executor to obtain value from */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The indexes with a key column that the update may change */
+  std::vector<IndexInfo *> changed_indexes_;
+
+  bool update_result_{false};
 };
 }  // namespace bustub
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parameter_value_expression.h
+//
+// Identification: src/include/execution/expressions/parameter_value_expression.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "execution/expressions/abstract_expression.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/**
+ * ParameterValueExpression represents a parameter placeholder of a prepared statement, e.g., `$1`.
+ *
+ * A prepared statement is planned once and its plan is shared by every execution, possibly by several threads at the
+ * same time. The values of the parameters are thus not stored in the plan: each execution binds them to its own thread
+ * with a ParameterBinding, and the expression reads them from there.
+ */
+class ParameterValueExpression : public AbstractExpression {
+ public:
+  /** Creates a new parameter expression for the parameter at position param_idx, starting from 0 for `$1`. */
+  ParameterValueExpression(uint32_t param_idx, TypeId ret_type)
+      : AbstractExpression({}, ret_type), param_idx_(param_idx) {}
+
+  auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override { return GetBoundValue(); }
+
+  auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
+                    const Schema &right_schema) const -> Value override {
+    return GetBoundValue();
+  }
+
+  /** @return the string representation of the plan node and its children */
+  auto ToString() const -> std::string override { return fmt::format("${}", param_idx_ + 1); }
+
+  BUSTUB_EXPR_CLONE_WITH_CHILDREN(ParameterValueExpression);
+
+  /** @return the position of the parameter */
+  auto GetParamIdx() const -> uint32_t { return param_idx_; }
+
+ private:
+  friend class ParameterBinding;
+
+  auto GetBoundValue() const -> Value {
+    if (bound_params == nullptr || param_idx_ >= bound_params->size()) {
+      throw Exception(fmt::format("parameter ${} is not bound", param_idx_ + 1));
+    }
+    return (*bound_params)[param_idx_];
+  }
+
+  /** The parameter values of the statement the current thread executes */
+  static inline thread_local const std::vector<Value> *bound_params = nullptr;
+
+  uint32_t param_idx_;
+};
+
+/**
+ * ParameterBinding binds parameter values to the current thread for as long as it lives. The values must outlive the
+ * binding. Bindings nest: the previous values are bound again when a binding goes away.
+ */
+class ParameterBinding {
+ public:
+  explicit ParameterBinding(const std::vector<Value> *params) : previous_(ParameterValueExpression::bound_params) {
+    ParameterValueExpression::bound_params = params;
+  }
+
+  ~ParameterBinding() { ParameterValueExpression::bound_params = previous_; }
+
+  DISALLOW_COPY_AND_MOVE(ParameterBinding);
+
+ private:
+  const std::vector<Value> *previous_;
+};
+
+}  // namespace bustub
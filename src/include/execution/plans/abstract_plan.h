@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -38,10 +39,13 @@ enum class PlanType {
   Update,
   Delete,
   Aggregation,
+  StreamAggregation,
   Limit,
   NestedLoopJoin,
   NestedIndexJoin,
   HashJoin,
+  HashSemiJoin,
+  MergeJoin,
   Filter,
   Values,
   Projection,
@@ -52,6 +56,8 @@ enum class PlanType {
 
 class AbstractPlanNode;
 using AbstractPlanNodeRef = std::shared_ptr<const AbstractPlanNode>;
+/** Produces the extra text printed after a plan node, e.g. its estimated cost. */
+using PlanAnnotator = std::function<std::string(const AbstractPlanNode &)>;
 
 /**
  * AbstractPlanNode represents all the possible types of plan nodes in our system.
@@ -84,12 +90,18 @@ class AbstractPlanNode {
   /** @return the type of this plan node */
   virtual auto GetType() const -> PlanType = 0;
 
-  /** @return the string representation of the plan node and its children */
-  auto ToString(bool with_schema = true) const -> std::string {
+  /**
+   * @return the string representation of the plan node and its children
+   * @param with_schema whether to print the output schema of every node
+   * @param annotator if set, its text is printed after every node
+   */
+  auto ToString(bool with_schema = true, const PlanAnnotator &annotator = nullptr) const -> std::string {
+    auto annotation = annotator ? fmt::format(" | {}", annotator(*this)) : "";
     if (with_schema) {
-      return fmt::format("{} | {}{}", PlanNodeToString(), output_schema_, ChildrenToString(2, with_schema));
+      return fmt::format("{} | {}{}{}", PlanNodeToString(), output_schema_, annotation,
+                         ChildrenToString(2, with_schema, annotator));
     }
-    return fmt::format("{}{}", PlanNodeToString(), ChildrenToString(2, with_schema));
+    return fmt::format("{}{}{}", PlanNodeToString(), annotation, ChildrenToString(2, with_schema, annotator));
   }
 
   /** @return the cloned plan node with new children */
@@ -110,7 +122,8 @@ class AbstractPlanNode {
   virtual auto PlanNodeToString() const -> std::string { return "<unknown>"; }
 
   /** @return the string representation of the plan node's children */
-  auto ChildrenToString(int indent, bool with_schema = true) const -> std::string;
+  auto ChildrenToString(int indent, bool with_schema = true, const PlanAnnotator &annotator = nullptr) const
+      -> std::string;
 
  private:
 };
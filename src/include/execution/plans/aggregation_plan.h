@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -26,11 +27,19 @@
 namespace bustub {
 
 /** AggregationType enumerates all the possible aggregation functions in our system */
-enum class AggregationType { CountStarAggregate, CountAggregate, SumAggregate, MinAggregate, MaxAggregate };
+enum class AggregationType {
+  CountStarAggregate,
+  CountAggregate,
+  SumAggregate,
+  MinAggregate,
+  MaxAggregate,
+  AvgAggregate
+};
 
 /**
  * AggregationPlanNode represents the various SQL aggregation functions.
- * For example, COUNT(), SUM(), MIN() and MAX().
+ * For example, COUNT(), SUM(), MIN(), MAX() and AVG(), each of which may only aggregate the DISTINCT values of its
+ * input.
  *
  * NOTE: To simplify this project, AggregationPlanNode must always have exactly one child.
  */
@@ -43,13 +52,18 @@ class AggregationPlanNode : public AbstractPlanNode {
    * @param group_bys The group by clause of the aggregation
    * @param aggregates The expressions that we are aggregating
    * @param agg_types The types that we are aggregating
+   * @param distinct Whether each aggregate only sees the distinct values of its input, none of them if empty
    */
   AggregationPlanNode(SchemaRef output_schema, AbstractPlanNodeRef child, std::vector<AbstractExpressionRef> group_bys,
-                      std::vector<AbstractExpressionRef> aggregates, std::vector<AggregationType> agg_types)
+                      std::vector<AbstractExpressionRef> aggregates, std::vector<AggregationType> agg_types,
+                      std::vector<bool> distinct = {})
       : AbstractPlanNode(std::move(output_schema), {std::move(child)}),
         group_bys_(std::move(group_bys)),
         aggregates_(std::move(aggregates)),
-        agg_types_(std::move(agg_types)) {}
+        agg_types_(std::move(agg_types)),
+        distinct_(std::move(distinct)) {
+    distinct_.resize(agg_types_.size(), false);
+  }
 
   /** @return The type of the plan node */
   auto GetType() const -> PlanType override { return PlanType::Aggregation; }
@@ -75,6 +89,9 @@ class AggregationPlanNode : public AbstractPlanNode {
   /** @return The aggregate types */
   auto GetAggregateTypes() const -> const std::vector<AggregationType> & { return agg_types_; }
 
+  /** @return Whether each aggregate only sees the distinct values of its input */
+  auto GetDistinct() const -> const std::vector<bool> & { return distinct_; }
+
   static auto InferAggSchema(const std::vector<AbstractExpressionRef> &group_bys,
                              const std::vector<AbstractExpressionRef> &aggregates,
                              const std::vector<AggregationType> &agg_types) -> Schema;
@@ -87,6 +104,8 @@ class AggregationPlanNode : public AbstractPlanNode {
   std::vector<AbstractExpressionRef> aggregates_;
   /** The aggregation types */
   std::vector<AggregationType> agg_types_;
+  /** Whether each aggregation is over the DISTINCT values of its input */
+  std::vector<bool> distinct_;
 
  protected:
   auto PlanNodeToString() const -> std::string override;
@@ -100,10 +119,14 @@ struct AggregateKey {
   /**
    * Compares two aggregate keys for equality.
    * @param other the other aggregate key to be compared with
-   * @return `true` if both aggregate keys have equivalent group-by expressions, `false` otherwise
+   * @return `true` if both aggregate keys have equivalent group-by expressions, `false` otherwise. Like in GROUP BY
+   * and DISTINCT, NULL is equivalent to NULL.
    */
   auto operator==(const AggregateKey &other) const -> bool {
     for (uint32_t i = 0; i < other.group_bys_.size(); i++) {
+      if (group_bys_[i].IsNull() && other.group_bys_[i].IsNull()) {
+        continue;
+      }
       if (group_bys_[i].CompareEquals(other.group_bys_[i]) != CmpBool::CmpTrue) {
         return false;
       }
@@ -112,12 +135,6 @@ struct AggregateKey {
   }
 };
 
-/** AggregateValue represents a value for each of the running aggregates */
-struct AggregateValue {
-  /** The aggregate values */
-  std::vector<Value> aggregates_;
-};
-
 }  // namespace bustub
 
 namespace std {
@@ -138,6 +155,20 @@ struct hash<bustub::AggregateKey> {
 
 }  // namespace std
 
+namespace bustub {
+
+/** AggregateValue represents a value for each of the running aggregates */
+struct AggregateValue {
+  /** The aggregate values, the running sum for an AVG */
+  std::vector<Value> aggregates_;
+  /** The number of values summed up by each AVG */
+  std::vector<int64_t> counts_{};
+  /** The values already aggregated by each DISTINCT aggregate */
+  std::vector<std::unordered_set<AggregateKey>> distinct_values_{};
+};
+
+}  // namespace bustub
+
 template <>
 struct fmt::formatter<bustub::AggregationType> : formatter<std::string> {
   template <typename FormatContext>
@@ -160,6 +191,9 @@ struct fmt::formatter<bustub::AggregationType> : formatter<std::string> {
       case AggregationType::MaxAggregate:
         name = "max";
         break;
+      case AggregationType::AvgAggregate:
+        name = "avg";
+        break;
     }
     return formatter<std::string>::format(name, ctx);
   }
@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_semi_join_plan.h
+//
+// Identification: src/include/execution/plans/hash_semi_join_plan.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/table_ref/bound_join_ref.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * HashSemiJoinPlanNode outputs the left tuples that have (semi join) or do not have (anti join) a right tuple with the
+ * same keys, each at most once. It is what `EXISTS`, `IN` and their negations are planned as, with the keys coming
+ * from the equalities that correlate the subquery with the query around it, and from the `IN`.
+ *
+ * A NULL key never matches. A null-aware anti join additionally follows `NOT IN`, where the last key is the value
+ * looked up: a left tuple whose value is NULL, or whose value is not found among right values that include a NULL, is
+ * unknown and not output either, unless there are no right tuples for the other keys at all.
+ */
+class HashSemiJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new HashSemiJoinPlanNode instance.
+   * @param output_schema The output schema, the one of the left plan
+   * @param left The plan whose tuples are output
+   * @param right The plan whose tuples are looked for
+   * @param left_key_expressions The keys of the left tuples
+   * @param right_key_expressions The keys of the right tuples
+   * @param join_type SEMI or ANTI
+   * @param null_aware If the anti join follows the NULL semantics of `NOT IN`
+   */
+  HashSemiJoinPlanNode(SchemaRef output_schema, AbstractPlanNodeRef left, AbstractPlanNodeRef right,
+                       std::vector<AbstractExpressionRef> left_key_expressions,
+                       std::vector<AbstractExpressionRef> right_key_expressions, JoinType join_type, bool null_aware)
+      : AbstractPlanNode(std::move(output_schema), {std::move(left), std::move(right)}),
+        left_key_expressions_{std::move(left_key_expressions)},
+        right_key_expressions_{std::move(right_key_expressions)},
+        join_type_(join_type),
+        null_aware_(null_aware) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::HashSemiJoin; }
+
+  /** @return The expressions to compute the left join keys */
+  auto LeftJoinKeyExpressions() const -> const std::vector<AbstractExpressionRef> & { return left_key_expressions_; }
+
+  /** @return The expressions to compute the right join keys */
+  auto RightJoinKeyExpressions() const -> const std::vector<AbstractExpressionRef> & { return right_key_expressions_; }
+
+  /** @return The left plan node of the join, whose tuples are output */
+  auto GetLeftPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 2, "Hash semi joins should have exactly two children plans.");
+    return GetChildAt(0);
+  }
+
+  /** @return The right plan node of the join */
+  auto GetRightPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 2, "Hash semi joins should have exactly two children plans.");
+    return GetChildAt(1);
+  }
+
+  /** @return SEMI or ANTI */
+  auto GetJoinType() const -> JoinType { return join_type_; };
+
+  /** @return If the anti join follows the NULL semantics of `NOT IN` */
+  auto IsNullAware() const -> bool { return null_aware_; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(HashSemiJoinPlanNode);
+
+  /** The expressions to compute the left join keys */
+  std::vector<AbstractExpressionRef> left_key_expressions_;
+  /** The expressions to compute the right join keys */
+  std::vector<AbstractExpressionRef> right_key_expressions_;
+
+  /** The join type, SEMI or ANTI */
+  JoinType join_type_;
+
+  /** If the anti join follows the NULL semantics of `NOT IN` */
+  bool null_aware_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -12,8 +12,10 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
@@ -21,33 +23,62 @@
 
 namespace bustub {
 /**
- * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
+ * IndexScanPlanNode identifies a table that should be scanned through one of its indexes. Without a key it scans a
+ * B+ tree index in key order, with a key it only looks up the tuples whose index key equals it.
+ *
+ * The scan may also filter the tuples it reads, and stop after a number of tuples pass the filter. A bounded scan of
+ * a B+ tree answers `ORDER BY key LIMIT n` by reading little more than the first n qualifying tuples.
  */
 class IndexScanPlanNode : public AbstractPlanNode {
  public:
   /**
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
-   * @param table_oid the identifier of table to be scanned
+   * @param index_oid the identifier of the index to be scanned
+   * @param pred_key a constant expression for the key to look up, or nullptr to scan the whole index
+   * @param filter_predicate the predicate the tuples must satisfy, or nullptr to produce them all
+   * @param limit the number of tuples after which the scan stops, or std::nullopt to produce them all
    */
-  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
-      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, AbstractExpressionRef pred_key = nullptr,
+                    AbstractExpressionRef filter_predicate = nullptr, std::optional<size_t> limit = std::nullopt)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        pred_key_(std::move(pred_key)),
+        filter_predicate_(std::move(filter_predicate)),
+        limit_(limit) {}
 
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
-  /** @return the identifier of the table that should be scanned */
+  /** @return the identifier of the index that should be scanned */
   auto GetIndexOid() const -> index_oid_t { return index_oid_; }
 
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(IndexScanPlanNode);
 
-  /** The table whose tuples should be scanned. */
+  /** The index whose tuples should be scanned. */
   index_oid_t index_oid_;
 
-  // Add anything you want here for index lookup
+  /** The key to look up, nullptr for a full scan. */
+  AbstractExpressionRef pred_key_;
+
+  /** The predicate the produced tuples satisfy, nullptr if there is none. */
+  AbstractExpressionRef filter_predicate_;
+
+  /** The number of tuples after which the scan stops, std::nullopt if it is not bounded. */
+  std::optional<size_t> limit_;
 
  protected:
   auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
+    std::vector<std::string> attrs{fmt::format("index_oid={}", index_oid_)};
+    if (pred_key_ != nullptr) {
+      attrs.push_back(fmt::format("pred_key={}", pred_key_));
+    }
+    if (filter_predicate_ != nullptr) {
+      attrs.push_back(fmt::format("filter={}", filter_predicate_));
+    }
+    if (limit_.has_value()) {
+      attrs.push_back(fmt::format("limit={}", *limit_));
+    }
+    return fmt::format("IndexScan {{ {} }}", fmt::join(attrs, ", "));
   }
 };
 
@@ -0,0 +1,44 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// stream_aggregation_plan.h
+//
+// Identification: src/include/execution/plans/stream_aggregation_plan.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "execution/plans/aggregation_plan.h"
+
+namespace bustub {
+
+/**
+ * StreamAggregationPlanNode is an aggregation whose child emits the rows of each group next to each other, because it
+ * is sorted by the GROUP BY columns. Every group is output as soon as the next one starts, so only one is kept in
+ * memory, and the groups come out in the order of the child.
+ */
+class StreamAggregationPlanNode : public AggregationPlanNode {
+ public:
+  /**
+   * Construct a new StreamAggregationPlanNode that computes the same as an aggregation over a sorted child.
+   * @param aggregation The aggregation plan node, whose child is sorted by its group by columns
+   */
+  explicit StreamAggregationPlanNode(const AggregationPlanNode &aggregation) : AggregationPlanNode(aggregation) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::StreamAggregation; }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(StreamAggregationPlanNode);
+
+ protected:
+  auto PlanNodeToString() const -> std::string override;
+};
+
+}  // namespace bustub
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// result_cursor.h
+//
+// Identification: src/include/execution/result_cursor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/abstract_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/** The number of tuples a streamed result is delivered in at a time. */
+static constexpr size_t RESULT_BATCH_SIZE = 1024;
+
+/**
+ * ResultCursor pulls the result of a query from its root executor in batches, for applications that embed BusTub and
+ * consume rows at their own pace. Only one batch is held in memory at a time, and the first batch is available as soon
+ * as the executors have produced it, rather than once the whole query has run.
+ *
+ * The cursor must not outlive the transaction it executes in. The query is run by the thread calling Next().
+ */
+class ResultCursor {
+ public:
+  /**
+   * Create a cursor over the result of a plan. The executors are only initialized by the first call to Next().
+   * @param exec_ctx The executor context the query executes in
+   * @param plan The plan to execute
+   * @param schema The schema of the tuples the cursor delivers
+   * @param batch_size The maximum number of tuples delivered by a call to Next()
+   */
+  ResultCursor(std::unique_ptr<ExecutorContext> exec_ctx, AbstractPlanNodeRef plan, SchemaRef schema,
+               size_t batch_size = RESULT_BATCH_SIZE);
+
+  DISALLOW_COPY_AND_MOVE(ResultCursor);
+
+  /** @return the schema of the delivered tuples */
+  auto GetSchema() const -> const Schema & { return *schema_; }
+
+  /**
+   * Fetch the next batch of the result.
+   * @param[out] batch Cleared, then filled with at most batch_size tuples
+   * @return `false` once the result is exhausted, in which case the batch is empty
+   * @throws ExecutionException if the query fails
+   */
+  auto Next(std::vector<Tuple> *batch) -> bool;
+
+ private:
+  std::unique_ptr<ExecutorContext> exec_ctx_;
+  /** The plan, which the executors point into */
+  AbstractPlanNodeRef plan_;
+  std::unique_ptr<AbstractExecutor> executor_;
+  SchemaRef schema_;
+  size_t batch_size_;
+  bool is_initialized_{false};
+  bool is_exhausted_{false};
+};
+
+}  // namespace bustub
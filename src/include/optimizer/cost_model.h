@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// cost_model.h
+//
+// Identification: src/include/optimizer/cost_model.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/** PlanCost is the estimated output of a plan node, and the estimated work to produce it, children included. */
+struct PlanCost {
+  /** The number of rows the node produces */
+  double rows_{0};
+  /** The work of the node and its children, roughly in tuples touched */
+  double cost_{0};
+};
+
+/** ColumnOrigin is the table column that an output column of a plan passes on unchanged. */
+struct ColumnOrigin {
+  /** The table, or nullptr for a mock table */
+  TableInfo *table_;
+  uint32_t col_idx_;
+  /** The estimated number of rows of the table */
+  double table_rows_;
+};
+
+/**
+ * CostModel estimates how many rows plan nodes produce and how much work they take. Table sizes are the live tuple
+ * counts the table heaps keep; distinct counts and histograms come from the statistics ANALYZE collects, and the
+ * columns of tables that were never analyzed are assumed to hold unique values. Predicates without statistics to go by
+ * get fixed default selectivities.
+ *
+ * The cost of every join algorithm is exposed on its own, so that the join enumerator and EXPLAIN agree on costs.
+ */
+class CostModel {
+ public:
+  static constexpr double DEFAULT_EQ_SELECTIVITY = 0.1;
+  /** The selectivity of ranges, and of predicates the model cannot look into */
+  static constexpr double DEFAULT_SELECTIVITY = 1.0 / 3;
+  /** The number of children of an inner index page, which decides how many levels an index lookup walks */
+  static constexpr double INDEX_FANOUT = 100;
+
+  explicit CostModel(const Catalog &catalog) : catalog_(catalog) {}
+
+  /**
+   * Estimate a plan node. Estimates are cached by node, so the plan must stay alive as long as the model is used.
+   * @param plan the plan node, whose children are estimated as well
+   */
+  auto Estimate(const AbstractPlanNode &plan) -> PlanCost;
+
+  /** @return the estimate of a plan node, formatted for EXPLAIN */
+  auto Annotate(const AbstractPlanNode &plan) -> std::string;
+
+  /**
+   * Estimate the fraction of the input rows that satisfy a predicate.
+   * @param pred the predicate
+   * @param inputs the plans whose tuples the predicate refers to, by tuple index: one for a filter, two for a join
+   */
+  auto Selectivity(const AbstractExpression &pred, const std::vector<const AbstractPlanNode *> &inputs) const
+      -> double;
+
+  /** @return the table column that an output column of a plan comes from, if it is passed on unchanged */
+  auto ResolveColumn(const AbstractPlanNode &plan, uint32_t col_idx) const -> std::optional<ColumnOrigin>;
+
+  /** @return the number of rows of a table, as its table heap counts them */
+  static auto TableRows(TableInfo *table) -> double;
+
+  /** The nested loop join runs the whole right side again for every left tuple. */
+  static auto NestedLoopJoinCost(const PlanCost &left, const PlanCost &right, double rows) -> double;
+
+  /** The hash join reads each side once, and builds its hash table over the right side. */
+  static auto HashJoinCost(const PlanCost &left, const PlanCost &right, double rows) -> double;
+
+  /** The merge join reads each side once, in the order of the join keys, and keeps no hash table. */
+  static auto MergeJoinCost(const PlanCost &left, const PlanCost &right, double rows) -> double;
+
+  /** The nested index join looks up every outer tuple in an index of a table of inner_rows rows. */
+  static auto IndexJoinCost(const PlanCost &outer, double inner_rows, double rows) -> double;
+
+ private:
+  auto EstimateNode(const AbstractPlanNode &plan) -> PlanCost;
+
+  /** @return the estimated number of distinct values of a column of a plan, if it comes from a table */
+  auto DistinctCount(const AbstractExpression &expr, const std::vector<const AbstractPlanNode *> &inputs) const
+      -> std::optional<double>;
+
+  auto ComparisonSelectivity(const AbstractExpression &pred, const std::vector<const AbstractPlanNode *> &inputs) const
+      -> double;
+
+  const Catalog &catalog_;
+  std::unordered_map<const AbstractPlanNode *, PlanCost> estimates_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// expression_util.h
+//
+// Identification: src/include/optimizer/expression_util.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+
+namespace bustub {
+
+/** @return true if the expression is the constant `true` */
+auto IsConstantTrue(const AbstractExpression &expr) -> bool;
+
+/**
+ * Split a predicate into the conjuncts of its AND chain. Conjuncts that are the constant `true` are left out.
+ * @param expr the predicate
+ * @param[out] conjuncts the conjuncts are appended here
+ */
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts);
+
+/** @return the AND of the conjuncts, or the constant `true` if there are none */
+auto ConjoinExpressions(const std::vector<AbstractExpressionRef> &conjuncts) -> AbstractExpressionRef;
+
+/**
+ * Renumber the columns of a join predicate, which refers to the left tuple as tuple 0 and the right tuple as tuple 1,
+ * as columns of a single tuple.
+ * @param expr the join predicate
+ * @param left_offset the position of the first left column in the single tuple
+ * @param right_offset the position of the first right column in the single tuple
+ */
+auto FlattenJoinColumns(const AbstractExpressionRef &expr, uint32_t left_offset, uint32_t right_offset)
+    -> AbstractExpressionRef;
+
+/**
+ * Replace every column of an expression by the expression that computes it from the tuple below, e.g. to move an
+ * expression below a projection.
+ * @param expr the expression
+ * @param columns the expression that computes each column of the tuple the expression refers to
+ */
+auto SubstituteColumns(const AbstractExpressionRef &expr, const std::vector<AbstractExpressionRef> &columns)
+    -> AbstractExpressionRef;
+
+}  // namespace bustub
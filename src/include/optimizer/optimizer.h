@@ -43,6 +43,34 @@ class Optimizer {
    */
   auto OptimizeMergeFilterNLJ(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief push every conjunct of a filter as far down the plan as it can go: through projections, sorts and the group
+   * by columns of aggregations, to the side of a join it refers to, and into the filter of a seq scan. Conjuncts on
+   * both sides of a join become part of the join predicate.
+   */
+  auto OptimizePredicatePushdown(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief push conjuncts over the output of a plan node into the node, or as close to the tables as possible.
+   * @return the plan, which applies the conjuncts
+   */
+  auto PushDownConjuncts(const AbstractPlanNodeRef &plan, std::vector<AbstractExpressionRef> conjuncts)
+      -> AbstractPlanNodeRef;
+
+  /**
+   * @brief evaluate the expressions of filters, joins, projections and scans that do not depend on any column, and
+   * simplify AND and OR with a constant side. Filters that become always true are removed.
+   */
+  auto OptimizeConstantFolding(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief reorder a tree of inner nested loop joins by cost. The relations and predicates of the tree form a join
+   * graph, and a dynamic program over its subsets (DPsub) picks the cheapest order along with a nested loop, hash or
+   * nested index join for every join. Predicates of a single relation become a filter below the joins. Cardinalities
+   * come from the statistics of ANALYZE, see CostModel.
+   */
+  auto OptimizeJoinOrder(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief optimize nested loop join into hash join.
    * In the starter code, we will check NLJs with exactly one equal condition. You can further support optimizing joins
@@ -51,7 +79,27 @@ class Optimizer {
   auto OptimizeNLJAsHashJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
   /**
-   * @brief optimize nested loop join into index join.
+   * @brief optimize hash join into merge join when both of its inputs already come sorted by their join keys, e.g.
+   * from a B+ tree index scan or a sort. See OutputOrdering.
+   */
+  auto OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief optimize aggregation into streaming aggregation when its child already comes sorted by the group by
+   * columns, so that one group is kept in memory instead of all of them. See OutputOrdering.
+   */
+  auto OptimizeAggregationAsStreamAggregation(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief the sort order of the output of a plan, a plan property derived from its nodes: index scans and sorts
+   * produce an order, filters, limits, projections, streaming aggregations and the left side of joins pass it on.
+   * @return the columns that the output is sorted by in ascending order, most significant first, or none
+   */
+  auto OutputOrdering(const AbstractPlanNode &plan) const -> std::vector<uint32_t>;
+
+  /**
+   * @brief optimize nested loop join into index join. Unless the starter rules are forced, the index join is only
+   * picked when the cost model finds it cheaper than the hash join the equi-join would become otherwise.
    */
   auto OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
@@ -65,6 +113,13 @@ class Optimizer {
    */
   auto OptimizeMergeFilterScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief optimize a seq scan filtered by `column = constant` into a point lookup on an index of that column. A hash
+   * index is preferred over a B+ tree when the column has both. Any other conjuncts of the filter are kept in a filter
+   * above the index scan.
+   */
+  auto OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief rewrite expression to be used in nested loop joins. e.g., if we have `SELECT * FROM a, b WHERE a.x = b.y`,
    * we will have `#0.x = #0.y` in the filter plan node. We will need to figure out where does `0.x` and `0.y` belong
@@ -81,7 +136,8 @@ class Optimizer {
   auto IsPredicateTrue(const AbstractExpression &expr) -> bool;
 
   /**
-   * @brief optimize order by as index scan if there's an index on a table
+   * @brief optimize order by as index scan if there's an index on a table. The filter of the scan, if any, moves into
+   * the index scan.
    */
   auto OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
@@ -89,17 +145,28 @@ class Optimizer {
   auto MatchIndex(const std::string &table_name, uint32_t index_key_idx)
       -> std::optional<std::tuple<index_oid_t, std::string>>;
 
+  /**
+   * @brief move a sort or a limit below the projection under it, so that it can reach the scan, e.g. to become an
+   * index scan. A sort only moves if its keys are columns of the tuples below the projection.
+   */
+  auto OptimizeSortLimitBelowProjection(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief optimize a limit over an index scan into a bounded index scan, which stops reading the index after enough
+   * tuples passed its filter. With OptimizeOrderByAsIndexScan, `ORDER BY key LIMIT n` reads only about n tuples.
+   */
+  auto OptimizeLimitAsBoundedIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief optimize sort + limit as top N
    */
   auto OptimizeSortLimitAsTopN(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
   /**
-   * @brief get the estimated cardinality for a table based on the table name. Useful when join reordering. BusTub
-   * doesn't support statistics for now, so it's the only way for you to get the table size :(
+   * @brief get the number of rows of a table, which its table heap keeps up to date on every insert and delete.
    *
    * @param table_name
-   * @return std::optional<size_t>
+   * @return the row count, or std::nullopt if there is no such table
    */
   auto EstimatedCardinality(const std::string &table_name) -> std::optional<size_t>;
 
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// plan_cache.h
+//
+// Identification: src/include/planner/plan_cache.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "catalog/schema.h"
+#include "common/stats.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/** CachedPlan is an optimized plan, ready to be executed again. */
+struct CachedPlan {
+  AbstractPlanNodeRef plan_;
+  /** The output schema of the statement, whose column names the optimizer may have lost in the plan */
+  SchemaRef schema_;
+  /** The version of the catalog the plan was made at */
+  uint64_t catalog_version_{0};
+};
+
+/**
+ * PlanCache keeps the optimized plans of the most recently executed statements, so that a statement that is executed
+ * again skips the parser, the binder, the planner and the optimizer. Statements are looked up by their normalized SQL
+ * text. A plan made at an older version of the catalog is never returned, since a new index or new statistics may
+ * make it worse, or a new table wrong. When the cache is full, the least recently used plan is evicted.
+ *
+ * The cache is shared by all the threads of an instance.
+ */
+class PlanCache {
+ public:
+  static constexpr size_t DEFAULT_CAPACITY = 128;
+
+  explicit PlanCache(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity) {}
+
+  /**
+   * Normalize a SQL statement into a cache key: whitespace is collapsed and keywords and names are lower-cased,
+   * except inside quotes, and a trailing semicolon is dropped.
+   */
+  static auto Normalize(const std::string &sql) -> std::string;
+
+  /** @return whether a normalized statement may be cached: only SELECT, INSERT, UPDATE and DELETE are */
+  static auto IsCacheable(const std::string &key) -> bool;
+
+  /** @return the plan cached for a key, unless there is none or it was made at another catalog version */
+  auto Get(const std::string &key, uint64_t catalog_version) -> std::optional<CachedPlan>;
+
+  /** Cache the plan of a key, replacing the one it had. */
+  void Put(const std::string &key, CachedPlan plan);
+
+  /** Drop every plan, e.g. because a setting the optimizer reads has changed. */
+  void Clear();
+
+  /** @return the number of cached plans */
+  auto Size() -> size_t;
+
+  StatCounter hits_;
+  StatCounter misses_;
+  StatCounter evictions_;
+
+ private:
+  using Entry = std::pair<std::string, CachedPlan>;
+
+  std::mutex latch_;
+  size_t capacity_;
+  /** The cached plans, the most recently used first */
+  std::list<Entry> lru_list_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> entries_;
+};
+
+}  // namespace bustub
@@ -35,6 +35,7 @@ class BoundJoinRef;
 class BoundExpressionListRef;
 class BoundAggCall;
 class BoundCTERef;
+class BoundSubqueryExpr;
 class ColumnValueExpression;
 
 /**
@@ -44,7 +45,7 @@ class PlannerContext {
  public:
   PlannerContext() = default;
 
-  void AddAggregation(std::unique_ptr<BoundExpression> expr);
+  void AddAggregation(const BoundExpression *expr);
 
   /** Indicates whether aggregation is allowed in this context. */
   bool allow_aggregation_{false};
@@ -55,9 +56,10 @@ class PlannerContext {
   /**
    * In the first phase of aggregation planning, we put all agg calls expressions into this vector.
    * The expressions in this vector should be used over the output of the original filter / table
-   * scan plan node.
+   * scan plan node. They point into the bound statement, which planning leaves as it is, so that a prepared
+   * statement can be planned again.
    */
-  std::vector<std::unique_ptr<BoundExpression>> aggregations_;
+  std::vector<const BoundExpression *> aggregations_;
 
   /**
    * In the second phase of aggregation planning, we plan agg calls from `aggregations_`, and generate
@@ -87,6 +89,18 @@ class Planner {
 
   auto PlanSelect(const SelectStatement &statement) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief Plan a WHERE clause over its FROM clause
+   *
+   * `[NOT] EXISTS` and `[NOT] IN` subqueries among the ANDed conditions are decorrelated into semi and anti joins,
+   * which run after a filter of the other conditions.
+   */
+  auto PlanWhere(const BoundExpression &where, AbstractPlanNodeRef child) -> AbstractPlanNodeRef;
+
+  /** Plan a subquery condition as a semi join (or an anti join if negated) of the left plan with the subquery. */
+  auto PlanSubqueryPredicate(const BoundSubqueryExpr &expr, bool negated, AbstractPlanNodeRef left)
+      -> AbstractPlanNodeRef;
+
   /**
    * @brief Plan a `BoundTableRef`
    *
@@ -110,7 +124,7 @@ class Planner {
 
   auto PlanExpressionListRef(const BoundExpressionListRef &table_ref) -> AbstractPlanNodeRef;
 
-  void AddAggCallToContext(BoundExpression &expr);
+  void AddAggCallToContext(const BoundExpression &expr);
 
   auto PlanExpression(const BoundExpression &expr, const std::vector<AbstractPlanNodeRef> &children)
       -> std::tuple<std::string, AbstractExpressionRef>;
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// client.h
+//
+// Identification: src/include/server/client.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "common/macros.h"
+#include "server/wire_protocol.h"
+
+namespace bustub {
+
+/** The answer of a server to a query. */
+struct QueryResult {
+  /** RESULT, FAILED or ERROR, see wire_protocol.h */
+  FrameTag tag_;
+  /** The rows returned, or the error message */
+  std::string payload_;
+
+  auto IsSuccessful() const -> bool { return tag_ == FrameTag::RESULT; }
+};
+
+/**
+ * Client is a connection to a BusTub server, and thus a session in it. A client sends one query at a time.
+ */
+class Client {
+ public:
+  Client() = default;
+
+  ~Client();
+
+  DISALLOW_COPY_AND_MOVE(Client);
+
+  /** Connect to a server listening on a TCP port. */
+  void ConnectTcp(const std::string &host, uint16_t port);
+
+  /** Connect to a server listening on a Unix domain socket. */
+  void ConnectUnix(const std::string &path);
+
+  /**
+   * Send a query to the server, and wait for its answer.
+   * @throws Exception if the connection is lost
+   */
+  auto Execute(const std::string &sql) -> QueryResult;
+
+ private:
+  int fd_{-1};
+};
+
+}  // namespace bustub
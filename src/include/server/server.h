@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// server.h
+//
+// Identification: src/include/server/server.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "common/bustub_instance.h"
+#include "common/macros.h"
+#include "server/session.h"
+
+namespace bustub {
+
+/** The number of threads executing queries in a server, unless told otherwise. */
+static constexpr size_t SERVER_DEFAULT_WORKERS = 8;
+
+/**
+ * Server lets many clients query a BusTub instance at the same time over local sockets, each in a session of its
+ * own, with the protocol described in wire_protocol.h.
+ *
+ * A single thread waits on every socket with epoll. When a client has sent something, its connection is queued for a
+ * fixed pool of workers, which read what has arrived without waiting for more, then execute and answer the queries
+ * that came in full. A connection is only watched again once they are answered, so a session never executes two
+ * queries at a time, and neither hundreds of idle sessions nor a client that sends half a query hold a thread.
+ * Answers the client does not take right away are kept, and the connection is watched until it can send them; no
+ * more of its queries are read meanwhile, so a client that stops reading holds neither a thread nor more memory.
+ */
+class Server {
+ public:
+  /**
+   * Create a server for a BusTub instance, which must outlive it.
+   * @param bustub The instance the clients query
+   * @param worker_cnt The number of threads executing queries
+   */
+  explicit Server(BustubInstance *bustub, size_t worker_cnt = SERVER_DEFAULT_WORKERS);
+
+  /** Stop the server, closing every connection and rolling back the transactions left open. */
+  ~Server();
+
+  DISALLOW_COPY_AND_MOVE(Server);
+
+  /**
+   * Accept connections on a TCP port of the loopback interface. Must be called before Start().
+   * @param port The port, or 0 for any free port
+   * @return the port listened on
+   */
+  auto ListenTcp(uint16_t port) -> uint16_t;
+
+  /** Accept connections on a Unix domain socket, created at path. Must be called before Start(). */
+  void ListenUnix(const std::string &path);
+
+  /** Start serving the clients, in background threads. */
+  void Start();
+
+  /** Stop serving the clients. Queries being executed are finished first. */
+  void Stop();
+
+  /** @return the number of connected clients */
+  auto GetSessionCount() -> size_t;
+
+ private:
+  /** A connected client. */
+  struct Connection {
+    Connection(int fd, BustubInstance *bustub) : fd_(fd), session_(bustub) {}
+    int fd_;
+    Session session_;
+    /** The bytes received that do not make a whole frame yet */
+    std::string received_;
+    /** The bytes of answers the client did not take yet */
+    std::string unsent_;
+  };
+
+  void PollLoop();
+  void WorkerLoop();
+  void Accept(int listen_fd);
+  /**
+   * Send what a client did not take yet, then read what it has sent, and execute and answer the queries that arrived
+   * in full.
+   */
+  void Serve(int fd);
+  /** Wait for the events of a connection again, as only the poller does. */
+  void Watch(int fd, uint32_t events);
+  void CloseConnection(int fd);
+
+  BustubInstance *bustub_;
+  size_t worker_cnt_;
+  int epoll_fd_{-1};
+  /** Written to wake the poller up when the server stops */
+  int wakeup_fd_{-1};
+  std::vector<int> listen_fds_;
+  std::vector<std::string> unix_paths_;
+
+  std::mutex latch_;
+  std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+  /** The connections whose client has sent a query, for the workers to serve */
+  std::deque<int> ready_fds_;
+  std::condition_variable ready_cv_;
+  bool is_stopping_{false};
+
+  std::thread poller_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// session.h
+//
+// Identification: src/include/server/session.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "common/bustub_instance.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+class Transaction;
+
+/**
+ * Session is the state a client keeps in a BusTub instance across its queries: its variables, its prepared statements,
+ * and the transaction it opened with BEGIN, if any. Many sessions may execute queries in the same instance at the same
+ * time, but a session executes one query at a time.
+ */
+class Session {
+ public:
+  explicit Session(BustubInstance *bustub) : bustub_(bustub) {}
+
+  /** Roll back the transaction left open by the session, if any. */
+  ~Session();
+
+  DISALLOW_COPY_AND_MOVE(Session);
+
+  /**
+   * Execute SQL in the session. `BEGIN`, `COMMIT` and `ROLLBACK` (or `ABORT`) control the transaction of the session.
+   * Other statements run in the open transaction, or else in a transaction of their own, which is committed if they
+   * succeed and rolled back if not.
+   * @return `true` if the statements succeeded, `false` otherwise
+   */
+  auto Execute(const std::string &sql, ResultWriter &writer) -> bool;
+
+  /** @return the transaction opened with BEGIN, or nullptr */
+  auto GetTransaction() const -> Transaction * { return txn_; }
+
+  /** @return the value of a session variable, or an empty string */
+  auto GetVariable(const std::string &key) const -> std::string {
+    return BustubInstance::GetSessionVariable(variables_, key);
+  }
+
+ private:
+  void Abort(Transaction *txn);
+
+  BustubInstance *bustub_;
+  SessionVariables variables_;
+  PreparedStatements prepared_statements_;
+  Transaction *txn_{nullptr};
+};
+
+}  // namespace bustub
@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// wire_protocol.h
+//
+// Identification: src/include/server/wire_protocol.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bustub {
+
+/**
+ * The BusTub wire protocol is made of frames: a one-byte tag, the length of the payload as a 4-byte big-endian
+ * integer, then the payload. A client sends QUERY frames holding one or more SQL statements, and the server answers
+ * each of them with exactly one frame, in order:
+ *
+ * - RESULT: the statements succeeded. The payload holds the rows they returned, one per line, every cell followed by
+ *   a tab, like `bustub-sqllogictest` prints them.
+ * - FAILED: the statements were executed, but one of them failed, e.g. on a conflict. The payload is as for RESULT.
+ * - ERROR: the statements could not be executed, e.g. because they do not parse. The payload is the error message.
+ *
+ * `BEGIN`, `COMMIT` and `ROLLBACK` open and end a transaction spanning several queries of a session. Outside of one,
+ * every query runs in a transaction of its own.
+ */
+enum class FrameTag : char {
+  QUERY = 'Q',
+  RESULT = 'R',
+  FAILED = 'F',
+  ERROR = 'E',
+};
+
+/** The largest payload a frame may have. */
+static constexpr uint32_t MAX_FRAME_PAYLOAD = 64 * 1024 * 1024;
+
+/** The size of the tag and the length in front of every payload. */
+static constexpr size_t FRAME_HEADER_SIZE = 5;
+
+/** What TakeFrame() found at the front of a buffer. */
+enum class FrameState { COMPLETE, INCOMPLETE, MALFORMED };
+
+/**
+ * Write a frame to a blocking socket.
+ * @return `false` if the socket was closed or failed, or the payload is too large
+ */
+auto WriteFrame(int fd, FrameTag tag, const std::string &payload) -> bool;
+
+/**
+ * Append a frame to the bytes to be sent to a socket. This is how a writer that must not wait for a slow reader, like
+ * the server, queues its frames for SendBuffered().
+ * @return `false` if the payload is too large
+ */
+auto AppendFrame(std::string *buffer, FrameTag tag, const std::string &payload) -> bool;
+
+/**
+ * Send as many of the bytes queued for a nonblocking socket as it takes without waiting.
+ * @param buffer the bytes to be sent, from which the ones sent are removed
+ * @return `false` if the socket was closed or failed
+ */
+auto SendBuffered(int fd, std::string *buffer) -> bool;
+
+/**
+ * Read a frame from a socket, waiting until all of it has arrived.
+ * @return `false` if the socket was closed or failed, or the frame is malformed
+ */
+auto ReadFrame(int fd, FrameTag *tag, std::string *payload) -> bool;
+
+/**
+ * Take the frame at the front of the bytes received from a socket, if all of it has arrived. This is how a reader that
+ * must not wait for the rest of a frame, like the server, collects it over several reads.
+ * @param buffer the bytes received and not taken yet, from which a complete frame is removed
+ * @param max_payload the largest payload the reader accepts, at most MAX_FRAME_PAYLOAD
+ * @return COMPLETE if a frame was taken, INCOMPLETE if more bytes are needed, MALFORMED if the frame is too large
+ */
+auto TakeFrame(std::string *buffer, FrameTag *tag, std::string *payload, uint32_t max_payload = MAX_FRAME_PAYLOAD)
+    -> FrameState;
+
+}  // namespace bustub
@@ -19,9 +19,20 @@
 #include <string>
 
 #include "common/config.h"
+#include "common/stats.h"
 
 namespace bustub {
 
+/**
+ * DiskStats counts the pages read and written through a disk manager, and how long each access took.
+ */
+struct DiskStats {
+  StatCounter reads_;
+  StatCounter writes_;
+  StatHistogram read_latency_ns_;
+  StatHistogram write_latency_ns_;
+};
+
 /**
  * DiskManager takes care of the allocation and deallocation of pages within a database. It performs the reading and
  * writing of pages to and from disk, providing a logical file layer within the context of a database management system.
@@ -83,10 +94,19 @@ class DiskManager {
   /** @return the number of disk writes */
   auto GetNumWrites() const -> int;
 
+  /**
+   * @return the number of pages the database file already holds, so that a reopened database does not hand out page
+   * ids that are in use. The memory-backed disk managers always start empty.
+   */
+  auto GetNumPages() -> page_id_t;
+
   /**
    * Sets the future which is used to check for non-blocking flushes.
    * @param f the non-blocking flush check
    */
+  /** @return the page I/O statistics of this disk manager */
+  auto GetStats() -> DiskStats & { return stats_; }
+
   inline void SetFlushLogFuture(std::future<void> *f) { flush_log_f_ = f; }
 
   /** Checks if the non-blocking flush future was set. */
@@ -106,6 +126,7 @@ class DiskManager {
   std::future<void> *flush_log_f_{nullptr};
   // With multiple buffer pool instances, need to protect file access
   std::mutex db_io_latch_;
+  DiskStats stats_;
 };
 
 }  // namespace bustub
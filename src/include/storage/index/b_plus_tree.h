@@ -10,6 +10,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <optional>
 #include <queue>
 #include <string>
 #include <utility>
@@ -21,6 +22,7 @@
 #include "storage/page/b_plus_tree_internal_page.h"
 #include "storage/page/b_plus_tree_leaf_page.h"
 #include "storage/page/b_plus_tree_page.h"
+#include "storage/page/page_guard.h"
 
 namespace bustub {
 
@@ -52,22 +54,27 @@ class BPlusTree {
   // Insert a key-value pair into this B+ tree.
   auto Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr) -> bool;
   auto InsertHelper(const KeyType &key, const ValueType &value, Transaction *transaction, LatchModes mode) -> bool;
+  // Insert key-value pairs sorted by key, descending once for each run of keys that lands in the same leaf.
+  auto InsertBatch(const std::vector<std::pair<KeyType, ValueType>> &entries, Transaction *transaction = nullptr)
+      -> size_t;
   void InsertInLeaf(LeafPage *recipient, KeyType key, ValueType value);
   void InsertInParent(BPlusTreePage *recipient, const KeyType &key, BPlusTreePage *recipient_new, int &dirty_height);
-  auto CreateInternalPage() -> InternalPage *;
-  auto CreateLeafPage() -> LeafPage *;
+  auto CreateInternalPage() -> BasicPageGuard;
+  auto CreateLeafPage() -> BasicPageGuard;
   void InitBplusTree(KeyType key, ValueType value);
 
   // Remove a key and its value from this B+ tree.
   void Remove(const KeyType &key, Transaction *transaction = nullptr);
   void RemoveHelper(const KeyType &key, Transaction *transaction, LatchModes mode);
+  // Remove keys sorted in ascending order, descending once for each run of keys that lives in the same leaf.
+  void RemoveBatch(const std::vector<KeyType> &keys, Transaction *transaction = nullptr);
   void DeleteEntry(BPlusTreePage *recipient, KeyType key, int &dirty_height);
   auto TryRedistribute(BPlusTreePage *recipient, KeyType key) -> bool;
   void Redistribute(BPlusTreePage *recipient, BPlusTreePage *recipient_brother, InternalPage *parent,
                     int recipient_position, bool brother_on_left);
   auto TryMerge(BPlusTreePage *recipient, KeyType key, int &dirty_height) -> bool;
-  void Merge(BPlusTreePage *recipient, BPlusTreePage *recipient_brother, Page *brother_page, InternalPage *parent,
-             int recipient_position, bool brother_on_left, int &dirty_height);
+  void Merge(BPlusTreePage *recipient, WritePageGuard brother_guard, InternalPage *parent, int recipient_position,
+             bool brother_on_left, int &dirty_height);
   void UpdateAllParentID(InternalPage *recipient);
   void UpdateParentID(InternalPage *recipient, int index);
   // return the value associated with a given key
@@ -76,6 +83,9 @@ class BPlusTree {
   // return the page id of the root node
   auto GetRootPageId() -> page_id_t;
 
+  // adopt the existing tree rooted at root_page_id, e.g. when the catalog reopens the index
+  void SetRootPageId(page_id_t root_page_id);
+
   // index iterator
   auto Begin() -> INDEXITERATOR_TYPE;
   auto Begin(const KeyType &key) -> INDEXITERATOR_TYPE;
@@ -102,7 +112,8 @@ class BPlusTree {
 
   auto ReinterpretAsInternalPage(BPlusTreePage *page) -> BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator> *;
 
-  auto FindLeafPage(const KeyType &key, Transaction *transaction = nullptr, LatchModes mode = LatchModes::READ)
+  auto FindLeafPage(const KeyType &key, Transaction *transaction = nullptr, LatchModes mode = LatchModes::READ,
+                    std::optional<KeyType> *upper_bound = nullptr)
       -> std::pair<Page *, BPlusTreeLeafPage<KeyType, RID, KeyComparator> *>;
 
   void LatchRootPageId(Transaction *transaction, BPlusTree::LatchModes mode);
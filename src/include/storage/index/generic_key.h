@@ -12,13 +12,37 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstring>
 
+#include "common/exception.h"
+#include "fmt/format.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
 namespace bustub {
 
+/**
+ * Whether a key tuple can be copied into a key of key_size bytes. The null bitmap after the fixed-size area may not
+ * fit, NULLs are still told apart by their sentinel, but the payloads of the VARCHARs must: ToValue reads them back.
+ * @param tuple the key tuple
+ * @param key_schema the schema of the key tuple
+ * @param key_size the size of the key, in bytes
+ */
+inline auto KeyFits(const Tuple &tuple, const Schema &key_schema, size_t key_size) -> bool {
+  // The payloads are at the end of the tuple, so they fit if the tuple does or none of them is stored out of line.
+  if (tuple.GetLength() <= key_size) {
+    return true;
+  }
+  for (auto col_idx : key_schema.GetUnlinedColumns()) {
+    auto len = *reinterpret_cast<const uint16_t *>(tuple.GetData() + key_schema.GetColumn(col_idx).GetOffset());
+    if (len != Tuple::VARCHAR_SLOT_NULL && len > Tuple::VARCHAR_INLINE_LENGTH) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /**
  * Generic key is used for indexing with opaque data.
  *
@@ -29,10 +53,20 @@ namespace bustub {
 template <size_t KeySize>
 class GenericKey {
  public:
-  inline void SetFromKey(const Tuple &tuple) {
+  /**
+   * Copy a key tuple into the key.
+   * @param tuple the key tuple
+   * @param key_schema the schema of the key tuple
+   * @throw Exception if a VARCHAR payload of the key ends past KeySize bytes, see KeyFits
+   */
+  inline void SetFromKey(const Tuple &tuple, const Schema &key_schema) {
+    if (!KeyFits(tuple, key_schema, KeySize)) {
+      throw Exception(ExceptionType::OUT_OF_RANGE,
+                      fmt::format("index key of {} bytes does not fit in {} bytes", tuple.GetLength(), KeySize));
+    }
     // intialize to 0
     memset(data_, 0, KeySize);
-    memcpy(data_, tuple.GetData(), tuple.GetLength());
+    memcpy(data_, tuple.GetData(), std::min<size_t>(tuple.GetLength(), KeySize));
   }
 
   // NOTE: for test purpose only
@@ -42,17 +76,13 @@ class GenericKey {
   }
 
   inline auto ToValue(Schema *schema, uint32_t column_idx) const -> Value {
-    const char *data_ptr;
     const auto &col = schema->GetColumn(column_idx);
     const TypeId column_type = col.GetType();
     const bool is_inlined = col.IsInlined();
-    if (is_inlined) {
-      data_ptr = (data_ + col.GetOffset());
-    } else {
-      int32_t offset = *reinterpret_cast<int32_t *>(const_cast<char *>(data_ + col.GetOffset()));
-      data_ptr = (data_ + offset);
+    if (!is_inlined) {
+      return Tuple::DeserializeVarchar(data_, col.GetOffset());
     }
-    return Value::DeserializeFrom(data_ptr, column_type);
+    return Value::DeserializeFrom(data_ + col.GetOffset(), column_type);
   }
 
   // NOTE: for test purpose only
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/config.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -156,8 +157,9 @@ class Index {
    * @param key The index key
    * @param rid The RID associated with the key
    * @param transaction The transaction context
+   * @return false if the index already holds the key (a B+ tree) or the key with this RID (a hash table)
    */
-  virtual void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) = 0;
+  virtual auto InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool = 0;
 
   /**
    * Delete an index entry by key.
@@ -175,6 +177,35 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  /**
+   * Insert the entries a statement produced for this index. The default inserts them one at a time, an index that
+   * can apply them faster in its own key order overrides it.
+   * @param entries The index keys and their RIDs, in no particular order
+   * @param transaction The transaction context
+   */
+  virtual void InsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) {
+    for (const auto &[key, rid] : entries) {
+      InsertEntry(key, rid, transaction);
+    }
+  }
+
+  /**
+   * Delete the entries a statement removed from this index, one at a time unless the index overrides it.
+   * @param entries The index keys and their RIDs, in no particular order
+   * @param transaction The transaction context
+   */
+  virtual void DeleteEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) {
+    for (const auto &[key, rid] : entries) {
+      DeleteEntry(key, rid, transaction);
+    }
+  }
+
+  /**
+   * @return The page the index can be reopened from, i.e. the root of a B+ tree or the directory of a hash table, or
+   * INVALID_PAGE_ID if the index does not live in the buffer pool
+   */
+  virtual auto GetRootPageId() -> page_id_t { return INVALID_PAGE_ID; }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
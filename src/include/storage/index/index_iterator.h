@@ -21,14 +21,24 @@
 namespace bustub {
 
 #define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
-#define LEAF_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator> *
+#define LEAF_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>
 
+/**
+ * The iterator keeps its current leaf page pinned through a page guard, so it is move-only: a copy would unpin the
+ * same page twice.
+ */
 INDEX_TEMPLATE_ARGUMENTS
 class IndexIterator {
  public:
   // you may define your own constructor based on your member variables
   IndexIterator();
-  IndexIterator(page_id_t page_id, int index, LEAF_TYPE leaf_page, BufferPoolManager *buffer_pool_manager);
+  IndexIterator(BasicPageGuard leaf_guard, int index, BufferPoolManager *buffer_pool_manager);
+
+  IndexIterator(const IndexIterator &) = delete;
+  auto operator=(const IndexIterator &) -> IndexIterator & = delete;
+  IndexIterator(IndexIterator &&) noexcept = default;
+  auto operator=(IndexIterator &&) noexcept -> IndexIterator & = default;
+
   ~IndexIterator();  // NOLINT
 
   auto IsEnd() -> bool;
@@ -43,11 +53,10 @@ class IndexIterator {
 
  private:
   // add your own private member variables here
-  auto FetchLeafPage(page_id_t page_id) -> LEAF_TYPE;
-
   page_id_t page_id_{INVALID_PAGE_ID};
   int index_{-1};
-  LEAF_TYPE leaf_page_{nullptr};
+  BasicPageGuard leaf_guard_;
+  const LEAF_TYPE *leaf_page_{nullptr};
   BufferPoolManager *buffer_pool_manager_{nullptr};
 };
 
@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// catalog_page.h
+//
+// Identification: src/include/storage/page/catalog_page.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * The catalog is serialized into one byte stream, which is cut into a chain of catalog pages. The header page records
+ * the first page of the chain under the name CATALOG_RECORD_NAME.
+ *
+ * Format (size in byte):
+ *  ---------------------------------------------------------------
+ * | NextPageId (4) | DataSize (4) | Data (BUSTUB_PAGE_SIZE - 8) ... |
+ *  ---------------------------------------------------------------
+ */
+class CatalogPage {
+ public:
+  /** Name of the header page record that points to the first catalog page. */
+  static constexpr const char *CATALOG_RECORD_NAME = "__catalog";
+  /** Number of bytes of the stream a single page holds. */
+  static constexpr size_t DATA_CAPACITY = BUSTUB_PAGE_SIZE - sizeof(page_id_t) - sizeof(uint32_t);
+
+  void Init() {
+    next_page_id_ = INVALID_PAGE_ID;
+    data_size_ = 0;
+  }
+
+  auto GetNextPageId() const -> page_id_t { return next_page_id_; }
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /** @return the number of stream bytes stored in this page */
+  auto GetDataSize() const -> uint32_t { return data_size_; }
+
+  auto GetData() const -> const char * { return data_; }
+
+  /** Store size bytes of the stream, at most DATA_CAPACITY, in this page. */
+  void SetData(const char *data, uint32_t size) {
+    memcpy(data_, data, size);
+    data_size_ = size;
+  }
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t data_size_;
+  char data_[DATA_CAPACITY];
+};
+
+static_assert(sizeof(CatalogPage) == BUSTUB_PAGE_SIZE);
+
+}  // namespace bustub
@@ -25,7 +25,7 @@ namespace bustub {
  * Store indexed key and and value together within block page. Supports
  * non-unique keys.
  *
- * Block page format (keys are stored in order):
+ * Block page format (slots are filled in the order the table probes them):
  *  ----------------------------------------------------------------
  * | KEY(1) + VALUE(1) | KEY(2) + VALUE(2) | ... | KEY(n) + VALUE(n)
  *  ----------------------------------------------------------------
@@ -56,22 +56,20 @@ class HashTableBlockPage {
   auto ValueAt(slot_offset_t bucket_ind) const -> ValueType;
 
   /**
-   * Attempts to insert a key and value into an index in the block.
-   * The insert is thread safe. It uses compare and swap to claim the index,
-   * and then writes the key and value into the index, and then marks the
-   * index as readable.
+   * Inserts a key and value into an index in the block, and marks the index as occupied and readable. The index may
+   * hold a tombstone, which is overwritten. The caller holds the table latch exclusively, so no one else writes to the
+   * block at the same time.
    *
    * @param bucket_ind index to write the key and value to
    * @param key key to insert
    * @param value value to insert
-   * @return If the value is inserted successfully, it returns true. If the
-   * index is marked as occupied before the key and value can be inserted,
-   * Insert returns false.
+   * @return true if the value is inserted, false if the index already holds a readable pair
    */
   auto Insert(slot_offset_t bucket_ind, const KeyType &key, const ValueType &value) -> bool;
 
   /**
-   * Removes a key and value at index.
+   * Removes a key and value at index. The index stays occupied, i.e. it becomes a tombstone, so that probes for keys
+   * further down the sequence do not stop there.
    *
    * @param bucket_ind ind to remove the value
    */
@@ -94,49 +92,9 @@ class HashTableBlockPage {
   auto IsReadable(slot_offset_t bucket_ind) const -> bool;
 
   /**
-   * Scan the bucket and collect values that have the matching key
-   *
-   * @return true if at least one key matched
-   */
-  auto GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result) -> bool;
-
-  /**
-   * Attempts to insert a key and value in the bucket.
-   * The insert is thread safe. It uses compare and swap to claim the index,
-   * and then writes the key and value into the index, and then marks the
-   * index as readable.
-   *
-   * @param key key to insert
-   * @param value value to insert
-   * @return true if inserted, false if duplicate KV pair or bucket is full
-   */
-  auto Insert(KeyType key, ValueType value, KeyComparator cmp) -> bool;
-
-  /**
-   * Removes a key and value.
-   * @return true if removed, false if not found
-   */
-  auto Remove(KeyType key, ValueType value, KeyComparator cmp) -> bool;
-
-  /**
-   * @return the number of readable elements, i.e. current size
-   */
-  auto NumReadable() -> uint32_t;
-
-  /**
-   * @return whether the bucket is full
-   */
-  auto IsFull() -> bool;
-
-  /**
-   * @return whether the bucket is empty
-   */
-  auto IsEmpty() -> bool;
-
-  /**
-   * Prints the bucket's occupancy information
+   * @return the number of readable elements in the block
    */
-  void PrintBucket();
+  auto NumReadable() const -> uint32_t;
 
  private:
   std::atomic_char occupied_[(BLOCK_ARRAY_SIZE - 1) / 8 + 1];
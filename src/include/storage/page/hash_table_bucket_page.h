@@ -30,8 +30,11 @@ namespace bustub {
  *  ----------------------------------------------------------------
  *
  *  Here '+' means concatenation.
- *  The above format omits the space required for the occupied_ and
- *  readable_ arrays. More information is in storage/page/hash_table_page_defs.h.
+ *  The above format omits the space required for the overflow page id and the
+ *  occupied_ and readable_ arrays. More information is in storage/page/hash_table_page_defs.h.
+ *
+ *  A bucket whose pairs can't be told apart by their hashes can't be split, so it goes on in a chain of overflow
+ *  pages, which are bucket pages as well.
  *
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
@@ -45,7 +48,7 @@ class HashTableBucketPage {
    *
    * @return true if at least one key matched
    */
-  auto GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result) -> bool;
+  auto GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result) const -> bool;
 
   /**
    * Attempts to insert a key and value in the bucket.  Uses the occupied_
@@ -120,17 +123,23 @@ class HashTableBucketPage {
   /**
    * @return the number of readable elements, i.e. current size
    */
-  auto NumReadable() -> uint32_t;
+  auto NumReadable() const -> uint32_t;
 
   /**
    * @return whether the bucket is full
    */
-  auto IsFull() -> bool;
+  auto IsFull() const -> bool;
 
   /**
    * @return whether the bucket is empty
    */
-  auto IsEmpty() -> bool;
+  auto IsEmpty() const -> bool;
+
+  /** @return the next page of the bucket, or INVALID_PAGE_ID if this is the last one */
+  auto GetOverflowPageId() const -> page_id_t { return overflow_page_id_; }
+
+  /** Link the page that follows this one in the bucket. A new bucket page must set INVALID_PAGE_ID here first. */
+  void SetOverflowPageId(page_id_t overflow_page_id) { overflow_page_id_ = overflow_page_id; }
 
   /**
    * Prints the bucket's occupancy information
@@ -138,6 +147,14 @@ class HashTableBucketPage {
   void PrintBucket();
 
  private:
+  /**
+   * The hash table hashes the raw bytes of a key, so two keys in it can only be equal if their bytes are. Checking that
+   * first keeps the comparator, which deserializes both keys, off every slot that holds another key.
+   * @return whether the key at bucket_idx equals key
+   */
+  auto KeyEquals(const KeyType &key, uint32_t bucket_idx, KeyComparator cmp) const -> bool;
+
+  page_id_t overflow_page_id_;
   //  For more on BUCKET_ARRAY_SIZE see storage/page/hash_table_page_defs.h
   char occupied_[(BUCKET_ARRAY_SIZE - 1) / 8 + 1];
   // 0 if tombstone/brand new (never occupied), 1 otherwise.
@@ -37,14 +37,14 @@ class HeaderPage : public Page {
   auto UpdateRecord(const std::string &name, page_id_t root_id) -> bool;
 
   // return root_id if success
-  auto GetRootId(const std::string &name, page_id_t *root_id) -> bool;
-  auto GetRecordCount() -> int;
+  auto GetRootId(const std::string &name, page_id_t *root_id) const -> bool;
+  auto GetRecordCount() const -> int;
 
  private:
   /**
    * helper functions
    */
-  auto FindRecord(const std::string &name) -> int;
+  auto FindRecord(const std::string &name) const -> int;
 
   void SetRecordCount(int record_count);
 };
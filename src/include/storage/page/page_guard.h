@@ -0,0 +1,212 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_guard.h
+//
+// Identification: src/include/storage/page/page_guard.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <type_traits>
+
+#include "storage/page/page.h"
+
+namespace bustub {
+
+class BufferPoolManager;
+class ReadPageGuard;
+class WritePageGuard;
+
+/**
+ * BasicPageGuard keeps a page pinned in the buffer pool for as long as it lives, and unpins it when it is dropped or
+ * goes out of scope. It is move-only, so that every pin is released exactly once.
+ *
+ * A guard remembers whether the page was modified through it: GetDataMut() and AsMut() mark the page dirty, GetData()
+ * and As() do not.
+ */
+class BasicPageGuard {
+ public:
+  BasicPageGuard() = default;
+
+  /**
+   * @param bpm the buffer pool manager the page was pinned in
+   * @param page the pinned page, or nullptr for an empty guard
+   */
+  BasicPageGuard(BufferPoolManager *bpm, Page *page) : bpm_(bpm), page_(page) {}
+
+  BasicPageGuard(const BasicPageGuard &) = delete;
+  auto operator=(const BasicPageGuard &) -> BasicPageGuard & = delete;
+
+  BasicPageGuard(BasicPageGuard &&that) noexcept;
+  auto operator=(BasicPageGuard &&that) noexcept -> BasicPageGuard &;
+
+  ~BasicPageGuard() { Drop(); }
+
+  /** Unpin the page, after which the guard is empty. Dropping an empty guard does nothing. */
+  void Drop();
+
+  /**
+   * Read-latch the page and hand the pin over to a read guard. This guard is empty afterwards.
+   * @return the read guard
+   */
+  auto UpgradeRead() -> ReadPageGuard;
+
+  /**
+   * Write-latch the page and hand the pin over to a write guard. This guard is empty afterwards.
+   * @return the write guard
+   */
+  auto UpgradeWrite() -> WritePageGuard;
+
+  /** @return true if the guard holds a page, false if the page could not be fetched or the guard was dropped */
+  auto IsValid() const -> bool { return page_ != nullptr; }
+
+  /** @return the id of the guarded page */
+  auto PageId() const -> page_id_t { return page_->GetPageId(); }
+
+  /** @return the data of the guarded page */
+  auto GetData() const -> const char * { return page_->GetData(); }
+
+  /** @return the data of the guarded page, which is marked dirty */
+  auto GetDataMut() -> char * {
+    is_dirty_ = true;
+    return page_->GetData();
+  }
+
+  /**
+   * @return the guarded page as T. Pages that derive from Page (e.g. TablePage) are the page itself, any other layout
+   * (e.g. BPlusTreePage) is laid over the page data.
+   */
+  template <class T>
+  auto As() const -> const T * {
+    if constexpr (std::is_base_of_v<Page, T>) {
+      return static_cast<const T *>(page_);
+    } else {
+      return reinterpret_cast<const T *>(GetData());
+    }
+  }
+
+  /** @return the guarded page as T, which is marked dirty. See As(). */
+  template <class T>
+  auto AsMut() -> T * {
+    is_dirty_ = true;
+    if constexpr (std::is_base_of_v<Page, T>) {
+      return static_cast<T *>(page_);
+    } else {
+      return reinterpret_cast<T *>(page_->GetData());
+    }
+  }
+
+ private:
+  friend class ReadPageGuard;
+  friend class WritePageGuard;
+
+  BufferPoolManager *bpm_{nullptr};
+  Page *page_{nullptr};
+  bool is_dirty_{false};
+};
+
+/**
+ * ReadPageGuard keeps a page pinned and read-latched for as long as it lives.
+ */
+class ReadPageGuard {
+ public:
+  ReadPageGuard() = default;
+
+  /**
+   * @param bpm the buffer pool manager the page was pinned in
+   * @param page the pinned and read-latched page, or nullptr for an empty guard
+   */
+  ReadPageGuard(BufferPoolManager *bpm, Page *page) : guard_(bpm, page) {}
+
+  ReadPageGuard(const ReadPageGuard &) = delete;
+  auto operator=(const ReadPageGuard &) -> ReadPageGuard & = delete;
+
+  ReadPageGuard(ReadPageGuard &&that) noexcept = default;
+  auto operator=(ReadPageGuard &&that) noexcept -> ReadPageGuard &;
+
+  ~ReadPageGuard() { Drop(); }
+
+  /** Unlatch and unpin the page, after which the guard is empty. Dropping an empty guard does nothing. */
+  void Drop();
+
+  /** @return true if the guard holds a page */
+  auto IsValid() const -> bool { return guard_.IsValid(); }
+
+  /** @return the id of the guarded page */
+  auto PageId() const -> page_id_t { return guard_.PageId(); }
+
+  /** @return the data of the guarded page */
+  auto GetData() const -> const char * { return guard_.GetData(); }
+
+  /** @return the guarded page as T, see BasicPageGuard::As() */
+  template <class T>
+  auto As() const -> const T * {
+    return guard_.As<T>();
+  }
+
+ private:
+  friend class BasicPageGuard;
+
+  BasicPageGuard guard_;
+};
+
+/**
+ * WritePageGuard keeps a page pinned and write-latched for as long as it lives.
+ */
+class WritePageGuard {
+ public:
+  WritePageGuard() = default;
+
+  /**
+   * @param bpm the buffer pool manager the page was pinned in
+   * @param page the pinned and write-latched page, or nullptr for an empty guard
+   */
+  WritePageGuard(BufferPoolManager *bpm, Page *page) : guard_(bpm, page) {}
+
+  WritePageGuard(const WritePageGuard &) = delete;
+  auto operator=(const WritePageGuard &) -> WritePageGuard & = delete;
+
+  WritePageGuard(WritePageGuard &&that) noexcept = default;
+  auto operator=(WritePageGuard &&that) noexcept -> WritePageGuard &;
+
+  ~WritePageGuard() { Drop(); }
+
+  /** Unlatch and unpin the page, after which the guard is empty. Dropping an empty guard does nothing. */
+  void Drop();
+
+  /** @return true if the guard holds a page */
+  auto IsValid() const -> bool { return guard_.IsValid(); }
+
+  /** @return the id of the guarded page */
+  auto PageId() const -> page_id_t { return guard_.PageId(); }
+
+  /** @return the data of the guarded page */
+  auto GetData() const -> const char * { return guard_.GetData(); }
+
+  /** @return the data of the guarded page, which is marked dirty */
+  auto GetDataMut() -> char * { return guard_.GetDataMut(); }
+
+  /** @return the guarded page as T, see BasicPageGuard::As() */
+  template <class T>
+  auto As() const -> const T * {
+    return guard_.As<T>();
+  }
+
+  /** @return the guarded page as T, which is marked dirty */
+  template <class T>
+  auto AsMut() -> T * {
+    return guard_.AsMut<T>();
+  }
+
+ private:
+  friend class BasicPageGuard;
+
+  BasicPageGuard guard_;
+};
+
+}  // namespace bustub
@@ -12,6 +12,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
@@ -36,9 +41,10 @@ class TableHeap {
    * @param lock_manager the lock manager
    * @param log_manager the log manager
    * @param first_page_id the id of the first page
+   * @param tuple_count the number of tuples in the table, as saved with the catalog
    */
   TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
-            page_id_t first_page_id);
+            page_id_t first_page_id, uint64_t tuple_count = 0);
 
   /**
    * Create a table heap with a transaction. (create table)
@@ -99,6 +105,20 @@ class TableHeap {
    */
   auto GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool acquire_read_lock = true) -> bool;
 
+  /**
+   * Vacuum the table. Every page is compacted, then live tuples are moved from later pages of the chain into the free
+   * space of earlier ones, and pages left empty are unlinked and deleted. Delete-marked tuples are never moved, since
+   * a pending commit or abort still refers to them by RID, and neither is anything on the pages in written_pages.
+   * The caller must make sure that no other transaction is running meanwhile, see
+   * TransactionManager::BlockOtherTransactions.
+   * @param txn transaction performing the vacuum
+   * @param written_pages the pages txn wrote to, which its commit or abort refers to by RID and stay as they are
+   * @param[out] moved the old and new rid of every moved tuple, so that the caller can fix up the indexes
+   * @return the number of pages freed
+   */
+  auto Vacuum(Transaction *txn, const std::unordered_set<page_id_t> &written_pages,
+              std::vector<std::pair<RID, RID>> *moved) -> size_t;
+
   /** @return the begin iterator of this table */
   auto Begin(Transaction *txn) -> TableIterator;
 
@@ -108,11 +128,24 @@ class TableHeap {
   /** @return the id of the first page of this table */
   inline auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
 
+  /**
+   * @return the number of tuples in the table. A deleted tuple is counted until its delete is applied at commit, so
+   * the count is exact for committed data and serves the optimizer as the size of the table.
+   */
+  auto GetTupleCount() const -> uint64_t { return tuple_count_.load(std::memory_order_relaxed); }
+
+  /**
+   * Count the tuples of a table opened from disk by walking its pages, which reads the whole table. Only valid once
+   * the pages are consistent, i.e. after recovery.
+   */
+  void RecountTuples();
+
  private:
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   LogManager *log_manager_;
   page_id_t first_page_id_{};
+  std::atomic<uint64_t> tuple_count_{0};
 };
 
 }  // namespace bustub
@@ -23,14 +23,22 @@ namespace bustub {
 
 /**
  * Tuple format:
- * ---------------------------------------------------------------------
- * | FIXED-SIZE or VARIED-SIZED OFFSET | PAYLOAD OF VARIED-SIZED FIELD |
- * ---------------------------------------------------------------------
+ * ---------------------------------------------------------------------------------
+ * | FIXED-SIZE VALUE or VARCHAR SLOT | NULL BITMAP | PAYLOAD OF VARIED-SIZED FIELD |
+ * ---------------------------------------------------------------------------------
+ *
+ * A VARCHAR slot takes 4 bytes: the length of the value (2), followed by the offset of its payload (2). Values of at
+ * most 2 bytes are stored in place of the offset and have no payload, and NULL is marked by a length of
+ * VARCHAR_SLOT_NULL.
+ *
+ * Bit i of the null bitmap is set iff column i is NULL. NULL fixed-size values also keep their null sentinel in the
+ * fixed-size area, so that an index key, which is a prefix of the key tuple, still compares as before.
  */
 class Tuple {
   friend class TablePage;
   friend class TableHeap;
   friend class TableIterator;
+  friend class TupleView;
 
  public:
   // Default constructor (to create a dummy tuple)
@@ -48,6 +56,12 @@ class Tuple {
   // assign operator, deep copy
   auto operator=(const Tuple &other) -> Tuple &;
 
+  // move constructor, steals the data of other
+  Tuple(Tuple &&other) noexcept;
+
+  // move assign operator, steals the data of other
+  auto operator=(Tuple &&other) noexcept -> Tuple &;
+
   ~Tuple() {
     if (allocated_) {
       delete[] data_;
@@ -75,14 +89,22 @@ class Tuple {
   auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value;
 
   // Generates a key tuple given schemas and attributes
-  auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) -> Tuple;
+  auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const
+      -> Tuple;
 
   // Is the column value null ?
   inline auto IsNull(const Schema *schema, uint32_t column_idx) const -> bool {
-    Value value = GetValue(schema, column_idx);
-    return value.IsNull();
+    return (data_[schema->GetLength() + column_idx / 8] & (1 << (column_idx % 8))) != 0;
   }
-  inline auto IsAllocated() -> bool { return allocated_; }
+
+  // Deserialize the VARCHAR whose slot is at `slot_offset` of the tuple data `data`
+  static auto DeserializeVarchar(const char *data, uint32_t slot_offset) -> Value;
+
+  // Length of a VARCHAR slot which holds NULL
+  static constexpr uint16_t VARCHAR_SLOT_NULL = UINT16_MAX;
+  // VARCHAR values up to this length are stored in their slot
+  static constexpr uint16_t VARCHAR_INLINE_LENGTH = sizeof(uint16_t);
+  inline auto IsAllocated() const -> bool { return allocated_; }
 
   auto ToString(const Schema *schema) const -> std::string;
 
@@ -90,6 +112,9 @@ class Tuple {
   // Get the starting storage address of specific column
   auto GetDataPtr(const Schema *schema, uint32_t column_idx) const -> const char *;
 
+  // Size of the null bitmap for the schema
+  static auto NullBitmapSize(const Schema *schema) -> uint32_t { return (schema->GetColumnCount() + 7) / 8; }
+
   bool allocated_{false};  // is allocated?
   RID rid_{};              // if pointing to the table heap, the rid is valid
   uint32_t size_{0};
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_view.h
+//
+// Identification: src/include/storage/table/tuple_view.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/rid.h"
+#include "storage/page/page_guard.h"
+#include "storage/page/table_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TupleView reads the tuples of a table page in place, without copying them out of the buffer pool.
+ *
+ * The view pins and read-latches the page for as long as it lives, and GetTuple() returns a tuple which points right
+ * into the page. Such a tuple is only valid until the view moves on or goes away; Materialize() makes a copy that
+ * outlives it. Since the page stays latched, a view must not be held across calls that may latch the same page
+ * again, e.g. it must not outlive the Next() call of the executor that created it.
+ */
+class TupleView {
+ public:
+  TupleView() = default;
+
+  /**
+   * Pin and read-latch a table page.
+   * @param buffer_pool_manager the buffer pool manager
+   * @param page_id the table page to view
+   */
+  TupleView(BufferPoolManager *buffer_pool_manager, page_id_t page_id);
+
+  TupleView(const TupleView &) = delete;
+  auto operator=(const TupleView &) -> TupleView & = delete;
+
+  TupleView(TupleView &&other) noexcept = default;
+  auto operator=(TupleView &&other) noexcept -> TupleView & = default;
+
+  ~TupleView() { Release(); }
+
+  /** Unlatch and unpin the page. */
+  void Release();
+
+  /** @return true if the page could be fetched */
+  auto IsValid() const -> bool { return guard_.IsValid(); }
+
+  /** @return the next page of the table */
+  auto GetNextPageId() const -> page_id_t { return guard_.As<TablePage>()->GetNextPageId(); }
+
+  /**
+   * Move to the tuple at rid.
+   * @return false if there is no such tuple in this page
+   */
+  auto Seek(const RID &rid) -> bool;
+
+  /**
+   * Move to the first tuple of the page.
+   * @return false if the page has no tuple
+   */
+  auto SeekFirst() -> bool;
+
+  /**
+   * Move to the tuple following rid, which need not exist anymore.
+   * @return false if there is no tuple after rid in this page
+   */
+  auto SeekAfter(const RID &rid) -> bool;
+
+  /** @return the rid of the current tuple */
+  auto GetRid() const -> RID { return tuple_.GetRid(); }
+
+  /** @return the current tuple, in place. Only valid until the view moves on. */
+  auto GetTuple() const -> const Tuple & { return tuple_; }
+
+  /** @return the value of a column of the current tuple */
+  auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value {
+    return tuple_.GetValue(schema, column_idx);
+  }
+
+  /** @return a copy of the current tuple, which owns its data */
+  auto Materialize() const -> Tuple;
+
+ private:
+  ReadPageGuard guard_;
+  Tuple tuple_;
+};
+
+}  // namespace bustub
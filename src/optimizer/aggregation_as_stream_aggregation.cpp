@@ -0,0 +1,49 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/stream_aggregation_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeAggregationAsStreamAggregation(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeAggregationAsStreamAggregation(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Aggregation) {
+    const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+    const auto &group_bys = agg_plan.GetGroupBys();
+    if (group_bys.empty()) {
+      return optimized_plan;
+    }
+    std::vector<uint32_t> group_by_columns;
+    for (const auto &group_by : group_bys) {
+      const auto *column = dynamic_cast<const ColumnValueExpression *>(group_by.get());
+      if (column == nullptr) {
+        return optimized_plan;
+      }
+      group_by_columns.push_back(column->GetColIdx());
+    }
+    // The rows of a group are next to each other if the child is sorted by the group by columns first, in any order.
+    auto ordering = OutputOrdering(*agg_plan.GetChildPlan());
+    if (ordering.size() < group_by_columns.size()) {
+      return optimized_plan;
+    }
+    ordering.resize(group_by_columns.size());
+    std::sort(ordering.begin(), ordering.end());
+    std::sort(group_by_columns.begin(), group_by_columns.end());
+    if (ordering == group_by_columns) {
+      return std::make_shared<StreamAggregationPlanNode>(agg_plan);
+    }
+  }
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,122 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/expression_util.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+auto IsConstantFalse(const AbstractExpression &expr) -> bool {
+  const auto *const_expr = dynamic_cast<const ConstantValueExpression *>(&expr);
+  return const_expr != nullptr && const_expr->val_.GetTypeId() == TypeId::BOOLEAN && !const_expr->val_.IsNull() &&
+         !const_expr->val_.GetAs<bool>();
+}
+
+auto FoldConstants(const AbstractExpressionRef &expr) -> AbstractExpressionRef {
+  std::vector<AbstractExpressionRef> children;
+  bool all_constant = true;
+  for (const auto &child : expr->GetChildren()) {
+    children.push_back(FoldConstants(child));
+    all_constant = all_constant && dynamic_cast<const ConstantValueExpression *>(children.back().get()) != nullptr;
+  }
+  auto folded = expr->CloneWithChildren(children);
+  if (children.empty()) {
+    return folded;
+  }
+
+  if (all_constant) {
+    // Without any column the expression does not look at the tuple. An expression that cannot be evaluated, e.g. a
+    // comparison of incompatible types, is left for the executors to report, as they might never evaluate it.
+    try {
+      static const Schema EMPTY_SCHEMA{std::vector<Column>{}};
+      return std::make_shared<ConstantValueExpression>(folded->Evaluate(nullptr, EMPTY_SCHEMA));
+    } catch (const Exception &) {
+      return folded;
+    }
+  }
+
+  // `x AND false` is false and `x OR true` is true even if x is NULL, while `x AND true` and `x OR false` are x.
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(folded.get()); logic_expr != nullptr) {
+    for (size_t i = 0; i < 2; i++) {
+      const auto &constant = *children[i];
+      const auto &other = children[1 - i];
+      if (logic_expr->logic_type_ == LogicType::And) {
+        if (IsConstantFalse(constant)) {
+          return children[i];
+        }
+        if (IsConstantTrue(constant)) {
+          return other;
+        }
+      } else {
+        if (IsConstantTrue(constant)) {
+          return children[i];
+        }
+        if (IsConstantFalse(constant)) {
+          return other;
+        }
+      }
+    }
+  }
+  return folded;
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeConstantFolding(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeConstantFolding(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  switch (optimized_plan->GetType()) {
+    case PlanType::Filter: {
+      const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*optimized_plan);
+      auto predicate = FoldConstants(filter_plan.GetPredicate());
+      if (IsConstantTrue(*predicate)) {
+        return optimized_plan->GetChildAt(0);
+      }
+      return std::make_shared<FilterPlanNode>(filter_plan.output_schema_, std::move(predicate),
+                                              optimized_plan->GetChildAt(0));
+    }
+    case PlanType::NestedLoopJoin: {
+      const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
+      return std::make_shared<NestedLoopJoinPlanNode>(nlj_plan.output_schema_, nlj_plan.GetLeftPlan(),
+                                                      nlj_plan.GetRightPlan(), FoldConstants(nlj_plan.predicate_),
+                                                      nlj_plan.GetJoinType());
+    }
+    case PlanType::Projection: {
+      const auto &projection = dynamic_cast<const ProjectionPlanNode &>(*optimized_plan);
+      std::vector<AbstractExpressionRef> expressions;
+      for (const auto &expr : projection.GetExpressions()) {
+        expressions.push_back(FoldConstants(expr));
+      }
+      return std::make_shared<ProjectionPlanNode>(projection.output_schema_, std::move(expressions),
+                                                  optimized_plan->GetChildAt(0));
+    }
+    case PlanType::SeqScan: {
+      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*optimized_plan);
+      if (seq_scan.filter_predicate_ == nullptr) {
+        return optimized_plan;
+      }
+      auto predicate = FoldConstants(seq_scan.filter_predicate_);
+      return std::make_shared<SeqScanPlanNode>(seq_scan.output_schema_, seq_scan.GetTableOid(), seq_scan.table_name_,
+                                               IsConstantTrue(*predicate) ? nullptr : std::move(predicate));
+    }
+    default:
+      return optimized_plan;
+  }
+}
+
+}  // namespace bustub
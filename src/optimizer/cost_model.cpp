@@ -0,0 +1,404 @@
+#include "optimizer/cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>  // NOLINT
+
+#include "execution/executors/mock_scan_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/hash_semi_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/mock_scan_plan.h"
+#include "execution/plans/nested_index_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "execution/plans/values_plan.h"
+
+namespace bustub {
+
+namespace {
+
+/** Two columns are equal in 1/max(ndv) of the pairs, if the values of the column with fewer of them all match. */
+auto EqualitySelectivity(std::optional<double> left_distinct, std::optional<double> right_distinct) -> double {
+  if (!left_distinct.has_value() && !right_distinct.has_value()) {
+    return CostModel::DEFAULT_EQ_SELECTIVITY;
+  }
+  return 1.0 / std::max({left_distinct.value_or(1.0), right_distinct.value_or(1.0), 1.0});
+}
+
+/**
+ * A semi join keeps the left rows that match at least one right row, and an anti join the others. Each left row is
+ * expected to match right_rows * selectivity rows, so it matches at all with that probability, capped at 1.
+ */
+auto SemiJoinRows(JoinType join_type, double left_rows, double right_rows, double selectivity) -> double {
+  auto matched = left_rows * std::min(1.0, right_rows * selectivity);
+  return join_type == JoinType::ANTI ? left_rows - matched : matched;
+}
+
+/** @return the number of index pages a lookup in an index over a table of table_rows rows reads */
+auto IndexLevels(double table_rows) -> double {
+  return std::max(1.0, std::log(table_rows + 1) / std::log(CostModel::INDEX_FANOUT));
+}
+
+auto Flip(ComparisonType comp_type) -> ComparisonType {
+  switch (comp_type) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return comp_type;
+  }
+}
+
+/** The fraction of the values of a table column below a constant, if the column has a histogram to tell. */
+auto HistogramLessThan(const ColumnOrigin &origin, const Value &constant) -> std::optional<double> {
+  if (origin.table_ == nullptr) {
+    return std::nullopt;
+  }
+  auto column_type = origin.table_->schema_.GetColumn(origin.col_idx_).GetType();
+  if ((column_type == TypeId::VARCHAR) != (constant.GetTypeId() == TypeId::VARCHAR)) {
+    return std::nullopt;
+  }
+  std::scoped_lock lock(origin.table_->stats_latch_);
+  const auto &stats = origin.table_->stats_;
+  if (stats == nullptr || stats->columns_[origin.col_idx_].histogram_.GetBounds().empty()) {
+    return std::nullopt;
+  }
+  return stats->columns_[origin.col_idx_].histogram_.EstimateLessThan(constant) *
+         (1 - stats->GetNullFraction(origin.col_idx_));
+}
+
+}  // namespace
+
+auto CostModel::Estimate(const AbstractPlanNode &plan) -> PlanCost {
+  if (auto it = estimates_.find(&plan); it != estimates_.end()) {
+    return it->second;
+  }
+  auto estimate = EstimateNode(plan);
+  estimates_.emplace(&plan, estimate);
+  return estimate;
+}
+
+auto CostModel::Annotate(const AbstractPlanNode &plan) -> std::string {
+  auto estimate = Estimate(plan);
+  return fmt::format("rows={:.0f} cost={:.0f}", estimate.rows_, estimate.cost_);
+}
+
+auto CostModel::TableRows(TableInfo *table) -> double {
+  return table->table_ != nullptr ? static_cast<double>(table->table_->GetTupleCount()) : 0;
+}
+
+auto CostModel::NestedLoopJoinCost(const PlanCost &left, const PlanCost &right, double rows) -> double {
+  return left.cost_ + std::max(left.rows_, 1.0) * right.cost_ + left.rows_ * right.rows_ + rows;
+}
+
+auto CostModel::HashJoinCost(const PlanCost &left, const PlanCost &right, double rows) -> double {
+  // Inserting into the hash table is dearer than probing it.
+  return left.cost_ + right.cost_ + left.rows_ + 2 * right.rows_ + rows;
+}
+
+auto CostModel::MergeJoinCost(const PlanCost &left, const PlanCost &right, double rows) -> double {
+  return left.cost_ + right.cost_ + left.rows_ + right.rows_ + rows;
+}
+
+auto CostModel::IndexJoinCost(const PlanCost &outer, double inner_rows, double rows) -> double {
+  // Every lookup walks down the index, and then reads the inner tuple it finds.
+  return outer.cost_ + outer.rows_ * (IndexLevels(inner_rows) + 1) + rows;
+}
+
+auto CostModel::ResolveColumn(const AbstractPlanNode &plan, uint32_t col_idx) const -> std::optional<ColumnOrigin> {
+  switch (plan.GetType()) {
+    case PlanType::SeqScan: {
+      auto *table = catalog_.GetTable(dynamic_cast<const SeqScanPlanNode &>(plan).GetTableOid());
+      return ColumnOrigin{table, col_idx, TableRows(table)};
+    }
+    case PlanType::IndexScan: {
+      const auto *index = catalog_.GetIndex(dynamic_cast<const IndexScanPlanNode &>(plan).GetIndexOid());
+      auto *table = catalog_.GetTable(index->table_name_);
+      return ColumnOrigin{table, col_idx, TableRows(table)};
+    }
+    case PlanType::MockScan:
+      return ColumnOrigin{nullptr, col_idx,
+                          static_cast<double>(GetSizeOf(&dynamic_cast<const MockScanPlanNode &>(plan)))};
+    case PlanType::Filter:
+    case PlanType::Sort:
+    case PlanType::Limit:
+    case PlanType::TopN:
+    case PlanType::HashSemiJoin:
+      return ResolveColumn(*plan.GetChildAt(0), col_idx);
+    case PlanType::Projection: {
+      const auto &expr = dynamic_cast<const ProjectionPlanNode &>(plan).GetExpressions()[col_idx];
+      if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+        return ResolveColumn(*plan.GetChildAt(0), column->GetColIdx());
+      }
+      return std::nullopt;
+    }
+    case PlanType::Aggregation:
+    case PlanType::StreamAggregation: {
+      const auto &group_bys = dynamic_cast<const AggregationPlanNode &>(plan).GetGroupBys();
+      if (col_idx < group_bys.size()) {
+        if (const auto *column = dynamic_cast<const ColumnValueExpression *>(group_bys[col_idx].get());
+            column != nullptr) {
+          return ResolveColumn(*plan.GetChildAt(0), column->GetColIdx());
+        }
+      }
+      return std::nullopt;
+    }
+    case PlanType::NestedLoopJoin:
+    case PlanType::HashJoin:
+    case PlanType::MergeJoin: {
+      auto left_column_cnt = plan.GetChildAt(0)->OutputSchema().GetColumnCount();
+      if (col_idx < left_column_cnt) {
+        return ResolveColumn(*plan.GetChildAt(0), col_idx);
+      }
+      return ResolveColumn(*plan.GetChildAt(1), col_idx - left_column_cnt);
+    }
+    case PlanType::NestedIndexJoin: {
+      const auto &nij_plan = dynamic_cast<const NestedIndexJoinPlanNode &>(plan);
+      auto outer_column_cnt = nij_plan.GetChildPlan()->OutputSchema().GetColumnCount();
+      if (col_idx < outer_column_cnt) {
+        return ResolveColumn(*nij_plan.GetChildPlan(), col_idx);
+      }
+      auto *table = catalog_.GetTable(nij_plan.GetInnerTableOid());
+      return ColumnOrigin{table, col_idx - outer_column_cnt, TableRows(table)};
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+auto CostModel::DistinctCount(const AbstractExpression &expr, const std::vector<const AbstractPlanNode *> &inputs) const
+    -> std::optional<double> {
+  const auto *column = dynamic_cast<const ColumnValueExpression *>(&expr);
+  if (column == nullptr || column->GetTupleIdx() >= inputs.size()) {
+    return std::nullopt;
+  }
+  auto origin = ResolveColumn(*inputs[column->GetTupleIdx()], column->GetColIdx());
+  if (!origin.has_value()) {
+    return std::nullopt;
+  }
+  if (origin->table_ != nullptr) {
+    std::scoped_lock lock(origin->table_->stats_latch_);
+    if (origin->table_->stats_ != nullptr) {
+      return std::max<double>(1, origin->table_->stats_->GetDistinctCount(origin->col_idx_));
+    }
+  }
+  // Without statistics, assume that every value is different.
+  return std::max(1.0, origin->table_rows_);
+}
+
+auto CostModel::ComparisonSelectivity(const AbstractExpression &pred,
+                                      const std::vector<const AbstractPlanNode *> &inputs) const -> double {
+  const auto &cmp_expr = dynamic_cast<const ComparisonExpression &>(pred);
+  auto comp_type = cmp_expr.comp_type_;
+  const auto *left = cmp_expr.GetChildAt(0).get();
+  const auto *right = cmp_expr.GetChildAt(1).get();
+  if (dynamic_cast<const ConstantValueExpression *>(left) != nullptr) {
+    std::swap(left, right);
+    comp_type = Flip(comp_type);
+  }
+  const auto *constant = dynamic_cast<const ConstantValueExpression *>(right);
+  if (constant != nullptr && constant->val_.IsNull()) {
+    return 0;
+  }
+
+  if (comp_type == ComparisonType::Equal || comp_type == ComparisonType::NotEqual) {
+    auto left_distinct = DistinctCount(*left, inputs);
+    auto eq_selectivity = constant != nullptr ? EqualitySelectivity(left_distinct, std::nullopt)
+                                              : EqualitySelectivity(left_distinct, DistinctCount(*right, inputs));
+    return comp_type == ComparisonType::Equal ? eq_selectivity : 1 - eq_selectivity;
+  }
+
+  const auto *column = dynamic_cast<const ColumnValueExpression *>(left);
+  if (column == nullptr || constant == nullptr || column->GetTupleIdx() >= inputs.size()) {
+    return DEFAULT_SELECTIVITY;
+  }
+  auto origin = ResolveColumn(*inputs[column->GetTupleIdx()], column->GetColIdx());
+  auto less = origin.has_value() ? HistogramLessThan(*origin, constant->val_) : std::nullopt;
+  if (!less.has_value()) {
+    return DEFAULT_SELECTIVITY;
+  }
+  if (comp_type == ComparisonType::LessThan || comp_type == ComparisonType::LessThanOrEqual) {
+    return *less;
+  }
+  return std::max(0.0, 1 - *less);
+}
+
+auto CostModel::Selectivity(const AbstractExpression &pred, const std::vector<const AbstractPlanNode *> &inputs) const
+    -> double {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(&pred); logic_expr != nullptr) {
+    auto left = Selectivity(*logic_expr->GetChildAt(0), inputs);
+    auto right = Selectivity(*logic_expr->GetChildAt(1), inputs);
+    return logic_expr->logic_type_ == LogicType::And ? left * right : left + right - left * right;
+  }
+  if (dynamic_cast<const ComparisonExpression *>(&pred) != nullptr) {
+    return ComparisonSelectivity(pred, inputs);
+  }
+  if (const auto *const_expr = dynamic_cast<const ConstantValueExpression *>(&pred);
+      const_expr != nullptr && const_expr->val_.GetTypeId() == TypeId::BOOLEAN) {
+    return !const_expr->val_.IsNull() && const_expr->val_.GetAs<bool>() ? 1 : 0;
+  }
+  return DEFAULT_SELECTIVITY;
+}
+
+auto CostModel::EstimateNode(const AbstractPlanNode &plan) -> PlanCost {
+  std::vector<PlanCost> children;
+  children.reserve(plan.GetChildren().size());
+  for (const auto &child : plan.GetChildren()) {
+    children.push_back(Estimate(*child));
+  }
+
+  switch (plan.GetType()) {
+    case PlanType::SeqScan: {
+      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(plan);
+      auto table_rows = TableRows(catalog_.GetTable(seq_scan.GetTableOid()));
+      auto selectivity =
+          seq_scan.filter_predicate_ != nullptr ? Selectivity(*seq_scan.filter_predicate_, {&plan}) : 1.0;
+      return {table_rows * selectivity, table_rows};
+    }
+    case PlanType::IndexScan: {
+      const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(plan);
+      const auto *index = catalog_.GetIndex(index_scan.GetIndexOid());
+      auto table_rows = TableRows(catalog_.GetTable(index->table_name_));
+      auto selectivity =
+          index_scan.filter_predicate_ != nullptr ? Selectivity(*index_scan.filter_predicate_, {&plan}) : 1.0;
+      // The scan reads the tuples the index points to, and a bounded scan stops once enough of them passed the filter.
+      auto read = table_rows;
+      auto cost = 0.0;
+      if (index_scan.pred_key_ != nullptr) {
+        ColumnValueExpression key_column(0, index->index_->GetKeyAttrs()[0], TypeId::INTEGER);
+        read = table_rows * EqualitySelectivity(DistinctCount(key_column, {&plan}), std::nullopt);
+        cost = IndexLevels(table_rows);
+      }
+      auto rows = read * selectivity;
+      if (index_scan.limit_.has_value()) {
+        auto limit = static_cast<double>(*index_scan.limit_);
+        read = std::min(read, limit / std::max(selectivity, 1.0 / std::max(read, 1.0)));
+        rows = std::min(rows, limit);
+      }
+      return {rows, cost + read};
+    }
+    case PlanType::MockScan: {
+      auto rows = static_cast<double>(GetSizeOf(&dynamic_cast<const MockScanPlanNode &>(plan)));
+      return {rows, rows};
+    }
+    case PlanType::Values: {
+      auto rows = static_cast<double>(dynamic_cast<const ValuesPlanNode &>(plan).GetValues().size());
+      return {rows, rows};
+    }
+    case PlanType::Filter: {
+      const auto &filter = dynamic_cast<const FilterPlanNode &>(plan);
+      auto selectivity = Selectivity(*filter.GetPredicate(), {plan.GetChildAt(0).get()});
+      return {children[0].rows_ * selectivity, children[0].cost_ + children[0].rows_};
+    }
+    case PlanType::Projection:
+      return {children[0].rows_, children[0].cost_ + children[0].rows_};
+    case PlanType::NestedLoopJoin: {
+      const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(plan);
+      auto selectivity = Selectivity(nlj_plan.Predicate(), {plan.GetChildAt(0).get(), plan.GetChildAt(1).get()});
+      auto rows = children[0].rows_ * children[1].rows_ * selectivity;
+      if (nlj_plan.GetJoinType() == JoinType::LEFT) {
+        rows = std::max(rows, children[0].rows_);
+      } else if (nlj_plan.GetJoinType() == JoinType::SEMI || nlj_plan.GetJoinType() == JoinType::ANTI) {
+        rows = SemiJoinRows(nlj_plan.GetJoinType(), children[0].rows_, children[1].rows_, selectivity);
+      }
+      return {rows, NestedLoopJoinCost(children[0], children[1], rows)};
+    }
+    case PlanType::HashJoin: {
+      const auto &hj_plan = dynamic_cast<const HashJoinPlanNode &>(plan);
+      auto left_ndv = DistinctCount(hj_plan.LeftJoinKeyExpression(), {plan.GetChildAt(0).get()});
+      auto right_ndv = DistinctCount(hj_plan.RightJoinKeyExpression(), {plan.GetChildAt(1).get()});
+      auto selectivity = EqualitySelectivity(left_ndv, right_ndv);
+      auto rows = children[0].rows_ * children[1].rows_ * selectivity;
+      if (hj_plan.GetJoinType() == JoinType::LEFT) {
+        rows = std::max(rows, children[0].rows_);
+      }
+      return {rows, HashJoinCost(children[0], children[1], rows)};
+    }
+    case PlanType::MergeJoin: {
+      const auto &mj_plan = dynamic_cast<const MergeJoinPlanNode &>(plan);
+      auto left_ndv = DistinctCount(mj_plan.LeftJoinKeyExpression(), {plan.GetChildAt(0).get()});
+      auto right_ndv = DistinctCount(mj_plan.RightJoinKeyExpression(), {plan.GetChildAt(1).get()});
+      auto selectivity = EqualitySelectivity(left_ndv, right_ndv);
+      auto rows = children[0].rows_ * children[1].rows_ * selectivity;
+      if (mj_plan.GetJoinType() == JoinType::LEFT) {
+        rows = std::max(rows, children[0].rows_);
+      }
+      return {rows, MergeJoinCost(children[0], children[1], rows)};
+    }
+    case PlanType::HashSemiJoin: {
+      const auto &semi_plan = dynamic_cast<const HashSemiJoinPlanNode &>(plan);
+      double selectivity = 1;
+      for (size_t i = 0; i < semi_plan.LeftJoinKeyExpressions().size(); i++) {
+        selectivity *=
+            EqualitySelectivity(DistinctCount(*semi_plan.LeftJoinKeyExpressions()[i], {plan.GetChildAt(0).get()}),
+                                DistinctCount(*semi_plan.RightJoinKeyExpressions()[i], {plan.GetChildAt(1).get()}));
+      }
+      auto rows = SemiJoinRows(semi_plan.GetJoinType(), children[0].rows_, children[1].rows_, selectivity);
+      return {rows, HashJoinCost(children[0], children[1], rows)};
+    }
+    case PlanType::NestedIndexJoin: {
+      const auto &nij_plan = dynamic_cast<const NestedIndexJoinPlanNode &>(plan);
+      auto *inner_table = catalog_.GetTable(nij_plan.GetInnerTableOid());
+      auto inner_rows = TableRows(inner_table);
+      // The inner key is looked up in the output of the join, whose inner columns follow the outer ones.
+      auto inner_key = catalog_.GetIndex(nij_plan.GetIndexOid())->index_->GetKeyAttrs()[0];
+      ColumnValueExpression inner_column(0, nij_plan.GetChildPlan()->OutputSchema().GetColumnCount() + inner_key,
+                                         TypeId::INTEGER);
+      auto selectivity = EqualitySelectivity(DistinctCount(*nij_plan.KeyPredicate(), {nij_plan.GetChildPlan().get()}),
+                                             DistinctCount(inner_column, {&plan}));
+      auto rows = children[0].rows_ * inner_rows * selectivity;
+      if (nij_plan.GetJoinType() == JoinType::LEFT) {
+        rows = std::max(rows, children[0].rows_);
+      }
+      return {rows, IndexJoinCost(children[0], inner_rows, rows)};
+    }
+    case PlanType::Aggregation:
+    case PlanType::StreamAggregation: {
+      const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(plan);
+      double groups = 1;
+      for (const auto &group_by : agg_plan.GetGroupBys()) {
+        groups *= DistinctCount(*group_by, {plan.GetChildAt(0).get()})
+                      .value_or(std::max(1.0, children[0].rows_ * DEFAULT_EQ_SELECTIVITY));
+      }
+      auto rows = agg_plan.GetGroupBys().empty() ? 1 : std::min(groups, children[0].rows_);
+      return {rows, children[0].cost_ + children[0].rows_};
+    }
+    case PlanType::Sort:
+      return {children[0].rows_, children[0].cost_ + children[0].rows_ * std::log2(std::max(children[0].rows_, 2.0))};
+    case PlanType::Limit: {
+      auto limit = static_cast<double>(dynamic_cast<const LimitPlanNode &>(plan).GetLimit());
+      return {std::min(limit, children[0].rows_), children[0].cost_};
+    }
+    case PlanType::TopN: {
+      auto n = static_cast<double>(dynamic_cast<const TopNPlanNode &>(plan).GetN());
+      return {std::min(n, children[0].rows_), children[0].cost_ + children[0].rows_ * std::log2(std::max(n, 2.0))};
+    }
+    case PlanType::Insert:
+    case PlanType::Update:
+    case PlanType::Delete:
+      return {1, children[0].cost_ + children[0].rows_};
+  }
+  PlanCost estimate{children.empty() ? 1 : children[0].rows_, 0};
+  for (const auto &child : children) {
+    estimate.cost_ += child.cost_;
+  }
+  return estimate;
+}
+
+}  // namespace bustub
@@ -0,0 +1,65 @@
+#include "optimizer/expression_util.h"
+
+#include <memory>
+#include <utility>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+auto IsConstantTrue(const AbstractExpression &expr) -> bool {
+  const auto *const_expr = dynamic_cast<const ConstantValueExpression *>(&expr);
+  return const_expr != nullptr && const_expr->val_.GetTypeId() == TypeId::BOOLEAN && !const_expr->val_.IsNull() &&
+         const_expr->val_.GetAs<bool>();
+}
+
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    SplitConjuncts(logic_expr->GetChildAt(0), conjuncts);
+    SplitConjuncts(logic_expr->GetChildAt(1), conjuncts);
+  } else if (!IsConstantTrue(*expr)) {
+    conjuncts->push_back(expr);
+  }
+}
+
+auto ConjoinExpressions(const std::vector<AbstractExpressionRef> &conjuncts) -> AbstractExpressionRef {
+  if (conjuncts.empty()) {
+    return std::make_shared<ConstantValueExpression>(ValueFactory::GetBooleanValue(true));
+  }
+  auto expr = conjuncts[0];
+  for (size_t i = 1; i < conjuncts.size(); i++) {
+    expr = std::make_shared<LogicExpression>(expr, conjuncts[i], LogicType::And);
+  }
+  return expr;
+}
+
+auto FlattenJoinColumns(const AbstractExpressionRef &expr, uint32_t left_offset, uint32_t right_offset)
+    -> AbstractExpressionRef {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    auto offset = column->GetTupleIdx() == 0 ? left_offset : right_offset;
+    return std::make_shared<ColumnValueExpression>(0, offset + column->GetColIdx(), column->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.push_back(FlattenJoinColumns(child, left_offset, right_offset));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+auto SubstituteColumns(const AbstractExpressionRef &expr, const std::vector<AbstractExpressionRef> &columns)
+    -> AbstractExpressionRef {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    return columns[column->GetColIdx()];
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.push_back(SubstituteColumns(child, columns));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+}  // namespace bustub
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OutputOrdering(const AbstractPlanNode &plan) const -> std::vector<uint32_t> {
+  switch (plan.GetType()) {
+    case PlanType::IndexScan: {
+      const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(plan);
+      const auto *index = catalog_.GetIndex(index_scan.GetIndexOid());
+      // A point lookup of any index returns a single key. A B+ tree is scanned in key order, but it holds no NULL
+      // keys, so a scan of it only comes out in the order of a sort when its key columns are NOT NULL.
+      if (index_scan.pred_key_ != nullptr) {
+        return index->index_->GetKeyAttrs();
+      }
+      const auto &key_columns = index->key_schema_.GetColumns();
+      auto is_nullable = [](const Column &column) { return column.IsNullable(); };
+      if (index->index_type_ != IndexType::BPlusTreeIndex ||
+          std::any_of(key_columns.begin(), key_columns.end(), is_nullable)) {
+        return {};
+      }
+      return index->index_->GetKeyAttrs();
+    }
+    case PlanType::Sort: {
+      std::vector<uint32_t> ordering;
+      for (const auto &[order_type, expr] : dynamic_cast<const SortPlanNode &>(plan).GetOrderBy()) {
+        const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get());
+        if (column == nullptr || order_type == OrderByType::DESC) {
+          break;
+        }
+        ordering.push_back(column->GetColIdx());
+      }
+      return ordering;
+    }
+    case PlanType::Projection: {
+      // The ordering survives as long as the projection passes its columns on.
+      const auto &exprs = dynamic_cast<const ProjectionPlanNode &>(plan).GetExpressions();
+      std::vector<uint32_t> ordering;
+      for (auto col_idx : OutputOrdering(*plan.GetChildAt(0))) {
+        uint32_t out_idx = 0;
+        while (out_idx < exprs.size()) {
+          const auto *column = dynamic_cast<const ColumnValueExpression *>(exprs[out_idx].get());
+          if (column != nullptr && column->GetColIdx() == col_idx) {
+            break;
+          }
+          out_idx++;
+        }
+        if (out_idx == exprs.size()) {
+          break;
+        }
+        ordering.push_back(out_idx);
+      }
+      return ordering;
+    }
+    case PlanType::StreamAggregation: {
+      // The groups come out in the order of the child, and the group by columns come first.
+      const auto &group_bys = dynamic_cast<const AggregationPlanNode &>(plan).GetGroupBys();
+      std::vector<uint32_t> ordering;
+      for (auto col_idx : OutputOrdering(*plan.GetChildAt(0))) {
+        auto it = std::find_if(group_bys.begin(), group_bys.end(), [col_idx](const auto &group_by) {
+          const auto *column = dynamic_cast<const ColumnValueExpression *>(group_by.get());
+          return column != nullptr && column->GetColIdx() == col_idx;
+        });
+        if (it == group_bys.end()) {
+          break;
+        }
+        ordering.push_back(static_cast<uint32_t>(it - group_bys.begin()));
+      }
+      return ordering;
+    }
+    case PlanType::Filter:
+    case PlanType::Limit:
+    // Joins that stream their left side keep its order, and its columns come first.
+    case PlanType::NestedLoopJoin:
+    case PlanType::NestedIndexJoin:
+    case PlanType::HashJoin:
+    case PlanType::HashSemiJoin:
+    case PlanType::MergeJoin:
+      return OutputOrdering(*plan.GetChildAt(0));
+    default:
+      return {};
+  }
+}
+
+auto Optimizer::OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeHashJoinAsMergeJoin(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::HashJoin) {
+    const auto &hj_plan = dynamic_cast<const HashJoinPlanNode &>(*optimized_plan);
+    const auto *left_key = dynamic_cast<const ColumnValueExpression *>(&hj_plan.LeftJoinKeyExpression());
+    const auto *right_key = dynamic_cast<const ColumnValueExpression *>(&hj_plan.RightJoinKeyExpression());
+    if (left_key == nullptr || right_key == nullptr) {
+      return optimized_plan;
+    }
+    // Both sides must come sorted by their key, then the merge join needs no hash table and keeps the order.
+    auto left_ordering = OutputOrdering(*hj_plan.GetLeftPlan());
+    auto right_ordering = OutputOrdering(*hj_plan.GetRightPlan());
+    if (!left_ordering.empty() && left_ordering[0] == left_key->GetColIdx() && !right_ordering.empty() &&
+        right_ordering[0] == right_key->GetColIdx()) {
+      return std::make_shared<MergeJoinPlanNode>(hj_plan.output_schema_, hj_plan.GetLeftPlan(), hj_plan.GetRightPlan(),
+                                                 hj_plan.left_key_expression_, hj_plan.right_key_expression_,
+                                                 hj_plan.GetJoinType());
+    }
+  }
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/nested_index_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/cost_model.h"
+#include "optimizer/expression_util.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** Joins of more relations are kept in the order they were written in, as enumerating them would take too long. */
+constexpr size_t MAX_REORDER_RELATIONS = 10;
+
+/** A set of relations of the join graph, one bit per relation. */
+using RelationSet = uint32_t;
+
+/** JoinRelation is an input of the inner joins that is not an inner join itself. */
+struct JoinRelation {
+  AbstractPlanNodeRef plan_;
+  /** The first column of the relation in the output of the whole join */
+  uint32_t offset_;
+  /** The conjuncts that only refer to this relation */
+  std::vector<AbstractExpressionRef> filters_;
+};
+
+/** JoinConjunct is one conjunct of the join predicates, whose columns are numbered as in the output of the join. */
+struct JoinConjunct {
+  AbstractExpressionRef expr_;
+  RelationSet relations_;
+};
+
+/** JoinCandidate is the cheapest plan found for a set of relations. */
+struct JoinCandidate {
+  AbstractPlanNodeRef plan_;
+  /** The columns the plan outputs, numbered as in the output of the whole join */
+  std::vector<uint32_t> columns_;
+  PlanCost estimate_;
+};
+
+/**
+ * Renumber the columns of a conjunct of the whole join as the columns of the two inputs of a join. With no right
+ * columns, the conjunct is renumbered for a filter over the left input.
+ */
+auto ToInputColumns(const AbstractExpressionRef &expr, const std::vector<uint32_t> &left_columns,
+                    const std::vector<uint32_t> &right_columns) -> AbstractExpressionRef {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr.get()); column != nullptr) {
+    auto it = std::find(left_columns.begin(), left_columns.end(), column->GetColIdx());
+    if (it != left_columns.end()) {
+      return std::make_shared<ColumnValueExpression>(0, it - left_columns.begin(), column->GetReturnType());
+    }
+    it = std::find(right_columns.begin(), right_columns.end(), column->GetColIdx());
+    BUSTUB_ASSERT(it != right_columns.end(), "a conjunct refers to a column of neither input");
+    return std::make_shared<ColumnValueExpression>(1, it - right_columns.begin(), column->GetReturnType());
+  }
+  std::vector<AbstractExpressionRef> children;
+  for (const auto &child : expr->GetChildren()) {
+    children.push_back(ToInputColumns(child, left_columns, right_columns));
+  }
+  return expr->CloneWithChildren(std::move(children));
+}
+
+/** @return the relations a conjunct refers to */
+auto ReferencedRelations(const AbstractExpression &expr, const std::vector<JoinRelation> &relations) -> RelationSet {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(&expr); column != nullptr) {
+    for (size_t i = relations.size(); i-- > 0;) {
+      if (column->GetColIdx() >= relations[i].offset_) {
+        return RelationSet{1} << i;
+      }
+    }
+  }
+  RelationSet set = 0;
+  for (const auto &child : expr.GetChildren()) {
+    set |= ReferencedRelations(*child, relations);
+  }
+  return set;
+}
+
+/**
+ * Collect the relations and predicates of a tree of inner nested loop joins.
+ * @return the number of columns of the tree
+ */
+auto CollectJoinGraph(const AbstractPlanNodeRef &plan, uint32_t offset, std::vector<JoinRelation> *relations,
+                      std::vector<AbstractExpressionRef> *conjuncts) -> uint32_t {
+  if (plan->GetType() == PlanType::NestedLoopJoin) {
+    const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+    if (nlj_plan.GetJoinType() == JoinType::INNER) {
+      auto left_column_cnt = CollectJoinGraph(nlj_plan.GetLeftPlan(), offset, relations, conjuncts);
+      auto right_column_cnt = CollectJoinGraph(nlj_plan.GetRightPlan(), offset + left_column_cnt, relations, conjuncts);
+      std::vector<AbstractExpressionRef> predicates;
+      SplitConjuncts(nlj_plan.predicate_, &predicates);
+      for (const auto &predicate : predicates) {
+        conjuncts->push_back(FlattenJoinColumns(predicate, offset, offset + left_column_cnt));
+      }
+      return left_column_cnt + right_column_cnt;
+    }
+  }
+  // The filter of a scan is taken apart as well, so that the scan stays available to an index join.
+  if (plan->GetType() == PlanType::SeqScan) {
+    const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*plan);
+    if (seq_scan.filter_predicate_ != nullptr) {
+      std::vector<AbstractExpressionRef> filters;
+      SplitConjuncts(seq_scan.filter_predicate_, &filters);
+      for (const auto &filter : filters) {
+        conjuncts->push_back(FlattenJoinColumns(filter, offset, offset));
+      }
+      auto raw_scan = std::make_shared<SeqScanPlanNode>(seq_scan.output_schema_, seq_scan.GetTableOid(),
+                                                        seq_scan.table_name_, nullptr);
+      relations->push_back(JoinRelation{std::move(raw_scan), offset, {}});
+      return plan->OutputSchema().GetColumnCount();
+    }
+  }
+  relations->push_back(JoinRelation{plan, offset, {}});
+  return plan->OutputSchema().GetColumnCount();
+}
+
+/** @return the columns of `left_column = right_column`, if the expression compares a column of each input */
+auto MatchEquiJoinKeys(const AbstractExpression &expr) -> std::optional<std::pair<uint32_t, uint32_t>> {
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(&expr);
+  if (cmp_expr == nullptr || cmp_expr->comp_type_ != ComparisonType::Equal) {
+    return std::nullopt;
+  }
+  const auto *left = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(0).get());
+  const auto *right = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(1).get());
+  if (left == nullptr || right == nullptr || left->GetTupleIdx() == right->GetTupleIdx() ||
+      left->GetReturnType() != right->GetReturnType()) {
+    return std::nullopt;
+  }
+  if (left->GetTupleIdx() == 1) {
+    std::swap(left, right);
+  }
+  return std::make_pair(left->GetColIdx(), right->GetColIdx());
+}
+
+/**
+ * JoinEnumerator finds the cheapest order and algorithms for the joins of a join graph, by dynamic programming over
+ * the subsets of relations (DPsub): the sets are visited in numeric order, and every split of a set into two non-empty
+ * halves is tried, which is O(3^n) joins for n relations.
+ */
+class JoinEnumerator {
+ public:
+  JoinEnumerator(const Catalog &catalog, std::vector<JoinRelation> relations, std::vector<JoinConjunct> conjuncts)
+      : catalog_(catalog), cost_model_(catalog), relations_(std::move(relations)), conjuncts_(std::move(conjuncts)) {}
+
+  /** @return the cheapest plan joining all relations, which outputs columns_ in the given order */
+  auto Enumerate() -> JoinCandidate {
+    auto relation_cnt = relations_.size();
+    RelationSet all = (RelationSet{1} << relation_cnt) - 1;
+    best_.resize(all + 1);
+
+    for (size_t i = 0; i < relation_cnt; i++) {
+      auto &relation = relations_[i];
+      std::vector<uint32_t> columns(relation.plan_->OutputSchema().GetColumnCount());
+      for (uint32_t j = 0; j < columns.size(); j++) {
+        columns[j] = relation.offset_ + j;
+      }
+      auto plan = relation.plan_;
+      if (!relation.filters_.empty()) {
+        std::vector<AbstractExpressionRef> filters;
+        for (const auto &filter : relation.filters_) {
+          filters.push_back(ToInputColumns(filter, columns, {}));
+        }
+        plan = std::make_shared<FilterPlanNode>(plan->output_schema_, ConjoinExpressions(filters), plan);
+      }
+      auto estimate = cost_model_.Estimate(*plan);
+      best_[RelationSet{1} << i] = JoinCandidate{std::move(plan), std::move(columns), estimate};
+    }
+
+    // Every proper subset of a set is numerically smaller, so its best plan is known by the time the set is reached.
+    for (RelationSet set = 1; set <= all; set++) {
+      if ((set & (set - 1)) == 0) {
+        continue;
+      }
+      // Cross products are only considered if the relations cannot be joined on a predicate.
+      for (bool allow_cross_product : {false, true}) {
+        for (RelationSet left = (set - 1) & set; left != 0; left = (left - 1) & set) {
+          auto right = set ^ left;
+          std::vector<AbstractExpressionRef> predicates;
+          for (const auto &conjunct : conjuncts_) {
+            if ((conjunct.relations_ & ~set) == 0 && (conjunct.relations_ & ~left) != 0 &&
+                (conjunct.relations_ & ~right) != 0) {
+              predicates.push_back(conjunct.expr_);
+            }
+          }
+          if (predicates.empty() && !allow_cross_product) {
+            continue;
+          }
+          auto candidate = Join(*best_[left], *best_[right], predicates,
+                                (right & (right - 1)) == 0 ? &relations_[__builtin_ctz(right)] : nullptr);
+          if (!best_[set].has_value() || candidate.estimate_.cost_ < best_[set]->estimate_.cost_) {
+            best_[set] = std::move(candidate);
+          }
+        }
+        if (best_[set].has_value()) {
+          break;
+        }
+      }
+    }
+    return *best_[all];
+  }
+
+ private:
+  /**
+   * Find the cheapest way to join two candidates.
+   * @param left the outer input
+   * @param right the inner input
+   * @param conjuncts the conjuncts that connect the inputs
+   * @param right_relation the relation the right input consists of, if it is a single one
+   */
+  auto Join(const JoinCandidate &left, const JoinCandidate &right, const std::vector<AbstractExpressionRef> &conjuncts,
+            const JoinRelation *right_relation) -> JoinCandidate {
+    std::vector<AbstractExpressionRef> predicates;
+    std::vector<double> selectivities;
+    double selectivity = 1;
+    for (const auto &conjunct : conjuncts) {
+      predicates.push_back(ToInputColumns(conjunct, left.columns_, right.columns_));
+      selectivities.push_back(cost_model_.Selectivity(*predicates.back(), {left.plan_.get(), right.plan_.get()}));
+      selectivity *= selectivities.back();
+    }
+    auto input_rows = left.estimate_.rows_ * right.estimate_.rows_;
+    auto rows = input_rows * selectivity;
+    auto columns = left.columns_;
+    columns.insert(columns.end(), right.columns_.begin(), right.columns_.end());
+    auto schema = std::make_shared<Schema>(NestedLoopJoinPlanNode::InferJoinSchema(*left.plan_, *right.plan_));
+    auto left_column_cnt = static_cast<uint32_t>(left.columns_.size());
+
+    // The other conjuncts are checked by a filter above a hash or index join.
+    auto filter_others = [&](AbstractPlanNodeRef join, size_t key_idx, std::vector<AbstractExpressionRef> others) {
+      for (size_t i = 0; i < predicates.size(); i++) {
+        if (i != key_idx) {
+          others.push_back(predicates[i]);
+        }
+      }
+      if (others.empty()) {
+        return join;
+      }
+      for (auto &other : others) {
+        other = FlattenJoinColumns(other, 0, left_column_cnt);
+      }
+      return AbstractPlanNodeRef{std::make_shared<FilterPlanNode>(schema, ConjoinExpressions(others), std::move(join))};
+    };
+
+    auto nlj = std::make_shared<NestedLoopJoinPlanNode>(schema, left.plan_, right.plan_, ConjoinExpressions(predicates),
+                                                        JoinType::INNER);
+    JoinCandidate best{std::move(nlj), columns,
+                       PlanCost{rows, CostModel::NestedLoopJoinCost(left.estimate_, right.estimate_, rows)}};
+
+    for (size_t i = 0; i < predicates.size(); i++) {
+      auto keys = MatchEquiJoinKeys(*predicates[i]);
+      if (!keys.has_value()) {
+        continue;
+      }
+      auto key_type = schema->GetColumn(keys->first).GetType();
+      auto join_rows = input_rows * selectivities[i];
+      auto filter_cost = predicates.size() > 1 ? join_rows : 0;
+
+      auto hash_join_cost = CostModel::HashJoinCost(left.estimate_, right.estimate_, join_rows) + filter_cost;
+      if (hash_join_cost < best.estimate_.cost_) {
+        auto hash_join = std::make_shared<HashJoinPlanNode>(
+            schema, left.plan_, right.plan_, std::make_shared<ColumnValueExpression>(0, keys->first, key_type),
+            std::make_shared<ColumnValueExpression>(0, keys->second, key_type), JoinType::INNER);
+        best = JoinCandidate{filter_others(std::move(hash_join), i, {}), columns, PlanCost{rows, hash_join_cost}};
+      }
+
+      // An index of the inner table replaces scanning it, as long as the inner side is a plain scan.
+      if (right_relation == nullptr || right_relation->plan_->GetType() != PlanType::SeqScan) {
+        continue;
+      }
+      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*right_relation->plan_);
+      const auto *index_info = MatchIndex(seq_scan.table_name_, keys->second);
+      if (seq_scan.filter_predicate_ != nullptr || index_info == nullptr ||
+          index_info->key_schema_.GetColumn(0).GetType() != key_type) {
+        continue;
+      }
+      // The filters of the inner relation are checked above the join, which also scales the estimate of its rows.
+      auto inner_rows = CostModel::TableRows(catalog_.GetTable(seq_scan.GetTableOid()));
+      auto index_join_rows = join_rows / right.estimate_.rows_ * inner_rows;
+      if (right.estimate_.rows_ <= 0) {
+        index_join_rows = left.estimate_.rows_ * inner_rows * selectivities[i];
+      }
+      std::vector<AbstractExpressionRef> inner_filters;
+      for (const auto &filter : right_relation->filters_) {
+        inner_filters.push_back(ToInputColumns(filter, left.columns_, right.columns_));
+      }
+      auto index_filter_cost = predicates.size() > 1 || !inner_filters.empty() ? index_join_rows : 0;
+      auto index_join_cost = CostModel::IndexJoinCost(left.estimate_, inner_rows, index_join_rows) + index_filter_cost;
+      if (index_join_cost < best.estimate_.cost_) {
+        auto index_join = std::make_shared<NestedIndexJoinPlanNode>(
+            schema, left.plan_, std::make_shared<ColumnValueExpression>(0, keys->first, key_type),
+            seq_scan.GetTableOid(), index_info->index_oid_, index_info->name_, seq_scan.table_name_,
+            seq_scan.output_schema_, JoinType::INNER);
+        best = JoinCandidate{filter_others(std::move(index_join), i, std::move(inner_filters)), columns,
+                             PlanCost{rows, index_join_cost}};
+      }
+    }
+    return best;
+  }
+
+  /** @return an index whose key is exactly the given column of the table, or nullptr */
+  auto MatchIndex(const std::string &table_name, uint32_t col_idx) const -> const IndexInfo * {
+    const auto key_attrs = std::vector{col_idx};
+    for (const auto *index_info : catalog_.GetTableIndexes(table_name)) {
+      if (index_info->index_->GetKeyAttrs() == key_attrs) {
+        return index_info;
+      }
+    }
+    return nullptr;
+  }
+
+  const Catalog &catalog_;
+  CostModel cost_model_;
+  std::vector<JoinRelation> relations_;
+  std::vector<JoinConjunct> conjuncts_;
+  /** The cheapest plan of every set of relations */
+  std::vector<std::optional<JoinCandidate>> best_;
+};
+
+}  // namespace
+
+auto Optimizer::OptimizeJoinOrder(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  // A filter right above the joins contributes its conjuncts, which refer to the output of the joins already.
+  auto join_root = plan;
+  std::vector<AbstractExpressionRef> conjuncts;
+  if (plan->GetType() == PlanType::Filter) {
+    join_root = plan->GetChildAt(0);
+    SplitConjuncts(dynamic_cast<const FilterPlanNode &>(*plan).GetPredicate(), &conjuncts);
+  }
+  std::vector<JoinRelation> relations;
+  if (join_root->GetType() == PlanType::NestedLoopJoin) {
+    CollectJoinGraph(join_root, 0, &relations, &conjuncts);
+  }
+  if (relations.size() < 2 || relations.size() > MAX_REORDER_RELATIONS) {
+    std::vector<AbstractPlanNodeRef> children;
+    for (const auto &child : plan->GetChildren()) {
+      children.emplace_back(OptimizeJoinOrder(child));
+    }
+    return plan->CloneWithChildren(std::move(children));
+  }
+
+  for (auto &relation : relations) {
+    relation.plan_ = OptimizeJoinOrder(relation.plan_);
+  }
+  // Conjuncts of a single relation filter it before the joins, and constant ones are checked by the last join.
+  RelationSet all = (RelationSet{1} << relations.size()) - 1;
+  std::vector<JoinConjunct> join_conjuncts;
+  for (auto &conjunct : conjuncts) {
+    auto set = ReferencedRelations(*conjunct, relations);
+    if (set != 0 && (set & (set - 1)) == 0) {
+      relations[__builtin_ctz(set)].filters_.push_back(std::move(conjunct));
+    } else {
+      join_conjuncts.push_back(JoinConjunct{std::move(conjunct), set == 0 ? all : set});
+    }
+  }
+
+  auto best = JoinEnumerator(catalog_, std::move(relations), std::move(join_conjuncts)).Enumerate();
+  bool in_order = true;
+  for (uint32_t i = 0; i < best.columns_.size(); i++) {
+    in_order = in_order && best.columns_[i] == i;
+  }
+  if (in_order) {
+    return best.plan_;
+  }
+  // Put the columns back in the order the plans above expect.
+  std::vector<AbstractExpressionRef> columns;
+  for (uint32_t i = 0; i < best.columns_.size(); i++) {
+    auto pos = std::find(best.columns_.begin(), best.columns_.end(), i) - best.columns_.begin();
+    columns.push_back(
+        std::make_shared<ColumnValueExpression>(0, pos, join_root->OutputSchema().GetColumn(i).GetType()));
+  }
+  return std::make_shared<ProjectionPlanNode>(join_root->output_schema_, std::move(columns), best.plan_);
+}
+
+}  // namespace bustub
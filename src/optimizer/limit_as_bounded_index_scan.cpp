@@ -0,0 +1,34 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeLimitAsBoundedIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeLimitAsBoundedIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Limit) {
+    return optimized_plan;
+  }
+  BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Limit with multiple children?? Impossible!");
+  const auto &child_plan = optimized_plan->children_[0];
+  if (child_plan->GetType() != PlanType::IndexScan) {
+    return optimized_plan;
+  }
+  // The scan stops by itself once enough tuples passed its filter, instead of reading the index to the end.
+  const auto &limit_plan = dynamic_cast<const LimitPlanNode &>(*optimized_plan);
+  const auto &index_scan = dynamic_cast<const IndexScanPlanNode &>(*child_plan);
+  auto limit = std::min(limit_plan.GetLimit(), index_scan.limit_.value_or(limit_plan.GetLimit()));
+  return std::make_shared<IndexScanPlanNode>(limit_plan.output_schema_, index_scan.index_oid_, index_scan.pred_key_,
+                                             index_scan.filter_predicate_, limit);
+}
+
+}  // namespace bustub
@@ -16,6 +16,7 @@
 #include "execution/plans/nested_loop_join_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "optimizer/cost_model.h"
 #include "optimizer/optimizer.h"
 #include "type/type_id.h"
 
@@ -43,6 +44,10 @@ auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> Abstr
     const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*optimized_plan);
     // Has exactly two children
     BUSTUB_ENSURE(nlj_plan.children_.size() == 2, "NLJ should have exactly 2 children.");
+    // Semi and anti joins output left tuples only, which these join executors cannot do.
+    if (nlj_plan.GetJoinType() == JoinType::SEMI || nlj_plan.GetJoinType() == JoinType::ANTI) {
+      return optimized_plan;
+    }
     // Check if expr is equal condition where one is for the left table, and one is for the right table.
     if (const auto *expr = dynamic_cast<const ComparisonExpression *>(&nlj_plan.Predicate()); expr != nullptr) {
       if (expr->comp_type_ == ComparisonType::Equal) {
@@ -57,9 +62,22 @@ auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> Abstr
                 std::make_shared<ColumnValueExpression>(0, right_expr->GetColIdx(), right_expr->GetReturnType());
             // Now it's in form of <column_expr> = <column_expr>. Let's match an index for them.
 
-            // Ensure right child is table scan
-            if (nlj_plan.GetRightPlan()->GetType() == PlanType::SeqScan) {
+            // Ensure right child is table scan, without a filter the index lookup would skip
+            if (nlj_plan.GetRightPlan()->GetType() == PlanType::SeqScan &&
+                dynamic_cast<const SeqScanPlanNode &>(*nlj_plan.GetRightPlan()).filter_predicate_ == nullptr) {
               const auto &right_seq_scan = dynamic_cast<const SeqScanPlanNode &>(*nlj_plan.GetRightPlan());
+              // The equi-join becomes a hash join otherwise, so the index has to beat it. A big outer side probing a
+              // small table is cheaper to hash.
+              if (!force_starter_rule_) {
+                CostModel cost_model(catalog_);
+                auto left = cost_model.Estimate(*nlj_plan.GetLeftPlan());
+                auto right = cost_model.Estimate(*nlj_plan.GetRightPlan());
+                auto rows = cost_model.Estimate(nlj_plan).rows_;
+                auto inner_rows = CostModel::TableRows(catalog_.GetTable(right_seq_scan.GetTableOid()));
+                if (CostModel::IndexJoinCost(left, inner_rows, rows) > CostModel::HashJoinCost(left, right, rows)) {
+                  return optimized_plan;
+                }
+              }
               if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1) {
                 if (auto index = MatchIndex(right_seq_scan.table_name_, right_expr->GetColIdx());
                     index != std::nullopt) {
@@ -1,7 +1,7 @@
 #include "optimizer/optimizer.h"
 #include <optional>
-#include "common/util/string_util.h"
 #include "execution/plans/abstract_plan.h"
+#include "optimizer/cost_model.h"
 
 namespace bustub {
 
@@ -21,25 +21,11 @@ auto Optimizer::Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef
 }
 
 auto Optimizer::EstimatedCardinality(const std::string &table_name) -> std::optional<size_t> {
-  if (StringUtil::EndsWith(table_name, "_1m")) {
-    return std::make_optional(1000000);
+  auto *table_info = catalog_.GetTable(table_name);
+  if (table_info == Catalog::NULL_TABLE_INFO) {
+    return std::nullopt;
   }
-  if (StringUtil::EndsWith(table_name, "_100k")) {
-    return std::make_optional(100000);
-  }
-  if (StringUtil::EndsWith(table_name, "_50k")) {
-    return std::make_optional(50000);
-  }
-  if (StringUtil::EndsWith(table_name, "_10k")) {
-    return std::make_optional(10000);
-  }
-  if (StringUtil::EndsWith(table_name, "_1k")) {
-    return std::make_optional(1000);
-  }
-  if (StringUtil::EndsWith(table_name, "_100")) {
-    return std::make_optional(100);
-  }
-  return std::nullopt;
+  return static_cast<size_t>(CostModel::TableRows(table_info));
 }
 
 }  // namespace bustub
@@ -10,10 +10,18 @@ namespace bustub {
 auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
   auto p = plan;
   p = OptimizeMergeProjection(p);
-  p = OptimizeMergeFilterNLJ(p);
+  p = OptimizeConstantFolding(p);
+  p = OptimizePredicatePushdown(p);  // Subsumes merging filters into nested loop joins.
+  p = OptimizeJoinOrder(p);
   p = OptimizeNLJAsIndexJoin(p);
-  // p = OptimizeNLJAsHashJoin(p);  // Enable this rule after you have implemented hash join.
-  p = OptimizeOrderByAsIndexScan(p);
+  p = OptimizeNLJAsHashJoin(p);
+  p = OptimizeSortLimitBelowProjection(p);
+  p = OptimizeMergeFilterScan(p);  // Let the scan evaluate the filter in place, see TupleView.
+  p = OptimizeSeqScanAsIndexScan(p);
+  p = OptimizeOrderByAsIndexScan(p);  // After point lookups, which beat scanning the index in order.
+  p = OptimizeLimitAsBoundedIndexScan(p);
+  p = OptimizeAggregationAsStreamAggregation(p);  // After the rules that introduce index scans.
+  p = OptimizeHashJoinAsMergeJoin(p);
   p = OptimizeSortLimitAsTopN(p);
   return p;
 }
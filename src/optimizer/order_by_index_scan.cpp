@@ -55,17 +55,37 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
     BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Sort with multiple children?? Impossible!");
     const auto &child_plan = optimized_plan->children_[0];
 
-    if (child_plan->GetType() == PlanType::SeqScan) {
-      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
+    // A filter, of the scan or right above it, is applied by the index scan to the tuples it reads.
+    const AbstractPlanNode *scan_plan = child_plan.get();
+    AbstractExpressionRef filter_predicate;
+    if (scan_plan->GetType() == PlanType::Filter) {
+      filter_predicate = dynamic_cast<const FilterPlanNode &>(*scan_plan).GetPredicate();
+      scan_plan = scan_plan->GetChildAt(0).get();
+    }
+    if (scan_plan->GetType() == PlanType::SeqScan) {
+      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*scan_plan);
+      if (seq_scan.filter_predicate_ != nullptr) {
+        if (filter_predicate != nullptr) {
+          return optimized_plan;
+        }
+        filter_predicate = seq_scan.filter_predicate_;
+      }
       const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
       const auto indices = catalog_.GetTableIndexes(table_info->name_);
 
+      // The index holds no NULL keys, which the sort would put first.
+      const auto &order_by_column = table_info->schema_.GetColumn(order_by_column_id);
+      if (order_by_column.IsNullable()) {
+        return optimized_plan;
+      }
       for (const auto *index : indices) {
         const auto &columns = index->key_schema_.GetColumns();
-        if (columns.size() == 1 &&
-            columns[0].GetName() == table_info->schema_.GetColumn(order_by_column_id).GetName()) {
+        // Only a B+ tree hands out its keys in order.
+        if (index->index_type_ == IndexType::BPlusTreeIndex && columns.size() == 1 &&
+            columns[0].GetName() == order_by_column.GetName()) {
           // Index matched, return index scan instead
-          return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_);
+          return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_, nullptr,
+                                                     std::move(filter_predicate));
         }
       }
     }
@@ -0,0 +1,156 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/expression_util.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return the tuples an expression refers to, one bit per tuple index */
+auto ReferencedTuples(const AbstractExpression &expr) -> uint32_t {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(&expr); column != nullptr) {
+    return 1U << column->GetTupleIdx();
+  }
+  uint32_t tuples = 0;
+  for (const auto &child : expr.GetChildren()) {
+    tuples |= ReferencedTuples(*child);
+  }
+  return tuples;
+}
+
+/** @return true if every column the expression refers to is one of the first column_cnt columns */
+auto RefersToFirstColumns(const AbstractExpression &expr, size_t column_cnt) -> bool {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(&expr); column != nullptr) {
+    return column->GetColIdx() < column_cnt;
+  }
+  for (const auto &child : expr.GetChildren()) {
+    if (!RefersToFirstColumns(*child, column_cnt)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto AddFilter(AbstractPlanNodeRef plan, const std::vector<AbstractExpressionRef> &conjuncts) -> AbstractPlanNodeRef {
+  if (conjuncts.empty()) {
+    return plan;
+  }
+  auto schema = plan->output_schema_;
+  return std::make_shared<FilterPlanNode>(std::move(schema), ConjoinExpressions(conjuncts), std::move(plan));
+}
+
+}  // namespace
+
+auto Optimizer::OptimizePredicatePushdown(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  return PushDownConjuncts(plan, {});
+}
+
+auto Optimizer::PushDownConjuncts(const AbstractPlanNodeRef &plan, std::vector<AbstractExpressionRef> conjuncts)
+    -> AbstractPlanNodeRef {
+  switch (plan->GetType()) {
+    case PlanType::Filter: {
+      SplitConjuncts(dynamic_cast<const FilterPlanNode &>(*plan).GetPredicate(), &conjuncts);
+      return PushDownConjuncts(plan->GetChildAt(0), std::move(conjuncts));
+    }
+    case PlanType::SeqScan: {
+      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*plan);
+      if (conjuncts.empty()) {
+        return plan;
+      }
+      if (seq_scan.filter_predicate_ != nullptr) {
+        conjuncts.insert(conjuncts.begin(), seq_scan.filter_predicate_);
+      }
+      return std::make_shared<SeqScanPlanNode>(seq_scan.output_schema_, seq_scan.GetTableOid(), seq_scan.table_name_,
+                                               ConjoinExpressions(conjuncts));
+    }
+    case PlanType::Projection: {
+      const auto &projection = dynamic_cast<const ProjectionPlanNode &>(*plan);
+      for (auto &conjunct : conjuncts) {
+        conjunct = SubstituteColumns(conjunct, projection.GetExpressions());
+      }
+      return plan->CloneWithChildren({PushDownConjuncts(plan->GetChildAt(0), std::move(conjuncts))});
+    }
+    case PlanType::Sort:
+      return plan->CloneWithChildren({PushDownConjuncts(plan->GetChildAt(0), std::move(conjuncts))});
+    case PlanType::Aggregation: {
+      // A conjunct on the group by columns removes whole groups, so it can remove their rows before they are grouped.
+      // Without any column it would also decide whether an aggregation without groups outputs its single row.
+      const auto &aggregation = dynamic_cast<const AggregationPlanNode &>(*plan);
+      const auto &group_bys = aggregation.GetGroupBys();
+      std::vector<AbstractExpressionRef> below;
+      std::vector<AbstractExpressionRef> above;
+      for (auto &conjunct : conjuncts) {
+        if (ReferencedTuples(*conjunct) != 0 && RefersToFirstColumns(*conjunct, group_bys.size())) {
+          below.push_back(SubstituteColumns(conjunct, group_bys));
+        } else {
+          above.push_back(std::move(conjunct));
+        }
+      }
+      return AddFilter(plan->CloneWithChildren({PushDownConjuncts(plan->GetChildAt(0), std::move(below))}), above);
+    }
+    case PlanType::NestedLoopJoin: {
+      const auto &nlj_plan = dynamic_cast<const NestedLoopJoinPlanNode &>(*plan);
+      auto join_type = nlj_plan.GetJoinType();
+      if (join_type != JoinType::INNER && join_type != JoinType::LEFT) {
+        break;
+      }
+      auto left_column_cnt = nlj_plan.GetLeftPlan()->OutputSchema().GetColumnCount();
+      auto right_column_cnt = nlj_plan.GetRightPlan()->OutputSchema().GetColumnCount();
+
+      // The conjuncts from above become part of an inner join's predicate. A left join must still output every left
+      // tuple, so only conjuncts on the left side may pass it.
+      std::vector<AbstractExpressionRef> predicates;
+      std::vector<AbstractExpressionRef> left;
+      std::vector<AbstractExpressionRef> above;
+      SplitConjuncts(nlj_plan.predicate_, &predicates);
+      for (auto &conjunct : conjuncts) {
+        auto join_conjunct = RewriteExpressionForJoin(conjunct, left_column_cnt, right_column_cnt);
+        if (join_type == JoinType::INNER) {
+          predicates.push_back(std::move(join_conjunct));
+        } else if (ReferencedTuples(*join_conjunct) == 1) {
+          left.push_back(std::move(conjunct));
+        } else {
+          above.push_back(std::move(conjunct));
+        }
+      }
+
+      // A conjunct of the join predicate on the right side only filters the right tuples before they are joined, which
+      // a left join pads with NULLs as well. A conjunct on the left side only does the same for an inner join.
+      std::vector<AbstractExpressionRef> right;
+      std::vector<AbstractExpressionRef> join_predicates;
+      for (auto &predicate : predicates) {
+        auto tuples = ReferencedTuples(*predicate);
+        if (tuples == 1 && join_type == JoinType::INNER) {
+          left.push_back(std::move(predicate));
+        } else if (tuples == 2) {
+          right.push_back(FlattenJoinColumns(predicate, 0, 0));
+        } else {
+          join_predicates.push_back(std::move(predicate));
+        }
+      }
+      auto join = std::make_shared<NestedLoopJoinPlanNode>(
+          nlj_plan.output_schema_, PushDownConjuncts(nlj_plan.GetLeftPlan(), std::move(left)),
+          PushDownConjuncts(nlj_plan.GetRightPlan(), std::move(right)), ConjoinExpressions(join_predicates), join_type);
+      return AddFilter(std::move(join), above);
+    }
+    default:
+      break;
+  }
+
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(PushDownConjuncts(child, {}));
+  }
+  return AddFilter(plan->CloneWithChildren(std::move(children)), conjuncts);
+}
+
+}  // namespace bustub
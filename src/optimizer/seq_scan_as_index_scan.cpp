@@ -0,0 +1,98 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/expressions/parameter_value_expression.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * Find `column = constant` (or `constant = column`) among the conjuncts of the predicate.
+ * @return the column and the constant, or nullptrs if there is no such conjunct
+ */
+auto FindPointPredicate(const AbstractExpressionRef &expr, const Catalog &catalog, const std::string &table_name)
+    -> std::pair<const ColumnValueExpression *, AbstractExpressionRef> {
+  if (const auto *logic_expr = dynamic_cast<const LogicExpression *>(expr.get());
+      logic_expr != nullptr && logic_expr->logic_type_ == LogicType::And) {
+    auto found = FindPointPredicate(logic_expr->GetChildAt(0), catalog, table_name);
+    return found.first != nullptr ? found : FindPointPredicate(logic_expr->GetChildAt(1), catalog, table_name);
+  }
+  const auto *cmp_expr = dynamic_cast<const ComparisonExpression *>(expr.get());
+  if (cmp_expr == nullptr || cmp_expr->comp_type_ != ComparisonType::Equal) {
+    return {nullptr, nullptr};
+  }
+  for (size_t column_side = 0; column_side < 2; column_side++) {
+    const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(cmp_expr->GetChildAt(column_side).get());
+    const auto &constant = cmp_expr->GetChildAt(1 - column_side);
+    const auto *constant_expr = dynamic_cast<const ConstantValueExpression *>(constant.get());
+    const auto *param_expr = dynamic_cast<const ParameterValueExpression *>(constant.get());
+    if (column_expr == nullptr || (constant_expr == nullptr && param_expr == nullptr) ||
+        (constant_expr != nullptr && constant_expr->val_.IsNull())) {
+      continue;
+    }
+    // The constant, or the parameter of a prepared statement, becomes the index key as is, so it has to have the
+    // column's type.
+    const auto &column = catalog.GetTable(table_name)->schema_.GetColumn(column_expr->GetColIdx());
+    if (constant->GetReturnType() == column.GetType()) {
+      return {column_expr, constant};
+    }
+  }
+  return {nullptr, nullptr};
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeSeqScanAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*optimized_plan);
+  if (seq_scan.filter_predicate_ == nullptr) {
+    return optimized_plan;
+  }
+  auto [column_expr, key] = FindPointPredicate(seq_scan.filter_predicate_, catalog_, seq_scan.table_name_);
+  if (column_expr == nullptr) {
+    return optimized_plan;
+  }
+
+  // Any index on exactly this column serves the lookup, but a hash index answers it without walking down a tree.
+  const IndexInfo *match = nullptr;
+  const auto key_attrs = std::vector{column_expr->GetColIdx()};
+  for (const auto *index_info : catalog_.GetTableIndexes(seq_scan.table_name_)) {
+    if (index_info->index_->GetKeyAttrs() == key_attrs &&
+        (match == nullptr || index_info->index_type_ == IndexType::HashTableIndex)) {
+      match = index_info;
+    }
+  }
+  if (match == nullptr) {
+    return optimized_plan;
+  }
+
+  auto index_scan = std::make_shared<IndexScanPlanNode>(seq_scan.output_schema_, match->index_oid_, std::move(key));
+  if (dynamic_cast<const LogicExpression *>(seq_scan.filter_predicate_.get()) == nullptr) {
+    // The point predicate was the whole filter.
+    return index_scan;
+  }
+  // The other conjuncts still have to be checked on every tuple the index returns.
+  return std::make_shared<FilterPlanNode>(seq_scan.output_schema_, seq_scan.filter_predicate_, std::move(index_scan));
+}
+
+}  // namespace bustub
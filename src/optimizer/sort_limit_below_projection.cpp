@@ -0,0 +1,53 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "optimizer/expression_util.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeSortLimitBelowProjection(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeSortLimitBelowProjection(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Sort && optimized_plan->GetType() != PlanType::Limit) {
+    return optimized_plan;
+  }
+  BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Sort or limit with multiple children?? Impossible!");
+  if (optimized_plan->children_[0]->GetType() != PlanType::Projection) {
+    return optimized_plan;
+  }
+  const auto &projection = dynamic_cast<const ProjectionPlanNode &>(*optimized_plan->children_[0]);
+  const auto &input = projection.GetChildPlan();
+
+  AbstractPlanNodeRef below;
+  if (optimized_plan->GetType() == PlanType::Limit) {
+    // Any projection may as well be computed for the tuples that pass the limit only.
+    const auto &limit_plan = dynamic_cast<const LimitPlanNode &>(*optimized_plan);
+    below = std::make_shared<LimitPlanNode>(input->output_schema_, input, limit_plan.GetLimit());
+  } else {
+    // Sorting on the columns below the projection gives the same order. A key that the projection computes stays
+    // above it, so that the sort does not compute it again in every comparison.
+    std::vector<std::pair<OrderByType, AbstractExpressionRef>> order_bys;
+    for (const auto &[order_type, expr] : dynamic_cast<const SortPlanNode &>(*optimized_plan).GetOrderBy()) {
+      auto input_expr = SubstituteColumns(expr, projection.GetExpressions());
+      if (dynamic_cast<const ColumnValueExpression *>(input_expr.get()) == nullptr) {
+        return optimized_plan;
+      }
+      order_bys.emplace_back(order_type, std::move(input_expr));
+    }
+    below = std::make_shared<SortPlanNode>(input->output_schema_, input, std::move(order_bys));
+  }
+  // The moved node may now sit on top of another projection.
+  return projection.CloneWithChildren({OptimizeSortLimitBelowProjection(below)});
+}
+
+}  // namespace bustub
@@ -26,10 +26,6 @@ namespace bustub {
 
 auto Planner::PlanAggCall(const BoundAggCall &agg_call, const std::vector<AbstractPlanNodeRef> &children)
     -> std::tuple<AggregationType, std::vector<AbstractExpressionRef>> {
-  if (agg_call.is_distinct_) {
-    throw NotImplementedException("distinct agg is not implemented yet");
-  }
-
   std::vector<AbstractExpressionRef> exprs;
 
   {
@@ -104,6 +100,7 @@ auto Planner::PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRe
   // Phase-1: plan an aggregation plan node out of all of the information we have.
   std::vector<AbstractExpressionRef> input_exprs;
   std::vector<AggregationType> agg_types;
+  std::vector<bool> distinct;
   auto agg_begin_idx = group_by_exprs.size();  // agg-calls will be after group-bys in the output of agg.
 
   size_t term_idx = 0;
@@ -124,9 +121,11 @@ auto Planner::PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRe
     }
 
     agg_types.push_back(agg_type);
+    distinct.push_back(agg_call.is_distinct_);
     output_col_names.emplace_back(fmt::format("agg#{}", term_idx));
-    ctx_.expr_in_agg_.emplace_back(
-        std::make_unique<ColumnValueExpression>(0, agg_begin_idx + term_idx, TypeId::INTEGER));
+    ctx_.expr_in_agg_.emplace_back(std::make_unique<ColumnValueExpression>(
+        0, agg_begin_idx + term_idx,
+        agg_type == AggregationType::AvgAggregate ? TypeId::DECIMAL : TypeId::INTEGER));
 
     term_idx += 1;
   }
@@ -136,7 +135,7 @@ auto Planner::PlanSelectAgg(const SelectStatement &statement, AbstractPlanNodeRe
   // Create the aggregation plan node for the first phase (finally!)
   AbstractPlanNodeRef plan = std::make_shared<AggregationPlanNode>(
       std::make_shared<Schema>(ProjectionPlanNode::RenameSchema(agg_output_schema, output_col_names)), std::move(child),
-      std::move(group_by_exprs), std::move(input_exprs), std::move(agg_types));
+      std::move(group_by_exprs), std::move(input_exprs), std::move(agg_types), std::move(distinct));
 
   // Phase-2: plan filter / projection to match the original select list
 
@@ -0,0 +1,93 @@
+#include "planner/plan_cache.h"
+
+#include <cctype>
+#include <initializer_list>
+
+namespace bustub {
+
+auto PlanCache::Normalize(const std::string &sql) -> std::string {
+  std::string key;
+  key.reserve(sql.size());
+  char quote = 0;
+  for (char c : sql) {
+    if (quote != 0) {
+      key += c;
+      if (c == quote) {
+        quote = 0;
+      }
+      continue;
+    }
+    if (c == '\'' || c == '"') {
+      quote = c;
+      key += c;
+    } else if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+      if (!key.empty() && key.back() != ' ') {
+        key += ' ';
+      }
+    } else {
+      key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+  }
+  while (!key.empty() && (key.back() == ' ' || key.back() == ';')) {
+    key.pop_back();
+  }
+  return key;
+}
+
+auto PlanCache::IsCacheable(const std::string &key) -> bool {
+  for (const auto *keyword : {"select ", "insert ", "update ", "delete "}) {
+    if (key.rfind(keyword, 0) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto PlanCache::Get(const std::string &key, uint64_t catalog_version) -> std::optional<CachedPlan> {
+  std::scoped_lock lock(latch_);
+  auto entry = entries_.find(key);
+  if (entry == entries_.end()) {
+    misses_.Add();
+    return std::nullopt;
+  }
+  if (entry->second->second.catalog_version_ != catalog_version) {
+    lru_list_.erase(entry->second);
+    entries_.erase(entry);
+    misses_.Add();
+    return std::nullopt;
+  }
+  lru_list_.splice(lru_list_.begin(), lru_list_, entry->second);
+  hits_.Add();
+  return entry->second->second;
+}
+
+void PlanCache::Put(const std::string &key, CachedPlan plan) {
+  std::scoped_lock lock(latch_);
+  if (capacity_ == 0) {
+    return;
+  }
+  if (auto entry = entries_.find(key); entry != entries_.end()) {
+    lru_list_.erase(entry->second);
+    entries_.erase(entry);
+  }
+  if (lru_list_.size() >= capacity_) {
+    entries_.erase(lru_list_.back().first);
+    lru_list_.pop_back();
+    evictions_.Add();
+  }
+  lru_list_.emplace_front(key, std::move(plan));
+  entries_.emplace(key, lru_list_.begin());
+}
+
+void PlanCache::Clear() {
+  std::scoped_lock lock(latch_);
+  lru_list_.clear();
+  entries_.clear();
+}
+
+auto PlanCache::Size() -> size_t {
+  std::scoped_lock lock(latch_);
+  return lru_list_.size();
+}
+
+}  // namespace bustub
@@ -7,6 +7,7 @@
 #include "binder/expressions/bound_binary_op.h"
 #include "binder/expressions/bound_column_ref.h"
 #include "binder/expressions/bound_constant.h"
+#include "binder/expressions/bound_parameter.h"
 #include "binder/expressions/bound_unary_op.h"
 #include "binder/statement/select_statement.h"
 #include "common/exception.h"
@@ -14,6 +15,7 @@
 #include "common/util/string_util.h"
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/parameter_value_expression.h"
 #include "execution/plans/abstract_plan.h"
 #include "fmt/format.h"
 #include "planner/planner.h"
@@ -99,27 +101,25 @@ auto Planner::PlanConstant(const BoundConstant &expr, const std::vector<Abstract
   return std::make_shared<ConstantValueExpression>(expr.val_);
 }
 
-void Planner::AddAggCallToContext(BoundExpression &expr) {
+void Planner::AddAggCallToContext(const BoundExpression &expr) {
   switch (expr.type_) {
     case ExpressionType::AGG_CALL: {
-      auto &agg_call_expr = dynamic_cast<BoundAggCall &>(expr);
-      auto agg_name = fmt::format("__pseudo_agg#{}", ctx_.aggregations_.size());
-      auto agg_call =
-          BoundAggCall(agg_name, agg_call_expr.is_distinct_, std::vector<std::unique_ptr<BoundExpression>>{});
-      // Replace the agg call in the original bound expression with a pseudo one, add agg call to the context.
-      ctx_.AddAggregation(std::make_unique<BoundAggCall>(std::exchange(agg_call_expr, std::move(agg_call))));
+      // Add the agg call to the context. When the expression is planned later on, agg calls are taken from the
+      // context in the same order.
+      ctx_.AddAggregation(&expr);
       return;
     }
     case ExpressionType::COLUMN_REF: {
       return;
     }
     case ExpressionType::BINARY_OP: {
-      auto &binary_op_expr = dynamic_cast<BoundBinaryOp &>(expr);
+      const auto &binary_op_expr = dynamic_cast<const BoundBinaryOp &>(expr);
       AddAggCallToContext(*binary_op_expr.larg_);
       AddAggCallToContext(*binary_op_expr.rarg_);
       return;
     }
-    case ExpressionType::CONSTANT: {
+    case ExpressionType::CONSTANT:
+    case ExpressionType::PARAMETER: {
       return;
     }
     case ExpressionType::ALIAS: {
@@ -154,11 +154,18 @@ auto Planner::PlanExpression(const BoundExpression &expr, const std::vector<Abst
       const auto &constant_expr = dynamic_cast<const BoundConstant &>(expr);
       return std::make_tuple(UNNAMED_COLUMN, PlanConstant(constant_expr, children));
     }
+    case ExpressionType::PARAMETER: {
+      const auto &param_expr = dynamic_cast<const BoundParameter &>(expr);
+      return std::make_tuple(UNNAMED_COLUMN,
+                             std::make_shared<ParameterValueExpression>(param_expr.param_idx_, param_expr.type_id_));
+    }
     case ExpressionType::ALIAS: {
       const auto &alias_expr = dynamic_cast<const BoundAlias &>(expr);
       auto [_1, expr] = PlanExpression(*alias_expr.child_, children);
       return std::make_tuple(alias_expr.alias_, std::move(expr));
     }
+    case ExpressionType::SUBQUERY:
+      throw NotImplementedException("subqueries are only supported as conditions ANDed into a WHERE clause");
     default:
       break;
   }
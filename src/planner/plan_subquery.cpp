@@ -0,0 +1,248 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_expression.h"
+#include "binder/bound_table_ref.h"
+#include "binder/expressions/bound_alias.h"
+#include "binder/expressions/bound_binary_op.h"
+#include "binder/expressions/bound_column_ref.h"
+#include "binder/expressions/bound_subquery_expr.h"
+#include "binder/expressions/bound_unary_op.h"
+#include "binder/statement/select_statement.h"
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_semi_join_plan.h"
+#include "execution/plans/nested_loop_join_plan.h"
+#include "execution/plans/values_plan.h"
+#include "planner/planner.h"
+
+namespace bustub {
+
+namespace {
+
+/** Collect the conjuncts of a bound predicate, the operands of its top-level ANDs. */
+void SplitBoundConjuncts(const BoundExpression &expr, std::vector<const BoundExpression *> *conjuncts) {
+  if (expr.type_ == ExpressionType::BINARY_OP) {
+    const auto &binary_op = dynamic_cast<const BoundBinaryOp &>(expr);
+    if (binary_op.op_name_ == "and") {
+      SplitBoundConjuncts(*binary_op.larg_, conjuncts);
+      SplitBoundConjuncts(*binary_op.rarg_, conjuncts);
+      return;
+    }
+  }
+  conjuncts->push_back(&expr);
+}
+
+/** @return the subquery of a `[NOT] EXISTS` or `[NOT] IN` conjunct, or nullptr for any other conjunct */
+auto AsSubqueryPredicate(const BoundExpression &expr, bool *negated) -> const BoundSubqueryExpr * {
+  *negated = false;
+  if (expr.type_ == ExpressionType::SUBQUERY) {
+    return &dynamic_cast<const BoundSubqueryExpr &>(expr);
+  }
+  if (expr.type_ == ExpressionType::UNARY_OP) {
+    const auto &unary_op = dynamic_cast<const BoundUnaryOp &>(expr);
+    if (unary_op.op_name_ == "not" && unary_op.arg_->type_ == ExpressionType::SUBQUERY) {
+      *negated = true;
+      return &dynamic_cast<const BoundSubqueryExpr &>(*unary_op.arg_);
+    }
+  }
+  return nullptr;
+}
+
+/** Collect the column references of an expression, leaving out those of the subqueries in it. */
+void CollectColumnRefs(const BoundExpression &expr, std::vector<const BoundColumnRef *> *column_refs) {
+  switch (expr.type_) {
+    case ExpressionType::COLUMN_REF:
+      column_refs->push_back(&dynamic_cast<const BoundColumnRef &>(expr));
+      return;
+    case ExpressionType::BINARY_OP: {
+      const auto &binary_op = dynamic_cast<const BoundBinaryOp &>(expr);
+      CollectColumnRefs(*binary_op.larg_, column_refs);
+      CollectColumnRefs(*binary_op.rarg_, column_refs);
+      return;
+    }
+    case ExpressionType::UNARY_OP:
+      CollectColumnRefs(*dynamic_cast<const BoundUnaryOp &>(expr).arg_, column_refs);
+      return;
+    case ExpressionType::ALIAS:
+      CollectColumnRefs(*dynamic_cast<const BoundAlias &>(expr).child_, column_refs);
+      return;
+    default:
+      return;
+  }
+}
+
+/** @return true if every column an expression refers to is an output column of the plan */
+auto IsOver(const BoundExpression &expr, const AbstractPlanNode &plan) -> bool {
+  std::vector<const BoundColumnRef *> column_refs;
+  CollectColumnRefs(expr, &column_refs);
+  for (const auto *column_ref : column_refs) {
+    if (!plan.OutputSchema().TryGetColIdx(column_ref->ToString()).has_value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Plan the conjuncts of a predicate over the children, and AND them back together. */
+auto PlanConjunction(Planner *planner, const std::vector<const BoundExpression *> &conjuncts,
+                     const std::vector<AbstractPlanNodeRef> &children) -> AbstractExpressionRef {
+  AbstractExpressionRef predicate = nullptr;
+  for (const auto *conjunct : conjuncts) {
+    auto [_, expr] = planner->PlanExpression(*conjunct, children);
+    predicate = predicate == nullptr ? std::move(expr)
+                                     : planner->GetBinaryExpressionFromFactory("and", predicate, std::move(expr));
+  }
+  return predicate;
+}
+
+}  // namespace
+
+auto Planner::PlanWhere(const BoundExpression &where, AbstractPlanNodeRef child) -> AbstractPlanNodeRef {
+  std::vector<const BoundExpression *> conjuncts;
+  SplitBoundConjuncts(where, &conjuncts);
+  std::vector<const BoundExpression *> predicates;
+  std::vector<std::pair<const BoundSubqueryExpr *, bool>> subqueries;
+  for (const auto *conjunct : conjuncts) {
+    bool negated;
+    if (const auto *subquery = AsSubqueryPredicate(*conjunct, &negated); subquery != nullptr) {
+      subqueries.emplace_back(subquery, negated);
+    } else {
+      predicates.push_back(conjunct);
+    }
+  }
+
+  auto plan = std::move(child);
+  if (subqueries.empty()) {
+    auto [_, expr] = PlanExpression(where, {plan});
+    return std::make_shared<FilterPlanNode>(std::make_shared<Schema>(plan->OutputSchema()), std::move(expr),
+                                            std::move(plan));
+  }
+
+  // Filter first, so that the joins with the subqueries see fewer tuples.
+  if (!predicates.empty()) {
+    auto filter_expr = PlanConjunction(this, predicates, {plan});
+    plan = std::make_shared<FilterPlanNode>(std::make_shared<Schema>(plan->OutputSchema()), std::move(filter_expr),
+                                            std::move(plan));
+  }
+  for (const auto &[subquery, negated] : subqueries) {
+    plan = PlanSubqueryPredicate(*subquery, negated, std::move(plan));
+  }
+  return plan;
+}
+
+auto Planner::PlanSubqueryPredicate(const BoundSubqueryExpr &expr, bool negated, AbstractPlanNodeRef left)
+    -> AbstractPlanNodeRef {
+  const auto &subquery = *expr.subquery_;
+  auto join_type = negated ? JoinType::ANTI : JoinType::SEMI;
+  bool null_aware = negated && expr.subquery_type_ == SubqueryType::ANY;
+  auto output_schema = std::make_shared<Schema>(left->OutputSchema());
+
+  // Plan the FROM clause of the subquery on its own, to tell which of its WHERE conjuncts refer to the outer query.
+  auto ctx_guard = NewContext();
+  if (!subquery.ctes_.empty()) {
+    ctx_.cte_list_ = &subquery.ctes_;
+  }
+  AbstractPlanNodeRef right;
+  if (subquery.table_->type_ == TableReferenceType::EMPTY) {
+    right = std::make_shared<ValuesPlanNode>(
+        std::make_shared<Schema>(std::vector<Column>{}),
+        std::vector<std::vector<AbstractExpressionRef>>{std::vector<AbstractExpressionRef>{}});
+  } else {
+    right = PlanTableRef(*subquery.table_);
+  }
+  std::vector<const BoundExpression *> conjuncts;
+  if (!subquery.where_->IsInvalid()) {
+    SplitBoundConjuncts(*subquery.where_, &conjuncts);
+  }
+  std::vector<const BoundExpression *> local_conjuncts;
+  std::vector<const BoundExpression *> correlated_conjuncts;
+  for (const auto *conjunct : conjuncts) {
+    (IsOver(*conjunct, *right) ? local_conjuncts : correlated_conjuncts).push_back(conjunct);
+  }
+
+  std::vector<AbstractExpressionRef> left_keys;
+  std::vector<AbstractExpressionRef> right_keys;
+  if (correlated_conjuncts.empty()) {
+    // An uncorrelated subquery is planned as it is, and only needs to run once.
+    right = PlanSelect(subquery);
+    if (expr.subquery_type_ == SubqueryType::ANY) {
+      auto [_, left_key] = PlanExpression(*expr.child_, {left});
+      left_keys.push_back(std::move(left_key));
+      auto value_type = right->OutputSchema().GetColumn(0).GetType();
+      right_keys.push_back(std::make_shared<ColumnValueExpression>(0, 0, value_type));
+    }
+    return std::make_shared<HashSemiJoinPlanNode>(std::move(output_schema), std::move(left), std::move(right),
+                                                  std::move(left_keys), std::move(right_keys), join_type, null_aware);
+  }
+
+  // A correlated subquery is decorrelated into a join with its FROM clause. Whether a left tuple has a match does not
+  // depend on DISTINCT or ORDER BY, but it does on whatever would have to be evaluated for each left tuple.
+  bool has_agg = false;
+  for (const auto &item : subquery.select_list_) {
+    has_agg = has_agg || item->HasAggregation();
+  }
+  if (has_agg || !subquery.group_by_.empty() || !subquery.having_->IsInvalid() || !subquery.limit_count_->IsInvalid() ||
+      !subquery.limit_offset_->IsInvalid()) {
+    throw NotImplementedException("correlated subqueries with aggregation or LIMIT are not supported");
+  }
+  if (!local_conjuncts.empty()) {
+    auto filter_expr = PlanConjunction(this, local_conjuncts, {right});
+    right = std::make_shared<FilterPlanNode>(std::make_shared<Schema>(right->OutputSchema()), std::move(filter_expr),
+                                             std::move(right));
+  }
+
+  // `outer = inner` conjuncts become keys of a hash semi join. The value of an IN comes last, as the executor expects.
+  std::vector<const BoundExpression *> join_conjuncts;
+  for (const auto *conjunct : correlated_conjuncts) {
+    if (conjunct->type_ == ExpressionType::BINARY_OP) {
+      const auto &binary_op = dynamic_cast<const BoundBinaryOp &>(*conjunct);
+      if (binary_op.op_name_ == "=") {
+        const auto *outer_expr = binary_op.larg_.get();
+        const auto *inner_expr = binary_op.rarg_.get();
+        if (!IsOver(*inner_expr, *right)) {
+          std::swap(outer_expr, inner_expr);
+        }
+        if (IsOver(*inner_expr, *right) && IsOver(*outer_expr, *left)) {
+          auto [_1, left_key] = PlanExpression(*outer_expr, {left});
+          auto [_2, right_key] = PlanExpression(*inner_expr, {right});
+          left_keys.push_back(std::move(left_key));
+          right_keys.push_back(std::move(right_key));
+          continue;
+        }
+      }
+    }
+    join_conjuncts.push_back(conjunct);
+  }
+
+  if (join_conjuncts.empty()) {
+    if (expr.subquery_type_ == SubqueryType::ANY) {
+      auto [_1, left_key] = PlanExpression(*expr.child_, {left});
+      auto [_2, right_key] = PlanExpression(*subquery.select_list_[0], {right});
+      left_keys.push_back(std::move(left_key));
+      right_keys.push_back(std::move(right_key));
+    }
+    return std::make_shared<HashSemiJoinPlanNode>(std::move(output_schema), std::move(left), std::move(right),
+                                                  std::move(left_keys), std::move(right_keys), join_type, null_aware);
+  }
+
+  // Anything else correlated is evaluated for every pair of tuples by a nested loop join.
+  if (null_aware) {
+    throw NotImplementedException("NOT IN subqueries can only be correlated by equalities");
+  }
+  std::vector<AbstractPlanNodeRef> children{left, right};
+  auto predicate = PlanConjunction(this, correlated_conjuncts, children);
+  if (expr.subquery_type_ == SubqueryType::ANY) {
+    auto [_1, left_value] = PlanExpression(*expr.child_, children);
+    auto [_2, right_value] = PlanExpression(*subquery.select_list_[0], children);
+    predicate = GetBinaryExpressionFromFactory(
+        "and", predicate, GetBinaryExpressionFromFactory("=", std::move(left_value), std::move(right_value)));
+  }
+  return std::make_shared<NestedLoopJoinPlanNode>(std::move(output_schema), std::move(left), std::move(right),
+                                                  std::move(predicate), join_type);
+}
+
+}  // namespace bustub
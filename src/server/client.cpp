@@ -0,0 +1,72 @@
+#include "server/client.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "common/exception.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+Client::~Client() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+void Client::ConnectTcp(const std::string &host, uint16_t port) {
+  BUSTUB_ASSERT(fd_ < 0, "already connected");
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+    throw Exception(fmt::format("invalid address: {}", host));
+  }
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+    auto error = Exception(fmt::format("cannot connect to {}:{}: {}", host, port, strerror(errno)));
+    if (fd >= 0) {
+      close(fd);
+    }
+    throw error;
+  }
+  int enable = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+  fd_ = fd;
+}
+
+void Client::ConnectUnix(const std::string &path) {
+  BUSTUB_ASSERT(fd_ < 0, "already connected");
+  sockaddr_un addr{};
+  if (path.size() >= sizeof(addr.sun_path)) {
+    throw Exception(fmt::format("socket path too long: {}", path));
+  }
+  addr.sun_family = AF_UNIX;
+  memcpy(addr.sun_path, path.c_str(), path.size());
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+    auto error = Exception(fmt::format("cannot connect to {}: {}", path, strerror(errno)));
+    if (fd >= 0) {
+      close(fd);
+    }
+    throw error;
+  }
+  fd_ = fd;
+}
+
+auto Client::Execute(const std::string &sql) -> QueryResult {
+  QueryResult result;
+  if (!WriteFrame(fd_, FrameTag::QUERY, sql) || !ReadFrame(fd_, &result.tag_, &result.payload_)) {
+    throw Exception("connection to the server lost");
+  }
+  return result;
+}
+
+}  // namespace bustub
@@ -0,0 +1,340 @@
+#include "server/server.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "common/exception.h"
+#include "fmt/format.h"
+#include "server/wire_protocol.h"
+
+namespace bustub {
+
+namespace {
+
+/** The number of events the poller takes from epoll at a time. */
+constexpr int SERVER_MAX_EVENTS = 256;
+
+/** The number of connections the kernel queues for the poller to accept. */
+constexpr int SERVER_LISTEN_BACKLOG = 1024;
+
+/** The number of bytes a worker reads from a socket at a time. */
+constexpr size_t SERVER_READ_SIZE = 16 * 1024;
+
+/** The largest query a client may send. A connection that sends a larger frame is dropped. */
+constexpr uint32_t SERVER_MAX_QUERY_SIZE = 1024 * 1024;
+
+auto SocketError(const std::string &what) -> Exception {
+  return Exception(fmt::format("{}: {}", what, strerror(errno)));
+}
+
+}  // namespace
+
+Server::Server(BustubInstance *bustub, size_t worker_cnt) : bustub_(bustub), worker_cnt_(worker_cnt) {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ < 0) {
+    throw SocketError("cannot create epoll instance");
+  }
+  wakeup_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (wakeup_fd_ < 0) {
+    throw SocketError("cannot create eventfd");
+  }
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = wakeup_fd_;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event);
+}
+
+Server::~Server() {
+  Stop();
+  close(wakeup_fd_);
+  close(epoll_fd_);
+}
+
+auto Server::ListenTcp(uint16_t port) -> uint16_t {
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    throw SocketError("cannot create socket");
+  }
+  int enable = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  socklen_t addr_len = sizeof(addr);
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), addr_len) < 0 || listen(fd, SERVER_LISTEN_BACKLOG) < 0 ||
+      getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &addr_len) < 0) {
+    auto error = SocketError(fmt::format("cannot listen on port {}", port));
+    close(fd);
+    throw error;
+  }
+
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  listen_fds_.push_back(fd);
+  return ntohs(addr.sin_port);
+}
+
+void Server::ListenUnix(const std::string &path) {
+  sockaddr_un addr{};
+  if (path.size() >= sizeof(addr.sun_path)) {
+    throw Exception(fmt::format("socket path too long: {}", path));
+  }
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    throw SocketError("cannot create socket");
+  }
+
+  // A socket left behind by a server that did not stop cleanly is replaced.
+  unlink(path.c_str());
+  addr.sun_family = AF_UNIX;
+  memcpy(addr.sun_path, path.c_str(), path.size());
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(fd, SERVER_LISTEN_BACKLOG) < 0) {
+    auto error = SocketError(fmt::format("cannot listen on {}", path));
+    close(fd);
+    throw error;
+  }
+
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  listen_fds_.push_back(fd);
+  unix_paths_.push_back(path);
+}
+
+void Server::Start() {
+  poller_ = std::thread([this] { PollLoop(); });
+  for (size_t i = 0; i < worker_cnt_; i++) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+void Server::Stop() {
+  {
+    std::scoped_lock lock(latch_);
+    if (is_stopping_) {
+      return;
+    }
+    is_stopping_ = true;
+  }
+  uint64_t wakeup = 1;
+  [[maybe_unused]] auto written = write(wakeup_fd_, &wakeup, sizeof(wakeup));
+  ready_cv_.notify_all();
+
+  if (poller_.joinable()) {
+    poller_.join();
+  }
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+
+  for (auto fd : listen_fds_) {
+    close(fd);
+  }
+  listen_fds_.clear();
+  for (const auto &path : unix_paths_) {
+    unlink(path.c_str());
+  }
+  unix_paths_.clear();
+
+  auto connections = std::move(connections_);
+  for (auto &[fd, connection] : connections) {
+    connection.reset();
+    close(fd);
+  }
+}
+
+auto Server::GetSessionCount() -> size_t {
+  std::scoped_lock lock(latch_);
+  return connections_.size();
+}
+
+void Server::PollLoop() {
+  std::vector<epoll_event> events(SERVER_MAX_EVENTS);
+  while (true) {
+    int event_cnt = epoll_wait(epoll_fd_, events.data(), SERVER_MAX_EVENTS, -1);
+    if (event_cnt < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    for (int i = 0; i < event_cnt; i++) {
+      int fd = events[i].data.fd;
+      if (fd == wakeup_fd_) {
+        return;
+      }
+      if (std::find(listen_fds_.begin(), listen_fds_.end(), fd) != listen_fds_.end()) {
+        Accept(fd);
+        continue;
+      }
+      // A closed connection is served too: the worker finds nothing to read, and closes it.
+      std::scoped_lock lock(latch_);
+      ready_fds_.push_back(fd);
+      ready_cv_.notify_one();
+    }
+  }
+}
+
+void Server::Accept(int listen_fd) {
+  while (true) {
+    // Workers only read what has arrived, so that a client sending part of a frame does not hold one of them.
+    int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      // EAGAIN once every pending connection is accepted. Other errors only concern the connection at hand.
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      return;
+    }
+    // Answers are small and must not wait for more data; this fails harmlessly on Unix domain sockets.
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    {
+      std::scoped_lock lock(latch_);
+      connections_.emplace(fd, std::make_unique<Connection>(fd, bustub_));
+    }
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  }
+}
+
+void Server::WorkerLoop() {
+  while (true) {
+    int fd;
+    {
+      std::unique_lock lock(latch_);
+      ready_cv_.wait(lock, [this] { return is_stopping_ || !ready_fds_.empty(); });
+      if (is_stopping_) {
+        return;
+      }
+      fd = ready_fds_.front();
+      ready_fds_.pop_front();
+    }
+    Serve(fd);
+  }
+}
+
+void Server::Serve(int fd) {
+  // Only this worker touches the connection until it is watched again, so it stays valid without the latch.
+  Connection *connection;
+  {
+    std::scoped_lock lock(latch_);
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) {
+      return;
+    }
+    connection = it->second.get();
+  }
+
+  // The answers the client did not take yet go first. Until it takes them, none of its queries are read.
+  if (!SendBuffered(fd, &connection->unsent_)) {
+    CloseConnection(fd);
+    return;
+  }
+  if (!connection->unsent_.empty()) {
+    Watch(fd, EPOLLOUT);
+    return;
+  }
+
+  // A client that closes its end may still have sent queries before, which are answered first. Once a whole frame of
+  // the largest size fits in the buffer, the rest waits in the socket.
+  bool is_closed = false;
+  char buffer[SERVER_READ_SIZE];
+  while (connection->received_.size() < FRAME_HEADER_SIZE + SERVER_MAX_QUERY_SIZE) {
+    auto received = recv(fd, buffer, sizeof(buffer), 0);
+    if (received > 0) {
+      connection->received_.append(buffer, received);
+      continue;
+    }
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    is_closed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+    break;
+  }
+
+  FrameTag tag;
+  std::string sql;
+  while (connection->unsent_.empty()) {
+    auto state = TakeFrame(&connection->received_, &tag, &sql, SERVER_MAX_QUERY_SIZE);
+    if (state == FrameState::INCOMPLETE) {
+      break;
+    }
+    if (state == FrameState::MALFORMED || tag != FrameTag::QUERY) {
+      CloseConnection(fd);
+      return;
+    }
+
+    std::stringstream ss;
+    SimpleStreamWriter writer(ss, true);
+    FrameTag answer;
+    std::string payload;
+    try {
+      answer = connection->session_.Execute(sql, writer) ? FrameTag::RESULT : FrameTag::FAILED;
+      payload = ss.str();
+    } catch (const std::exception &ex) {
+      answer = FrameTag::ERROR;
+      payload = ex.what();
+    }
+    if (!AppendFrame(&connection->unsent_, answer, payload) || !SendBuffered(fd, &connection->unsent_)) {
+      CloseConnection(fd);
+      return;
+    }
+  }
+  if (!connection->unsent_.empty()) {
+    Watch(fd, EPOLLOUT);
+    return;
+  }
+  if (is_closed) {
+    CloseConnection(fd);
+    return;
+  }
+  Watch(fd, EPOLLIN | EPOLLRDHUP);
+}
+
+void Server::Watch(int fd, uint32_t events) {
+  epoll_event event{};
+  event.events = events | EPOLLONESHOT;
+  event.data.fd = fd;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event);
+}
+
+void Server::CloseConnection(int fd) {
+  std::unique_ptr<Connection> connection;
+  {
+    std::scoped_lock lock(latch_);
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) {
+      return;
+    }
+    connection = std::move(it->second);
+    connections_.erase(it);
+  }
+  // Roll back the transaction the client left open, then let the descriptor be reused.
+  connection.reset();
+  close(fd);
+}
+
+}  // namespace bustub
@@ -0,0 +1,69 @@
+#include "server/session.h"
+
+#include "common/exception.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "planner/plan_cache.h"
+
+namespace bustub {
+
+Session::~Session() {
+  if (txn_ != nullptr) {
+    Abort(txn_);
+  }
+}
+
+void Session::Abort(Transaction *txn) {
+  bustub_->txn_manager_->Abort(txn);
+  delete txn;
+}
+
+auto Session::Execute(const std::string &sql, ResultWriter &writer) -> bool {
+  auto command = PlanCache::Normalize(sql);
+  if (command == "begin" || command == "begin transaction" || command == "start transaction") {
+    if (txn_ != nullptr) {
+      throw Exception("a transaction is already in progress");
+    }
+    txn_ = bustub_->txn_manager_->Begin();
+    return true;
+  }
+  if (command == "commit" || command == "end") {
+    if (txn_ == nullptr) {
+      throw Exception("no transaction is in progress");
+    }
+    bustub_->txn_manager_->Commit(txn_);
+    delete txn_;
+    txn_ = nullptr;
+    return true;
+  }
+  if (command == "rollback" || command == "abort") {
+    if (txn_ == nullptr) {
+      throw Exception("no transaction is in progress");
+    }
+    Abort(txn_);
+    txn_ = nullptr;
+    return true;
+  }
+
+  if (txn_ != nullptr) {
+    return bustub_->ExecuteSqlTxn(sql, writer, txn_, &variables_, &prepared_statements_);
+  }
+
+  auto *txn = bustub_->txn_manager_->Begin();
+  bool is_successful;
+  try {
+    is_successful = bustub_->ExecuteSqlTxn(sql, writer, txn, &variables_, &prepared_statements_);
+  } catch (...) {
+    Abort(txn);
+    throw;
+  }
+  if (!is_successful) {
+    Abort(txn);
+    return false;
+  }
+  bustub_->txn_manager_->Commit(txn);
+  delete txn;
+  return true;
+}
+
+}  // namespace bustub
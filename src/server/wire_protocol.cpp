@@ -0,0 +1,119 @@
+#include "server/wire_protocol.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+namespace bustub {
+
+namespace {
+
+auto SendAll(int fd, const char *data, size_t size) -> bool {
+  while (size > 0) {
+    // A peer that went away must not kill the process with SIGPIPE.
+    auto sent = send(fd, data, size, MSG_NOSIGNAL);
+    if (sent < 0 && errno == EINTR) {
+      continue;
+    }
+    if (sent <= 0) {
+      return false;
+    }
+    data += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+auto RecvAll(int fd, char *data, size_t size) -> bool {
+  while (size > 0) {
+    auto received = recv(fd, data, size, 0);
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    if (received <= 0) {
+      return false;
+    }
+    data += received;
+    size -= received;
+  }
+  return true;
+}
+
+}  // namespace
+
+auto WriteFrame(int fd, FrameTag tag, const std::string &payload) -> bool {
+  std::string frame;
+  return AppendFrame(&frame, tag, payload) && SendAll(fd, frame.data(), frame.size());
+}
+
+auto AppendFrame(std::string *buffer, FrameTag tag, const std::string &payload) -> bool {
+  if (payload.size() > MAX_FRAME_PAYLOAD) {
+    return false;
+  }
+  char header[FRAME_HEADER_SIZE];
+  header[0] = static_cast<char>(tag);
+  uint32_t length = htonl(static_cast<uint32_t>(payload.size()));
+  memcpy(header + 1, &length, sizeof(length));
+  buffer->append(header, sizeof(header));
+  buffer->append(payload);
+  return true;
+}
+
+auto SendBuffered(int fd, std::string *buffer) -> bool {
+  size_t offset = 0;
+  while (offset < buffer->size()) {
+    // A peer that went away must not kill the process with SIGPIPE.
+    auto sent = send(fd, buffer->data() + offset, buffer->size() - offset, MSG_NOSIGNAL);
+    if (sent < 0 && errno == EINTR) {
+      continue;
+    }
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+    if (sent <= 0) {
+      return false;
+    }
+    offset += sent;
+  }
+  buffer->erase(0, offset);
+  return true;
+}
+
+auto ReadFrame(int fd, FrameTag *tag, std::string *payload) -> bool {
+  char header[FRAME_HEADER_SIZE];
+  if (!RecvAll(fd, header, sizeof(header))) {
+    return false;
+  }
+  uint32_t length;
+  memcpy(&length, header + 1, sizeof(length));
+  length = ntohl(length);
+  if (length > MAX_FRAME_PAYLOAD) {
+    return false;
+  }
+  *tag = static_cast<FrameTag>(header[0]);
+  payload->resize(length);
+  return RecvAll(fd, payload->data(), length);
+}
+
+auto TakeFrame(std::string *buffer, FrameTag *tag, std::string *payload, uint32_t max_payload) -> FrameState {
+  if (buffer->size() < FRAME_HEADER_SIZE) {
+    return FrameState::INCOMPLETE;
+  }
+  uint32_t length;
+  memcpy(&length, buffer->data() + 1, sizeof(length));
+  length = ntohl(length);
+  if (length > max_payload) {
+    return FrameState::MALFORMED;
+  }
+  if (buffer->size() < FRAME_HEADER_SIZE + length) {
+    return FrameState::INCOMPLETE;
+  }
+  *tag = static_cast<FrameTag>((*buffer)[0]);
+  payload->assign(*buffer, FRAME_HEADER_SIZE, length);
+  buffer->erase(0, FRAME_HEADER_SIZE + length);
+  return FrameState::COMPLETE;
+}
+
+}  // namespace bustub
@@ -78,6 +78,8 @@ void DiskManager::ShutDown() {
  * Write the contents of the specified page into disk file
  */
 void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
+  stats_.writes_.Add();
+  StatTimer timer(&stats_.write_latency_ns_);
   std::scoped_lock scoped_db_io_latch(db_io_latch_);
   size_t offset = static_cast<size_t>(page_id) * BUSTUB_PAGE_SIZE;
   // set write cursor to offset
@@ -97,6 +99,8 @@ void DiskManager::WritePage(page_id_t page_id, const char *page_data) {
  * Read the contents of the specified page into the given memory area
  */
 void DiskManager::ReadPage(page_id_t page_id, char *page_data) {
+  stats_.reads_.Add();
+  StatTimer timer(&stats_.read_latency_ns_);
   std::scoped_lock scoped_db_io_latch(db_io_latch_);
   int offset = page_id * BUSTUB_PAGE_SIZE;
   // check if read beyond file length
@@ -194,6 +198,14 @@ auto DiskManager::GetNumFlushes() const -> int { return num_flushes_; }
  */
 auto DiskManager::GetNumWrites() const -> int { return num_writes_; }
 
+auto DiskManager::GetNumPages() -> page_id_t {
+  if (file_name_.empty()) {
+    return 0;
+  }
+  auto file_size = GetFileSize(file_name_);
+  return file_size <= 0 ? 0 : (file_size + BUSTUB_PAGE_SIZE - 1) / BUSTUB_PAGE_SIZE;
+}
+
 /**
  * Returns true if the log is currently being flushed
  */
@@ -33,6 +33,8 @@ DiskManagerMemory::DiskManagerMemory(size_t pages) { memory_ = new char[pages *
  * Write the contents of the specified page into disk file
  */
 void DiskManagerMemory::WritePage(page_id_t page_id, const char *page_data) {
+  stats_.writes_.Add();
+  StatTimer timer(&stats_.write_latency_ns_);
   size_t offset = static_cast<size_t>(page_id) * BUSTUB_PAGE_SIZE;
   // set write cursor to offset
   num_writes_ += 1;
@@ -43,6 +45,8 @@ void DiskManagerMemory::WritePage(page_id_t page_id, const char *page_data) {
  * Read the contents of the specified page into the given memory area
  */
 void DiskManagerMemory::ReadPage(page_id_t page_id, char *page_data) {
+  stats_.reads_.Add();
+  StatTimer timer(&stats_.read_latency_ns_);
   int64_t offset = static_cast<int64_t>(page_id) * BUSTUB_PAGE_SIZE;
   memcpy(page_data, memory_ + offset, BUSTUB_PAGE_SIZE);
 }
@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <cstring>
 #include <string>
+#include <utility>
 
 #include "common/config.h"
 #include "common/exception.h"
@@ -133,14 +134,14 @@ auto BPLUSTREE_TYPE::InsertHelper(const KeyType &key, const ValueType &value, Tr
   } else {
     // 由于没有新创建内存区，所以可能插入的时候叶子会越界？
     // 同时和删除并发的时候可能会出错（和copy函数有关）？但是删除函数已经加锁了。但插入的时候叶子也被加锁不应该会越界啊
-    auto leaf_page_new = CreateLeafPage();
+    BasicPageGuard leaf_guard_new = CreateLeafPage();
+    auto leaf_page_new = leaf_guard_new.AsMut<LeafPage>();
     leaf_page_new->SetParentPageId(leaf_page->GetParentPageId());
     leaf_page->Insert(key, value, comparator_);
     leaf_page->MoveLatterHalfTo(leaf_page_new);
     // 如果分裂条件设置为插入后为n则进行分裂，那是不是变相说明插入前为n-1为满。那么最大值是不是变相为maxsize-1。
     const auto key_upward = leaf_page_new->KeyAt(0);
     InsertInParent(leaf_page, key_upward, leaf_page_new, dirty_height);
-    buffer_pool_manager_->UnpinPage(leaf_page_new->GetPageId(), true);
     // 在并发过程中，原先要分裂的叶子页面交给锁管理器释放。buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(),
     // true);
   }
@@ -148,6 +149,56 @@ auto BPLUSTREE_TYPE::InsertHelper(const KeyType &key, const ValueType &value, Tr
   return true;
 }
 
+/*
+ * Insert entries sorted by key. Each descent latches a leaf, and the entries that follow go straight into it for as
+ * long as they sort below the leaf's upper separator and the leaf has room, so a run of keys that lands in one leaf
+ * costs one descent instead of one per key. A full leaf is split by the regular insert, and the batch goes on from a
+ * new descent.
+ * @return: the number of entries inserted, duplicate keys are skipped
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::InsertBatch(const std::vector<std::pair<KeyType, ValueType>> &entries, Transaction *transaction)
+    -> size_t {
+  bool create_transaction = false;
+  if (transaction == nullptr) {
+    transaction = new Transaction(0);
+    create_transaction = true;
+  }
+  size_t inserted = 0;
+  size_t i = 0;
+  while (i < entries.size()) {
+    LatchRootPageId(transaction, LatchModes::OPTIMIZE);
+    if (IsEmpty()) {
+      ReleaseAllLatches(transaction, LatchModes::OPTIMIZE);
+      inserted += InsertHelper(entries[i].first, entries[i].second, transaction, LatchModes::INSERT) ? 1 : 0;
+      i++;
+      continue;
+    }
+    std::optional<KeyType> upper_bound;
+    auto leaf_page = FindLeafPage(entries[i].first, transaction, LatchModes::OPTIMIZE, &upper_bound).second;
+    size_t run_begin = i;
+    int dirty_height = 0;
+    while (i < entries.size() && leaf_page->GetSize() < leaf_max_size_ - 1 &&
+           (!upper_bound.has_value() || comparator_(entries[i].first, *upper_bound) < 0)) {
+      if (leaf_page->Insert(entries[i].first, entries[i].second, comparator_)) {
+        inserted++;
+        dirty_height = 1;
+      }
+      i++;
+    }
+    ReleaseAllLatches(transaction, LatchModes::OPTIMIZE, dirty_height);
+    if (i == run_begin) {
+      // the leaf the key belongs to is full
+      inserted += InsertHelper(entries[i].first, entries[i].second, transaction, LatchModes::OPTIMIZE) ? 1 : 0;
+      i++;
+    }
+  }
+  if (create_transaction) {
+    delete transaction;
+  }
+  return inserted;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::InsertInLeaf(LeafPage *recipient, KeyType key, ValueType value) {
   recipient->Insert(key, value, comparator_);
@@ -158,7 +209,8 @@ void BPLUSTREE_TYPE::InsertInParent(BPlusTreePage *recipient, const KeyType &key
                                     int &dirty_height) {
   dirty_height++;
   if (recipient->IsRootPage()) {
-    auto root_node = CreateInternalPage();
+    BasicPageGuard root_guard = CreateInternalPage();
+    auto root_node = root_guard.AsMut<InternalPage>();
     root_page_id_ = root_node->GetPageId();  // 每次修改完根节点以后都要更新索引
     UpdateRootPageId();
     root_node->SetValueAt(0, recipient->GetPageId());
@@ -167,13 +219,11 @@ void BPLUSTREE_TYPE::InsertInParent(BPlusTreePage *recipient, const KeyType &key
     root_node->IncreaseSize(1);
     recipient->SetParentPageId(root_node->GetPageId());
     recipient_new->SetParentPageId(root_node->GetPageId());
-    buffer_pool_manager_->UnpinPage(root_node->GetPageId(), true);
     return;
   }
 
-  auto parent_node_id = recipient->GetParentPageId();
-  auto [parent_buffer_page, raw_parent_node] = FetchBPlusTreePage(parent_node_id);
-  auto parent_node = ReinterpretAsInternalPage(raw_parent_node);
+  BasicPageGuard parent_guard = buffer_pool_manager_->FetchPageBasic(recipient->GetParentPageId());
+  auto parent_node = parent_guard.AsMut<InternalPage>();
 
   if (parent_node->GetSize() < parent_node->GetMaxSize()) {
     parent_node->Insert(key, recipient_new->GetPageId(), comparator_);
@@ -182,11 +232,12 @@ void BPLUSTREE_TYPE::InsertInParent(BPlusTreePage *recipient, const KeyType &key
     auto *mem_t = new char[INTERNAL_PAGE_HEADER_SIZE + (internal_max_size_ + 1) * sizeof(MappingType)];
     auto *new_internal_t = reinterpret_cast<InternalPage *>(mem_t);
     // memset(mem_t, 0, INTERNAL_PAGE_HEADER_SIZE+(internal_max_size_+1)*sizeof(MappingType))
-    std::memcpy(mem_t, parent_buffer_page->GetData(),
+    std::memcpy(mem_t, parent_guard.GetData(),
                 INTERNAL_PAGE_HEADER_SIZE + (internal_max_size_) * sizeof(MappingType));
     new_internal_t->Insert(key, recipient_new->GetPageId(), comparator_);
 
-    auto parent_node_new = CreateInternalPage();
+    BasicPageGuard parent_guard_new = CreateInternalPage();
+    auto parent_node_new = parent_guard_new.AsMut<InternalPage>();
     parent_node_new->SetParentPageId(parent_node->GetParentPageId());
     // Copy T.P1 … T.P⌈(n+1)∕2⌉ into P
     std::copy(new_internal_t->GetArray(), new_internal_t->GetArray() + (internal_max_size_ + 2) / 2,
@@ -202,32 +253,31 @@ void BPLUSTREE_TYPE::InsertInParent(BPlusTreePage *recipient, const KeyType &key
     UpdateAllParentID(parent_node_new);
     delete[] mem_t;
     InsertInParent(parent_node, key_upward, parent_node_new, dirty_height);
-    buffer_pool_manager_->UnpinPage(parent_node_new->GetPageId(), true);
   }
-  buffer_pool_manager_->UnpinPage(parent_buffer_page->GetPageId(), true);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::CreateInternalPage() -> InternalPage * {
-  auto p_id = INVALID_PAGE_ID;
-  auto parent_id = INVALID_PAGE_ID;
-  auto new_page = buffer_pool_manager_->NewPage(&p_id);
-  auto new_internal_page = reinterpret_cast<InternalPage *>(new_page->GetData());
-  new_internal_page->Init(p_id, parent_id, internal_max_size_);
-  return new_internal_page;
+auto BPLUSTREE_TYPE::CreateInternalPage() -> BasicPageGuard {
+  page_id_t p_id = INVALID_PAGE_ID;
+  page_id_t parent_id = INVALID_PAGE_ID;
+  BasicPageGuard new_guard = buffer_pool_manager_->NewPageGuarded(&p_id);
+  if (!new_guard.IsValid()) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot allocate new page");
+  }
+  new_guard.AsMut<InternalPage>()->Init(p_id, parent_id, internal_max_size_);
+  return new_guard;
 }
 
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::CreateLeafPage() -> LeafPage * {
+auto BPLUSTREE_TYPE::CreateLeafPage() -> BasicPageGuard {
   page_id_t p_id = INVALID_PAGE_ID;
   page_id_t parent_id = INVALID_PAGE_ID;
-  auto new_page = buffer_pool_manager_->NewPage(&p_id);
-  if (new_page == nullptr) {
+  BasicPageGuard new_guard = buffer_pool_manager_->NewPageGuarded(&p_id);
+  if (!new_guard.IsValid()) {
     throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot allocate new page");
   }
-  auto new_leaf_page = reinterpret_cast<LeafPage *>(new_page->GetData());
-  new_leaf_page->Init(p_id, parent_id, leaf_max_size_);
-  return new_leaf_page;
+  new_guard.AsMut<LeafPage>()->Init(p_id, parent_id, leaf_max_size_);
+  return new_guard;
 }
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -237,14 +287,14 @@ void BPLUSTREE_TYPE::InitBplusTree(const KeyType key, const ValueType value) {
    * and set this page to be B+ Leaf Page and insert first key-value pair into it
    * update the header page root_idx and unpin this page with dirty flag
    */
-  auto bplus_root = CreateLeafPage();
+  BasicPageGuard root_guard = CreateLeafPage();
+  auto bplus_root = root_guard.AsMut<LeafPage>();
   root_page_id_ = bplus_root->GetPageId();
   UpdateRootPageId(!header_record_created_);
   header_record_created_ = true;
   bplus_root->SetKeyAt(0, key);
   bplus_root->SetValueAt(0, value);
   bplus_root->IncreaseSize(1);
-  buffer_pool_manager_->UnpinPage(root_page_id_, true);
 }
 /*****************************************************************************
  * REMOVE
@@ -292,6 +342,49 @@ void BPLUSTREE_TYPE::RemoveHelper(const KeyType &key, Transaction *transaction,
   ReleaseAllLatches(transaction, mode, dirty_height);
 }
 
+/*
+ * Remove keys sorted in ascending order. Like InsertBatch, the keys that follow the one a descent was made for are
+ * removed from the same leaf while they sort below its upper separator and the leaf stays above its minimum size. A
+ * removal that would need a redistribution or a merge goes through the regular remove.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::RemoveBatch(const std::vector<KeyType> &keys, Transaction *transaction) {
+  bool create_transaction = false;
+  if (transaction == nullptr) {
+    transaction = new Transaction(0);
+    create_transaction = true;
+  }
+  size_t i = 0;
+  while (i < keys.size()) {
+    LatchRootPageId(transaction, LatchModes::OPTIMIZE);
+    if (IsEmpty()) {
+      ReleaseAllLatches(transaction, LatchModes::OPTIMIZE);
+      break;
+    }
+    std::optional<KeyType> upper_bound;
+    auto leaf_page = FindLeafPage(keys[i], transaction, LatchModes::OPTIMIZE, &upper_bound).second;
+    size_t run_begin = i;
+    int dirty_height = 0;
+    while (i < keys.size() &&
+           (leaf_page->GetSize() > leaf_page->GetMinSize() || (leaf_page->IsRootPage() && leaf_page->GetSize() > 1)) &&
+           (!upper_bound.has_value() || comparator_(keys[i], *upper_bound) < 0)) {
+      if (leaf_page->RemoveKey(keys[i], comparator_)) {
+        dirty_height = 1;
+      }
+      i++;
+    }
+    ReleaseAllLatches(transaction, LatchModes::OPTIMIZE, dirty_height);
+    if (i == run_begin) {
+      // removing the key underflows the leaf
+      RemoveHelper(keys[i], transaction, LatchModes::OPTIMIZE);
+      i++;
+    }
+  }
+  if (create_transaction) {
+    delete transaction;
+  }
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::DeleteEntry(BPlusTreePage *recipient, KeyType key, int &dirty_height) {
   // 依据传入的结点类型对key进行删除
@@ -317,7 +410,6 @@ void BPLUSTREE_TYPE::DeleteEntry(BPlusTreePage *recipient, KeyType key, int &dir
   dirty_height++;
   // 重分配或合并前应该满足不得不进行分配和合并的条件
   if (recipient->GetSize() >= recipient->GetMinSize()) {
-    buffer_pool_manager_->UnpinPage(recipient->GetPageId(), true);
     return;
   }
 
@@ -327,9 +419,8 @@ void BPLUSTREE_TYPE::DeleteEntry(BPlusTreePage *recipient, KeyType key, int &dir
       if (recipient->GetSize() == 1) {
         root_page_id_ = ReinterpretAsInternalPage(recipient)->ValueAt(0);
         UpdateRootPageId(false);
-        BPlusTreePage *new_root_page = FetchBPlusTreePage(root_page_id_).second;
-        new_root_page->SetParentPageId(INVALID_PAGE_ID);
-        buffer_pool_manager_->UnpinPage(root_page_id_, true);
+        BasicPageGuard new_root_guard = buffer_pool_manager_->FetchPageBasic(root_page_id_);
+        new_root_guard.AsMut<BPlusTreePage>()->SetParentPageId(INVALID_PAGE_ID);
       }
     } else {
       if (recipient->GetSize() == 0) {
@@ -354,9 +445,8 @@ void BPLUSTREE_TYPE::DeleteEntry(BPlusTreePage *recipient, KeyType key, int &dir
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::TryRedistribute(BPlusTreePage *recipient, KeyType key) -> bool {
   // 确定父结点和兄弟结点
-  auto parent_node_id = recipient->GetParentPageId();
-  BPlusTreePage *parent_node_header = FetchBPlusTreePage(parent_node_id).second;
-  auto parent_node = ReinterpretAsInternalPage(parent_node_header);
+  BasicPageGuard parent_guard = buffer_pool_manager_->FetchPageBasic(recipient->GetParentPageId());
+  auto parent_node = parent_guard.As<InternalPage>();
   int recipient_position = parent_node->BinarySearch(key, comparator_).first;
   auto redistribute_result = false;
   // 此处为逻辑框架//判断是左兄弟还是右兄弟。
@@ -368,33 +458,28 @@ auto BPLUSTREE_TYPE::TryRedistribute(BPlusTreePage *recipient, KeyType key) -> b
   // }
   if (recipient_position < parent_node->GetSize() - 1) {
     // 一定有右兄弟.先和右兄弟重分配,不成功后和左兄弟重分配
-    auto position = parent_node->ValueAt(recipient_position + 1);
-    auto [brother_node_raw, brother_node_header] = FetchBPlusTreePage(position);
-    brother_node_raw->WLatch();
-    if (brother_node_header->GetSize() > brother_node_header->GetMinSize()) {
+    WritePageGuard brother_guard = buffer_pool_manager_->FetchPageWrite(parent_node->ValueAt(recipient_position + 1));
+    auto brother_node = brother_guard.As<BPlusTreePage>();
+    if (brother_node->GetSize() > brother_node->GetMinSize()) {
       // 保证兄弟结点能借
-      Redistribute(recipient, brother_node_header, parent_node, recipient_position, false);
+      Redistribute(recipient, brother_guard.AsMut<BPlusTreePage>(), parent_guard.AsMut<InternalPage>(),
+                   recipient_position, false);
       redistribute_result = true;
     }
-    brother_node_raw->WUnlatch();
-    buffer_pool_manager_->UnpinPage(brother_node_header->GetPageId(), redistribute_result);
   }
   // 若以上重分配没进行说明要么position=current size 即只有左兄弟 或者说明右兄弟无法进行重分配。
 
   if ((recipient_position > 0) && (recipient_position <= (parent_node->GetSize() - 1)) && !redistribute_result) {
     // 位置合法，且没进行过右兄弟分配或右兄弟分配失败
-    auto position = parent_node->ValueAt(recipient_position - 1);
-    auto [brother_node_raw, brother_node_header] = FetchBPlusTreePage(position);
-    brother_node_raw->WLatch();
-    if (brother_node_header->GetSize() > brother_node_header->GetMinSize()) {
+    WritePageGuard brother_guard = buffer_pool_manager_->FetchPageWrite(parent_node->ValueAt(recipient_position - 1));
+    auto brother_node = brother_guard.As<BPlusTreePage>();
+    if (brother_node->GetSize() > brother_node->GetMinSize()) {
       // 保证兄弟结点能借
-      Redistribute(recipient, brother_node_header, parent_node, recipient_position, true);
+      Redistribute(recipient, brother_guard.AsMut<BPlusTreePage>(), parent_guard.AsMut<InternalPage>(),
+                   recipient_position, true);
       redistribute_result = true;
     }
-    brother_node_raw->WUnlatch();
-    buffer_pool_manager_->UnpinPage(brother_node_header->GetPageId(), redistribute_result);
   }
-  buffer_pool_manager_->UnpinPage(parent_node->GetPageId(), redistribute_result);
   return redistribute_result;
 }
 
@@ -436,40 +521,34 @@ void BPLUSTREE_TYPE::Redistribute(BPlusTreePage *recipient, BPlusTreePage *recip
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::TryMerge(BPlusTreePage *recipient, KeyType key, int &dirty_height) -> bool {
   // 确定父结点和兄弟结点
-  auto parent_node_id = recipient->GetParentPageId();
-  BPlusTreePage *raw_parent_node = FetchBPlusTreePage(parent_node_id).second;
-  auto parent_node = ReinterpretAsInternalPage(raw_parent_node);
+  BasicPageGuard parent_guard = buffer_pool_manager_->FetchPageBasic(recipient->GetParentPageId());
+  auto parent_node = parent_guard.AsMut<InternalPage>();
   int recipient_position = parent_node->BinarySearch(key, comparator_).first;
   auto merge_result = false;
 
   if (recipient_position < parent_node->GetSize() - 1) {
     // 一定有右兄弟.先和右兄弟合并,不成功后和左兄弟合并
-    auto b_position = parent_node->ValueAt(recipient_position + 1);
-    auto [brother_node_raw, brother_node_header] = FetchBPlusTreePage(b_position);
-    brother_node_raw->WLatch();  // 在merge中释放锁
-    Merge(recipient, brother_node_header, brother_node_raw, parent_node, recipient_position, false, dirty_height);
+    WritePageGuard brother_guard = buffer_pool_manager_->FetchPageWrite(parent_node->ValueAt(recipient_position + 1));
+    // 在merge中释放锁
+    Merge(recipient, std::move(brother_guard), parent_node, recipient_position, false, dirty_height);
     merge_result = true;
-    buffer_pool_manager_->UnpinPage(brother_node_header->GetPageId(), merge_result);
   }
   // 经历过重分配失败以后，合并必然会成功，除非当前位置没有右兄弟，才会合并失败。
 
   if ((recipient_position > 0) && (recipient_position <= (parent_node->GetSize() - 1)) && !merge_result) {
     // 位置合法，且没进行过右兄弟分配或右兄弟分配失败
-    auto b_position = parent_node->ValueAt(recipient_position - 1);
-    auto [brother_node_raw, brother_node_header] = FetchBPlusTreePage(b_position);
-    brother_node_raw->WLatch();
-    Merge(recipient, brother_node_header, brother_node_raw, parent_node, recipient_position, true, dirty_height);
+    WritePageGuard brother_guard = buffer_pool_manager_->FetchPageWrite(parent_node->ValueAt(recipient_position - 1));
+    Merge(recipient, std::move(brother_guard), parent_node, recipient_position, true, dirty_height);
     merge_result = true;
-    buffer_pool_manager_->UnpinPage(brother_node_header->GetPageId(), merge_result);
   }
-  buffer_pool_manager_->UnpinPage(parent_node->GetPageId(),
-                                  merge_result);  // ”谁借谁还“ 谁申请的内存页面，使用完毕后由谁归还
+  // ”谁借谁还“ 谁申请的内存页面，使用完毕后由谁归还：父结点由 parent_guard 归还
   return merge_result;
 }
 
 INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::Merge(BPlusTreePage *recipient, BPlusTreePage *recipient_brother, Page *brother_page,
-                           InternalPage *parent, int recipient_position, bool brother_on_left, int &dirty_height) {
+void BPLUSTREE_TYPE::Merge(BPlusTreePage *recipient, WritePageGuard brother_guard, InternalPage *parent,
+                           int recipient_position, bool brother_on_left, int &dirty_height) {
+  auto recipient_brother = brother_guard.AsMut<BPlusTreePage>();
   // 合并的过程主要细节为：1.判断根叶节点2.判断左合并还是有合并3.递归调用4.合并后废弃节点的处理
   if (recipient->IsLeafPage()) {
     // 对于叶节点 需要额外考虑nextpageid的重设。
@@ -479,7 +558,7 @@ void BPLUSTREE_TYPE::Merge(BPlusTreePage *recipient, BPlusTreePage *recipient_br
       // 合并时默认结点中大的元素排在小的元素后面
       curr_node->MergeTo(brother_node);
       brother_node->SetNextPageId(curr_node->GetNextPageId());
-      brother_page->WUnlatch();
+      brother_guard.Drop();
       //  curr_node->SetParentPageId(INVALID_PAGE_ID);
       // 这个空页面的锁也应该交由锁管理器释放 同时被unpim
       // buffer_pool_manager_->UnpinPage(curr_node->GetPageId(), false);
@@ -488,7 +567,7 @@ void BPLUSTREE_TYPE::Merge(BPlusTreePage *recipient, BPlusTreePage *recipient_br
       brother_node->MergeTo(curr_node);
       curr_node->SetNextPageId(brother_node->GetNextPageId());
       // brother_node->SetParentPageId(INVALID_PAGE_ID);
-      brother_page->WUnlatch();
+      brother_guard.Drop();
       // buffer_pool_manager_->UnpinPage(brother_node->GetPageId(), false);
       DeleteEntry(parent, parent->KeyAt(recipient_position + 1), dirty_height);
     }
@@ -505,7 +584,7 @@ void BPLUSTREE_TYPE::Merge(BPlusTreePage *recipient, BPlusTreePage *recipient_br
       UpdateAllParentID(brother_node);
       brother_node->SetKeyAt(old_brother_size, parent->KeyAt(recipient_position));
       // curr_node->SetParentPageId(INVALID_PAGE_ID);
-      brother_page->WUnlatch();
+      brother_guard.Drop();
       // 非兄弟页面一律交给锁管理器解锁，兄弟页面谁申请的谁解锁
       // buffer_pool_manager_->UnpinPage(curr_node->GetPageId(), false);
       // LOG_DEBUG("leftbrother %lld", parent->KeyAt(recipient_position).ToString());
@@ -516,7 +595,7 @@ void BPLUSTREE_TYPE::Merge(BPlusTreePage *recipient, BPlusTreePage *recipient_br
       UpdateAllParentID(curr_node);
       // brother_node->SetParentPageId(INVALID_PAGE_ID);
       curr_node->SetKeyAt(old_curr_size, parent->KeyAt(recipient_position + 1));
-      brother_page->WUnlatch();
+      brother_guard.Drop();
       // buffer_pool_manager_->UnpinPage(brother_node->GetPageId(), false);
       // LOG_DEBUG("rightbrother %lld", parent->KeyAt(recipient_position).ToString());
       DeleteEntry(parent, parent->KeyAt(recipient_position + 1), dirty_height);
@@ -526,21 +605,18 @@ void BPLUSTREE_TYPE::Merge(BPlusTreePage *recipient, BPlusTreePage *recipient_br
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::UpdateParentID(InternalPage *recipient, int index) {
-  auto parent_id = recipient->GetPageId();
-  BPlusTreePage *refresh_nodes = FetchBPlusTreePage(recipient->ValueAt(index)).second;
-  refresh_nodes->SetParentPageId(parent_id);
-  buffer_pool_manager_->UnpinPage(recipient->ValueAt(index), true);
+  BasicPageGuard refresh_guard = buffer_pool_manager_->FetchPageBasic(recipient->ValueAt(index));
+  refresh_guard.AsMut<BPlusTreePage>()->SetParentPageId(recipient->GetPageId());
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::UpdateAllParentID(InternalPage *recipient) {
   auto parent_id = recipient->GetPageId();
   for (int i = 0; i < recipient->GetSize(); i++) {
-    auto refresh_nodes = FetchBPlusTreePage(recipient->ValueAt(i)).second;
-    if (refresh_nodes->GetParentPageId() != parent_id) {
-      refresh_nodes->SetParentPageId(parent_id);
+    BasicPageGuard refresh_guard = buffer_pool_manager_->FetchPageBasic(recipient->ValueAt(i));
+    if (refresh_guard.As<BPlusTreePage>()->GetParentPageId() != parent_id) {
+      refresh_guard.AsMut<BPlusTreePage>()->SetParentPageId(parent_id);
     }
-    buffer_pool_manager_->UnpinPage(refresh_nodes->GetPageId(), true);
   }
 }
 
@@ -558,7 +634,7 @@ auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE {
     return End();
   }
   auto [raw_leaf_page, leaf_page] = FindLeafPage(KeyType());
-  return INDEXITERATOR_TYPE(leaf_page->GetPageId(), 0, leaf_page, buffer_pool_manager_);
+  return INDEXITERATOR_TYPE(BasicPageGuard(buffer_pool_manager_, raw_leaf_page), 0, buffer_pool_manager_);
 }
 
 /*
@@ -568,21 +644,23 @@ auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE {
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE {
+  if (IsEmpty()) {
+    return End();
+  }
   auto [raw_leaf_page, leaf_page] = FindLeafPage(key);
+  BasicPageGuard leaf_guard(buffer_pool_manager_, raw_leaf_page);
   auto index_position = leaf_page->SearchPosition(key, comparator_);
   if (index_position == -1) {
     // 若index_position为-1，说明当前页面所有元素的key都比给定的key小，迭代器只能指向下个页面的首元素
-    auto leaf_id = leaf_page->GetPageId();
     auto next_page_id = leaf_page->GetNextPageId();
-    buffer_pool_manager_->UnpinPage(leaf_id, false);
     if (next_page_id == INVALID_PAGE_ID) {
       return End();
     }
-    leaf_page = ReinterpretAsLeafPage(FetchBPlusTreePage(next_page_id).second);
+    leaf_guard = buffer_pool_manager_->FetchPageBasic(next_page_id);
     index_position = 0;
   }
 
-  return INDEXITERATOR_TYPE(leaf_page->GetPageId(), index_position, leaf_page, buffer_pool_manager_);
+  return INDEXITERATOR_TYPE(std::move(leaf_guard), index_position, buffer_pool_manager_);
 }
 
 /*
@@ -598,6 +676,18 @@ auto BPLUSTREE_TYPE::End() -> INDEXITERATOR_TYPE { return INDEXITERATOR_TYPE();
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::GetRootPageId() -> page_id_t { return root_page_id_; }
+
+/**
+ * Adopt an existing tree. Its pages are read on first use; only the header page is looked at here, to keep updating
+ * the record of the tree rather than inserting a second one.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetRootPageId(page_id_t root_page_id) {
+  root_page_id_ = root_page_id;
+  ReadPageGuard header_guard = buffer_pool_manager_->FetchPageRead(HEADER_PAGE_ID);
+  page_id_t recorded_root_id;
+  header_record_created_ = header_guard.As<HeaderPage>()->GetRootId(index_name_, &recorded_root_id);
+}
 /*
  * In concurrent mode, need to grab latch on the root id
  * before fetching the root page
@@ -673,7 +763,8 @@ void BPLUSTREE_TYPE::ReleaseAllLatches(Transaction *transaction, LatchModes mode
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
-  auto *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(HEADER_PAGE_ID));
+  BasicPageGuard header_guard = buffer_pool_manager_->FetchPageBasic(HEADER_PAGE_ID);
+  auto header_page = header_guard.AsMut<HeaderPage>();
   if (insert_record != 0) {
     // create a new record<index_name + root_page_id> in header_page
     header_page->InsertRecord(index_name_, root_page_id_);
@@ -681,7 +772,6 @@ void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
     // update root_page_id in header_page
     header_page->UpdateRecord(index_name_, root_page_id_);
   }
-  buffer_pool_manager_->UnpinPage(HEADER_PAGE_ID, true);
 }
 /*****************************************************************************
  * Custommize Part
@@ -706,10 +796,12 @@ auto BPLUSTREE_TYPE::ReinterpretAsInternalPage(BPlusTreePage *page)
 /**
  * Iterate through the B+ Tree to fetch a leaf page
  * the caller should unpin the leaf page after usage
+ * if upper_bound is given, it is set to the smallest separator above the leaf, and left alone for the rightmost leaf
  * @return pointer to a leaf page if found, nullptr otherwise
  */
 INDEX_TEMPLATE_ARGUMENTS
-auto BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, Transaction *transaction, BPlusTree::LatchModes mode)
+auto BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, Transaction *transaction, BPlusTree::LatchModes mode,
+                                  std::optional<KeyType> *upper_bound)
     -> std::pair<Page *, BPlusTreeLeafPage<KeyType, RID, KeyComparator> *> {
   // BUSTUB_ASSERT(transaction != nullptr, "transction==nullptr");
   auto [curr_page_raw, curr_page] = FetchBPlusTreePage(root_page_id_);
@@ -742,7 +834,12 @@ auto BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, Transaction *transaction,
   }
   // 递归向下遍历
   while (!curr_page->IsLeafPage()) {
-    page_id_t next_page_id = ReinterpretAsInternalPage(curr_page)->BinarySearch(key, comparator_).second;
+    auto internal_page = ReinterpretAsInternalPage(curr_page);
+    auto [position, next_page_id] = internal_page->BinarySearch(key, comparator_);
+    // the separator right of the child bounds every key the leaf may hold, and the bound tightens level by level
+    if (upper_bound != nullptr && position + 1 < internal_page->GetSize()) {
+      *upper_bound = internal_page->KeyAt(position + 1);
+    }
     auto next_page_pair = FetchBPlusTreePage(next_page_id);
     // 并发后unpinPage放在并发判断的逻辑当中执行
     //  buffer_pool_manager_->UnpinPage(curr_page->GetPageId(), false);
@@ -2,6 +2,7 @@
  * index_iterator.cpp
  */
 #include <cassert>
+#include <utility>
 
 #include "common/config.h"
 #include "storage/index/index_iterator.h"
@@ -16,19 +17,18 @@ INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE::IndexIterator() = default;
 
 /*
- * Assume the caller has fetched the leaf page for us, unpin it later on when we are done with it
+ * The caller hands the pinned leaf page over to us, it is unpinned when we move on or go away
  */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE::IndexIterator(page_id_t page_id, int index, LEAF_TYPE leaf_page,
-                                  BufferPoolManager *buffer_pool_manager)
-    : page_id_(page_id), index_(index), leaf_page_(leaf_page), buffer_pool_manager_(buffer_pool_manager) {}
+INDEXITERATOR_TYPE::IndexIterator(BasicPageGuard leaf_guard, int index, BufferPoolManager *buffer_pool_manager)
+    : page_id_(leaf_guard.PageId()),
+      index_(index),
+      leaf_guard_(std::move(leaf_guard)),
+      leaf_page_(leaf_guard_.As<LEAF_TYPE>()),
+      buffer_pool_manager_(buffer_pool_manager) {}
 
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE::~IndexIterator() {  // NOLINT
-  if (page_id_ != INVALID_PAGE_ID) {
-    buffer_pool_manager_->UnpinPage(page_id_, false);
-  }
-}
+INDEXITERATOR_TYPE::~IndexIterator() = default;  // NOLINT
 
 INDEX_TEMPLATE_ARGUMENTS
 auto INDEXITERATOR_TYPE::IsEnd() -> bool { return page_id_ == INVALID_PAGE_ID; }
@@ -45,12 +45,13 @@ auto INDEXITERATOR_TYPE::operator++() -> INDEXITERATOR_TYPE & {
   if (index_ == leaf_page_->GetSize()) {
     page_id_ = leaf_page_->GetNextPageId();
     if (page_id_ == INVALID_PAGE_ID) {
-      buffer_pool_manager_->UnpinPage(leaf_page_->GetPageId(), false);
+      leaf_guard_.Drop();
       leaf_page_ = nullptr;
       index_ = -1;
     } else {
-      buffer_pool_manager_->UnpinPage(leaf_page_->GetPageId(), false);
-      leaf_page_ = FetchLeafPage(page_id_);
+      // Assigning the guard unpins the page we are leaving.
+      leaf_guard_ = buffer_pool_manager_->FetchPageBasic(page_id_);
+      leaf_page_ = leaf_guard_.As<LEAF_TYPE>();
       index_ = 0;
     }
   }
@@ -65,15 +66,6 @@ auto INDEXITERATOR_TYPE::operator==(const IndexIterator &itr) const -> bool {
 INDEX_TEMPLATE_ARGUMENTS
 auto INDEXITERATOR_TYPE::operator!=(const IndexIterator &itr) const -> bool { return !operator==(itr); }
 
-/*
- *fetch函数使用前需要判断能否使用
- *无效页面页面不能调用
- */
-INDEX_TEMPLATE_ARGUMENTS
-auto INDEXITERATOR_TYPE::FetchLeafPage(page_id_t page_id) -> LEAF_TYPE {
-  return reinterpret_cast<LEAF_TYPE>(buffer_pool_manager_->FetchPage(page_id)->GetData());
-}
-
 template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
 
 template class IndexIterator<GenericKey<8>, RID, GenericComparator<8>>;
@@ -25,8 +25,8 @@ auto HeaderPage::InsertRecord(const std::string &name, const page_id_t root_id)
 
   int record_num = GetRecordCount();
   int offset = 4 + record_num * 36;
-  // check for duplicate name
-  if (FindRecord(name) != -1) {
+  // check for duplicate name, and for room
+  if (FindRecord(name) != -1 || offset + 36 > BUSTUB_PAGE_SIZE) {
     return false;
   }
   // copy record content
@@ -68,7 +68,7 @@ auto HeaderPage::UpdateRecord(const std::string &name, const page_id_t root_id)
   return true;
 }
 
-auto HeaderPage::GetRootId(const std::string &name, page_id_t *root_id) -> bool {
+auto HeaderPage::GetRootId(const std::string &name, page_id_t *root_id) const -> bool {
   assert(name.length() < 32);
 
   int index = FindRecord(name);
@@ -77,7 +77,7 @@ auto HeaderPage::GetRootId(const std::string &name, page_id_t *root_id) -> bool
     return false;
   }
   int offset = (index + 1) * 36;
-  *root_id = *reinterpret_cast<page_id_t *>(GetData() + offset);
+  *root_id = *reinterpret_cast<const page_id_t *>(GetData() + offset);
 
   return true;
 }
@@ -86,15 +86,15 @@ auto HeaderPage::GetRootId(const std::string &name, page_id_t *root_id) -> bool
  * helper functions
  */
 // record count
-auto HeaderPage::GetRecordCount() -> int { return *reinterpret_cast<int *>(GetData()); }
+auto HeaderPage::GetRecordCount() const -> int { return *reinterpret_cast<const int *>(GetData()); }
 
 void HeaderPage::SetRecordCount(int record_count) { memcpy(GetData(), &record_count, 4); }
 
-auto HeaderPage::FindRecord(const std::string &name) -> int {
+auto HeaderPage::FindRecord(const std::string &name) const -> int {
   int record_num = GetRecordCount();
 
   for (int i = 0; i < record_num; i++) {
-    char *raw_name = reinterpret_cast<char *>(GetData() + (4 + i * 36));
+    const char *raw_name = GetData() + (4 + i * 36);
     if (strcmp(raw_name, name.c_str()) == 0) {
       return i;
     }
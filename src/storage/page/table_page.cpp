@@ -38,8 +38,8 @@ void TablePage::Init(page_id_t page_id, uint32_t page_size, page_id_t prev_page_
 auto TablePage::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, LockManager *lock_manager,
                             LogManager *log_manager) -> bool {
   BUSTUB_ASSERT(tuple.size_ > 0, "Cannot have empty tuples.");
-  // If there is not enough space, then return false.
-  if (GetFreeSpaceRemaining() < tuple.size_ + SIZE_TUPLE) {
+  // If there is not enough space even when reusing a slot, then return false.
+  if (GetFreeSpaceRemaining() < tuple.size_) {
     return false;
   }
 
@@ -188,6 +188,12 @@ auto TablePage::UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID
   //    new_tuple); lsn_t lsn = log_manager->AppendLogRecord(&log_record); SetLSN(lsn); txn->SetPrevLSN(lsn);
   //  }
 
+  // If the size does not change, the new value simply overwrites the old one and nothing else has to move.
+  if (new_tuple.size_ == tuple_size) {
+    memcpy(GetData() + tuple_offset, new_tuple.data_, new_tuple.size_);
+    return true;
+  }
+
   // Perform the update.
   uint32_t free_space_pointer = GetFreeSpacePointer();
   BUSTUB_ASSERT(tuple_offset >= free_space_pointer, "Offset should appear after current free space position.");
@@ -257,6 +263,11 @@ void TablePage::ApplyDelete(const RID &rid, Transaction *txn, LogManager *log_ma
       SetTupleOffsetAtSlot(i, tuple_offset_i + tuple_size);
     }
   }
+
+  // Give the slot itself back if it was the last one.
+  if (slot_num + 1 == GetTupleCount()) {
+    Compact();
+  }
 }
 
 void TablePage::RollbackDelete(const RID &rid, Transaction *txn, LogManager *log_manager) {
@@ -282,7 +293,7 @@ void TablePage::RollbackDelete(const RID &rid, Transaction *txn, LogManager *log
   }
 }
 
-auto TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager) -> bool {
+auto TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager) const -> bool {
   // Get the current slot number.
   uint32_t slot_num = rid.GetSlotNum();
   // If somehow we have more slots than tuples, abort the transaction.
@@ -326,7 +337,40 @@ auto TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
   return true;
 }
 
-auto TablePage::GetFirstTupleRid(RID *first_rid) -> bool {
+auto TablePage::ViewTuple(const RID &rid, Tuple *tuple) const -> bool {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (slot_num >= GetTupleCount()) {
+    return false;
+  }
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  if (IsDeleted(tuple_size)) {
+    return false;
+  }
+  if (tuple->allocated_) {
+    delete[] tuple->data_;
+  }
+  // The viewed tuple is only ever read, see TupleView.
+  tuple->data_ = const_cast<char *>(GetData()) + GetTupleOffsetAtSlot(slot_num);  // NOLINT
+  tuple->size_ = tuple_size;
+  tuple->rid_ = rid;
+  tuple->allocated_ = false;
+  return true;
+}
+
+auto TablePage::Compact() -> bool {
+  // Only empty slots at the tail can go, any other slot is still addressed by the RIDs of the tuples after it.
+  uint32_t tuple_count = GetTupleCount();
+  while (tuple_count > 0 && GetTupleSize(tuple_count - 1) == 0) {
+    tuple_count--;
+  }
+  if (tuple_count == GetTupleCount()) {
+    return false;
+  }
+  SetTupleCount(tuple_count);
+  return true;
+}
+
+auto TablePage::GetFirstTupleRid(RID *first_rid) const -> bool {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
     if (!IsDeleted(GetTupleSize(i))) {
@@ -338,7 +382,7 @@ auto TablePage::GetFirstTupleRid(RID *first_rid) -> bool {
   return false;
 }
 
-auto TablePage::GetNextTupleRid(const RID &cur_rid, RID *next_rid) -> bool {
+auto TablePage::GetNextTupleRid(const RID &cur_rid, RID *next_rid) const -> bool {
   BUSTUB_ASSERT(cur_rid.GetPageId() == GetTablePageId(), "Wrong table!");
   // Find and return the first valid tuple after our current slot number.
   for (auto i = cur_rid.GetSlotNum() + 1; i < GetTupleCount(); ++i) {
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <cassert>
+#include <utility>
 
 #include "common/logger.h"
 #include "fmt/format.h"
@@ -19,21 +20,21 @@
 namespace bustub {
 
 TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
-                     page_id_t first_page_id)
+                     page_id_t first_page_id, uint64_t tuple_count)
     : buffer_pool_manager_(buffer_pool_manager),
       lock_manager_(lock_manager),
       log_manager_(log_manager),
-      first_page_id_(first_page_id) {}
+      first_page_id_(first_page_id),
+      tuple_count_(tuple_count) {}
 
 TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
                      Transaction *txn)
     : buffer_pool_manager_(buffer_pool_manager), lock_manager_(lock_manager), log_manager_(log_manager) {
   // Initialize the first table page.
-  auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(&first_page_id_));
-  BUSTUB_ASSERT(first_page != nullptr,
+  auto first_guard = buffer_pool_manager_->NewPageGuarded(&first_page_id_);
+  BUSTUB_ASSERT(first_guard.IsValid(),
                 "Couldn't create a page for the table heap. Have you completed the buffer pool manager project?");
-  first_page->Init(first_page_id_, BUSTUB_PAGE_SIZE, INVALID_LSN, log_manager_, txn);
-  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+  first_guard.AsMut<TablePage>()->Init(first_page_id_, BUSTUB_PAGE_SIZE, INVALID_LSN, log_manager_, txn);
 }
 
 auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> bool {
@@ -42,50 +43,42 @@ auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> b
     return false;
   }
 
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
-  if (cur_page == nullptr) {
+  auto cur_guard = buffer_pool_manager_->FetchPageWrite(first_page_id_);
+  if (!cur_guard.IsValid()) {
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
 
-  cur_page->WLatch();
-
   // Insert into the first page with enough space. If no such page exists, create a new page and insert into that.
-  // INVARIANT: cur_page is WLatched if you leave the loop normally.
-  while (!cur_page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_)) {
-    auto next_page_id = cur_page->GetNextPageId();
+  // Pages without room are only read, so that walking past them does not dirty them.
+  while (cur_guard.As<TablePage>()->GetFreeSpaceRemaining() < tuple.size_ ||
+         !cur_guard.AsMut<TablePage>()->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_)) {
+    auto next_page_id = cur_guard.As<TablePage>()->GetNextPageId();
     // If the next page is a valid page,
     if (next_page_id != INVALID_PAGE_ID) {
-      auto next_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
-      next_page->WLatch();
-      // Unlatch and unpin the current page.
-      cur_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
-      cur_page = next_page;
+      // Latch the next page before letting go of the current one.
+      auto next_guard = buffer_pool_manager_->FetchPageWrite(next_page_id);
+      cur_guard = std::move(next_guard);
     } else {
       // Otherwise we have run out of valid pages. We need to create a new page.
-      auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&next_page_id));
+      auto new_guard = buffer_pool_manager_->NewPageGuarded(&next_page_id);
       // If we could not create a new page,
-      if (new_page == nullptr) {
+      if (!new_guard.IsValid()) {
         // Then life sucks and we abort the transaction.
-        cur_page->WUnlatch();
-        buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
         txn->SetState(TransactionState::ABORTED);
         return false;
       }
       // Otherwise we were able to create a new page. We initialize it now.
-      new_page->WLatch();
+      auto next_guard = new_guard.UpgradeWrite();
+      auto cur_page = cur_guard.AsMut<TablePage>();
       cur_page->SetNextPageId(next_page_id);
-      new_page->Init(next_page_id, BUSTUB_PAGE_SIZE, cur_page->GetTablePageId(), log_manager_, txn);
-      cur_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
-      cur_page = new_page;
+      next_guard.AsMut<TablePage>()->Init(next_page_id, BUSTUB_PAGE_SIZE, cur_page->GetTablePageId(), log_manager_,
+                                          txn);
+      cur_guard = std::move(next_guard);
     }
   }
-  // This line has caused most of us to double-take and "whoa double unlatch".
-  // We are not, in fact, double unlatching. See the invariant above.
-  cur_page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
+  cur_guard.Drop();
+  tuple_count_.fetch_add(1, std::memory_order_relaxed);
   // Update the transaction's write set.
   txn->GetWriteSet()->emplace_back(*rid, WType::INSERT, Tuple{}, this);
   return true;
@@ -94,17 +87,15 @@ auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> b
 auto TableHeap::MarkDelete(const RID &rid, Transaction *txn) -> bool {
   // TODO(Amadou): remove empty page
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto guard = buffer_pool_manager_->FetchPageWrite(rid.GetPageId());
   // If the page could not be found, then abort the transaction.
-  if (page == nullptr) {
+  if (!guard.IsValid()) {
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
   // Otherwise, mark the tuple as deleted.
-  page->WLatch();
-  page->MarkDelete(rid, txn, lock_manager_, log_manager_);
-  page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  guard.AsMut<TablePage>()->MarkDelete(rid, txn, lock_manager_, log_manager_);
+  guard.Drop();
   // Update the transaction's write set.
   txn->GetWriteSet()->emplace_back(rid, WType::DELETE, Tuple{}, this);
   return true;
@@ -112,18 +103,16 @@ auto TableHeap::MarkDelete(const RID &rid, Transaction *txn) -> bool {
 
 auto TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn) -> bool {
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto guard = buffer_pool_manager_->FetchPageWrite(rid.GetPageId());
   // If the page could not be found, then abort the transaction.
-  if (page == nullptr) {
+  if (!guard.IsValid()) {
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
   // Update the tuple; but first save the old value for rollbacks.
   Tuple old_tuple;
-  page->WLatch();
-  bool is_updated = page->UpdateTuple(tuple, &old_tuple, rid, txn, lock_manager_, log_manager_);
-  page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), is_updated);
+  bool is_updated = guard.AsMut<TablePage>()->UpdateTuple(tuple, &old_tuple, rid, txn, lock_manager_, log_manager_);
+  guard.Drop();
   // Update the transaction's write set.
   if (is_updated && txn->GetState() != TransactionState::ABORTED) {
     txn->GetWriteSet()->emplace_back(rid, WType::UPDATE, old_tuple, this);
@@ -133,47 +122,131 @@ auto TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn
 
 void TableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
-  BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
+  auto guard = buffer_pool_manager_->FetchPageWrite(rid.GetPageId());
+  BUSTUB_ASSERT(guard.IsValid(), "Couldn't find a page containing that RID.");
   // Delete the tuple from the page.
-  page->WLatch();
-  page->ApplyDelete(rid, txn, log_manager_);
+  guard.AsMut<TablePage>()->ApplyDelete(rid, txn, log_manager_);
+  tuple_count_.fetch_sub(1, std::memory_order_relaxed);
   /** Commented out to make compatible with p4; This is called only on commit or delete, which consequently unlocks the
    * tuple; so should be fine */
   // lock_manager_->Unlock(txn, rid);
-  page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
 }
 
 void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
-  BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
+  auto guard = buffer_pool_manager_->FetchPageWrite(rid.GetPageId());
+  BUSTUB_ASSERT(guard.IsValid(), "Couldn't find a page containing that RID.");
   // Rollback the delete.
-  page->WLatch();
-  page->RollbackDelete(rid, txn, log_manager_);
-  page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  guard.AsMut<TablePage>()->RollbackDelete(rid, txn, log_manager_);
+}
+
+void TableHeap::RecountTuples() {
+  uint64_t tuple_count = 0;
+  auto page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto guard = buffer_pool_manager_->FetchPageRead(page_id);
+    const auto *page = guard.As<TablePage>();
+    RID rid;
+    for (bool found = page->GetFirstTupleRid(&rid); found; found = page->GetNextTupleRid(rid, &rid)) {
+      tuple_count++;
+    }
+    page_id = page->GetNextPageId();
+  }
+  tuple_count_.store(tuple_count, std::memory_order_relaxed);
 }
 
 auto TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool acquire_read_lock) -> bool {
   // Find the page which contains the tuple.
-  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto guard = buffer_pool_manager_->FetchPageBasic(rid.GetPageId());
   // If the page could not be found, then abort the transaction.
-  if (page == nullptr) {
+  if (!guard.IsValid()) {
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
   // Read the tuple from the page.
-  if (acquire_read_lock) {
-    page->RLatch();
+  if (!acquire_read_lock) {
+    // The caller already holds the read latch, see TableIterator.
+    return guard.As<TablePage>()->GetTuple(rid, tuple, txn, lock_manager_);
   }
-  bool res = page->GetTuple(rid, tuple, txn, lock_manager_);
-  if (acquire_read_lock) {
-    page->RUnlatch();
+  auto read_guard = guard.UpgradeRead();
+  return read_guard.As<TablePage>()->GetTuple(rid, tuple, txn, lock_manager_);
+}
+
+auto TableHeap::Vacuum(Transaction *txn, const std::unordered_set<page_id_t> &written_pages,
+                       std::vector<std::pair<RID, RID>> *moved) -> size_t {
+  size_t freed_pages = 0;
+  // Tuples are only ever moved towards the front of the chain: from `src_page` into `dst_page`, which comes first.
+  auto dst_guard = buffer_pool_manager_->FetchPageWrite(first_page_id_);
+  BUSTUB_ASSERT(dst_guard.IsValid(), "Couldn't fetch the first page of the table.");
+  auto dst_page = dst_guard.AsMut<TablePage>();
+  dst_page->Compact();
+  auto src_page_id = dst_page->GetNextPageId();
+
+  while (src_page_id != INVALID_PAGE_ID) {
+    auto src_guard = buffer_pool_manager_->FetchPageWrite(src_page_id);
+    BUSTUB_ASSERT(src_guard.IsValid(), "Couldn't fetch a page of the table.");
+    auto src_page = src_guard.AsMut<TablePage>();
+    src_page->Compact();
+
+    // Drain the source page into the destination page(s) until one of them runs out. Compacting a page keeps the RIDs
+    // of its tuples, but moving them does not, so a page that an open transaction wrote to is only ever filled up.
+    auto is_written = written_pages.count(src_page_id) > 0;
+    RID rid;
+    Tuple tuple;
+    bool has_tuple = !is_written && src_page->GetFirstTupleRid(&rid);
+    bool src_is_dst = false;
+    while (has_tuple && !src_is_dst) {
+      RID next_rid;
+      bool has_next = src_page->GetNextTupleRid(rid, &next_rid);
+      src_page->GetTuple(rid, &tuple, txn, lock_manager_);
+      RID new_rid;
+      while (!dst_page->InsertTuple(tuple, &new_rid, txn, lock_manager_, log_manager_)) {
+        // The destination page is full, so the next page in the chain becomes the destination.
+        auto next_page_id = dst_page->GetNextPageId();
+        if (next_page_id == src_page_id) {
+          // The source page is now the destination and stays latched.
+          dst_guard = std::move(src_guard);
+          dst_page = src_page;
+          src_is_dst = true;
+          break;
+        }
+        dst_guard = buffer_pool_manager_->FetchPageWrite(next_page_id);
+        BUSTUB_ASSERT(dst_guard.IsValid(), "Couldn't fetch a page of the table.");
+        dst_page = dst_guard.AsMut<TablePage>();
+        dst_page->Compact();
+      }
+      if (src_is_dst) {
+        break;
+      }
+      src_page->ApplyDelete(rid, txn, log_manager_);
+      moved->emplace_back(rid, new_rid);
+      rid = next_rid;
+      has_tuple = has_next;
+    }
+
+    // Unless only delete-marked tuples are left behind, unlink the empty page from the chain and free it. The pages
+    // are latched in chain order: the source page is let go before the one in front of it is latched, the destination
+    // page stays latched since it comes before both.
+    auto next_src_page_id = src_page->GetNextPageId();
+    if (!src_is_dst && !is_written && src_page->IsEmpty()) {
+      auto prev_page_id = src_page->GetPrevPageId();
+      src_guard.Drop();
+      if (prev_page_id == dst_page->GetTablePageId()) {
+        dst_page->SetNextPageId(next_src_page_id);
+      } else {
+        auto prev_guard = buffer_pool_manager_->FetchPageWrite(prev_page_id);
+        prev_guard.AsMut<TablePage>()->SetNextPageId(next_src_page_id);
+      }
+      if (next_src_page_id != INVALID_PAGE_ID) {
+        auto next_guard = buffer_pool_manager_->FetchPageWrite(next_src_page_id);
+        next_guard.AsMut<TablePage>()->SetPrevPageId(prev_page_id);
+      }
+      buffer_pool_manager_->DeletePage(src_page_id);
+      freed_pages++;
+    }
+    src_page_id = next_src_page_id;
   }
-  buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
-  return res;
+  return freed_pages;
 }
 
 auto TableHeap::Begin(Transaction *txn) -> TableIterator {
@@ -182,16 +255,12 @@ auto TableHeap::Begin(Transaction *txn) -> TableIterator {
   RID rid;
   auto page_id = first_page_id_;
   while (page_id != INVALID_PAGE_ID) {
-    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
-    page->RLatch();
+    auto guard = buffer_pool_manager_->FetchPageRead(page_id);
     // If this fails because there is no tuple, then RID will be the default-constructed value, which means EOF.
-    auto found_tuple = page->GetFirstTupleRid(&rid);
-    page->RUnlatch();
-    buffer_pool_manager_->UnpinPage(page_id, false);
-    if (found_tuple) {
+    if (guard.As<TablePage>()->GetFirstTupleRid(&rid)) {
       break;
     }
-    page_id = page->GetNextPageId();
+    page_id = guard.As<TablePage>()->GetNextPageId();
   }
   return {this, rid, txn};
 }
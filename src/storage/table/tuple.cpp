@@ -16,22 +16,25 @@
 #include <string>
 #include <vector>
 
+#include "common/exception.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
-// TODO(Amadou): It does not look like nulls are supported. Add a null bitmap?
 Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true) {
   assert(values.size() == schema->GetColumnCount());
 
-  // 1. Calculate the size of the tuple.
-  uint32_t tuple_size = schema->GetLength();
+  // 1. Calculate the size of the tuple. Short and NULL VARCHARs have no payload.
+  uint32_t bitmap_offset = schema->GetLength();
+  uint32_t tuple_size = bitmap_offset + NullBitmapSize(schema);
   for (auto &i : schema->GetUnlinedColumns()) {
     auto len = values[i].GetLength();
-    if (len == BUSTUB_VALUE_NULL) {
-      len = 0;
+    if (len != BUSTUB_VALUE_NULL && len > VARCHAR_INLINE_LENGTH) {
+      tuple_size += len;
     }
-    tuple_size += (len + sizeof(uint32_t));
+  }
+  if (tuple_size > UINT16_MAX) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "tuple is too large");
   }
 
   // 2. Allocate memory.
@@ -41,20 +44,29 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true)
 
   // 3. Serialize each attribute based on the input value.
   uint32_t column_count = schema->GetColumnCount();
-  uint32_t offset = schema->GetLength();
+  uint32_t offset = bitmap_offset + NullBitmapSize(schema);
 
   for (uint32_t i = 0; i < column_count; i++) {
     const auto &col = schema->GetColumn(i);
+    if (values[i].IsNull()) {
+      data_[bitmap_offset + i / 8] |= static_cast<char>(1 << (i % 8));
+    }
     if (!col.IsInlined()) {
-      // Serialize relative offset, where the actual varchar data is stored.
-      *reinterpret_cast<uint32_t *>(data_ + col.GetOffset()) = offset;
-      // Serialize varchar value, in place (size+data).
-      values[i].SerializeTo(data_ + offset);
+      // Serialize the slot: the length, then either the relative offset of the payload or the value itself.
+      char *slot = data_ + col.GetOffset();
       auto len = values[i].GetLength();
       if (len == BUSTUB_VALUE_NULL) {
-        len = 0;
+        *reinterpret_cast<uint16_t *>(slot) = VARCHAR_SLOT_NULL;
+        continue;
+      }
+      *reinterpret_cast<uint16_t *>(slot) = static_cast<uint16_t>(len);
+      if (len <= VARCHAR_INLINE_LENGTH) {
+        memcpy(slot + sizeof(uint16_t), values[i].GetData(), len);
+      } else {
+        *reinterpret_cast<uint16_t *>(slot + sizeof(uint16_t)) = static_cast<uint16_t>(offset);
+        memcpy(data_ + offset, values[i].GetData(), len);
+        offset += len;
       }
-      offset += (len + sizeof(uint32_t));
     } else {
       values[i].SerializeTo(data_ + col.GetOffset());
     }
@@ -62,9 +74,6 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true)
 }
 
 Tuple::Tuple(const Tuple &other) : allocated_(other.allocated_), rid_(other.rid_), size_(other.size_) {
-  if (allocated_) {
-    delete[] data_;
-  }
   if (allocated_) {
     // Deep copy.
     data_ = new char[size_];
@@ -76,6 +85,9 @@ Tuple::Tuple(const Tuple &other) : allocated_(other.allocated_), rid_(other.rid_
 }
 
 auto Tuple::operator=(const Tuple &other) -> Tuple & {
+  if (this == &other) {
+    return *this;
+  }
   if (allocated_) {
     delete[] data_;
   }
@@ -95,16 +107,56 @@ auto Tuple::operator=(const Tuple &other) -> Tuple & {
   return *this;
 }
 
+Tuple::Tuple(Tuple &&other) noexcept
+    : allocated_(other.allocated_), rid_(other.rid_), size_(other.size_), data_(other.data_) {
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+}
+
+auto Tuple::operator=(Tuple &&other) noexcept -> Tuple & {
+  if (this == &other) {
+    return *this;
+  }
+  if (allocated_) {
+    delete[] data_;
+  }
+  allocated_ = other.allocated_;
+  rid_ = other.rid_;
+  size_ = other.size_;
+  data_ = other.data_;
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+  return *this;
+}
+
 auto Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const -> Value {
   assert(schema);
   assert(data_);
-  const TypeId column_type = schema->GetColumn(column_idx).GetType();
+  const auto &col = schema->GetColumn(column_idx);
+  if (!col.IsInlined()) {
+    return DeserializeVarchar(data_, col.GetOffset());
+  }
   const char *data_ptr = GetDataPtr(schema, column_idx);
   // the third parameter "is_inlined" is unused
-  return Value::DeserializeFrom(data_ptr, column_type);
+  return Value::DeserializeFrom(data_ptr, col.GetType());
+}
+
+auto Tuple::DeserializeVarchar(const char *data, uint32_t slot_offset) -> Value {
+  const char *slot = data + slot_offset;
+  uint16_t len = *reinterpret_cast<const uint16_t *>(slot);
+  if (len == VARCHAR_SLOT_NULL) {
+    return {TypeId::VARCHAR, nullptr, BUSTUB_VALUE_NULL, false};
+  }
+  if (len <= VARCHAR_INLINE_LENGTH) {
+    return {TypeId::VARCHAR, slot + sizeof(uint16_t), len, true};
+  }
+  uint16_t offset = *reinterpret_cast<const uint16_t *>(slot + sizeof(uint16_t));
+  return {TypeId::VARCHAR, data + offset, len, true};
 }
 
-auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs)
+auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const
     -> Tuple {
   std::vector<Value> values;
   values.reserve(key_attrs.size());
@@ -118,15 +170,9 @@ auto Tuple::GetDataPtr(const Schema *schema, const uint32_t column_idx) const ->
   assert(schema);
   assert(data_);
   const auto &col = schema->GetColumn(column_idx);
-  bool is_inlined = col.IsInlined();
-  // For inline type, data is stored where it is.
-  if (is_inlined) {
-    return (data_ + col.GetOffset());
-  }
-  // We read the relative offset from the tuple data.
-  int32_t offset = *reinterpret_cast<int32_t *>(data_ + col.GetOffset());
-  // And return the beginning address of the real data for the VARCHAR type.
-  return (data_ + offset);
+  // For inline type, data is stored where it is. VARCHARs are read through their slot by DeserializeVarchar.
+  assert(col.IsInlined());
+  return (data_ + col.GetOffset());
 }
 
 auto Tuple::ToString(const Schema *schema) const -> std::string {
@@ -0,0 +1,46 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_view.cpp
+//
+// Identification: src/storage/table/tuple_view.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tuple_view.h"
+
+namespace bustub {
+
+TupleView::TupleView(BufferPoolManager *buffer_pool_manager, page_id_t page_id)
+    : guard_(buffer_pool_manager->FetchPageRead(page_id)) {}
+
+void TupleView::Release() {
+  guard_.Drop();
+  tuple_ = Tuple{};
+}
+
+auto TupleView::Seek(const RID &rid) -> bool { return guard_.As<TablePage>()->ViewTuple(rid, &tuple_); }
+
+auto TupleView::SeekFirst() -> bool {
+  RID rid;
+  return guard_.As<TablePage>()->GetFirstTupleRid(&rid) && Seek(rid);
+}
+
+auto TupleView::SeekAfter(const RID &rid) -> bool {
+  RID next_rid;
+  return guard_.As<TablePage>()->GetNextTupleRid(rid, &next_rid) && Seek(next_rid);
+}
+
+auto TupleView::Materialize() const -> Tuple {
+  Tuple tuple(tuple_.rid_);
+  tuple.size_ = tuple_.size_;
+  tuple.data_ = new char[tuple.size_];
+  memcpy(tuple.data_, tuple_.data_, tuple.size_);
+  tuple.allocated_ = true;
+  return tuple;
+}
+
+}  // namespace bustub
@@ -0,0 +1,130 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// buffer_pool_stats_test.cpp
+//
+// Identification: test/buffer/buffer_pool_stats_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "common/bustub_instance.h"
+#include "common/stats.h"
+#include "concurrency/transaction_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(BufferPoolStatsTest, CounterAndHistogramTest) {
+  StatCounter counter;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&counter] {
+      for (int j = 0; j < 1000; j++) {
+        counter.Add();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.Get(), 8000);
+  counter.Reset();
+  EXPECT_EQ(counter.Get(), 0);
+
+  StatHistogram histogram;
+  EXPECT_EQ(histogram.GetPercentile(0.5), 0);
+  for (uint64_t value = 1; value <= 100; value++) {
+    histogram.Record(value);
+  }
+  histogram.Record(1000);
+  EXPECT_EQ(histogram.GetCount(), 101);
+  EXPECT_EQ(histogram.GetSum(), 5050 + 1000);
+  // 51 falls into the bucket [32, 64), and 1000 into [512, 1024).
+  EXPECT_EQ(histogram.GetPercentile(0.5), 63);
+  EXPECT_EQ(histogram.GetPercentile(1), 1023);
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolStatsTest, FetchPathTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(3, disk_manager.get());
+  const auto &stats = bpm->GetStats();
+
+  page_id_t page_ids[4];
+  for (auto &page_id : page_ids) {
+    auto guard = bpm->NewPageGuarded(&page_id);
+    guard.GetDataMut()[0] = 'a';
+  }
+  // The fourth page evicted the first, which was dirty.
+  EXPECT_EQ(stats.new_pages_.Get(), 4);
+  EXPECT_EQ(stats.dirty_writebacks_.Get(), 1);
+  EXPECT_EQ(bpm->GetReplacerStats().evictions_.Get(), 1);
+  EXPECT_EQ(disk_manager->GetStats().writes_.Get(), 1);
+
+  bpm->FetchPageBasic(page_ids[3]).Drop();
+  EXPECT_EQ(stats.fetch_hits_.Get(), 1);
+  EXPECT_EQ(stats.fetch_misses_.Get(), 0);
+  bpm->FetchPageBasic(page_ids[0]).Drop();
+  EXPECT_EQ(stats.fetch_misses_.Get(), 1);
+  EXPECT_EQ(disk_manager->GetStats().reads_.Get(), 1);
+  EXPECT_EQ(disk_manager->GetStats().read_latency_ns_.GetCount(), 1);
+
+  // With every frame pinned there is nothing left to evict.
+  std::vector<BasicPageGuard> guards;
+  for (int i = 0; i < 3; i++) {
+    guards.push_back(bpm->FetchPageBasic(page_ids[i]));
+  }
+  EXPECT_FALSE(bpm->FetchPageBasic(page_ids[3]).IsValid());
+  EXPECT_EQ(stats.no_free_frame_.Get(), 1);
+  EXPECT_EQ(bpm->GetReplacerStats().failed_evictions_.Get(), 1);
+
+  auto residency = bpm->GetResidency();
+  EXPECT_EQ(residency.free_, 0);
+  EXPECT_EQ(residency.pinned_, 3);
+  EXPECT_EQ(residency.header_ + residency.table_ + residency.index_internal_ + residency.index_leaf_ +
+                residency.other_,
+            3);
+}
+
+// NOLINTNEXTLINE
+TEST(BufferPoolStatsTest, StatsCommandTest) {
+  auto bustub = std::make_unique<BustubInstance>();
+  std::stringstream ss;
+  auto writer = SimpleStreamWriter(ss, true);
+  bustub->ExecuteSql("CREATE TABLE t(a int);", writer);
+  bustub->ExecuteSql("INSERT INTO t VALUES (1), (2), (3);", writer);
+
+  ss.str("");
+  bustub->ExecuteSql("\\stats", writer);
+  EXPECT_NE(ss.str().find("hit_ratio"), std::string::npos);
+  EXPECT_NE(ss.str().find("read_latency_ns_p99"), std::string::npos);
+
+  auto json = bustub->DumpStats();
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_EQ(json.back(), '}');
+  EXPECT_NE(json.find("\"buffer_pool\": {\"pool_size\": "), std::string::npos);
+  EXPECT_NE(json.find("\"residency\": {"), std::string::npos);
+  EXPECT_NE(json.find("\"table\": 1"), std::string::npos);
+
+  ss.str("");
+  bustub->ExecuteSql("\\stats reset", writer);
+  EXPECT_NE(bustub->DumpStats().find("\"fetch_hits\": 0,"), std::string::npos);
+  auto *txn = bustub->txn_manager_->Begin();
+  EXPECT_THROW(bustub->ExecuteSqlTxn("\\stats foo", writer, txn), Exception);
+  bustub->txn_manager_->Commit(txn);
+  delete txn;
+}
+
+}  // namespace bustub
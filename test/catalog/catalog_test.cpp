@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <memory>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -17,8 +19,12 @@
 #include "buffer/buffer_pool_manager_instance.h"
 #include "catalog/catalog.h"
 #include "catalog/table_generator.h"
+#include "common/bustub_instance.h"
+#include "concurrency/transaction.h"
 #include "execution/executor_context.h"
+#include "fmt/format.h"
 #include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -688,4 +694,128 @@ TEST(CatalogTest, DISABLED_IndexInteraction3) {
   remove("catalog_test.log");
 }
 
+/** @return the rids the index finds for the integer key */
+auto ScanIntegerKey(IndexInfo *index_info, int32_t key) -> std::vector<RID> {
+  std::vector<RID> rids;
+  Tuple key_tuple({ValueFactory::GetIntegerValue(key)}, &index_info->key_schema_);
+  index_info->index_->ScanKey(key_tuple, &rids, nullptr);
+  return rids;
+}
+
+// NOLINTNEXTLINE
+TEST(CatalogTest, RestartTest) {
+  const std::string db_file{"catalog_restart_test.db"};
+  remove(db_file.c_str());
+  std::stringstream ss;
+  auto writer = SimpleStreamWriter(ss, true);
+
+  table_oid_t t2_oid;
+  {
+    auto bustub = std::make_unique<BustubInstance>(db_file);
+    bustub->ExecuteSql("CREATE TABLE t1(a int, b varchar(16));", writer);
+    bustub->ExecuteSql("CREATE TABLE t2(x int);", writer);
+    std::string insert = "INSERT INTO t1 VALUES (0, 'v0')";
+    for (int i = 1; i < 1000; i++) {
+      insert += fmt::format(", ({}, 'v{}')", i, i);
+    }
+    bustub->ExecuteSql(insert + ";", writer);
+    bustub->ExecuteSql("CREATE INDEX t1a ON t1 USING btree (a);", writer);
+    bustub->ExecuteSql("CREATE INDEX t1a_hash ON t1 USING hash (a);", writer);
+    t2_oid = bustub->catalog_->GetTable("t2")->oid_;
+  }
+
+  {
+    auto bustub = std::make_unique<BustubInstance>(db_file);
+    auto *table_info = bustub->catalog_->GetTable("t1");
+    ASSERT_NE(table_info, Catalog::NULL_TABLE_INFO);
+    ASSERT_EQ(table_info->schema_.GetColumnCount(), 2);
+    EXPECT_EQ(table_info->schema_.GetColumn(0).GetType(), TypeId::INTEGER);
+    EXPECT_EQ(table_info->schema_.GetColumn(1).GetType(), TypeId::VARCHAR);
+    EXPECT_EQ(table_info->schema_.GetColumn(1).GetLength(), 16);
+    EXPECT_EQ(bustub->catalog_->GetTable("t2")->oid_, t2_oid);
+
+    auto *btree_info = bustub->catalog_->GetIndex("t1a", "t1");
+    auto *hash_info = bustub->catalog_->GetIndex("t1a_hash", "t1");
+    ASSERT_NE(btree_info, Catalog::NULL_INDEX_INFO);
+    ASSERT_NE(hash_info, Catalog::NULL_INDEX_INFO);
+    EXPECT_EQ(btree_info->index_type_, IndexType::BPlusTreeIndex);
+    EXPECT_EQ(hash_info->index_type_, IndexType::HashTableIndex);
+    EXPECT_EQ(ScanIntegerKey(btree_info, 567).size(), 1);
+    EXPECT_EQ(ScanIntegerKey(hash_info, 567).size(), 1);
+
+    ss.str("");
+    bustub->ExecuteSql("SELECT b FROM t1 WHERE a = 567;", writer);
+    EXPECT_EQ(ss.str(), "v567\t\n");
+
+    // Both the tables and the indexes keep working after the restart, and new objects get fresh oids.
+    bustub->ExecuteSql("INSERT INTO t1 VALUES (1000, 'v1000');", writer);
+    bustub->ExecuteSql("CREATE TABLE t3(y int);", writer);
+    EXPECT_GT(bustub->catalog_->GetTable("t3")->oid_, t2_oid);
+  }
+
+  {
+    auto bustub = std::make_unique<BustubInstance>(db_file);
+    ASSERT_NE(bustub->catalog_->GetTable("t3"), Catalog::NULL_TABLE_INFO);
+    ss.str("");
+    bustub->ExecuteSql("SELECT count(*) FROM t1;", writer);
+    EXPECT_EQ(ss.str(), "1001\t\n");
+    // The tuple count is saved with the catalog, so the open does not read the table to count it.
+    EXPECT_EQ(bustub->catalog_->GetTable("t1")->table_->GetTupleCount(), 1001);
+    EXPECT_EQ(ScanIntegerKey(bustub->catalog_->GetIndex("t1a", "t1"), 1000).size(), 1);
+    EXPECT_EQ(ScanIntegerKey(bustub->catalog_->GetIndex("t1a_hash", "t1"), 1000).size(), 1);
+  }
+
+  remove(db_file.c_str());
+  remove("catalog_restart_test.log");
+}
+
+TEST(CatalogTest, AnalyzeTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(64, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  std::vector<Column> columns{{"a", TypeId::INTEGER}, {"b", TypeId::INTEGER}};
+  Schema schema{columns};
+  auto *table_info = catalog->CreateTable(nullptr, "t", schema);
+
+  // More rows than TableStats samples. Column a holds 5000 distinct values, column b is NULL in every fourth row.
+  const int row_cnt = 30000;
+  Transaction txn(0);
+  for (int i = 0; i < row_cnt; i++) {
+    auto b = i % 4 == 0 ? ValueFactory::GetNullValueByType(TypeId::INTEGER) : ValueFactory::GetIntegerValue(i);
+    RID rid;
+    ASSERT_TRUE(table_info->table_->InsertTuple(Tuple{{ValueFactory::GetIntegerValue(i % 5000), b}, &schema}, &rid,
+                                                &txn));
+  }
+
+  EXPECT_EQ(table_info->stats_, nullptr);
+  catalog->AnalyzeTable(table_info);
+  ASSERT_NE(table_info->stats_, nullptr);
+  const auto &stats = *table_info->stats_;
+  EXPECT_EQ(stats.row_count_, row_cnt);
+  EXPECT_EQ(stats.sampled_rows_, TableStats::SAMPLE_SIZE);
+  EXPECT_FALSE(stats.IsStale());
+  EXPECT_DOUBLE_EQ(stats.GetNullFraction(0), 0);
+  EXPECT_DOUBLE_EQ(stats.GetNullFraction(1), 0.25);
+  EXPECT_NEAR(stats.GetDistinctCount(0), 5000, 500);
+  EXPECT_NEAR(stats.GetDistinctCount(1), row_cnt * 3 / 4, row_cnt / 10);
+  EXPECT_EQ(stats.columns_[0].min_.GetAs<int32_t>(), 0);
+  EXPECT_EQ(stats.columns_[0].max_.GetAs<int32_t>(), 4999);
+
+  // The histogram of a uniform column splits it evenly.
+  const auto &histogram = stats.columns_[0].histogram_;
+  EXPECT_EQ(histogram.GetBounds().size(), EquiDepthHistogram::BUCKET_CNT);
+  EXPECT_NEAR(histogram.EstimateLessThan(ValueFactory::GetIntegerValue(1250)), 0.25, 0.05);
+  EXPECT_NEAR(histogram.EstimateLessThan(ValueFactory::GetIntegerValue(4000)), 0.8, 0.05);
+  EXPECT_DOUBLE_EQ(histogram.EstimateLessThan(ValueFactory::GetIntegerValue(10000)), 1.0);
+
+  // Modifications keep the counts current, and eventually make the statistics stale.
+  Tuple null_row{{ValueFactory::GetIntegerValue(1), ValueFactory::GetNullValueByType(TypeId::INTEGER)}, &schema};
+  for (int i = 0; i < row_cnt / 4; i++) {
+    table_info->RecordInsert(null_row);
+  }
+  EXPECT_EQ(table_info->stats_->row_count_, row_cnt + row_cnt / 4);
+  EXPECT_DOUBLE_EQ(table_info->stats_->GetNullFraction(1), 0.4);
+  EXPECT_TRUE(table_info->stats_->IsStale());
+}
+
 }  // namespace bustub
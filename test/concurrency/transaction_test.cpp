@@ -13,10 +13,12 @@
 #include "concurrency/transaction.h"
 
 #include <atomic>
+#include <chrono>  // NOLINT
 #include <cstdio>
 #include <memory>
 #include <random>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -33,7 +35,9 @@
 #include "execution/plans/limit_plan.h"
 #include "execution/plans/nested_index_join_plan.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "fmt/format.h"
 #include "gtest/gtest.h"
+#include "storage/index/generic_key.h"
 #include "test_util.h"  // NOLINT
 #include "type/value_factory.h"
 
@@ -119,4 +123,215 @@ TEST_F(TransactionTest, DirtyReadsTest) {
   delete txn1;
 }
 
+// NOLINTNEXTLINE
+TEST_F(TransactionTest, UpdateRollbackTest) {
+  // txn1: UPDATE t SET x = x + 100, s = <longer string>, which moves the tuples that no longer fit in their page
+  // txn1: abort
+  // txn2: the table and its index are back as they were
+
+  auto noop_writer = NoopWriter();
+  bustub_->ExecuteSql("CREATE TABLE t (x int, s varchar(512));", noop_writer);
+  bustub_->ExecuteSql("CREATE INDEX t_x ON t(x);", noop_writer);
+  const int row_cnt = 40;
+  std::string short_string(100, 'a');
+  std::string long_string(400, 'b');
+  for (int i = 0; i < row_cnt; i++) {
+    bustub_->ExecuteSql(fmt::format("INSERT INTO t VALUES ({}, '{}');", i, short_string), noop_writer);
+  }
+
+  auto *txn1 = bustub_->txn_manager_->Begin();
+  std::stringstream ss1;
+  auto writer1 = SimpleStreamWriter(ss1, true);
+  ASSERT_TRUE(bustub_->ExecuteSqlTxn(fmt::format("UPDATE t SET x = x + 100, s = '{}'", long_string), writer1, txn1));
+  EXPECT_EQ(ss1.str(), fmt::format("{}\t\n", row_cnt));
+  std::stringstream ss2;
+  auto writer2 = SimpleStreamWriter(ss2, true);
+  bustub_->ExecuteSqlTxn("SELECT count(*) FROM t WHERE x = 105", writer2, txn1);
+  EXPECT_EQ(ss2.str(), "1\t\n");
+  bustub_->txn_manager_->Abort(txn1);
+  delete txn1;
+
+  auto *txn2 = bustub_->txn_manager_->Begin();
+  std::stringstream ss3;
+  auto writer3 = SimpleStreamWriter(ss3, true);
+  bustub_->ExecuteSqlTxn(fmt::format("SELECT count(*), sum(x) FROM t WHERE s = '{}'", short_string), writer3, txn2);
+  EXPECT_EQ(ss3.str(), fmt::format("{}\t{}\t\n", row_cnt, row_cnt * (row_cnt - 1) / 2));
+  std::stringstream ss4;
+  auto writer4 = SimpleStreamWriter(ss4, true);
+  bustub_->ExecuteSqlTxn("SELECT x FROM t WHERE x = 5", writer4, txn2);
+  EXPECT_EQ(ss4.str(), "5\t\n");
+  std::stringstream ss5;
+  auto writer5 = SimpleStreamWriter(ss5, true);
+  bustub_->ExecuteSqlTxn("SELECT x FROM t WHERE x = 105", writer5, txn2);
+  EXPECT_EQ(ss5.str(), "");
+  bustub_->txn_manager_->Commit(txn2);
+  delete txn2;
+
+  // txn3: UPDATE u SET k = 3 - k, which swaps the keys 1 and 2 between two rows
+  // txn3: abort
+  // txn4: both keys still find their rows through the index
+  bustub_->ExecuteSql("CREATE TABLE u (k int, v int);", noop_writer);
+  bustub_->ExecuteSql("CREATE INDEX u_k ON u(k);", noop_writer);
+  bustub_->ExecuteSql("INSERT INTO u VALUES (1, 10), (2, 20);", noop_writer);
+
+  auto *txn3 = bustub_->txn_manager_->Begin();
+  std::stringstream ss6;
+  auto writer6 = SimpleStreamWriter(ss6, true);
+  ASSERT_TRUE(bustub_->ExecuteSqlTxn("UPDATE u SET k = 3 - k", writer6, txn3));
+  EXPECT_EQ(ss6.str(), "2\t\n");
+  bustub_->txn_manager_->Abort(txn3);
+  delete txn3;
+
+  auto *txn4 = bustub_->txn_manager_->Begin();
+  for (int k = 1; k <= 2; k++) {
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true);
+    bustub_->ExecuteSqlTxn(fmt::format("SELECT v FROM u WHERE k = {}", k), writer, txn4);
+    EXPECT_EQ(ss.str(), fmt::format("{}\t\n", k * 10));
+  }
+  bustub_->txn_manager_->Commit(txn4);
+  delete txn4;
+
+  // txn5: UPDATE w SET s = 'x', which shrinks both tuples of the only page of w
+  // another transaction inserts two tuples as large as the old ones
+  // txn5: abort
+  // txn6: both tuples are back as they were
+  bustub_->ExecuteSql("CREATE TABLE w (x int, s varchar(2048));", noop_writer);
+  std::string wide_string(1500, 'c');
+  bustub_->ExecuteSql(fmt::format("INSERT INTO w VALUES (1, '{0}'), (2, '{0}');", wide_string), noop_writer);
+
+  auto *txn5 = bustub_->txn_manager_->Begin();
+  std::stringstream ss7;
+  auto writer7 = SimpleStreamWriter(ss7, true);
+  ASSERT_TRUE(bustub_->ExecuteSqlTxn("UPDATE w SET s = 'x'", writer7, txn5));
+  EXPECT_EQ(ss7.str(), "2\t\n");
+  ASSERT_TRUE(bustub_->ExecuteSql(fmt::format("INSERT INTO w VALUES (3, '{0}'), (4, '{0}');", wide_string), noop_writer));
+  bustub_->txn_manager_->Abort(txn5);
+  delete txn5;
+
+  auto *txn6 = bustub_->txn_manager_->Begin();
+  std::stringstream ss8;
+  auto writer8 = SimpleStreamWriter(ss8, true);
+  bustub_->ExecuteSqlTxn(fmt::format("SELECT count(*), sum(x) FROM w WHERE s = '{}'", wide_string), writer8, txn6);
+  EXPECT_EQ(ss8.str(), "4\t10\t\n");
+  bustub_->txn_manager_->Commit(txn6);
+  delete txn6;
+}
+
+// NOLINTNEXTLINE
+TEST_F(TransactionTest, UpdateDuplicateKeyTest) {
+  // UPDATE u SET k = k - 1 WHERE v >= 20, which would give two rows the key 1 of the B+ tree index
+  // the statement fails and its transaction is rolled back
+  // every row is still found by its old key, and only by it
+
+  auto noop_writer = NoopWriter();
+  bustub_->ExecuteSql("CREATE TABLE u (k int, v int);", noop_writer);
+  bustub_->ExecuteSql("CREATE INDEX u_k ON u(k);", noop_writer);
+  bustub_->ExecuteSql("INSERT INTO u VALUES (1, 10), (2, 20), (3, 30);", noop_writer);
+
+  EXPECT_FALSE(bustub_->ExecuteSql("UPDATE u SET k = k - 1 WHERE v >= 20", noop_writer));
+
+  auto *txn = bustub_->txn_manager_->Begin();
+  for (int k = 1; k <= 3; k++) {
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true);
+    bustub_->ExecuteSqlTxn(fmt::format("SELECT v FROM u WHERE k = {}", k), writer, txn);
+    EXPECT_EQ(ss.str(), fmt::format("{}\t\n", k * 10));
+  }
+  bustub_->txn_manager_->Commit(txn);
+  delete txn;
+}
+
+// NOLINTNEXTLINE
+TEST_F(TransactionTest, IndexKeyTooLargeTest) {
+  // an index with 8-byte keys on a VARCHAR column, which only holds strings of up to 2 bytes
+  // a statement that would give it a longer key fails before it writes the table
+
+  auto noop_writer = NoopWriter();
+  bustub_->ExecuteSql("CREATE TABLE v (k varchar(20), x int);", noop_writer);
+  auto *txn = bustub_->txn_manager_->Begin();
+  auto *table_info = bustub_->catalog_->GetTable("v");
+  auto key_schema = Schema::CopySchema(&table_info->schema_, {0});
+  ASSERT_NE(Catalog::NULL_INDEX_INFO,
+            (bustub_->catalog_->CreateIndex<GenericKey<8>, RID, GenericComparator<8>>(
+                txn, "v_k", "v", table_info->schema_, key_schema, {0}, 8, HashFunction<GenericKey<8>>{})));
+  bustub_->txn_manager_->Commit(txn);
+  delete txn;
+
+  EXPECT_FALSE(bustub_->ExecuteSql("INSERT INTO v VALUES ('ab', 1), ('a longer string', 2);", noop_writer));
+  ASSERT_TRUE(bustub_->ExecuteSql("INSERT INTO v VALUES ('ab', 3);", noop_writer));
+  EXPECT_FALSE(bustub_->ExecuteSql("UPDATE v SET k = 'a longer string';", noop_writer));
+
+  std::stringstream ss;
+  auto writer = SimpleStreamWriter(ss, true);
+  bustub_->ExecuteSql("SELECT k, x FROM v;", writer);
+  EXPECT_EQ(ss.str(), "ab\t3\t\n");
+}
+
+// NOLINTNEXTLINE
+TEST_F(TransactionTest, VacuumWithOpenTransactionTest) {
+  // txn1: UPDATE t SET s = 'changed' WHERE x = 395, on one of the last pages of t
+  // another thread: vacuum t, which waits for txn1
+  // txn1: abort, then the vacuum moves the tuples of the last pages into the ones emptied by a committed delete
+  // txn2: UPDATE t SET s = 'changed' WHERE x = 399, vacuum t itself, abort
+  // txn3: the updated tuples are back as they were, and the index still finds them
+
+  auto noop_writer = NoopWriter();
+  bustub_->ExecuteSql("CREATE TABLE t (x int, s varchar(128));", noop_writer);
+  bustub_->ExecuteSql("CREATE INDEX t_x ON t(x);", noop_writer);
+  const int row_cnt = 400;
+  std::string row_string(100, 'a');
+  for (int i = 0; i < row_cnt; i++) {
+    bustub_->ExecuteSql(fmt::format("INSERT INTO t VALUES ({}, '{}');", i, row_string), noop_writer);
+  }
+  bustub_->ExecuteSql("DELETE FROM t WHERE x < 380;", noop_writer);
+
+  auto *txn1 = bustub_->txn_manager_->Begin();
+  std::stringstream ss1;
+  auto writer1 = SimpleStreamWriter(ss1, true);
+  ASSERT_TRUE(bustub_->ExecuteSqlTxn("UPDATE t SET s = 'changed' WHERE x = 395", writer1, txn1));
+  EXPECT_EQ(ss1.str(), "1\t\n");
+
+  std::atomic<bool> is_vacuumed{false};
+  std::stringstream ss2;
+  std::thread vacuum_thread([&] {
+    auto writer2 = SimpleStreamWriter(ss2, true);
+    bustub_->ExecuteSql("\\vacuum t", writer2);
+    is_vacuumed = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(is_vacuumed);
+  bustub_->txn_manager_->Abort(txn1);
+  delete txn1;
+  vacuum_thread.join();
+  EXPECT_NE(ss2.str().find("pages freed"), std::string::npos);
+  EXPECT_EQ(ss2.str().find(" 0 tuples moved"), std::string::npos);
+
+  auto *txn2 = bustub_->txn_manager_->Begin();
+  std::stringstream ss3;
+  auto writer3 = SimpleStreamWriter(ss3, true);
+  ASSERT_TRUE(bustub_->ExecuteSqlTxn("UPDATE t SET s = 'changed' WHERE x = 399", writer3, txn2));
+  ASSERT_TRUE(bustub_->ExecuteSqlTxn("\\vacuum t", noop_writer, txn2));
+  bustub_->txn_manager_->Abort(txn2);
+  delete txn2;
+
+  auto *txn3 = bustub_->txn_manager_->Begin();
+  std::stringstream ss4;
+  auto writer4 = SimpleStreamWriter(ss4, true);
+  bustub_->ExecuteSqlTxn("SELECT count(*), sum(x) FROM t", writer4, txn3);
+  EXPECT_EQ(ss4.str(), fmt::format("{}\t{}\t\n", row_cnt - 380, (380 + row_cnt - 1) * (row_cnt - 380) / 2));
+  for (int x : {395, 399}) {
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true);
+    bustub_->ExecuteSqlTxn(fmt::format("SELECT s FROM t WHERE x = {}", x), writer, txn3);
+    EXPECT_EQ(ss.str(), row_string + "\t\n");
+  }
+  std::stringstream ss5;
+  auto writer5 = SimpleStreamWriter(ss5, true);
+  bustub_->ExecuteSqlTxn("SELECT count(*) FROM t WHERE s = 'changed'", writer5, txn3);
+  EXPECT_EQ(ss5.str(), "0\t\n");
+  bustub_->txn_manager_->Commit(txn3);
+  delete txn3;
+}
+
 }  // namespace bustub
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <thread>  // NOLINT
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include "container/disk/hash/disk_extendible_hash_table.h"
 #include "gtest/gtest.h"
 #include "murmur3/MurmurHash3.h"
+#include "storage/disk/disk_manager_memory.h"
 
 namespace bustub {
 
@@ -117,4 +119,133 @@ TEST(HashTableTest, SampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTableTest, GrowShrinkTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // Enough pairs to split the single bucket many times over, with two values per key.
+  const int num_keys = 10000;
+  for (int i = 0; i < num_keys; i++) {
+    ASSERT_TRUE(ht.Insert(nullptr, i, i));
+    ASSERT_TRUE(ht.Insert(nullptr, i, -i - 1));
+  }
+  EXPECT_GT(ht.GetGlobalDepth(), 4);
+  ht.VerifyIntegrity();
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ASSERT_TRUE(ht.GetValue(nullptr, i, &res));
+    ASSERT_EQ(2, res.size());
+  }
+
+  // Emptying the table merges every bucket back into one.
+  for (int i = 0; i < num_keys; i++) {
+    ASSERT_TRUE(ht.Remove(nullptr, i, i));
+    ASSERT_TRUE(ht.Remove(nullptr, i, -i - 1));
+    ASSERT_FALSE(ht.Remove(nullptr, i, i));
+  }
+  ht.VerifyIntegrity();
+  EXPECT_EQ(0, ht.GetGlobalDepth());
+  std::vector<int> res;
+  EXPECT_FALSE(ht.GetValue(nullptr, 0, &res));
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, DuplicateKeyTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // Each key has several pages worth of values, which no split can separate, next to keys with a single value.
+  const int num_keys = 4;
+  const int values_per_key = 2000;
+  for (int v = 0; v < values_per_key; v++) {
+    for (int k = 0; k < num_keys; k++) {
+      ASSERT_TRUE(ht.Insert(nullptr, k, v));
+    }
+    ASSERT_TRUE(ht.Insert(nullptr, num_keys + v, v));
+  }
+  EXPECT_FALSE(ht.Insert(nullptr, 0, values_per_key - 1));
+  ht.VerifyIntegrity();
+  for (int k = 0; k < num_keys; k++) {
+    std::vector<int> res;
+    ASSERT_TRUE(ht.GetValue(nullptr, k, &res));
+    ASSERT_EQ(values_per_key, res.size());
+    std::sort(res.begin(), res.end());
+    for (int v = 0; v < values_per_key; v++) {
+      ASSERT_EQ(v, res[v]);
+    }
+  }
+  for (int v = 0; v < values_per_key; v++) {
+    std::vector<int> res;
+    ASSERT_TRUE(ht.GetValue(nullptr, num_keys + v, &res));
+    ASSERT_EQ(1, res.size());
+  }
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+
+  // The overflow pages go away as they empty, and then the buckets merge back into one.
+  for (int v = 0; v < values_per_key; v++) {
+    for (int k = 0; k < num_keys; k++) {
+      ASSERT_TRUE(ht.Remove(nullptr, k, v));
+    }
+    ASSERT_TRUE(ht.Remove(nullptr, num_keys + v, v));
+    if (v == values_per_key / 2) {
+      std::vector<int> res;
+      ASSERT_TRUE(ht.GetValue(nullptr, 0, &res));
+      ASSERT_EQ(values_per_key - v - 1, res.size());
+    }
+  }
+  ht.VerifyIntegrity();
+  EXPECT_EQ(0, ht.GetGlobalDepth());
+  std::vector<int> res;
+  EXPECT_FALSE(ht.GetValue(nullptr, 0, &res));
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, ConcurrentTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  const int num_threads = 4;
+  const int keys_per_thread = 5000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&ht, t] {
+      for (int i = t * keys_per_thread; i < (t + 1) * keys_per_thread; i++) {
+        ASSERT_TRUE(ht.Insert(nullptr, i, i));
+        std::vector<int> res;
+        ASSERT_TRUE(ht.GetValue(nullptr, i, &res));
+      }
+      // Every thread removes half of its keys again.
+      for (int i = t * keys_per_thread; i < (t + 1) * keys_per_thread; i += 2) {
+        ASSERT_TRUE(ht.Remove(nullptr, i, i));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ht.VerifyIntegrity();
+  for (int i = 0; i < num_threads * keys_per_thread; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(i % 2 == 0 ? 0 : 1, res.size()) << i;
+  }
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+
+  delete bpm;
+  delete disk_manager;
+}
+
 }  // namespace bustub
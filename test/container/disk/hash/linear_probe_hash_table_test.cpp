@@ -0,0 +1,144 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// linear_probe_hash_table_test.cpp
+//
+// Identification: test/container/disk/hash/linear_probe_hash_table_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "container/disk/hash/linear_probe_hash_table.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, GrowTest) {
+  // Far fewer frames than the table ends up with pages.
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(8, disk_manager);
+  {
+    LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 100, HashFunction<int>());
+    auto initial_size = ht.GetSize();
+    EXPECT_GE(initial_size, 100);
+
+    const int num_keys = 20000;
+    for (int i = 0; i < num_keys; i++) {
+      ASSERT_TRUE(ht.Insert(nullptr, i, i));
+      ASSERT_TRUE(ht.Insert(nullptr, i, -i - 1));
+      ASSERT_FALSE(ht.Insert(nullptr, i, i));
+    }
+    EXPECT_EQ(ht.GetNumPairs(), 2 * num_keys);
+    EXPECT_GE(ht.GetSize() * 3, ht.GetNumPairs() * 4);
+    EXPECT_GT(ht.GetSize() / 250, bpm->GetPoolSize());
+
+    for (int i = 0; i < num_keys; i++) {
+      std::vector<int> res;
+      ASSERT_TRUE(ht.GetValue(nullptr, i, &res));
+      ASSERT_EQ(2, res.size());
+    }
+    std::vector<int> res;
+    EXPECT_FALSE(ht.GetValue(nullptr, num_keys, &res));
+
+    // Removing leaves tombstones behind, which must not hide the pairs probed past them.
+    for (int i = 0; i < num_keys; i += 2) {
+      ASSERT_TRUE(ht.Remove(nullptr, i, i));
+      ASSERT_FALSE(ht.Remove(nullptr, i, i));
+    }
+    for (int i = 0; i < num_keys; i++) {
+      std::vector<int> res;
+      ASSERT_TRUE(ht.GetValue(nullptr, i, &res));
+      ASSERT_EQ(i % 2 == 0 ? 1 : 2, res.size());
+    }
+
+    // An explicit resize keeps every pair.
+    auto size = ht.GetSize();
+    ht.Resize(size);
+    EXPECT_GE(ht.GetSize(), 2 * size);
+    EXPECT_EQ(ht.GetNumPairs(), num_keys * 3 / 2);
+    ASSERT_TRUE(ht.GetValue(nullptr, 1, &res));
+    EXPECT_TRUE(bpm->GetPinnedPages().empty());
+  }
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, TombstoneTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(8, disk_manager);
+  {
+    LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1000, HashFunction<int>());
+    auto initial_size = ht.GetSize();
+
+    // Churn through many more distinct keys than fit, but never keep more than a few around: the table sheds its
+    // tombstones instead of growing.
+    for (int round = 0; round < 50; round++) {
+      for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(ht.Insert(nullptr, round * 100 + i, i));
+      }
+      for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(ht.Remove(nullptr, round * 100 + i, i));
+      }
+    }
+    EXPECT_EQ(ht.GetSize(), initial_size);
+    EXPECT_EQ(ht.GetNumPairs(), 0);
+
+    // A tombstone is reused by the next insert that probes past it.
+    ASSERT_TRUE(ht.Insert(nullptr, 7, 7));
+    ASSERT_TRUE(ht.Remove(nullptr, 7, 7));
+    ASSERT_TRUE(ht.Insert(nullptr, 7, 8));
+    std::vector<int> res;
+    ASSERT_TRUE(ht.GetValue(nullptr, 7, &res));
+    EXPECT_EQ(res, std::vector<int>{8});
+  }
+  delete bpm;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, ConcurrentTest) {
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *bpm = new BufferPoolManagerInstance(16, disk_manager);
+  {
+    LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 100, HashFunction<int>());
+
+    const int num_threads = 4;
+    const int keys_per_thread = 3000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+      threads.emplace_back([&ht, t] {
+        for (int i = t * keys_per_thread; i < (t + 1) * keys_per_thread; i++) {
+          ASSERT_TRUE(ht.Insert(nullptr, i, i));
+          std::vector<int> res;
+          ASSERT_TRUE(ht.GetValue(nullptr, i, &res));
+        }
+        for (int i = t * keys_per_thread; i < (t + 1) * keys_per_thread; i += 2) {
+          ASSERT_TRUE(ht.Remove(nullptr, i, i));
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    for (int i = 0; i < num_threads * keys_per_thread; i++) {
+      std::vector<int> res;
+      ht.GetValue(nullptr, i, &res);
+      ASSERT_EQ(i % 2 == 0 ? 0 : 1, res.size()) << i;
+    }
+    EXPECT_TRUE(bpm->GetPinnedPages().empty());
+  }
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
@@ -0,0 +1,169 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// result_cursor_test.cpp
+//
+// Identification: test/execution/result_cursor_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/result_cursor.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "common/bustub_instance.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/execution_engine.h"
+#include "execution/executor_context.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+class ResultCursorTest : public ::testing::Test {
+ protected:
+  void SetUp() override { bustub_ = std::make_unique<BustubInstance>(); }
+
+  /** Create a table holding the integers 0 to row_cnt - 1. */
+  void CreateTable(const std::string &name, size_t row_cnt) {
+    NoopWriter writer;
+    ASSERT_TRUE(bustub_->ExecuteSql(fmt::format("CREATE TABLE {}(a int);", name), writer));
+    if (row_cnt == 0) {
+      return;
+    }
+    std::string insert = fmt::format("INSERT INTO {} VALUES (0)", name);
+    for (size_t i = 1; i < row_cnt; i++) {
+      insert += fmt::format(", ({})", i);
+    }
+    ASSERT_TRUE(bustub_->ExecuteSql(insert + ";", writer));
+  }
+
+  /** @return the sizes of the batches the cursor delivers until it is exhausted, checking the values on the way */
+  auto DrainCursor(ResultCursor *cursor) -> std::vector<size_t> {
+    std::vector<size_t> batch_sizes;
+    std::vector<Tuple> batch;
+    int expected = 0;
+    while (cursor->Next(&batch)) {
+      batch_sizes.push_back(batch.size());
+      for (const auto &tuple : batch) {
+        EXPECT_EQ(expected++, tuple.GetValue(&cursor->GetSchema(), 0).GetAs<int32_t>());
+      }
+    }
+    EXPECT_TRUE(batch.empty());
+    // An exhausted cursor stays exhausted.
+    EXPECT_FALSE(cursor->Next(&batch));
+    EXPECT_TRUE(batch.empty());
+    return batch_sizes;
+  }
+
+  /** @return the sizes of the batches ExecutionEngine::Execute hands to its consumer for a scan of the table */
+  auto ExecuteScan(const std::string &name, Transaction *txn, size_t batch_size) -> std::vector<size_t> {
+    auto *table_info = bustub_->catalog_->GetTable(name);
+    auto plan = std::make_shared<SeqScanPlanNode>(std::make_shared<Schema>(table_info->schema_), table_info->oid_,
+                                                  table_info->name_);
+    ExecutorContext exec_ctx(txn, bustub_->catalog_, bustub_->buffer_pool_manager_, bustub_->txn_manager_,
+                             bustub_->lock_manager_);
+    std::vector<size_t> batch_sizes;
+    EXPECT_TRUE(bustub_->execution_engine_->Execute(
+        plan, [&batch_sizes](const std::vector<Tuple> &batch) { batch_sizes.push_back(batch.size()); }, txn,
+        &exec_ctx, batch_size));
+    return batch_sizes;
+  }
+
+  auto PinnedPageCount() -> size_t {
+    return dynamic_cast<BufferPoolManagerInstance *>(bustub_->buffer_pool_manager_)->GetPinnedPages().size();
+  }
+
+  std::unique_ptr<BustubInstance> bustub_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(ResultCursorTest, BatchBoundaryTest) {
+  CreateTable("exact", RESULT_BATCH_SIZE);
+  CreateTable("over", 2 * RESULT_BATCH_SIZE + 1);
+  auto *txn = bustub_->txn_manager_->Begin();
+
+  // A result of exactly one batch is not followed by an empty one.
+  auto cursor = bustub_->OpenCursor("SELECT a FROM exact;", txn);
+  EXPECT_EQ(std::vector<size_t>({RESULT_BATCH_SIZE}), DrainCursor(cursor.get()));
+  cursor = bustub_->OpenCursor("SELECT a FROM over;", txn);
+  EXPECT_EQ(std::vector<size_t>({RESULT_BATCH_SIZE, RESULT_BATCH_SIZE, 1}), DrainCursor(cursor.get()));
+  cursor.reset();
+
+  EXPECT_EQ(std::vector<size_t>({RESULT_BATCH_SIZE}), ExecuteScan("exact", txn, RESULT_BATCH_SIZE));
+  EXPECT_EQ(std::vector<size_t>({RESULT_BATCH_SIZE, RESULT_BATCH_SIZE, 1}),
+            ExecuteScan("over", txn, RESULT_BATCH_SIZE));
+  EXPECT_EQ(std::vector<size_t>({1000, 1000, 49}), ExecuteScan("over", txn, 1000));
+
+  bustub_->txn_manager_->Commit(txn);
+  delete txn;
+}
+
+// NOLINTNEXTLINE
+TEST_F(ResultCursorTest, EmptyResultTest) {
+  CreateTable("empty", 0);
+  CreateTable("ten", 10);
+  auto *txn = bustub_->txn_manager_->Begin();
+
+  for (const auto *sql : {"SELECT a FROM empty;", "SELECT a FROM ten WHERE a > 100;"}) {
+    auto cursor = bustub_->OpenCursor(sql, txn);
+    std::vector<Tuple> batch(3);
+    EXPECT_FALSE(cursor->Next(&batch)) << sql;
+    EXPECT_TRUE(batch.empty()) << sql;
+    EXPECT_FALSE(cursor->Next(&batch)) << sql;
+  }
+  // The consumer is not called at all.
+  EXPECT_TRUE(ExecuteScan("empty", txn, RESULT_BATCH_SIZE).empty());
+
+  EXPECT_THROW(bustub_->OpenCursor("INSERT INTO empty VALUES (1);", txn), Exception);
+
+  bustub_->txn_manager_->Commit(txn);
+  delete txn;
+}
+
+// NOLINTNEXTLINE
+TEST_F(ResultCursorTest, EarlyCloseTest) {
+  CreateTable("t", 3 * RESULT_BATCH_SIZE);
+  auto *txn = bustub_->txn_manager_->Begin();
+  auto pinned_before = PinnedPageCount();
+
+  // Nothing runs, and nothing is pinned, before the first batch is asked for.
+  auto cursor = bustub_->OpenCursor("SELECT a FROM t;", txn);
+  EXPECT_EQ(pinned_before, PinnedPageCount());
+  cursor.reset();
+
+  // A cursor dropped in the middle of the result releases the pages its scan was on.
+  cursor = bustub_->OpenCursor("SELECT a FROM t;", txn);
+  std::vector<Tuple> batch;
+  ASSERT_TRUE(cursor->Next(&batch));
+  ASSERT_EQ(RESULT_BATCH_SIZE, batch.size());
+  cursor.reset();
+  EXPECT_EQ(pinned_before, PinnedPageCount());
+
+  // So does an exhausted cursor, as soon as it is exhausted.
+  cursor = bustub_->OpenCursor("SELECT a FROM t;", txn);
+  EXPECT_EQ(std::vector<size_t>({RESULT_BATCH_SIZE, RESULT_BATCH_SIZE, RESULT_BATCH_SIZE}),
+            DrainCursor(cursor.get()));
+  EXPECT_EQ(pinned_before, PinnedPageCount());
+  cursor.reset();
+  EXPECT_EQ(pinned_before, PinnedPageCount());
+
+  // The tuples of a batch stay valid after the cursor is gone.
+  cursor = bustub_->OpenCursor("SELECT a FROM t WHERE a >= 10;", txn);
+  ASSERT_TRUE(cursor->Next(&batch));
+  auto schema = cursor->GetSchema();
+  cursor.reset();
+  EXPECT_EQ(10, batch.front().GetValue(&schema, 0).GetAs<int32_t>());
+
+  bustub_->txn_manager_->Commit(txn);
+  delete txn;
+}
+
+}  // namespace bustub
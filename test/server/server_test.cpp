@@ -0,0 +1,277 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// server_test.cpp
+//
+// Identification: test/server/server_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/bustub_instance.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "server/client.h"
+#include "server/server.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace bustub {
+
+/** @return a blocking socket connected to the server, for tests that send frames by hand */
+auto ConnectRaw(uint16_t port) -> int {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  EXPECT_GE(fd, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  EXPECT_EQ(0, connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)));
+  return fd;
+}
+
+// NOLINTNEXTLINE
+TEST(ServerTest, QueryTest) {
+  BustubInstance bustub;
+  Server server(&bustub, 2);
+  auto port = server.ListenTcp(0);
+  auto path = fmt::format("/tmp/bustub-server-test-{}.sock", getpid());
+  server.ListenUnix(path);
+  server.Start();
+
+  Client tcp_client;
+  tcp_client.ConnectTcp("127.0.0.1", port);
+  Client unix_client;
+  unix_client.ConnectUnix(path);
+
+  ASSERT_TRUE(tcp_client.Execute("CREATE TABLE t(a int, b varchar(8));").IsSuccessful());
+  ASSERT_TRUE(tcp_client.Execute("INSERT INTO t VALUES (1, 'one'), (2, 'two');").IsSuccessful());
+  auto result = unix_client.Execute("SELECT a, b FROM t WHERE a = 2;");
+  ASSERT_TRUE(result.IsSuccessful());
+  ASSERT_EQ("2\ttwo\t\n", result.payload_);
+
+  result = unix_client.Execute("SELECT * FROM missing;");
+  ASSERT_EQ(FrameTag::ERROR, result.tag_);
+  ASSERT_FALSE(result.payload_.empty());
+
+  // An error leaves the session usable.
+  ASSERT_TRUE(unix_client.Execute("SELECT a FROM t;").IsSuccessful());
+  ASSERT_EQ(2, server.GetSessionCount());
+}
+
+// NOLINTNEXTLINE
+TEST(ServerTest, SessionTest) {
+  BustubInstance bustub;
+  Server server(&bustub, 2);
+  auto port = server.ListenTcp(0);
+  server.Start();
+
+  Client client_a;
+  client_a.ConnectTcp("127.0.0.1", port);
+  Client client_b;
+  client_b.ConnectTcp("127.0.0.1", port);
+  ASSERT_TRUE(client_a.Execute("CREATE TABLE t(a int);").IsSuccessful());
+
+  // Variables belong to a session.
+  ASSERT_TRUE(client_a.Execute("SET force_optimizer_starter_rule = yes;").IsSuccessful());
+  ASSERT_EQ("force_optimizer_starter_rule=yes\t\n", client_a.Execute("SHOW force_optimizer_starter_rule;").payload_);
+  ASSERT_EQ("force_optimizer_starter_rule=\t\n", client_b.Execute("SHOW force_optimizer_starter_rule;").payload_);
+
+  // A transaction spans the queries of a session until it ends.
+  ASSERT_TRUE(client_a.Execute("BEGIN;").IsSuccessful());
+  ASSERT_EQ(FrameTag::ERROR, client_a.Execute("BEGIN;").tag_);
+  ASSERT_TRUE(client_a.Execute("INSERT INTO t VALUES (1);").IsSuccessful());
+  ASSERT_EQ("1\t\n", client_a.Execute("SELECT * FROM t;").payload_);
+  ASSERT_TRUE(client_a.Execute("ROLLBACK;").IsSuccessful());
+  ASSERT_EQ("", client_b.Execute("SELECT * FROM t;").payload_);
+
+  ASSERT_TRUE(client_a.Execute("BEGIN;").IsSuccessful());
+  ASSERT_TRUE(client_a.Execute("INSERT INTO t VALUES (2);").IsSuccessful());
+  ASSERT_TRUE(client_a.Execute("COMMIT;").IsSuccessful());
+  ASSERT_EQ("2\t\n", client_b.Execute("SELECT * FROM t;").payload_);
+  ASSERT_EQ(FrameTag::ERROR, client_b.Execute("COMMIT;").tag_);
+
+  // The transaction of a client that goes away is rolled back.
+  {
+    Client client_c;
+    client_c.ConnectTcp("127.0.0.1", port);
+    ASSERT_TRUE(client_c.Execute("BEGIN;").IsSuccessful());
+    ASSERT_TRUE(client_c.Execute("INSERT INTO t VALUES (3);").IsSuccessful());
+  }
+  while (server.GetSessionCount() != 2) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ("2\t\n", client_b.Execute("SELECT * FROM t;").payload_);
+}
+
+// NOLINTNEXTLINE
+TEST(ServerTest, PreparedStatementTest) {
+  BustubInstance bustub;
+  Server server(&bustub, 2);
+  auto port = server.ListenTcp(0);
+  server.Start();
+
+  Client client_a;
+  client_a.ConnectTcp("127.0.0.1", port);
+  Client client_b;
+  client_b.ConnectTcp("127.0.0.1", port);
+  ASSERT_TRUE(client_a.Execute("CREATE TABLE t(a int, b varchar(8));").IsSuccessful());
+  ASSERT_TRUE(client_a.Execute("INSERT INTO t VALUES (1, 'one'), (2, 'two');").IsSuccessful());
+
+  // Prepared statements belong to a session, so two sessions can use the same name for different statements.
+  ASSERT_TRUE(client_a.Execute("PREPARE q(int) AS SELECT b FROM t WHERE a = $1;").IsSuccessful());
+  ASSERT_EQ(FrameTag::ERROR, client_b.Execute("EXECUTE q(1);").tag_);
+  ASSERT_TRUE(client_b.Execute("PREPARE q(int) AS SELECT a FROM t WHERE a > $1;").IsSuccessful());
+  ASSERT_EQ("one\t\n", client_a.Execute("EXECUTE q(1);").payload_);
+  ASSERT_EQ("2\t\n", client_b.Execute("EXECUTE q(1);").payload_);
+
+  ASSERT_TRUE(client_b.Execute("DEALLOCATE q;").IsSuccessful());
+  ASSERT_EQ(FrameTag::ERROR, client_b.Execute("EXECUTE q(1);").tag_);
+  ASSERT_EQ("two\t\n", client_a.Execute("EXECUTE q(2);").payload_);
+
+  // A client that connects later does not see them either.
+  {
+    Client client_c;
+    client_c.ConnectTcp("127.0.0.1", port);
+    ASSERT_EQ(FrameTag::ERROR, client_c.Execute("EXECUTE q(1);").tag_);
+    ASSERT_TRUE(client_c.Execute("PREPARE q(int) AS SELECT a FROM t WHERE a = $1;").IsSuccessful());
+  }
+  ASSERT_EQ("one\t\n", client_a.Execute("EXECUTE q(1);").payload_);
+}
+
+// NOLINTNEXTLINE
+TEST(ServerTest, PartialFrameTest) {
+  // With a single worker, a client that stops in the middle of a query must not keep the others waiting.
+  BustubInstance bustub;
+  Server server(&bustub, 1);
+  auto port = server.ListenTcp(0);
+  server.Start();
+
+  int fd = ConnectRaw(port);
+  std::string sql = "SELECT a FROM t;";
+  std::string frame(FRAME_HEADER_SIZE, static_cast<char>(FrameTag::QUERY));
+  uint32_t length = htonl(sql.size());
+  memcpy(frame.data() + 1, &length, sizeof(length));
+  frame += sql;
+  // Part of the header, then part of the payload, each of which leaves the worker with nothing to execute.
+  ASSERT_EQ(3, send(fd, frame.data(), 3, 0));
+
+  Client client;
+  client.ConnectTcp("127.0.0.1", port);
+  ASSERT_TRUE(client.Execute("CREATE TABLE t(a int);").IsSuccessful());
+  ASSERT_TRUE(client.Execute("INSERT INTO t VALUES (7);").IsSuccessful());
+  ASSERT_EQ(FRAME_HEADER_SIZE + 4 - 3, send(fd, frame.data() + 3, FRAME_HEADER_SIZE + 4 - 3, 0));
+  ASSERT_EQ("7\t\n", client.Execute("SELECT * FROM t;").payload_);
+
+  // The rest of the query, with a second query right behind it in the same write.
+  std::string rest = frame.substr(FRAME_HEADER_SIZE + 4) + frame;
+  ASSERT_EQ(rest.size(), send(fd, rest.data(), rest.size(), 0));
+  for (int i = 0; i < 2; i++) {
+    FrameTag tag;
+    std::string payload;
+    ASSERT_TRUE(ReadFrame(fd, &tag, &payload));
+    ASSERT_EQ(FrameTag::RESULT, tag);
+    ASSERT_EQ("7\t\n", payload);
+  }
+  close(fd);
+}
+
+// NOLINTNEXTLINE
+TEST(ServerTest, SlowReaderTest) {
+  // With a single worker, a client that does not read its answers must not keep the others waiting.
+  BustubInstance bustub;
+  Server server(&bustub, 1);
+  auto port = server.ListenTcp(0);
+  server.Start();
+
+  Client client;
+  client.ConnectTcp("127.0.0.1", port);
+  ASSERT_TRUE(client.Execute("CREATE TABLE t(a int, b varchar(128));").IsSuccessful());
+  std::string insert = "INSERT INTO t VALUES (0, '" + std::string(100, 'b') + "')";
+  for (int i = 1; i < 1000; i++) {
+    insert += fmt::format(", ({}, '{}')", i, std::string(100, 'b'));
+  }
+  ASSERT_TRUE(client.Execute(insert + ";").IsSuccessful());
+
+  // Far more answers than the socket buffers hold.
+  const int query_cnt = 200;
+  int fd = ConnectRaw(port);
+  for (int i = 0; i < query_cnt; i++) {
+    ASSERT_TRUE(WriteFrame(fd, FrameTag::QUERY, "SELECT * FROM t;"));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ("1000\t\n", client.Execute("SELECT count(*) FROM t;").payload_);
+
+  // Nothing is lost once the client reads again.
+  for (int i = 0; i < query_cnt; i++) {
+    FrameTag tag;
+    std::string payload;
+    ASSERT_TRUE(ReadFrame(fd, &tag, &payload));
+    ASSERT_EQ(FrameTag::RESULT, tag);
+    ASSERT_EQ(1000, std::count(payload.begin(), payload.end(), '\n'));
+  }
+  close(fd);
+
+  // A query larger than the server takes drops the connection, before all of it is sent.
+  fd = ConnectRaw(port);
+  std::string header(FRAME_HEADER_SIZE, static_cast<char>(FrameTag::QUERY));
+  uint32_t length = htonl(16 * 1024 * 1024);
+  memcpy(header.data() + 1, &length, sizeof(length));
+  ASSERT_EQ(header.size(), send(fd, header.data(), header.size(), 0));
+  FrameTag tag;
+  std::string payload;
+  ASSERT_FALSE(ReadFrame(fd, &tag, &payload));
+  close(fd);
+  ASSERT_TRUE(client.Execute("SELECT count(*) FROM t;").IsSuccessful());
+}
+
+// NOLINTNEXTLINE
+TEST(ServerTest, ConcurrentSessionTest) {
+  const int session_cnt = 64;
+  const int insert_cnt = 20;
+
+  BustubInstance bustub;
+  Server server(&bustub, 4);
+  auto port = server.ListenTcp(0);
+  server.Start();
+  {
+    Client client;
+    client.ConnectTcp("127.0.0.1", port);
+    ASSERT_TRUE(client.Execute("CREATE TABLE t(session int, i int);").IsSuccessful());
+  }
+
+  std::vector<std::thread> threads;
+  for (int session = 0; session < session_cnt; session++) {
+    threads.emplace_back([port, session, insert_cnt] {
+      Client client;
+      client.ConnectTcp("127.0.0.1", port);
+      for (int i = 0; i < insert_cnt; i++) {
+        ASSERT_TRUE(client.Execute(fmt::format("INSERT INTO t VALUES ({}, {});", session, i)).IsSuccessful());
+      }
+      auto result = client.Execute(fmt::format("SELECT count(*) FROM t WHERE session = {};", session));
+      ASSERT_EQ(fmt::format("{}\t\n", insert_cnt), result.payload_);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  Client client;
+  client.ConnectTcp("127.0.0.1", port);
+  ASSERT_EQ(fmt::format("{}\t\n", session_cnt * insert_cnt), client.Execute("SELECT count(*) FROM t;").payload_);
+}
+
+}  // namespace bustub
@@ -163,4 +163,68 @@ TEST(BPlusTreeTests, DeleteTest2) {
   remove("test.db");
   remove("test.log");
 }  // namespace bustub
+
+TEST(BPlusTreeTests, BatchTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  // create b+ tree, with small pages so that the batches split and merge leaves
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 5);
+  auto *transaction = new Transaction(0);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  // insert the even keys one at a time, then all the keys below 500 as a batch that repeats some of them
+  for (int64_t key = 0; key < 500; key += 2) {
+    GenericKey<8> index_key;
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, RID(0, key), transaction);
+  }
+  std::vector<std::pair<GenericKey<8>, RID>> entries;
+  for (int64_t key = 0; key < 500; key++) {
+    entries.emplace_back();
+    entries.back().first.SetFromInteger(key);
+    entries.back().second = RID(1, key);
+  }
+  EXPECT_EQ(tree.InsertBatch(entries, transaction), 250);
+
+  std::vector<RID> rids;
+  for (int64_t key = 0; key < 500; key++) {
+    rids.clear();
+    GenericKey<8> index_key;
+    index_key.SetFromInteger(key);
+    ASSERT_TRUE(tree.GetValue(index_key, &rids));
+    EXPECT_EQ(rids[0], RID(key % 2 == 0 ? 0 : 1, key));
+  }
+
+  // remove all the keys but the multiples of 7, plus some that are not in the tree
+  std::vector<GenericKey<8>> remove_keys;
+  for (int64_t key = 0; key < 600; key++) {
+    if (key % 7 != 0) {
+      remove_keys.emplace_back();
+      remove_keys.back().SetFromInteger(key);
+    }
+  }
+  tree.RemoveBatch(remove_keys, transaction);
+
+  int64_t expected_key = 0;
+  for (auto iter = tree.Begin(); !iter.IsEnd(); ++iter) {
+    EXPECT_EQ((*iter).second.GetSlotNum(), expected_key);
+    expected_key += 7;
+  }
+  EXPECT_EQ(expected_key, 504);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
 }  // namespace bustub
\ No newline at end of file
@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// page_guard_test.cpp
+//
+// Identification: test/storage/page_guard_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/page/header_page.h"
+#include "storage/page/page_guard.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(PageGuardTest, BasicTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(5, disk_manager.get());
+
+  page_id_t page_id;
+  auto *page = bpm->NewPage(&page_id);
+  {
+    auto guard = BasicPageGuard(bpm.get(), page);
+    EXPECT_EQ(page->GetPinCount(), 1);
+    EXPECT_EQ(guard.PageId(), page_id);
+
+    // Moving hands the pin over, it is released once.
+    auto moved = std::move(guard);
+    EXPECT_FALSE(guard.IsValid());  // NOLINT
+    EXPECT_TRUE(moved.IsValid());
+    EXPECT_EQ(page->GetPinCount(), 1);
+  }
+  EXPECT_EQ(page->GetPinCount(), 0);
+  EXPECT_FALSE(page->IsDirty());
+
+  // Writing through a guard marks the page dirty.
+  {
+    auto guard = bpm->FetchPageBasic(page_id);
+    EXPECT_EQ(page->GetPinCount(), 1);
+    std::strcpy(guard.GetDataMut(), "Hello");  // NOLINT
+  }
+  EXPECT_EQ(page->GetPinCount(), 0);
+  EXPECT_TRUE(page->IsDirty());
+
+  // Dropping twice is harmless.
+  auto guard = bpm->FetchPageBasic(page_id);
+  guard.Drop();
+  guard.Drop();
+  EXPECT_EQ(page->GetPinCount(), 0);
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+}
+
+// NOLINTNEXTLINE
+TEST(PageGuardTest, LatchTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(5, disk_manager.get());
+
+  page_id_t page_id;
+  auto new_guard = bpm->NewPageGuarded(&page_id);
+  auto *page = bpm->FetchPage(page_id);
+  bpm->UnpinPage(page_id, false);
+
+  {
+    // Two readers share the page.
+    auto reader1 = bpm->FetchPageRead(page_id);
+    auto reader2 = bpm->FetchPageRead(page_id);
+    EXPECT_EQ(page->GetPinCount(), 3);
+  }
+  {
+    auto writer = new_guard.UpgradeWrite();
+    EXPECT_FALSE(new_guard.IsValid());
+    std::strcpy(writer.AsMut<char>(), "Hello");  // NOLINT
+    EXPECT_EQ(page->GetPinCount(), 1);
+  }
+  // The write latch was released along with the pin, so the page can be latched again.
+  auto writer = bpm->FetchPageWrite(page_id);
+  EXPECT_STREQ(writer.As<char>(), "Hello");
+  writer.Drop();
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+
+  // A guard for a page that could not be fetched is empty.
+  page_id_t other_page_id;
+  std::vector<BasicPageGuard> guards;
+  for (int i = 0; i < 5; i++) {
+    guards.push_back(bpm->NewPageGuarded(&other_page_id));
+  }
+  EXPECT_FALSE(bpm->FetchPageRead(page_id).IsValid());
+  EXPECT_EQ(bpm->GetPinnedPages().size(), 5);
+}
+
+// NOLINTNEXTLINE
+TEST(PageGuardTest, BPlusTreePinLeakTest) {
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(50, disk_manager.get());
+  page_id_t page_id;
+  auto header_guard = bpm->NewPageGuarded(&page_id);
+  ASSERT_EQ(page_id, HEADER_PAGE_ID);
+  header_guard.AsMut<HeaderPage>()->Init();
+  header_guard.Drop();
+
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm.get(), comparator, 3, 5);
+  auto *transaction = new Transaction(0);
+  GenericKey<8> index_key;
+  for (int64_t key = 1; key <= 200; key++) {
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, RID(static_cast<int32_t>(key >> 32), static_cast<int32_t>(key)), transaction);
+  }
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+
+  int64_t scanned = 0;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    scanned++;
+  }
+  EXPECT_EQ(scanned, 200);
+  index_key.SetFromInteger(150);
+  {
+    auto iterator = tree.Begin(index_key);
+    EXPECT_EQ((*iterator).second.GetSlotNum(), 150);
+    EXPECT_EQ(bpm->GetPinnedPages().size(), 1);
+  }
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+
+  for (int64_t key = 1; key <= 200; key += 2) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key, transaction);
+  }
+  EXPECT_TRUE(bpm->GetPinnedPages().empty());
+
+  delete transaction;
+}
+
+}  // namespace bustub
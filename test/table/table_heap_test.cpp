@@ -0,0 +1,189 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_heap_test.cpp
+//
+// Identification: test/table/table_heap_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "logging/common.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
+
+namespace bustub {
+
+auto CountPages(BufferPoolManager *bpm, page_id_t page_id) -> size_t {
+  size_t page_cnt = 0;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = static_cast<TablePage *>(bpm->FetchPage(page_id));
+    auto next_page_id = page->GetNextPageId();
+    bpm->UnpinPage(page_id, false);
+    page_id = next_page_id;
+    page_cnt++;
+  }
+  return page_cnt;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, VacuumTest) {
+  Column col1{"a", TypeId::VARCHAR, 20};
+  Column col2{"b", TypeId::INTEGER};
+  std::vector<Column> cols{col1, col2};
+  Schema schema{cols};
+
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(50, disk_manager);
+  auto *lock_manager = new LockManager();
+  auto *log_manager = new LogManager(disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, log_manager, transaction);
+
+  std::vector<std::pair<RID, Tuple>> tuples;
+  for (int i = 0; i < 5000; ++i) {
+    RID rid;
+    Tuple tuple = ConstructTuple(&schema);
+    ASSERT_TRUE(table->InsertTuple(tuple, &rid, transaction));
+    tuples.emplace_back(rid, tuple);
+  }
+  EXPECT_EQ(table->GetTupleCount(), tuples.size());
+
+  // Keep one tuple out of eight, and leave one more delete-marked, which must not be moved.
+  std::vector<std::pair<RID, Tuple>> kept;
+  for (size_t i = 0; i < tuples.size(); ++i) {
+    if (i % 8 == 0) {
+      kept.push_back(tuples[i]);
+    } else if (i != tuples.size() - 1) {
+      ASSERT_TRUE(table->MarkDelete(tuples[i].first, transaction));
+      table->ApplyDelete(tuples[i].first, transaction);
+    } else {
+      ASSERT_TRUE(table->MarkDelete(tuples[i].first, transaction));
+    }
+  }
+  // The delete-marked tuple counts until its delete is applied.
+  EXPECT_EQ(table->GetTupleCount(), kept.size() + 1);
+  auto pages_before = CountPages(buffer_pool_manager, table->GetFirstPageId());
+
+  std::vector<std::pair<RID, RID>> moved;
+  auto freed_pages = table->Vacuum(transaction, {}, &moved);
+  auto pages_after = CountPages(buffer_pool_manager, table->GetFirstPageId());
+  EXPECT_GT(freed_pages, 0);
+  EXPECT_EQ(pages_before - freed_pages, pages_after);
+  EXPECT_LE(pages_after * 4, pages_before);
+
+  // Every kept tuple can be found at its (possibly new) location.
+  for (auto &[rid, tuple] : kept) {
+    for (const auto &[old_rid, new_rid] : moved) {
+      if (old_rid == rid) {
+        rid = new_rid;
+        break;
+      }
+    }
+    Tuple result;
+    ASSERT_TRUE(table->GetTuple(rid, &result, transaction));
+    ASSERT_EQ(tuple.GetValue(&schema, 0).CompareEquals(result.GetValue(&schema, 0)), CmpBool::CmpTrue);
+    ASSERT_EQ(tuple.GetValue(&schema, 1).CompareEquals(result.GetValue(&schema, 1)), CmpBool::CmpTrue);
+  }
+  size_t scanned = 0;
+  for (auto itr = table->Begin(transaction); itr != table->End(); ++itr) {
+    scanned++;
+  }
+  EXPECT_EQ(scanned, kept.size());
+
+  // The delete-marked tuple stayed where it was and can still be rolled back.
+  table->RollbackDelete(tuples.back().first, transaction);
+  Tuple result;
+  EXPECT_TRUE(table->GetTuple(tuples.back().first, &result, transaction));
+
+  // Counting the pages again, as reopening the table does, agrees with the count kept along the way.
+  table->RecountTuples();
+  EXPECT_EQ(table->GetTupleCount(), kept.size() + 1);
+
+  delete table;
+  delete log_manager;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, TupleViewTest) {
+  Column col1{"a", TypeId::VARCHAR, 20};
+  Column col2{"b", TypeId::INTEGER};
+  std::vector<Column> cols{col1, col2};
+  Schema schema{cols};
+
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManagerUnlimitedMemory();
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(10, disk_manager);
+  auto *lock_manager = new LockManager();
+  auto *log_manager = new LogManager(disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, log_manager, transaction);
+
+  // A smaller tuple may still fit into an earlier page, so tuples are matched by their rid rather than their order.
+  std::unordered_map<RID, Tuple> tuples;
+  for (int i = 0; i < 500; ++i) {
+    RID rid;
+    Tuple tuple = ConstructTuple(&schema);
+    ASSERT_TRUE(table->InsertTuple(tuple, &rid, transaction));
+    tuples.emplace(rid, tuple);
+  }
+
+  // Walk the whole table in place, and compare with what was inserted.
+  size_t scanned = 0;
+  for (auto page_id = table->GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+    TupleView view(buffer_pool_manager, page_id);
+    ASSERT_TRUE(view.IsValid());
+    for (bool found = view.SeekFirst(); found; found = view.SeekAfter(view.GetRid())) {
+      scanned++;
+      ASSERT_EQ(tuples.count(view.GetRid()), 1);
+      const auto &expected = tuples.at(view.GetRid());
+      ASSERT_EQ(view.GetValue(&schema, 0).CompareEquals(expected.GetValue(&schema, 0)), CmpBool::CmpTrue);
+      ASSERT_EQ(view.GetValue(&schema, 1).CompareEquals(expected.GetValue(&schema, 1)), CmpBool::CmpTrue);
+      ASSERT_FALSE(view.GetTuple().IsAllocated());
+    }
+    page_id = view.GetNextPageId();
+  }
+  EXPECT_EQ(scanned, tuples.size());
+
+  // A materialized tuple owns its data and outlives the view.
+  RID rid;
+  Tuple materialized;
+  {
+    TupleView view(buffer_pool_manager, table->GetFirstPageId());
+    ASSERT_TRUE(view.SeekFirst());
+    rid = view.GetRid();
+    materialized = view.Materialize();
+  }
+  EXPECT_TRUE(materialized.IsAllocated());
+  EXPECT_EQ(materialized.GetRid(), rid);
+  EXPECT_EQ(materialized.GetValue(&schema, 1).CompareEquals(tuples.at(rid).GetValue(&schema, 1)), CmpBool::CmpTrue);
+
+  // Every view has let go of its page.
+  for (int i = 0; i < 10; ++i) {
+    page_id_t page_id;
+    ASSERT_NE(buffer_pool_manager->NewPage(&page_id), nullptr);
+  }
+
+  delete table;
+  delete log_manager;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+}  // namespace bustub
@@ -19,8 +19,10 @@
 #include "buffer/buffer_pool_manager_instance.h"
 #include "gtest/gtest.h"
 #include "logging/common.h"
+#include "storage/index/generic_key.h"
 #include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 // NOLINTNEXTLINE
@@ -71,4 +73,69 @@ TEST(TupleTest, DISABLED_TableHeapTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(TupleTest, NullBitmapTest) {
+  Column col1{"a", TypeId::INTEGER};
+  Column col2{"b", TypeId::VARCHAR, 20};
+  Column col3{"c", TypeId::VARCHAR, 20};
+  Column col4{"d", TypeId::VARCHAR, 20};
+  Column col5{"e", TypeId::BIGINT};
+  std::vector<Column> cols{col1, col2, col3, col4, col5};
+  Schema schema{cols};
+
+  std::vector<Value> values{ValueFactory::GetNullValueByType(TypeId::INTEGER),
+                            ValueFactory::GetVarcharValue(std::string("x")),
+                            ValueFactory::GetNullValueByType(TypeId::VARCHAR),
+                            ValueFactory::GetVarcharValue(std::string("a longer string")),
+                            ValueFactory::GetBigIntValue(42)};
+  Tuple tuple{values, &schema};
+
+  // Fixed-size area, null bitmap, and only the payload of the long string.
+  EXPECT_EQ(tuple.GetLength(), 4 + 3 * 4 + 8 + 1 + 16);
+
+  std::vector<bool> is_null{true, false, true, false, false};
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    EXPECT_EQ(tuple.IsNull(&schema, i), is_null[i]);
+    auto value = tuple.GetValue(&schema, i);
+    EXPECT_EQ(value.IsNull(), is_null[i]);
+    if (!is_null[i]) {
+      EXPECT_EQ(value.CompareEquals(values[i]), CmpBool::CmpTrue);
+    }
+  }
+
+  // Moving leaves nothing behind to be freed twice.
+  Tuple moved{std::move(tuple)};
+  EXPECT_EQ(moved.GetValue(&schema, 3).ToString(), "a longer string");
+  EXPECT_EQ(tuple.GetData(), nullptr);  // NOLINT
+}
+
+// NOLINTNEXTLINE
+TEST(TupleTest, VarcharIndexKeyTest) {
+  Schema key_schema{std::vector<Column>{{"b", TypeId::VARCHAR, 20}}};
+  auto key_of = [&](const Value &value) { return Tuple{std::vector<Value>{value}, &key_schema}; };
+
+  // A short string stays in its slot, and "ab" ends its payload exactly at the end of an 8-byte key.
+  for (const auto &value : {ValueFactory::GetVarcharValue(std::string("x")),
+                            ValueFactory::GetVarcharValue(std::string("ab")),
+                            ValueFactory::GetNullValueByType(TypeId::VARCHAR)}) {
+    GenericKey<8> key;
+    key.SetFromKey(key_of(value), key_schema);
+    auto stored = key.ToValue(&key_schema, 0);
+    EXPECT_EQ(stored.IsNull(), value.IsNull());
+    if (!value.IsNull()) {
+      EXPECT_EQ(stored.CompareEquals(value), CmpBool::CmpTrue);
+    }
+  }
+
+  // A payload past the end of the key would be read back out of bounds.
+  auto long_value = ValueFactory::GetVarcharValue(std::string("a longer string"));
+  GenericKey<8> short_key;
+  EXPECT_THROW(short_key.SetFromKey(key_of(long_value), key_schema), Exception);
+  GenericKey<16> medium_key;
+  EXPECT_THROW(medium_key.SetFromKey(key_of(long_value), key_schema), Exception);
+  GenericKey<32> long_key;
+  long_key.SetFromKey(key_of(long_value), key_schema);
+  EXPECT_EQ(long_key.ToValue(&key_schema, 0).ToString(), "a longer string");
+}
+
 }  // namespace bustub
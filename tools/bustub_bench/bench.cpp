@@ -0,0 +1,169 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "fmt/core.h"
+
+#include <unistd.h>
+
+namespace bustub::bench {
+
+auto Registry() -> std::vector<Benchmark> & {
+  static std::vector<Benchmark> registry;
+  return registry;
+}
+
+}  // namespace bustub::bench
+
+/** A benchmark runs at least this long, so that timer and setup noise are small. */
+static const double BUSTUB_BENCH_MIN_TIME_S = 0.5;
+static const uint64_t BUSTUB_BENCH_MAX_ITERATIONS = 1000000000;
+
+struct Result {
+  std::string name_;
+  uint64_t iterations_;
+  double ns_per_iteration_;
+  double items_per_second_;
+};
+
+/**
+ * Run a benchmark with more and more iterations, the way Google Benchmark does: guess from the last run how many
+ * iterations fill the minimum time, and repeat until a run lasts that long.
+ */
+auto RunBenchmark(const bustub::bench::Benchmark &benchmark, int64_t arg, const std::string &name, double min_time_s)
+    -> Result {
+  uint64_t iterations = 1;
+  while (true) {
+    bustub::bench::State state(iterations, arg);
+    benchmark.function_(state);
+    double elapsed_s = state.GetElapsedNs() / 1e9;
+    if (elapsed_s >= min_time_s || iterations >= BUSTUB_BENCH_MAX_ITERATIONS) {
+      return {name, iterations, state.GetElapsedNs() / static_cast<double>(iterations),
+              elapsed_s > 0 ? state.GetItemsProcessed() / elapsed_s : 0};
+    }
+    double multiplier = elapsed_s <= min_time_s / 100 ? 10 : min_time_s * 1.4 / elapsed_s;
+    iterations = std::min(BUSTUB_BENCH_MAX_ITERATIONS,
+                          std::max(iterations + 1, static_cast<uint64_t>(iterations * multiplier)));
+  }
+}
+
+auto ToJson(const std::vector<Result> &results, const std::string &executable) -> std::string {
+  char date[64];
+  auto now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+  char host[256] = "";
+  gethostname(host, sizeof(host) - 1);
+#ifdef NDEBUG
+  const char *build_type = "release";
+#else
+  const char *build_type = "debug";
+#endif
+
+  std::string json = "{\n  \"context\": {\n";
+  json += fmt::format("    \"date\": \"{}\",\n", date);
+  json += fmt::format("    \"host_name\": \"{}\",\n", host);
+  json += fmt::format("    \"executable\": \"{}\",\n", executable);
+  json += fmt::format("    \"num_cpus\": {},\n", sysconf(_SC_NPROCESSORS_ONLN));
+  json += fmt::format("    \"library_build_type\": \"{}\"\n", build_type);
+  json += "  },\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto &result = results[i];
+    json += i == 0 ? "\n" : ",\n";
+    json += "    {\n";
+    json += fmt::format("      \"name\": \"{}\",\n", result.name_);
+    json += fmt::format("      \"iterations\": {},\n", result.iterations_);
+    json += fmt::format("      \"real_time\": {:.3f},\n", result.ns_per_iteration_);
+    json += "      \"time_unit\": \"ns\"";
+    if (result.items_per_second_ > 0) {
+      json += fmt::format(",\n      \"items_per_second\": {:.3f}", result.items_per_second_);
+    }
+    json += "\n    }";
+  }
+  json += "\n  ]\n}\n";
+  return json;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-bench");
+  program.add_argument("--benchmark_filter").help("only run the benchmarks whose name contains this string");
+  program.add_argument("--benchmark_min_time").help("run each benchmark for at least this many seconds");
+  program.add_argument("--benchmark_out").help("write the results as JSON to this file");
+  program.add_argument("--benchmark_format").help("console or json, the format written to stdout");
+  program.add_argument("--benchmark_list_tests")
+      .help("list the benchmarks instead of running them")
+      .default_value(false)
+      .implicit_value(true);
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  std::string filter;
+  if (program.present("--benchmark_filter")) {
+    filter = program.get("--benchmark_filter");
+  }
+  double min_time_s = BUSTUB_BENCH_MIN_TIME_S;
+  if (program.present("--benchmark_min_time")) {
+    min_time_s = std::stod(program.get("--benchmark_min_time"));
+  }
+  bool json_to_stdout = false;
+  if (program.present("--benchmark_format")) {
+    auto format = program.get("--benchmark_format");
+    if (format != "console" && format != "json") {
+      std::cerr << "unknown format: " << format << std::endl;
+      return 1;
+    }
+    json_to_stdout = format == "json";
+  }
+
+  std::vector<Result> results;
+  if (!json_to_stdout && !program.get<bool>("--benchmark_list_tests")) {
+    fmt::print("{:<48} {:>16} {:>12} {:>16}\n", "Benchmark", "Time", "Iterations", "Items/s");
+    fmt::print("{:-<95}\n", "");
+  }
+  for (const auto &benchmark : bustub::bench::Registry()) {
+    auto args = benchmark.args_.empty() ? std::vector<int64_t>{0} : benchmark.args_;
+    for (auto arg : args) {
+      auto name = benchmark.args_.empty() ? benchmark.name_ : fmt::format("{}/{}", benchmark.name_, arg);
+      if (name.find(filter) == std::string::npos) {
+        continue;
+      }
+      if (program.get<bool>("--benchmark_list_tests")) {
+        fmt::print("{}\n", name);
+        continue;
+      }
+      auto result = RunBenchmark(benchmark, arg, name, min_time_s);
+      if (!json_to_stdout) {
+        fmt::print("{:<48} {:>13.0f} ns {:>12} {:>16}\n", result.name_, result.ns_per_iteration_, result.iterations_,
+                   result.items_per_second_ > 0 ? fmt::format("{:.4g}", result.items_per_second_) : "");
+        std::fflush(stdout);
+      }
+      results.push_back(result);
+    }
+  }
+
+  auto json = ToJson(results, argv[0]);
+  if (json_to_stdout) {
+    fmt::print("{}", json);
+  }
+  if (program.present("--benchmark_out")) {
+    std::ofstream out(program.get("--benchmark_out"));
+    out << json;
+    if (!out) {
+      std::cerr << "cannot write " << program.get("--benchmark_out") << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}
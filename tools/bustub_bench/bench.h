@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bustub::bench {
+
+/**
+ * State is handed to a benchmark function. The function sets up its data, then runs the measured operation once per
+ * iteration of `for (auto _ : state)`. Only the loop is timed, and PauseTiming/ResumeTiming exclude work inside it.
+ */
+class State {
+ public:
+  State(uint64_t iterations, int64_t arg) : iterations_(iterations), arg_(arg) {}
+
+  /** The loop variable, which carries nothing. Marked unused so that compilers do not warn about it. */
+  struct [[maybe_unused]] Value {};
+
+  class Iterator {
+   public:
+    Iterator(State *state, uint64_t remaining) : state_(state), remaining_(remaining) {}
+
+    auto operator!=(const Iterator &other) -> bool {
+      if (remaining_ != other.remaining_) {
+        return true;
+      }
+      state_->PauseTiming();
+      return false;
+    }
+
+    auto operator++() -> Iterator & {
+      remaining_--;
+      return *this;
+    }
+
+    auto operator*() const -> Value { return {}; }
+
+   private:
+    State *state_;
+    uint64_t remaining_;
+  };
+
+  auto begin() -> Iterator {  // NOLINT
+    ResumeTiming();
+    return {this, iterations_};
+  }
+  auto end() -> Iterator { return {this, 0}; }  // NOLINT
+
+  void PauseTiming() {
+    if (running_) {
+      elapsed_ += std::chrono::steady_clock::now() - start_;
+      running_ = false;
+    }
+  }
+
+  void ResumeTiming() {
+    if (!running_) {
+      start_ = std::chrono::steady_clock::now();
+      running_ = true;
+    }
+  }
+
+  /** The argument the benchmark is registered with, e.g. a table size. 0 if it has none. */
+  auto Arg() const -> int64_t { return arg_; }
+
+  auto Iterations() const -> uint64_t { return iterations_; }
+
+  /** Report throughput, the number of items (rows, keys, ...) handled by all the iterations. */
+  void SetItemsProcessed(uint64_t items) { items_processed_ = items; }
+
+  auto GetItemsProcessed() const -> uint64_t { return items_processed_; }
+
+  auto GetElapsedNs() const -> uint64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed_).count();
+  }
+
+ private:
+  uint64_t iterations_;
+  int64_t arg_;
+  uint64_t items_processed_{0};
+  bool running_{false};
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::duration elapsed_{0};
+};
+
+using BenchmarkFunction = void (*)(State &);
+
+/** A benchmark function, run once for each of its arguments. */
+struct Benchmark {
+  std::string name_;
+  BenchmarkFunction function_;
+  std::vector<int64_t> args_;
+};
+
+auto Registry() -> std::vector<Benchmark> &;
+
+struct Registrar {
+  Registrar(const char *name, BenchmarkFunction function, std::vector<int64_t> args) {
+    Registry().push_back({name, function, std::move(args)});
+  }
+};
+
+/** Keep the compiler from optimizing away a value that is computed but never used. */
+template <class T>
+inline void DoNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");  // NOLINT
+}
+
+}  // namespace bustub::bench
+
+/** Register a benchmark function, optionally with the arguments to run it with. */
+#define BUSTUB_BENCHMARK(function, ...) \
+  static ::bustub::bench::Registrar function##_registrar(#function, function, {__VA_ARGS__})  // NOLINT
@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "catalog/schema.h"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "fmt/core.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace bustub::bench {
+
+/** The rows of the table the joins probe, small enough for a nested loop join. */
+static const int64_t BENCH_INNER_ROWS = 100;
+
+auto ExpressionSchema() -> Schema { return Schema({Column("a", TypeId::INTEGER), Column("b", TypeId::INTEGER)}); }
+
+void BM_ExpressionComparison(State &state) {
+  auto schema = ExpressionSchema();
+  Tuple tuple({ValueFactory::GetIntegerValue(1), ValueFactory::GetIntegerValue(2)}, &schema);
+  ComparisonExpression expr(std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER),
+                            std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(5)),
+                            ComparisonType::LessThan);
+  for (auto _ : state) {
+    auto value = expr.Evaluate(&tuple, schema);
+    DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_ExpressionComparison);
+
+void BM_ExpressionArithmetic(State &state) {
+  auto schema = ExpressionSchema();
+  Tuple tuple({ValueFactory::GetIntegerValue(1), ValueFactory::GetIntegerValue(2)}, &schema);
+  ArithmeticExpression expr(std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER),
+                            std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER), ArithmeticType::Plus);
+  for (auto _ : state) {
+    auto value = expr.Evaluate(&tuple, schema);
+    DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_ExpressionArithmetic);
+
+/** a < 5 AND b > 1, the shape of a typical range predicate. */
+void BM_ExpressionLogic(State &state) {
+  auto schema = ExpressionSchema();
+  Tuple tuple({ValueFactory::GetIntegerValue(1), ValueFactory::GetIntegerValue(2)}, &schema);
+  auto left = std::make_shared<ComparisonExpression>(
+      std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER),
+      std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(5)), ComparisonType::LessThan);
+  auto right = std::make_shared<ComparisonExpression>(
+      std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER),
+      std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(1)), ComparisonType::GreaterThan);
+  LogicExpression expr(left, right, LogicType::And);
+  for (auto _ : state) {
+    auto value = expr.Evaluate(&tuple, schema);
+    DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_ExpressionLogic);
+
+/** Execute a statement in its own transaction, and give up on the benchmark if it fails. */
+void ExecuteOrDie(BustubInstance *bustub, const std::string &sql, SessionVariables *variables = nullptr) {
+  NoopWriter writer;
+  auto *txn = bustub->txn_manager_->Begin();
+  try {
+    if (!bustub->ExecuteSqlTxn(sql, writer, txn, variables)) {
+      throw Exception("the query failed");
+    }
+  } catch (const Exception &ex) {
+    std::cerr << "unexpected failure when executing \"" << sql.substr(0, 64) << "\": " << ex.what() << std::endl;
+    exit(1);
+  }
+  bustub->txn_manager_->Commit(txn);
+  delete txn;
+}
+
+/**
+ * An instance with t(a, b, c) of the given number of rows, indexed on a, and u(a, b) of BENCH_INNER_ROWS rows. Loading
+ * is slow next to the queries, so the instances are shared by all the runs of all the executor benchmarks.
+ */
+auto ExecutorDatabase(int64_t rows) -> BustubInstance * {
+  static std::map<int64_t, std::unique_ptr<BustubInstance>> instances;
+  auto &bustub = instances[rows];
+  if (bustub != nullptr) {
+    return bustub.get();
+  }
+  bustub = std::make_unique<BustubInstance>();
+  ExecuteOrDie(bustub.get(), "CREATE TABLE t(a int, b int, c varchar(32));");
+  ExecuteOrDie(bustub.get(), "CREATE INDEX t_a ON t(a);");
+  ExecuteOrDie(bustub.get(), "CREATE TABLE u(a int, b int);");
+  for (int64_t begin = 0; begin < rows; begin += 1000) {
+    std::string sql = "INSERT INTO t VALUES ";
+    for (int64_t i = begin; i < std::min(rows, begin + 1000); i++) {
+      sql += fmt::format("{}({}, {}, 'bustub benchmark row')", i == begin ? "" : ", ", i, i % 100);
+    }
+    ExecuteOrDie(bustub.get(), sql);
+  }
+  std::string sql = "INSERT INTO u VALUES ";
+  for (int64_t i = 0; i < BENCH_INNER_ROWS; i++) {
+    sql += fmt::format("{}({}, {})", i == 0 ? "" : ", ", i * (rows / BENCH_INNER_ROWS), i);
+  }
+  ExecuteOrDie(bustub.get(), sql);
+  return bustub.get();
+}
+
+/**
+ * Run a query once per iteration, reporting the rows of t as the items processed. The plan cache keeps parsing and
+ * planning out of all but the first iteration, so this measures the executors.
+ */
+void RunQuery(State &state, const std::string &sql, bool force_starter_rule = false) {
+  auto *bustub = ExecutorDatabase(state.Arg());
+  SessionVariables variables;
+  if (force_starter_rule) {
+    variables["force_optimizer_starter_rule"] = "yes";
+  }
+  for (auto _ : state) {
+    ExecuteOrDie(bustub, sql, &variables);
+  }
+  state.SetItemsProcessed(state.Iterations() * state.Arg());
+}
+
+void BM_ExecutorSeqScan(State &state) { RunQuery(state, "SELECT a, b, c FROM t"); }
+BUSTUB_BENCHMARK(BM_ExecutorSeqScan, 1000, 10000);
+
+/** The starter rules leave the filter above the scan instead of evaluating it in the scan. */
+void BM_ExecutorFilter(State &state) { RunQuery(state, "SELECT a FROM t WHERE b < 10", true); }
+BUSTUB_BENCHMARK(BM_ExecutorFilter, 1000, 10000);
+
+void BM_ExecutorScanPredicate(State &state) { RunQuery(state, "SELECT a FROM t WHERE b < 10"); }
+BUSTUB_BENCHMARK(BM_ExecutorScanPredicate, 1000, 10000);
+
+void BM_ExecutorProjection(State &state) { RunQuery(state, "SELECT a + b, b - 2 FROM t"); }
+BUSTUB_BENCHMARK(BM_ExecutorProjection, 1000, 10000);
+
+void BM_ExecutorIndexScan(State &state) { RunQuery(state, "SELECT a, b FROM t ORDER BY a"); }
+BUSTUB_BENCHMARK(BM_ExecutorIndexScan, 1000, 10000);
+
+/** Every lookup is a new statement to parse and plan, as a client without prepared statements sends them. */
+void BM_ExecutorIndexPointLookup(State &state) {
+  auto *bustub = ExecutorDatabase(state.Arg());
+  int64_t i = 0;
+  for (auto _ : state) {
+    ExecuteOrDie(bustub, fmt::format("SELECT b FROM t WHERE a = {}", i++ % state.Arg()));
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_ExecutorIndexPointLookup, 10000);
+
+void BM_ExecutorAggregation(State &state) { RunQuery(state, "SELECT b, count(*), sum(a), max(a) FROM t GROUP BY b"); }
+BUSTUB_BENCHMARK(BM_ExecutorAggregation, 1000, 10000);
+
+/** One group per row of t, read in key order from the index, so only the current group is kept. */
+void BM_ExecutorStreamAggregation(State &state) {
+  RunQuery(state, "SELECT a, count(*), sum(b) FROM (SELECT * FROM t ORDER BY a) AS s GROUP BY a");
+}
+BUSTUB_BENCHMARK(BM_ExecutorStreamAggregation, 10000, 100000);
+
+/** The same groups in the same order, but the starter rules hash all of them. */
+void BM_ExecutorHashAggregationSortedInput(State &state) {
+  RunQuery(state, "SELECT a, count(*), sum(b) FROM (SELECT * FROM t ORDER BY a) AS s GROUP BY a", true);
+}
+BUSTUB_BENCHMARK(BM_ExecutorHashAggregationSortedInput, 10000, 100000);
+
+void BM_ExecutorSort(State &state) { RunQuery(state, "SELECT a, b FROM t ORDER BY b, a DESC"); }
+BUSTUB_BENCHMARK(BM_ExecutorSort, 1000, 10000);
+
+/** Once the heap is full, the scan skips the tuples that cannot enter it without copying them out. */
+void BM_ExecutorTopN(State &state) { RunQuery(state, "SELECT a, b FROM t ORDER BY b, a DESC LIMIT 10"); }
+BUSTUB_BENCHMARK(BM_ExecutorTopN, 1000, 10000, 100000);
+
+/** The starter rules leave the projection between the top-N and the scan, so every tuple reaches the heap. */
+void BM_ExecutorTopNStarterRules(State &state) {
+  RunQuery(state, "SELECT a, b FROM t ORDER BY b, a DESC LIMIT 10", true);
+}
+BUSTUB_BENCHMARK(BM_ExecutorTopNStarterRules, 10000, 100000);
+
+/** The index scan stops after the first 10 keys instead of feeding the whole table to a top-N. */
+void BM_ExecutorBoundedIndexScan(State &state) { RunQuery(state, "SELECT a, b FROM t ORDER BY a LIMIT 10"); }
+BUSTUB_BENCHMARK(BM_ExecutorBoundedIndexScan, 10000, 100000);
+
+void BM_ExecutorBoundedIndexScanStarterRules(State &state) {
+  RunQuery(state, "SELECT a, b FROM t ORDER BY a LIMIT 10", true);
+}
+BUSTUB_BENCHMARK(BM_ExecutorBoundedIndexScanStarterRules, 10000, 100000);
+
+/** The limit stops the scan early, so the rows of t are not a fair count of items here. */
+void BM_ExecutorLimit(State &state) {
+  RunQuery(state, "SELECT a FROM t LIMIT 10");
+  state.SetItemsProcessed(state.Iterations() * 10);
+}
+BUSTUB_BENCHMARK(BM_ExecutorLimit, 10000);
+
+void BM_ExecutorNestedLoopJoin(State &state) { RunQuery(state, "SELECT t.a, u.b FROM t INNER JOIN u ON t.b < u.b"); }
+BUSTUB_BENCHMARK(BM_ExecutorNestedLoopJoin, 1000);
+
+/** A non-equi join against a filtered scan, which the join reads only once. */
+void BM_ExecutorNestedLoopJoinFilteredInner(State &state) {
+  RunQuery(state, "SELECT t.a, u.b FROM t INNER JOIN u ON t.b > u.b AND u.b < 50");
+}
+BUSTUB_BENCHMARK(BM_ExecutorNestedLoopJoinFilteredInner, 1000);
+
+void BM_ExecutorNestedLoopLeftJoin(State &state) {
+  RunQuery(state, "SELECT t.a, u.b FROM t LEFT OUTER JOIN u ON t.b + 50 < u.b");
+}
+BUSTUB_BENCHMARK(BM_ExecutorNestedLoopLeftJoin, 1000);
+
+void BM_ExecutorHashJoin(State &state) { RunQuery(state, "SELECT t.a, u.b FROM t INNER JOIN u ON t.b = u.b"); }
+BUSTUB_BENCHMARK(BM_ExecutorHashJoin, 1000, 10000);
+
+/** Both sides come sorted by the join key, t from its index and u from a sort, so the join merges them. */
+void BM_ExecutorMergeJoin(State &state) {
+  RunQuery(state,
+           "SELECT x.a, y.b FROM (SELECT * FROM t ORDER BY a) AS x INNER JOIN (SELECT * FROM u ORDER BY a) AS y "
+           "ON x.a = y.a");
+}
+BUSTUB_BENCHMARK(BM_ExecutorMergeJoin, 1000, 10000);
+
+/** The same inputs, except that u is sorted the other way round, which leaves the join to a hash join. */
+void BM_ExecutorHashJoinSortedInputs(State &state) {
+  RunQuery(state,
+           "SELECT x.a, y.b FROM (SELECT * FROM t ORDER BY a) AS x INNER JOIN (SELECT * FROM u ORDER BY a DESC) AS y "
+           "ON x.a = y.a");
+}
+BUSTUB_BENCHMARK(BM_ExecutorHashJoinSortedInputs, 1000, 10000);
+
+/** A correlated EXISTS, decorrelated into a hash semi join that outputs each row of t at most once. */
+void BM_ExecutorSemiJoin(State &state) {
+  RunQuery(state, "SELECT t.a FROM t WHERE EXISTS (SELECT * FROM u WHERE u.b = t.b)");
+}
+BUSTUB_BENCHMARK(BM_ExecutorSemiJoin, 1000, 10000);
+
+void BM_ExecutorAntiJoin(State &state) { RunQuery(state, "SELECT t.a FROM t WHERE t.a NOT IN (SELECT u.a FROM u)"); }
+BUSTUB_BENCHMARK(BM_ExecutorAntiJoin, 1000, 10000);
+
+/** Probe the index on t.a for each row of u. */
+void BM_ExecutorNestedIndexJoin(State &state) {
+  RunQuery(state, "SELECT u.b, t.c FROM u INNER JOIN t ON u.a = t.a", true);
+  state.SetItemsProcessed(state.Iterations() * BENCH_INNER_ROWS);
+}
+BUSTUB_BENCHMARK(BM_ExecutorNestedIndexJoin, 10000);
+
+/** Insert a row through the values executor, maintaining the index on t.a. */
+void BM_ExecutorInsert(State &state) {
+  auto *bustub = ExecutorDatabase(state.Arg());
+  int64_t i = 0;
+  for (auto _ : state) {
+    ExecuteOrDie(bustub, fmt::format("INSERT INTO t VALUES ({}, 0, 'inserted row')", state.Arg() + i++));
+  }
+  state.SetItemsProcessed(state.Iterations());
+  ExecuteOrDie(bustub, fmt::format("DELETE FROM t WHERE a >= {}", state.Arg()));
+}
+BUSTUB_BENCHMARK(BM_ExecutorInsert, 1000);
+
+/** Insert a row and delete it again, so that the table keeps its size. */
+void BM_ExecutorDelete(State &state) {
+  auto *bustub = ExecutorDatabase(state.Arg());
+  int64_t key = state.Arg();
+  for (auto _ : state) {
+    state.PauseTiming();
+    ExecuteOrDie(bustub, fmt::format("INSERT INTO t VALUES ({}, 0, 'deleted row')", key));
+    state.ResumeTiming();
+    ExecuteOrDie(bustub, fmt::format("DELETE FROM t WHERE a = {}", key));
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_ExecutorDelete, 1000);
+
+/**
+ * Copy a table into one with three indexes: ascending, descending, and scattered keys. The statement maintains every
+ * index for all the rows it inserts, and the copy is emptied again between iterations.
+ */
+void BM_ExecutorBulkInsertSelect(State &state) {
+  BustubInstance bustub;
+  ExecuteOrDie(&bustub, "CREATE TABLE src(a int, b int, c int);");
+  ExecuteOrDie(&bustub, "CREATE TABLE dst(a int, b int, c int);");
+  ExecuteOrDie(&bustub, "CREATE INDEX dst_a ON dst(a);");
+  ExecuteOrDie(&bustub, "CREATE INDEX dst_b ON dst(b);");
+  ExecuteOrDie(&bustub, "CREATE INDEX dst_c ON dst(c);");
+  for (int64_t begin = 0; begin < state.Arg(); begin += 1000) {
+    std::string sql = "INSERT INTO src VALUES ";
+    for (int64_t i = begin; i < std::min(state.Arg(), begin + 1000); i++) {
+      sql += fmt::format("{}({}, {}, {})", i == begin ? "" : ", ", i, state.Arg() - i, (i * 7919) % state.Arg());
+    }
+    ExecuteOrDie(&bustub, sql);
+  }
+  for (auto _ : state) {
+    ExecuteOrDie(&bustub, "INSERT INTO dst SELECT a, b, c FROM src");
+    state.PauseTiming();
+    ExecuteOrDie(&bustub, "DELETE FROM dst");
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.Iterations() * state.Arg());
+}
+BUSTUB_BENCHMARK(BM_ExecutorBulkInsertSelect, 10000);
+
+}  // namespace bustub::bench
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/lru_k_replacer.h"
+#include "catalog/schema.h"
+#include "concurrency/transaction.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/index/generic_key.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace bustub::bench {
+
+using BenchTree = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+/** A buffer pool on an in-memory disk, with the header page the B+ trees keep their roots in already allocated. */
+struct BenchBufferPool {
+  explicit BenchBufferPool(size_t pool_size)
+      : disk_manager_(std::make_unique<DiskManagerUnlimitedMemory>()),
+        bpm_(std::make_unique<BufferPoolManagerInstance>(pool_size, disk_manager_.get())) {
+    page_id_t header_page_id;
+    bpm_->NewPageGuarded(&header_page_id);
+  }
+
+  std::unique_ptr<DiskManagerUnlimitedMemory> disk_manager_;
+  std::unique_ptr<BufferPoolManagerInstance> bpm_;
+};
+
+auto BenchSchema() -> Schema {
+  return Schema({Column("a", TypeId::INTEGER), Column("b", TypeId::BIGINT), Column("c", TypeId::VARCHAR, 32)});
+}
+
+auto BenchTuple(int32_t i, const Schema *schema) -> Tuple {
+  return Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetBigIntValue(i * 7L),
+                ValueFactory::GetVarcharValue("bustub benchmark tuple")},
+               schema);
+}
+
+/** Fetch and unpin pages already in the pool when arg is smaller than the pool, forcing evictions otherwise. */
+void BM_BufferPoolFetchUnpin(State &state) {
+  const size_t pool_size = 64;
+  BenchBufferPool pool(pool_size);
+  std::vector<page_id_t> page_ids(state.Arg());
+  for (auto &page_id : page_ids) {
+    pool.bpm_->NewPage(&page_id);
+    pool.bpm_->UnpinPage(page_id, true);
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    auto page_id = page_ids[i++ % page_ids.size()];
+    auto *page = pool.bpm_->FetchPage(page_id);
+    DoNotOptimize(page);
+    pool.bpm_->UnpinPage(page_id, false);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_BufferPoolFetchUnpin, 32, 256);
+
+void BM_BufferPoolReadGuard(State &state) {
+  BenchBufferPool pool(64);
+  page_id_t page_id;
+  pool.bpm_->NewPage(&page_id);
+  pool.bpm_->UnpinPage(page_id, true);
+  for (auto _ : state) {
+    auto guard = pool.bpm_->FetchPageRead(page_id);
+    DoNotOptimize(guard.GetData());
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_BufferPoolReadGuard);
+
+/** Access frames round robin, as a buffer pool hit does. */
+void BM_LRUKReplacerRecordAccess(State &state) {
+  const size_t frames = 1024;
+  LRUKReplacer replacer(frames, 10);
+  for (size_t frame = 0; frame < frames; frame++) {
+    replacer.RecordAccess(frame);
+    replacer.SetEvictable(frame, true);
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    replacer.RecordAccess(i++ % frames);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_LRUKReplacerRecordAccess);
+
+/** Evict a frame and bring it back, as a buffer pool miss does. */
+void BM_LRUKReplacerEvict(State &state) {
+  const size_t frames = 1024;
+  LRUKReplacer replacer(frames, 2);
+  for (size_t frame = 0; frame < frames; frame++) {
+    replacer.RecordAccess(frame);
+    replacer.SetEvictable(frame, true);
+  }
+  for (auto _ : state) {
+    frame_id_t frame;
+    replacer.Evict(&frame);
+    replacer.RecordAccess(frame);
+    replacer.SetEvictable(frame, true);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_LRUKReplacerEvict);
+
+/** Insert keys in random order into a growing tree. */
+void BM_BPlusTreeInsert(State &state) {
+  BenchBufferPool pool(1024);
+  Schema key_schema({Column("k", TypeId::BIGINT)});
+  BenchTree tree("bench_pk", pool.bpm_.get(), GenericComparator<8>(&key_schema));
+  std::vector<int64_t> keys(state.Iterations());
+  for (size_t i = 0; i < keys.size(); i++) {
+    keys[i] = i;
+  }
+  std::shuffle(keys.begin(), keys.end(), std::default_random_engine(0));
+  Transaction txn(0);
+  size_t i = 0;
+  for (auto _ : state) {
+    GenericKey<8> key;
+    key.SetFromInteger(keys[i]);
+    tree.Insert(key, RID(keys[i] >> 32, keys[i]), &txn);
+    i++;
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_BPlusTreeInsert);
+
+auto BuildTree(BenchBufferPool *pool, Schema *key_schema, int64_t keys) -> std::unique_ptr<BenchTree> {
+  auto tree = std::make_unique<BenchTree>("bench_pk", pool->bpm_.get(), GenericComparator<8>(key_schema));
+  Transaction txn(0);
+  for (int64_t i = 0; i < keys; i++) {
+    GenericKey<8> key;
+    key.SetFromInteger(i);
+    tree->Insert(key, RID(i >> 32, i), &txn);
+  }
+  return tree;
+}
+
+void BM_BPlusTreeLookup(State &state) {
+  BenchBufferPool pool(1024);
+  Schema key_schema({Column("k", TypeId::BIGINT)});
+  auto tree = BuildTree(&pool, &key_schema, state.Arg());
+  std::default_random_engine gen(0);
+  std::uniform_int_distribution<int64_t> key_dist(0, state.Arg() - 1);
+  std::vector<RID> result;
+  for (auto _ : state) {
+    GenericKey<8> key;
+    key.SetFromInteger(key_dist(gen));
+    result.clear();
+    tree->GetValue(key, &result);
+    DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_BPlusTreeLookup, 1000, 10000);
+
+void BM_BPlusTreeScan(State &state) {
+  BenchBufferPool pool(1024);
+  Schema key_schema({Column("k", TypeId::BIGINT)});
+  auto tree = BuildTree(&pool, &key_schema, state.Arg());
+  for (auto _ : state) {
+    for (auto iter = tree->Begin(); !iter.IsEnd(); ++iter) {
+      DoNotOptimize((*iter).second);
+    }
+  }
+  state.SetItemsProcessed(state.Iterations() * state.Arg());
+}
+BUSTUB_BENCHMARK(BM_BPlusTreeScan, 1000, 10000);
+
+void BM_TableHeapInsert(State &state) {
+  BenchBufferPool pool(1024);
+  auto schema = BenchSchema();
+  auto tuple = BenchTuple(1, &schema);
+  Transaction txn(0);
+  TableHeap table(pool.bpm_.get(), nullptr, nullptr, &txn);
+  for (auto _ : state) {
+    RID rid;
+    table.InsertTuple(tuple, &rid, &txn);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_TableHeapInsert);
+
+void BM_TableHeapScan(State &state) {
+  BenchBufferPool pool(1024);
+  auto schema = BenchSchema();
+  Transaction txn(0);
+  TableHeap table(pool.bpm_.get(), nullptr, nullptr, &txn);
+  for (int64_t i = 0; i < state.Arg(); i++) {
+    RID rid;
+    table.InsertTuple(BenchTuple(i, &schema), &rid, &txn);
+  }
+  for (auto _ : state) {
+    for (auto iter = table.Begin(&txn); iter != table.End(); ++iter) {
+      DoNotOptimize(iter->GetRid());
+    }
+  }
+  state.SetItemsProcessed(state.Iterations() * state.Arg());
+}
+BUSTUB_BENCHMARK(BM_TableHeapScan, 1000, 10000);
+
+void BM_TupleConstruct(State &state) {
+  auto schema = BenchSchema();
+  std::vector<Value> values{ValueFactory::GetIntegerValue(1), ValueFactory::GetBigIntValue(7),
+                            ValueFactory::GetVarcharValue("bustub benchmark tuple")};
+  for (auto _ : state) {
+    Tuple tuple(values, &schema);
+    DoNotOptimize(tuple.GetData());
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_TupleConstruct);
+
+void BM_TupleGetValue(State &state) {
+  auto schema = BenchSchema();
+  auto tuple = BenchTuple(1, &schema);
+  for (auto _ : state) {
+    auto value = tuple.GetValue(&schema, 2);
+    DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_TupleGetValue);
+
+/** Serialize a tuple into a buffer and read it back, as the table pages and the log do. */
+void BM_TupleSerialize(State &state) {
+  auto schema = BenchSchema();
+  auto tuple = BenchTuple(1, &schema);
+  std::vector<char> buffer(tuple.GetLength() + sizeof(uint32_t));
+  for (auto _ : state) {
+    tuple.SerializeTo(buffer.data());
+    Tuple copy;
+    copy.DeserializeFrom(buffer.data());
+    DoNotOptimize(copy.GetData());
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BUSTUB_BENCHMARK(BM_TupleSerialize);
+
+}  // namespace bustub::bench
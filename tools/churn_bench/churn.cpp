@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "argparse/argparse.hpp"
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/catalog.h"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "fmt/core.h"
+#include "storage/page/table_page.h"
+
+#include <sys/time.h>
+
+auto ClockMs() -> uint64_t {
+  struct timeval tm;
+  gettimeofday(&tm, nullptr);
+  return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
+}
+
+static const size_t BUSTUB_CHURN_ROWS = 20000;
+static const size_t BUSTUB_CHURN_BATCH = 1000;
+static const size_t BUSTUB_CHURN_SCAN_CNT = 20;
+
+auto ExecuteOrDie(bustub::BustubInstance *bustub, const std::string &query) -> std::string {
+  std::stringstream ss;
+  auto writer = bustub::SimpleStreamWriter(ss, true);
+  auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
+  if (!bustub->ExecuteSqlTxn(query, writer, txn)) {
+    fmt::print("unexpected failure when executing \"{}\"\n", query.substr(0, 64));
+    exit(1);
+  }
+  bustub->txn_manager_->Commit(txn);
+  delete txn;
+  return ss.str();
+}
+
+auto CountTablePages(bustub::BustubInstance *bustub, const std::string &table_name) -> size_t {
+  size_t page_cnt = 0;
+  auto page_id = bustub->catalog_->GetTable(table_name)->table_->GetFirstPageId();
+  while (page_id != bustub::INVALID_PAGE_ID) {
+    auto page = static_cast<bustub::TablePage *>(bustub->buffer_pool_manager_->FetchPage(page_id));
+    page->RLatch();
+    auto next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    bustub->buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+    page_cnt++;
+  }
+  return page_cnt;
+}
+
+void Report(bustub::BustubInstance *bustub, const std::string &phase) {
+  auto pages = CountTablePages(bustub, "churn");
+  std::string count;
+  auto start = ClockMs();
+  for (size_t i = 0; i < BUSTUB_CHURN_SCAN_CNT; i++) {
+    count = ExecuteOrDie(bustub, "SELECT count(*) FROM churn");
+  }
+  auto elapsed = ClockMs() - start;
+  fmt::print("{}: rows={} pages={} scan_ms={:.3}\n", phase, count.substr(0, count.find('\t')), pages,
+             elapsed / static_cast<double>(BUSTUB_CHURN_SCAN_CNT));
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-churn-bench");
+  program.add_argument("--rows").help("number of rows to load");
+  program.add_argument("--keep-every").help("keep one row out of n, delete the others");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t rows = BUSTUB_CHURN_ROWS;
+  if (program.present("--rows")) {
+    rows = std::stoi(program.get("--rows"));
+  }
+  size_t keep_every = 8;
+  if (program.present("--keep-every")) {
+    keep_every = std::stoi(program.get("--keep-every"));
+  }
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+
+  std::cerr << "x: create schema" << std::endl;
+  ExecuteOrDie(bustub.get(), "CREATE TABLE churn(id int, payload varchar(128));");
+  ExecuteOrDie(bustub.get(), "CREATE INDEX churnid on churn(id);");
+
+  std::cerr << "x: load " << rows << " rows" << std::endl;
+  for (size_t begin = 0; begin < rows; begin += BUSTUB_CHURN_BATCH) {
+    std::string query = "INSERT INTO churn VALUES ";
+    for (size_t i = begin; i < std::min(rows, begin + BUSTUB_CHURN_BATCH); i++) {
+      if (i != begin) {
+        query += ", ";
+      }
+      // Neighbouring rows get ids that are far apart, so that a range delete leaves holes all over the table.
+      auto id = (i % keep_every) * rows + i / keep_every;
+      query += fmt::format("({}, '{}')", id, std::string(16 + i % 64, 'a' + i % 26));
+    }
+    ExecuteOrDie(bustub.get(), query);
+  }
+  Report(bustub.get(), "loaded");
+
+  std::cerr << "x: delete all but one row out of " << keep_every << std::endl;
+  ExecuteOrDie(bustub.get(), fmt::format("DELETE FROM churn WHERE id >= {}", rows));
+  Report(bustub.get(), "churned");
+
+  std::cerr << "x: vacuum" << std::endl;
+  auto start = ClockMs();
+  std::cerr << ExecuteOrDie(bustub.get(), "\\vacuum churn");
+  fmt::print("vacuum_ms={}\n", ClockMs() - start);
+  Report(bustub.get(), "vacuumed");
+
+  // Every surviving row must still be reachable after it has been moved.
+  auto last_id = (rows - 1) / keep_every;
+  auto probe = ExecuteOrDie(bustub.get(), fmt::format("SELECT id FROM churn WHERE id = {}", last_id));
+  if (probe != fmt::format("{}\t\n", last_id)) {
+    fmt::print("index lookup failed after vacuum\n");
+    exit(1);
+  }
+
+  return 0;
+}
@@ -0,0 +1,146 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "catalog/catalog.h"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "fmt/core.h"
+#include "type/value_factory.h"
+
+#include <sys/time.h>
+
+auto ClockMs() -> uint64_t {
+  struct timeval tm;
+  gettimeofday(&tm, nullptr);
+  return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
+}
+
+static const size_t BUSTUB_LOOKUP_ROWS = 10000;
+static const size_t BUSTUB_LOOKUP_BATCH = 1000;
+static const size_t BUSTUB_LOOKUP_CNT = 2000;
+
+auto ExecuteOrDie(bustub::BustubInstance *bustub, const std::string &query) -> std::string {
+  std::stringstream ss;
+  auto writer = bustub::SimpleStreamWriter(ss, true);
+  auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
+  if (!bustub->ExecuteSqlTxn(query, writer, txn)) {
+    fmt::print("unexpected failure when executing \"{}\"\n", query.substr(0, 64));
+    exit(1);
+  }
+  bustub->txn_manager_->Commit(txn);
+  delete txn;
+  return ss.str();
+}
+
+void Load(bustub::BustubInstance *bustub, const std::string &table, const std::string &index_type, size_t rows) {
+  ExecuteOrDie(bustub, fmt::format("CREATE TABLE {}(id int, payload int);", table));
+  ExecuteOrDie(bustub, fmt::format("CREATE INDEX {}_id ON {} USING {} (id);", table, table, index_type));
+  for (size_t begin = 0; begin < rows; begin += BUSTUB_LOOKUP_BATCH) {
+    std::string query = fmt::format("INSERT INTO {} VALUES ", table);
+    for (size_t i = begin; i < std::min(rows, begin + BUSTUB_LOOKUP_BATCH); i++) {
+      if (i != begin) {
+        query += ", ";
+      }
+      query += fmt::format("({}, {})", i, i * 7);
+    }
+    ExecuteOrDie(bustub, query);
+  }
+}
+
+/** Point lookups through SQL, which go through the binder, planner and optimizer every time. */
+void MeasureSql(bustub::BustubInstance *bustub, const std::string &table, const std::vector<size_t> &keys) {
+  auto plan = ExecuteOrDie(bustub, fmt::format("EXPLAIN SELECT * FROM {} WHERE id = 0", table));
+  if (plan.find("IndexScan") == std::string::npos) {
+    fmt::print("{}: the point lookup is not planned as an index scan\n", table);
+    exit(1);
+  }
+  auto start = ClockMs();
+  for (auto key : keys) {
+    ExecuteOrDie(bustub, fmt::format("SELECT * FROM {} WHERE id = {}", table, key));
+  }
+  auto elapsed = ClockMs() - start;
+  fmt::print("{}_sql: lookup_ms={:.4} lookups_per_sec={:.0f}\n", table, elapsed / static_cast<double>(keys.size()),
+             static_cast<double>(keys.size()) / std::max<uint64_t>(elapsed, 1) * 1000);
+}
+
+/** Point lookups straight on the index, which is what the access method itself costs. */
+void MeasureIndex(bustub::BustubInstance *bustub, const std::string &table, const std::vector<size_t> &keys,
+                  size_t repeat) {
+  auto *index_info = bustub->catalog_->GetIndex(table + "_id", table);
+  const auto &key_schema = index_info->key_schema_;
+  auto *txn = bustub->txn_manager_->Begin();
+  std::vector<bustub::RID> result;
+  size_t found = 0;
+  auto start = ClockMs();
+  for (size_t i = 0; i < repeat; i++) {
+    for (auto key : keys) {
+      result.clear();
+      index_info->index_->ScanKey(bustub::Tuple({bustub::ValueFactory::GetIntegerValue(key)}, &key_schema), &result,
+                                  txn);
+      found += result.size();
+    }
+  }
+  auto elapsed = ClockMs() - start;
+  bustub->txn_manager_->Commit(txn);
+  delete txn;
+  if (found != keys.size() * repeat) {
+    fmt::print("{}: found {} of {} keys\n", table, found, keys.size() * repeat);
+    exit(1);
+  }
+  fmt::print("{}_index: lookups_per_sec={:.0f}\n", table,
+             static_cast<double>(keys.size() * repeat) / std::max<uint64_t>(elapsed, 1) * 1000);
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-hash-index-bench");
+  program.add_argument("--rows").help("number of rows to load into each table");
+  program.add_argument("--lookups").help("number of point lookups per table");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t rows = BUSTUB_LOOKUP_ROWS;
+  if (program.present("--rows")) {
+    rows = std::stoi(program.get("--rows"));
+  }
+  size_t lookups = BUSTUB_LOOKUP_CNT;
+  if (program.present("--lookups")) {
+    lookups = std::stoi(program.get("--lookups"));
+  }
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+
+  std::cerr << "x: load " << rows << " rows into each table" << std::endl;
+  Load(bustub.get(), "lookup_btree", "btree", rows);
+  Load(bustub.get(), "lookup_hash", "hash", rows);
+
+  // Both tables see the same keys in the same order.
+  std::mt19937 gen(15445);
+  std::uniform_int_distribution<size_t> dis(0, rows - 1);
+  std::vector<size_t> keys(lookups);
+  for (auto &key : keys) {
+    key = dis(gen);
+  }
+
+  std::cerr << "x: benchmark start" << std::endl;
+  MeasureSql(bustub.get(), "lookup_btree", keys);
+  MeasureSql(bustub.get(), "lookup_hash", keys);
+  MeasureIndex(bustub.get(), "lookup_btree", keys, 50);
+  MeasureIndex(bustub.get(), "lookup_hash", keys, 50);
+
+  return 0;
+}
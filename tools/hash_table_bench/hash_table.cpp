@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "catalog/schema.h"
+#include "container/disk/hash/linear_probe_hash_table.h"
+#include "fmt/core.h"
+#include "storage/disk/disk_manager.h"
+#include "storage/index/generic_key.h"
+
+#include <sys/time.h>
+
+auto ClockMs() -> uint64_t {
+  struct timeval tm;
+  gettimeofday(&tm, nullptr);
+  return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
+}
+
+static const size_t BUSTUB_HT_POOL_SIZE = 64;
+static const size_t BUSTUB_HT_KEYS = 200000;
+static const size_t BUSTUB_HT_PHASES = 10;
+static const size_t BUSTUB_HT_LOOKUPS = 20000;
+
+using KeyType = bustub::GenericKey<8>;
+using ValueType = bustub::RID;
+using HashTable = bustub::LinearProbeHashTable<KeyType, ValueType, bustub::GenericComparator<8>>;
+
+auto MakeKey(int64_t i) -> KeyType {
+  KeyType key;
+  key.SetFromInteger(i);
+  return key;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-hash-table-bench");
+  program.add_argument("--keys").help("number of keys to insert");
+  program.add_argument("--pool-size").help("number of frames in the buffer pool");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t keys = BUSTUB_HT_KEYS;
+  if (program.present("--keys")) {
+    keys = std::stoi(program.get("--keys"));
+  }
+  size_t pool_size = BUSTUB_HT_POOL_SIZE;
+  if (program.present("--pool-size")) {
+    pool_size = std::stoi(program.get("--pool-size"));
+  }
+
+  // A real file, so that pages evicted from the small pool actually go to disk and come back.
+  const std::string db_file = "hash_table_bench.db";
+  const std::string log_file = "hash_table_bench.log";
+  auto disk_manager = std::make_unique<bustub::DiskManager>(db_file);
+  auto bpm = std::make_unique<bustub::BufferPoolManagerInstance>(pool_size, disk_manager.get());
+  bustub::Schema key_schema({bustub::Column("key", bustub::TypeId::BIGINT)});
+
+  {
+    HashTable ht("bench", bpm.get(), bustub::GenericComparator<8>(&key_schema), 1000,
+                 bustub::HashFunction<KeyType>());
+    std::mt19937 gen(15445);
+    std::cerr << "x: insert " << keys << " keys into a pool of " << pool_size << " frames" << std::endl;
+
+    // Insert the keys in phases, and after each phase look up random keys that are in the table by now.
+    auto phase_size = std::max<size_t>(1, keys / BUSTUB_HT_PHASES);
+    for (size_t begin = 0; begin < keys; begin += phase_size) {
+      auto end = std::min(keys, begin + phase_size);
+      const auto &stats = bpm->GetStats();
+      auto misses_before = stats.fetch_misses_.Get();
+      auto start = ClockMs();
+      for (size_t i = begin; i < end; i++) {
+        ht.Insert(nullptr, MakeKey(i), ValueType(i >> 16, i & 0xffff));
+      }
+      auto insert_ms = std::max<uint64_t>(ClockMs() - start, 1);
+      auto insert_misses = stats.fetch_misses_.Get() - misses_before;
+
+      std::uniform_int_distribution<size_t> dis(0, end - 1);
+      std::vector<ValueType> result;
+      misses_before = stats.fetch_misses_.Get();
+      start = ClockMs();
+      for (size_t i = 0; i < BUSTUB_HT_LOOKUPS; i++) {
+        result.clear();
+        ht.GetValue(nullptr, MakeKey(dis(gen)), &result);
+        if (result.size() != 1) {
+          fmt::print("lookup found {} values\n", result.size());
+          return 1;
+        }
+      }
+      auto lookup_ms = std::max<uint64_t>(ClockMs() - start, 1);
+      auto lookup_misses = stats.fetch_misses_.Get() - misses_before;
+
+      auto size = ht.GetSize();
+      auto table_mb = static_cast<double>(size * sizeof(std::pair<KeyType, ValueType>)) / (1 << 20);
+      auto pool_mb = static_cast<double>(pool_size * bustub::BUSTUB_PAGE_SIZE) / (1 << 20);
+      fmt::print(
+          "pairs={} slots={} table_mb={:.1f} table_to_pool={:.1f} inserts_per_sec={:.0f} "
+          "insert_misses_per_op={:.3f} lookups_per_sec={:.0f} lookup_misses_per_op={:.3f}\n",
+          end, size, table_mb, table_mb / pool_mb,
+          static_cast<double>(end - begin) / insert_ms * 1000,
+          static_cast<double>(insert_misses) / (end - begin),
+          static_cast<double>(BUSTUB_HT_LOOKUPS) / lookup_ms * 1000,
+          static_cast<double>(lookup_misses) / BUSTUB_HT_LOOKUPS);
+    }
+  }
+
+  disk_manager->ShutDown();
+  std::remove(db_file.c_str());
+  std::remove(log_file.c_str());
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "fmt/core.h"
+
+static const size_t BUSTUB_RESTART_TABLES = 5000;
+/** Every this many tables get a hash index. */
+static const size_t BUSTUB_RESTART_INDEX_EVERY = 10;
+
+auto ElapsedMs(std::chrono::steady_clock::time_point start) -> double {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-restart-bench");
+  program.add_argument("--tables").help("number of tables to create before the restart");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t tables = BUSTUB_RESTART_TABLES;
+  if (program.present("--tables")) {
+    tables = std::stoi(program.get("--tables"));
+  }
+
+  const std::string db_file = "restart_bench.db";
+  const std::string log_file = "restart_bench.log";
+  std::remove(db_file.c_str());
+  std::remove(log_file.c_str());
+  std::stringstream ss;
+  bustub::SimpleStreamWriter writer(ss, true);
+
+  // Build a database of many small tables, and shut it down cleanly.
+  auto start = std::chrono::steady_clock::now();
+  auto bustub = std::make_unique<bustub::BustubInstance>(db_file);
+  for (size_t i = 0; i < tables; i++) {
+    bustub->ExecuteSql(fmt::format("CREATE TABLE t{}(a int, b int, c varchar(32));", i), writer);
+    bustub->ExecuteSql(fmt::format("INSERT INTO t{} VALUES ({}, {}, 'row of t{}');", i, i, i * 2, i), writer);
+    if (i % BUSTUB_RESTART_INDEX_EVERY == 0) {
+      bustub->ExecuteSql(fmt::format("CREATE INDEX t{}a ON t{} USING hash (a);", i, i), writer);
+    }
+  }
+  auto create_ms = ElapsedMs(start);
+  start = std::chrono::steady_clock::now();
+  bustub.reset();
+  auto shutdown_ms = ElapsedMs(start);
+
+  // Reopen it. Only the catalog pages are read here, the tables are read when they are queried.
+  start = std::chrono::steady_clock::now();
+  bustub = std::make_unique<bustub::BustubInstance>(db_file);
+  auto open_ms = ElapsedMs(start);
+  auto open_reads = bustub->disk_manager_->GetStats().reads_.Get();
+  auto reopened_tables = bustub->catalog_->GetTableNames().size();
+  if (reopened_tables != tables) {
+    fmt::print("reopened {} of {} tables\n", reopened_tables, tables);
+    return 1;
+  }
+
+  auto probe = tables / BUSTUB_RESTART_INDEX_EVERY / 2 * BUSTUB_RESTART_INDEX_EVERY;
+  ss.str("");
+  start = std::chrono::steady_clock::now();
+  bustub->ExecuteSql(fmt::format("SELECT b FROM t{} WHERE a = {};", probe, probe), writer);
+  auto first_query_ms = ElapsedMs(start);
+  if (ss.str() != fmt::format("{}\t\n", probe * 2)) {
+    fmt::print("query on t{} returned {}\n", probe, ss.str());
+    return 1;
+  }
+
+  fmt::print(
+      "tables={} create_ms={:.0f} shutdown_ms={:.1f} open_ms={:.2f} open_page_reads={} first_query_ms={:.2f} "
+      "first_query_page_reads={}\n",
+      tables, create_ms, shutdown_ms, open_ms, open_reads, first_query_ms,
+      bustub->disk_manager_->GetStats().reads_.Get() - open_reads);
+
+  bustub.reset();
+  std::remove(db_file.c_str());
+  std::remove(log_file.c_str());
+  return 0;
+}
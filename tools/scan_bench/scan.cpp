@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/result_cursor.h"
+#include "fmt/core.h"
+
+#include <malloc.h>
+#include <sys/time.h>
+
+// Count every heap allocation made by the process, and the bytes it holds on the heap.
+static std::atomic<uint64_t> allocation_cnt{0};
+static std::atomic<uint64_t> heap_bytes{0};
+static std::atomic<uint64_t> peak_heap_bytes{0};
+
+// NOLINTNEXTLINE
+auto operator new(size_t size) -> void * {
+  allocation_cnt++;
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {  // NOLINT
+    auto bytes = heap_bytes.fetch_add(malloc_usable_size(ptr)) + malloc_usable_size(ptr);
+    auto peak = peak_heap_bytes.load();
+    while (bytes > peak && !peak_heap_bytes.compare_exchange_weak(peak, bytes)) {
+    }
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+// NOLINTNEXTLINE
+auto operator new[](size_t size) -> void * { return operator new(size); }
+
+// NOLINTNEXTLINE
+void operator delete(void *ptr) noexcept {
+  heap_bytes.fetch_sub(malloc_usable_size(ptr));
+  std::free(ptr);  // NOLINT
+}
+
+// NOLINTNEXTLINE
+void operator delete[](void *ptr) noexcept { operator delete(ptr); }
+
+// NOLINTNEXTLINE
+void operator delete(void *ptr, size_t size) noexcept { operator delete(ptr); }
+
+// NOLINTNEXTLINE
+void operator delete[](void *ptr, size_t size) noexcept { operator delete(ptr); }
+
+auto ClockMs() -> uint64_t {
+  struct timeval tm;
+  gettimeofday(&tm, nullptr);
+  return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
+}
+
+static const size_t BUSTUB_SCAN_ROWS = 10000;
+static const size_t BUSTUB_SCAN_BATCH = 1000;
+static const size_t BUSTUB_SCAN_CNT = 10;
+
+auto ExecuteOrDie(bustub::BustubInstance *bustub, const std::string &query) -> std::string {
+  std::stringstream ss;
+  auto writer = bustub::SimpleStreamWriter(ss, true);
+  auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
+  if (!bustub->ExecuteSqlTxn(query, writer, txn)) {
+    fmt::print("unexpected failure when executing \"{}\"\n", query.substr(0, 64));
+    exit(1);
+  }
+  bustub->txn_manager_->Commit(txn);
+  delete txn;
+  return ss.str();
+}
+
+void Measure(bustub::BustubInstance *bustub, const std::string &name, const std::string &query, size_t rows) {
+  auto start_allocation_cnt = allocation_cnt.load();
+  auto start = ClockMs();
+  for (size_t i = 0; i < BUSTUB_SCAN_CNT; i++) {
+    ExecuteOrDie(bustub, query);
+  }
+  auto elapsed = ClockMs() - start;
+  auto allocations = allocation_cnt.load() - start_allocation_cnt;
+  fmt::print("{}: scan_ms={:.4} rows_per_sec={:.0f} allocations_per_row={:.2f}\n", name,
+             elapsed / static_cast<double>(BUSTUB_SCAN_CNT),
+             static_cast<double>(rows * BUSTUB_SCAN_CNT) / std::max<uint64_t>(elapsed, 1) * 1000,
+             allocations / static_cast<double>(rows * BUSTUB_SCAN_CNT));
+}
+
+auto ElapsedMs(std::chrono::steady_clock::time_point start) -> double {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** Formats every row like a client would, and notes when the first one arrives. */
+class FirstRowWriter : public bustub::NoopWriter {
+ public:
+  void WriteCell(const std::string &cell) override { bytes_ += cell.size(); }
+  void EndRow() override {
+    if (rows_++ == 0) {
+      first_row_ms_ = ElapsedMs(start_);
+    }
+  }
+
+  std::chrono::steady_clock::time_point start_{std::chrono::steady_clock::now()};
+  double first_row_ms_{0};
+  size_t rows_{0};
+  size_t bytes_{0};
+};
+
+// Measure how soon the first row of a large result arrives, and how much memory delivering it takes, when the rows
+// are written and when they are pulled through a cursor.
+void MeasureStreaming(bustub::BustubInstance *bustub, const std::string &query, size_t rows) {
+  auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
+  auto start_heap_bytes = heap_bytes.load();
+  peak_heap_bytes = start_heap_bytes;
+  FirstRowWriter writer;
+  if (!bustub->ExecuteSqlTxn(query, writer, txn) || writer.rows_ != rows) {
+    fmt::print("unexpected result of \"{}\"\n", query);
+    exit(1);
+  }
+  fmt::print("stream: first_row_ms={:.4} total_ms={:.4} peak_heap_mb={:.2}\n", writer.first_row_ms_,
+             ElapsedMs(writer.start_), (peak_heap_bytes - start_heap_bytes) / 1048576.0);
+
+  start_heap_bytes = heap_bytes.load();
+  peak_heap_bytes = start_heap_bytes;
+  auto start = std::chrono::steady_clock::now();
+  double first_batch_ms = 0;
+  size_t cursor_rows = 0;
+  {
+    auto cursor = bustub->OpenCursor(query, txn);
+    std::vector<bustub::Tuple> batch;
+    while (cursor->Next(&batch)) {
+      if (cursor_rows == 0) {
+        first_batch_ms = ElapsedMs(start);
+      }
+      cursor_rows += batch.size();
+    }
+  }
+  fmt::print("cursor: first_batch_ms={:.4} total_ms={:.4} peak_heap_mb={:.2}\n", first_batch_ms, ElapsedMs(start),
+             (peak_heap_bytes - start_heap_bytes) / 1048576.0);
+  if (cursor_rows != rows) {
+    fmt::print("cursor returned {} of {} rows\n", cursor_rows, rows);
+    exit(1);
+  }
+
+  bustub->txn_manager_->Commit(txn);
+  delete txn;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-scan-bench");
+  program.add_argument("--rows").help("number of rows to load");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t rows = BUSTUB_SCAN_ROWS;
+  if (program.present("--rows")) {
+    rows = std::stoi(program.get("--rows"));
+  }
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+
+  std::cerr << "x: create schema" << std::endl;
+  ExecuteOrDie(bustub.get(), "CREATE TABLE scan(id int, category int, payload varchar(64));");
+
+  std::cerr << "x: load " << rows << " rows" << std::endl;
+  for (size_t begin = 0; begin < rows; begin += BUSTUB_SCAN_BATCH) {
+    std::string query = "INSERT INTO scan VALUES ";
+    for (size_t i = begin; i < std::min(rows, begin + BUSTUB_SCAN_BATCH); i++) {
+      if (i != begin) {
+        query += ", ";
+      }
+      query += fmt::format("({}, {}, '{}')", i, i % 100, std::string(8 + i % 32, 'a' + i % 26));
+    }
+    ExecuteOrDie(bustub.get(), query);
+  }
+
+  std::cerr << "x: benchmark start" << std::endl;
+  Measure(bustub.get(), "count", "SELECT count(*) FROM scan", rows);
+  Measure(bustub.get(), "filter", "SELECT id FROM scan WHERE category = 7", rows);
+  Measure(bustub.get(), "project", "SELECT id, payload FROM scan", rows);
+  MeasureStreaming(bustub.get(), "SELECT id, payload FROM scan", rows);
+
+  return 0;
+}
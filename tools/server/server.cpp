@@ -0,0 +1,74 @@
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "fmt/core.h"
+#include "server/server.h"
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-server");
+  program.add_argument("--port").help("listen on this TCP port of the loopback interface");
+  program.add_argument("--socket").help("listen on a Unix domain socket at this path");
+  program.add_argument("--workers").help("number of threads executing queries");
+  program.add_argument("--db").help("database file, in memory if not given");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  if (!program.present("--port") && !program.present("--socket")) {
+    std::cerr << "either --port or --socket is required" << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t workers = bustub::SERVER_DEFAULT_WORKERS;
+  if (program.present("--workers")) {
+    workers = std::stoi(program.get("--workers"));
+  }
+
+  // Wait for the signals that stop the server in the main thread only.
+  sigset_t stop_signals;
+  sigemptyset(&stop_signals);
+  sigaddset(&stop_signals, SIGINT);
+  sigaddset(&stop_signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+  std::unique_ptr<bustub::BustubInstance> bustub;
+  if (program.present("--db")) {
+    bustub = std::make_unique<bustub::BustubInstance>(program.get("--db"));
+  } else {
+    bustub = std::make_unique<bustub::BustubInstance>();
+  }
+
+  try {
+    bustub::Server server(bustub.get(), workers);
+    if (program.present("--port")) {
+      auto port = server.ListenTcp(std::stoi(program.get("--port")));
+      std::cerr << fmt::format("x: listening on 127.0.0.1:{}", port) << std::endl;
+    }
+    if (program.present("--socket")) {
+      server.ListenUnix(program.get("--socket"));
+      std::cerr << fmt::format("x: listening on {}", program.get("--socket")) << std::endl;
+    }
+    server.Start();
+
+    int signal;
+    sigwait(&stop_signals, &signal);
+    std::cerr << fmt::format("x: stopping with {} sessions", server.GetSessionCount()) << std::endl;
+  } catch (const bustub::Exception &ex) {
+    std::cerr << ex.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "fmt/core.h"
+#include "server/client.h"
+#include "server/server.h"
+
+#include <unistd.h>
+
+static const size_t BUSTUB_SERVER_BENCH_SESSIONS = 256;
+static const size_t BUSTUB_SERVER_BENCH_ROWS = 10000;
+static const uint64_t BUSTUB_SERVER_BENCH_DURATION_MS = 10000;
+/** One query in this many is an insert, the others are point lookups. */
+static const size_t BUSTUB_SERVER_BENCH_INSERT_EVERY = 10;
+
+struct Target {
+  std::string socket_;
+  uint16_t port_{0};
+
+  void Connect(bustub::Client *client) const {
+    if (!socket_.empty()) {
+      client->ConnectUnix(socket_);
+    } else {
+      client->ConnectTcp("127.0.0.1", port_);
+    }
+  }
+};
+
+void ExecuteOrDie(bustub::Client *client, const std::string &query) {
+  auto result = client->Execute(query);
+  if (!result.IsSuccessful()) {
+    fmt::print("unexpected failure when executing \"{}\": {}\n", query.substr(0, 64), result.payload_);
+    exit(1);
+  }
+}
+
+auto Percentile(const std::vector<uint64_t> &sorted, double percentile) -> double {
+  if (sorted.empty()) {
+    return 0;
+  }
+  auto idx = std::min(sorted.size() - 1, static_cast<size_t>(percentile * sorted.size()));
+  return sorted[idx] / 1000.0;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-server-bench");
+  program.add_argument("--sessions").help("number of concurrent sessions");
+  program.add_argument("--duration").help("run the load for n milliseconds");
+  program.add_argument("--rows").help("number of rows to load");
+  program.add_argument("--port").help("load a server on this TCP port instead of an embedded one");
+  program.add_argument("--socket").help("load a server on this Unix domain socket instead of an embedded one");
+  program.add_argument("--workers").help("number of worker threads of the embedded server");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t sessions = BUSTUB_SERVER_BENCH_SESSIONS;
+  if (program.present("--sessions")) {
+    sessions = std::stoi(program.get("--sessions"));
+  }
+  size_t rows = BUSTUB_SERVER_BENCH_ROWS;
+  if (program.present("--rows")) {
+    rows = std::stoi(program.get("--rows"));
+  }
+  uint64_t duration_ms = BUSTUB_SERVER_BENCH_DURATION_MS;
+  if (program.present("--duration")) {
+    duration_ms = std::stoi(program.get("--duration"));
+  }
+  size_t workers = bustub::SERVER_DEFAULT_WORKERS;
+  if (program.present("--workers")) {
+    workers = std::stoi(program.get("--workers"));
+  }
+
+  // Without a server to load, one is started in this process, on a Unix domain socket.
+  Target target;
+  std::unique_ptr<bustub::BustubInstance> bustub;
+  std::unique_ptr<bustub::Server> server;
+  if (program.present("--socket")) {
+    target.socket_ = program.get("--socket");
+  } else if (program.present("--port")) {
+    target.port_ = std::stoi(program.get("--port"));
+  } else {
+    target.socket_ = fmt::format("/tmp/bustub-server-bench-{}.sock", getpid());
+    bustub = std::make_unique<bustub::BustubInstance>();
+    server = std::make_unique<bustub::Server>(bustub.get(), workers);
+    server->ListenUnix(target.socket_);
+    server->Start();
+    std::cerr << fmt::format("x: embedded server with {} workers", workers) << std::endl;
+  }
+
+  {
+    bustub::Client client;
+    target.Connect(&client);
+    std::cerr << "x: create schema" << std::endl;
+    ExecuteOrDie(&client, "CREATE TABLE bench(k int, v int);");
+    ExecuteOrDie(&client, "CREATE INDEX bench_k ON bench(k);");
+    ExecuteOrDie(&client, "CREATE TABLE bench_log(k int, v int);");
+
+    std::cerr << "x: load " << rows << " rows" << std::endl;
+    for (size_t begin = 0; begin < rows; begin += 1000) {
+      std::string query = "INSERT INTO bench VALUES ";
+      for (size_t i = begin; i < std::min(rows, begin + 1000); i++) {
+        query += fmt::format("{}({}, {})", i == begin ? "" : ", ", i, i * 7);
+      }
+      ExecuteOrDie(&client, query);
+    }
+  }
+
+  std::cerr << fmt::format("x: connect {} sessions", sessions) << std::endl;
+  std::vector<std::unique_ptr<bustub::Client>> clients;
+  for (size_t i = 0; i < sessions; i++) {
+    clients.push_back(std::make_unique<bustub::Client>());
+    target.Connect(clients.back().get());
+  }
+
+  std::cerr << "x: benchmark start" << std::endl;
+  std::atomic<bool> is_finished{false};
+  std::atomic<uint64_t> failed_cnt{0};
+  std::vector<std::vector<uint64_t>> latencies_us(sessions);
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t session = 0; session < sessions; session++) {
+    threads.emplace_back([session, rows, &clients, &latencies_us, &is_finished, &failed_cnt] {
+      std::default_random_engine gen(session);
+      std::uniform_int_distribution<size_t> key_dist(0, rows - 1);
+      auto &latencies = latencies_us[session];
+      for (size_t i = 0; !is_finished; i++) {
+        auto key = key_dist(gen);
+        auto query = i % BUSTUB_SERVER_BENCH_INSERT_EVERY == 0
+                         ? fmt::format("INSERT INTO bench_log VALUES ({}, {})", key, session)
+                         : fmt::format("SELECT v FROM bench WHERE k = {}", key);
+        auto query_start = std::chrono::steady_clock::now();
+        auto result = clients[session]->Execute(query);
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - query_start)
+                .count());
+        if (!result.IsSuccessful()) {
+          failed_cnt++;
+        }
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+  is_finished = true;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  clients.clear();
+
+  std::vector<uint64_t> all_latencies_us;
+  for (const auto &latencies : latencies_us) {
+    all_latencies_us.insert(all_latencies_us.end(), latencies.begin(), latencies.end());
+  }
+  std::sort(all_latencies_us.begin(), all_latencies_us.end());
+
+  fmt::print("<<< BEGIN\n");
+  fmt::print("sessions: {}\n", sessions);
+  fmt::print("queries: {}\n", all_latencies_us.size());
+  fmt::print("failed: {}\n", failed_cnt.load());
+  fmt::print("qps: {:.0f}\n", all_latencies_us.size() / elapsed_s);
+  fmt::print("p50_ms: {:.3f}\n", Percentile(all_latencies_us, 0.5));
+  fmt::print("p99_ms: {:.3f}\n", Percentile(all_latencies_us, 0.99));
+  fmt::print("p999_ms: {:.3f}\n", Percentile(all_latencies_us, 0.999));
+  fmt::print("max_ms: {:.3f}\n", all_latencies_us.empty() ? 0 : all_latencies_us.back() / 1000.0);
+  fmt::print(">>> END\n");
+
+  return 0;
+}
@@ -73,6 +73,12 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           fmt::print("IndexScan not found\n");
           return false;
         }
+      } else if (opt == "ensure:bounded_index_scan") {
+        if (!bustub::StringUtil::Contains(result.str(), "IndexScan") ||
+            !bustub::StringUtil::Contains(result.str(), "limit=")) {
+          fmt::print("Bounded IndexScan not found\n");
+          return false;
+        }
       } else if (opt == "ensure:topn") {
         if (!bustub::StringUtil::Contains(result.str(), "TopN")) {
           fmt::print("TopN not found\n");
@@ -88,6 +94,26 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           fmt::print("NestedIndexJoin not found\n");
           return false;
         }
+      } else if (opt == "ensure:hash_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "HashJoin")) {
+          fmt::print("HashJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:semi_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "HashSemiJoin")) {
+          fmt::print("HashSemiJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:merge_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "MergeJoin")) {
+          fmt::print("MergeJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:stream_agg") {
+        if (!bustub::StringUtil::Contains(result.str(), "StreamAgg")) {
+          fmt::print("StreamAgg not found\n");
+          return false;
+        }
       } else {
         throw bustub::NotImplementedException(fmt::format("unsupported extra option: {}", opt));
       }
@@ -18,6 +18,7 @@
 #include "fmt/core.h"
 #include "fmt/std.h"
 #include "terrier_bench_config.h"
+#include "type/value_factory.h"
 
 #include <sys/time.h>
 
@@ -120,6 +121,7 @@ auto main(int argc, char **argv) -> int {
   program.add_argument("--duration").help("run terrier bench for n milliseconds");
   program.add_argument("--force-create-index").help("create index in terrier bench");
   program.add_argument("--force-enable-update").help("use update statement in terrier bench");
+  program.add_argument("--prepared").help("run the statements as prepared statements in terrier bench");
 
   try {
     program.parse_args(argc, argv);
@@ -172,6 +174,17 @@ auto main(int argc, char **argv) -> int {
     std::cerr << "x: use insert + delete" << std::endl;
   }
 
+  bool enable_prepared = false;
+  if (program.present("--prepared")) {
+    enable_prepared = ParseBool(program.get("--prepared"));
+  }
+
+  if (enable_prepared) {
+    std::cerr << "x: use prepared statements" << std::endl;
+  } else {
+    std::cerr << "x: use plain statements" << std::endl;
+  }
+
   uint64_t duration_ms = 30000;
 
   if (program.present("--duration")) {
@@ -205,6 +218,15 @@ auto main(int argc, char **argv) -> int {
     }
   }
 
+  // Prepared statements are planned once here, after the index exists, and shared by all threads. Each execution
+  // binds its own parameters.
+  if (enable_prepared) {
+    bustub->ExecuteSql("PREPARE update_nft AS UPDATE nft SET terrier = $1 WHERE id = $2;", writer);
+    bustub->ExecuteSql("PREPARE delete_nft AS DELETE FROM nft WHERE id = $1;", writer);
+    bustub->ExecuteSql("PREPARE insert_nft AS INSERT INTO nft VALUES ($1, $2);", writer);
+    bustub->ExecuteSql("PREPARE count_terrier AS SELECT count(*) FROM nft WHERE terrier = $1;", writer);
+  }
+
   std::cerr << "x: benchmark start" << std::endl;
 
   std::vector<std::thread> threads;
@@ -213,7 +235,8 @@ auto main(int argc, char **argv) -> int {
   total_metrics.Begin();
 
   for (size_t thread_id = 0; thread_id < BUSTUB_TERRIER_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &bustub, enable_update, duration_ms, &total_metrics] {
+    threads.emplace_back(std::thread([thread_id, &bustub, enable_update, enable_prepared, duration_ms,
+                                      &total_metrics] {
       const size_t nft_range_size = BUSTUB_NFT_NUM / BUSTUB_TERRIER_THREAD;
       const size_t nft_range_begin = thread_id * nft_range_size;
       const size_t nft_range_end = (thread_id + 1) * nft_range_size;
@@ -234,8 +257,16 @@ auto main(int argc, char **argv) -> int {
 
         if (enable_update) {
           auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
-          std::string query = fmt::format("UPDATE nft SET terrier = {} WHERE id = {}", terrier_id, nft_id);
-          if (!bustub->ExecuteSqlTxn(query, writer, txn)) {
+          bool executed;
+          if (enable_prepared) {
+            std::vector<bustub::Value> params{bustub::ValueFactory::GetIntegerValue(terrier_id),
+                                              bustub::ValueFactory::GetIntegerValue(nft_id)};
+            executed = bustub->ExecutePreparedTxn("update_nft", params, writer, txn);
+          } else {
+            std::string query = fmt::format("UPDATE nft SET terrier = {} WHERE id = {}", terrier_id, nft_id);
+            executed = bustub->ExecuteSqlTxn(query, writer, txn);
+          }
+          if (!executed) {
             txn_success = false;
           }
 
@@ -255,8 +286,15 @@ auto main(int argc, char **argv) -> int {
         } else {
           auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
 
-          std::string query = fmt::format("DELETE FROM nft WHERE id = {}", nft_id);
-          if (!bustub->ExecuteSqlTxn(query, writer, txn)) {
+          bool executed;
+          if (enable_prepared) {
+            std::vector<bustub::Value> params{bustub::ValueFactory::GetIntegerValue(nft_id)};
+            executed = bustub->ExecutePreparedTxn("delete_nft", params, writer, txn);
+          } else {
+            std::string query = fmt::format("DELETE FROM nft WHERE id = {}", nft_id);
+            executed = bustub->ExecuteSqlTxn(query, writer, txn);
+          }
+          if (!executed) {
             txn_success = false;
           }
 
@@ -275,8 +313,15 @@ auto main(int argc, char **argv) -> int {
 
             txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
 
-            query = fmt::format("INSERT INTO nft VALUES ({}, {})", nft_id, terrier_id);
-            if (!bustub->ExecuteSqlTxn(query, writer, txn)) {
+            if (enable_prepared) {
+              std::vector<bustub::Value> params{bustub::ValueFactory::GetIntegerValue(nft_id),
+                                                bustub::ValueFactory::GetIntegerValue(terrier_id)};
+              executed = bustub->ExecutePreparedTxn("insert_nft", params, writer, txn);
+            } else {
+              std::string query = fmt::format("INSERT INTO nft VALUES ({}, {})", nft_id, terrier_id);
+              executed = bustub->ExecuteSqlTxn(query, writer, txn);
+            }
+            if (!executed) {
               txn_success = false;
             }
 
@@ -304,7 +349,7 @@ auto main(int argc, char **argv) -> int {
   }
 
   for (size_t thread_id = 0; thread_id < BUSTUB_TERRIER_THREAD; thread_id++) {
-    threads.emplace_back(std::thread([thread_id, &bustub, duration_ms, &total_metrics] {
+    threads.emplace_back(std::thread([thread_id, &bustub, enable_prepared, duration_ms, &total_metrics] {
       std::random_device r;
       std::default_random_engine gen(r());
       std::uniform_int_distribution<int> terrier_uniform_dist(0, BUSTUB_TERRIER_CNT - 1);
@@ -320,8 +365,15 @@ auto main(int argc, char **argv) -> int {
         auto txn = bustub->txn_manager_->Begin(nullptr, bustub::IsolationLevel::REPEATABLE_READ);
         bool txn_success = true;
 
-        std::string query = fmt::format("SELECT count(*) FROM nft WHERE terrier = {}", terrier_id);
-        if (!bustub->ExecuteSqlTxn(query, writer, txn)) {
+        bool executed;
+        if (enable_prepared) {
+          std::vector<bustub::Value> params{bustub::ValueFactory::GetIntegerValue(terrier_id)};
+          executed = bustub->ExecutePreparedTxn("count_terrier", params, writer, txn);
+        } else {
+          std::string query = fmt::format("SELECT count(*) FROM nft WHERE terrier = {}", terrier_id);
+          executed = bustub->ExecuteSqlTxn(query, writer, txn);
+        }
+        if (!executed) {
           txn_success = false;
         }
 